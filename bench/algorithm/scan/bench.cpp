@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/linear_scan.hpp"
+
+BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+/// @file linear_scan.hpp
+/// @brief Find, count and min over arrays of integers and floats
+///
+/// Checking Regressions For:
+/// - The AVX2/SSE2 kernels, and their runtime dispatch overhead on small arrays
+/// - Versus the scalar loops, and the std algorithms
+///
+/// Representative:
+/// Representative of filtering over columns of ids or measurements, where the item being searched
+/// for is usually absent (so the whole array is scanned).
+
+#pragma once
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+/// Items in `[1, 100]`, so `0` is never found.
+template <typename Item> std::vector<Item> scan_input(size_t n) {
+    U32XORShiftGen gen(SEED);
+    std::vector<Item> items(n);
+    for (auto& item : items) {
+        item = static_cast<Item>((gen.next() % 100) + 1);
+    }
+    return items;
+}
+
+template <ScanCase Impl> void find_absent(benchmark::State& state) {
+    using Item = typename Impl::Self_item_t;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<Item> const items = scan_input<Item>(n);
+    Item const needle = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(items.data());
+        if constexpr (LABEL_CHECK(Impl, derive_c_simd) || LABEL_CHECK(Impl, derive_c_scalar)) {
+            benchmark::DoNotOptimize(Impl::Self_find(items.data(), n, needle));
+        } else if constexpr (LABEL_CHECK(Impl, stl_algorithm)) {
+            benchmark::DoNotOptimize(std::find(items.begin(), items.end(), needle));
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <ScanCase Impl> void count(benchmark::State& state) {
+    using Item = typename Impl::Self_item_t;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<Item> const items = scan_input<Item>(n);
+    Item const needle = 50;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(items.data());
+        if constexpr (LABEL_CHECK(Impl, derive_c_simd) || LABEL_CHECK(Impl, derive_c_scalar)) {
+            benchmark::DoNotOptimize(Impl::Self_count(items.data(), n, needle));
+        } else if constexpr (LABEL_CHECK(Impl, stl_algorithm)) {
+            benchmark::DoNotOptimize(std::count(items.begin(), items.end(), needle));
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <ScanCase Impl> void min(benchmark::State& state) {
+    using Item = typename Impl::Self_item_t;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<Item> const items = scan_input<Item>(n);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(items.data());
+        if constexpr (LABEL_CHECK(Impl, derive_c_simd) || LABEL_CHECK(Impl, derive_c_scalar)) {
+            benchmark::DoNotOptimize(Impl::Self_min(items.data(), n));
+        } else if constexpr (LABEL_CHECK(Impl, stl_algorithm)) {
+            benchmark::DoNotOptimize(std::min_element(items.begin(), items.end()));
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(ITEM)                                                                                \
+    BENCHMARK_TEMPLATE(find_absent, Simd<ITEM>)->Apply(range::exponential<65536>);                 \
+    BENCHMARK_TEMPLATE(find_absent, Scalar<ITEM>)->Apply(range::exponential<65536>);               \
+    BENCHMARK_TEMPLATE(find_absent, Std<ITEM>)->Apply(range::exponential<65536>);                  \
+    BENCHMARK_TEMPLATE(count, Simd<ITEM>)->Apply(range::exponential<65536>);                       \
+    BENCHMARK_TEMPLATE(count, Scalar<ITEM>)->Apply(range::exponential<65536>);                     \
+    BENCHMARK_TEMPLATE(count, Std<ITEM>)->Apply(range::exponential<65536>);                        \
+    BENCHMARK_TEMPLATE(min, Simd<ITEM>)->Apply(range::exponential<65536>);                         \
+    BENCHMARK_TEMPLATE(min, Scalar<ITEM>)->Apply(range::exponential<65536>);                       \
+    BENCHMARK_TEMPLATE(min, Std<ITEM>)->Apply(range::exponential<65536>)
+
+BENCH(std::uint8_t);
+BENCH(std::int16_t);
+BENCH(std::uint32_t);
+BENCH(std::int64_t);
+BENCH(float);
+BENCH(double);
+
+#undef BENCH
@@ -0,0 +1,40 @@
+#pragma once
+#include <type_traits>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-c/algorithm/scan/includes.h>
+
+template <typename T>
+concept ScanCase = requires {
+    typename T::Self_item_t;
+    { T::impl_name } -> std::convertible_to<const char*>;
+};
+
+template <typename Item> struct Simd {
+    LABEL_ADD(derive_c_simd);
+    static constexpr const char* impl_name = "derive-c/scan";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define NAME Self
+#include <derive-c/algorithm/scan/template.h>
+};
+
+// JUSTIFY: Explicit ITEM_EQ and ITEM_ORD
+//  - Selects the scalar loops, the same as the default comparisons without the simd kernels.
+template <typename Item> struct Scalar {
+    LABEL_ADD(derive_c_scalar);
+    static constexpr const char* impl_name = "derive-c/scan (scalar)";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define ITEM_EQ DC_MEM_EQ
+#define ITEM_ORD DC_MEM_LT
+#define NAME Self
+#include <derive-c/algorithm/scan/template.h>
+};
+
+template <typename Item> struct Std {
+    LABEL_ADD(stl_algorithm);
+    static constexpr const char* impl_name = "std/algorithm";
+
+    using Self_item_t = Item;
+};
@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/sort.hpp"
+
+BENCHMARK_MAIN();
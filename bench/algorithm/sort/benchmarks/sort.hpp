@@ -0,0 +1,96 @@
+/// @file sort.hpp
+/// @brief Sorting uniformly random integers and floats
+///
+/// Checking Regressions For:
+/// - The inlined comparison in the introsort, versus qsort's function pointer comparator
+/// - Partitioning and pivot selection, versus std::sort
+/// - Radix sort passes over integer and float keys
+///
+/// Representative:
+/// Representative of sorting large arrays of plain keys (e.g. ids, timestamps, scores) before
+/// deduplicating, merging or searching them.
+
+#pragma once
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+template <typename Item> std::vector<Item> sort_input(size_t n) {
+    U32XORShiftGen gen(SEED);
+    std::vector<Item> items(n);
+    for (auto& item : items) {
+        if constexpr (std::is_floating_point_v<Item>) {
+            item = (static_cast<Item>(gen.next()) - static_cast<Item>(UINT32_MAX / 2)) / 1024.0;
+        } else {
+            item = static_cast<Item>(gen.next());
+        }
+    }
+    return items;
+}
+
+template <SortCase Impl> void sort_random(benchmark::State& state) {
+    using Item = typename Impl::Self_item_t;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<Item> const input = sort_input<Item>(n);
+    std::vector<Item> items(n);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::copy(input.begin(), input.end(), items.begin());
+        state.ResumeTiming();
+
+        if constexpr (LABEL_CHECK(Impl, derive_c_intro)) {
+            Impl::Self_sort(items.data(), items.size());
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_radix)) {
+            Impl::Self_sort(items.data(), items.size(), stdalloc_get_ref());
+        } else if constexpr (LABEL_CHECK(Impl, c_qsort)) {
+            std::qsort(items.data(), items.size(), sizeof(Item), Impl::compare);
+        } else if constexpr (LABEL_CHECK(Impl, stl_sort)) {
+            std::sort(items.begin(), items.end());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(items.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+// JUSTIFY: Sizes from 1e4 to 1e7
+//  - Large enough that the sort dominates the timing pause for the input copy.
+//  - 1e8 items (with a copy of the input, and the radix scratch) needs several GiB, so is left
+//    out of the default run.
+#define BENCH(IMPL)                                                                                \
+    BENCHMARK_TEMPLATE(sort_random, IMPL)                                                          \
+        ->Arg(10000)                                                                               \
+        ->Arg(100000)                                                                              \
+        ->Arg(1000000)                                                                             \
+        ->Arg(10000000)                                                                            \
+        ->Unit(benchmark::kMillisecond)
+
+BENCH(Intro<std::uint32_t>);
+BENCH(Radix<std::uint32_t>);
+BENCH(Qsort<std::uint32_t>);
+BENCH(StdSort<std::uint32_t>);
+BENCH(Intro<double>);
+BENCH(Radix<double>);
+BENCH(Qsort<double>);
+BENCH(StdSort<double>);
+
+#undef BENCH
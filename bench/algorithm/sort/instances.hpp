@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-c/algorithm/sort/intro/includes.h>
+#include <derive-c/algorithm/sort/radix/includes.h>
+
+template <typename T>
+concept SortCase = requires {
+    typename T::Self_item_t;
+    { T::impl_name } -> std::convertible_to<const char*>;
+};
+
+/// Order preserving radix keys for the benchmarked item types.
+inline uint32_t radix_key(uint32_t value) { return uint32_t_radix_key(value); }
+inline uint64_t radix_key(double value) { return double_radix_key(value); }
+
+template <typename Item> struct Intro {
+    LABEL_ADD(derive_c_intro);
+    static constexpr const char* impl_name = "derive-c/intro";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define NAME Self
+#include <derive-c/algorithm/sort/intro/template.h>
+};
+
+template <typename Item> struct Radix {
+    LABEL_ADD(derive_c_radix);
+    static constexpr const char* impl_name = "derive-c/radix";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define KEY decltype(radix_key(Item{}))
+#define ITEM_KEY(item) radix_key(*(item))
+#define NAME Self
+#include <derive-c/algorithm/sort/radix/template.h>
+};
+
+template <typename Item> struct Qsort {
+    LABEL_ADD(c_qsort);
+    static constexpr const char* impl_name = "c/qsort";
+
+    using Self_item_t = Item;
+
+    static int compare(void const* a, void const* b) {
+        Item const lhs = *static_cast<Item const*>(a);
+        Item const rhs = *static_cast<Item const*>(b);
+        return (lhs > rhs) - (lhs < rhs);
+    }
+};
+
+template <typename Item> struct StdSort {
+    LABEL_ADD(stl_sort);
+    static constexpr const char* impl_name = "std/sort";
+
+    using Self_item_t = Item;
+};
@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/iterate.hpp"
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+/// @file iterate.hpp
+/// @brief Iterating arenas with most of their entries removed
+///
+/// Checking Regressions For:
+/// - Skipping empty slots with the occupancy bitmap, from 1% to 100% of entries present
+/// - Iteration over each arena's block layout (one vector, fixed size blocks, doubling blocks)
+///
+/// Representative:
+/// Representative of a long lived arena of entities (e.g. graph nodes, game objects) where most
+/// entries have been removed, and a pass visits those remaining.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace iterate {
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"size", "percent_present"});
+    for (int64_t size : {1 << 12, 1 << 20}) {
+        for (int64_t percent : {1, 10, 50, 100}) {
+            benchmark->Args({size, percent});
+        }
+    }
+}
+
+template <ArenaCase Impl> typename Impl::Self make() {
+    if constexpr (LABEL_CHECK(Impl, derive_c_arena_contiguous)) {
+        return Impl::Self_new_with_capacity_for(1, stdalloc_get_ref());
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_arena_chunked) ||
+                         LABEL_CHECK(Impl, derive_c_arena_geometric)) {
+        return Impl::Self_new(stdalloc_get_ref());
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+} // namespace iterate
+
+/// Inserts `size` entries, then removes all but a random `percent_present` of them.
+template <ArenaCase Impl> void arena_iterate(benchmark::State& state) {
+    size_t const size = static_cast<size_t>(state.range(0));
+    uint32_t const percent = static_cast<uint32_t>(state.range(1));
+
+    typename Impl::Self arena = iterate::make<Impl>();
+    std::vector<typename Impl::Self_index_t> removed;
+    U32XORShiftGen gen(SEED);
+    for (size_t i = 0; i < size; i++) {
+        typename Impl::Self_index_t const index = Impl::Self_insert(&arena, i);
+        if (gen.next() % 100 >= percent) {
+            removed.push_back(index);
+        }
+    }
+    for (typename Impl::Self_index_t const index : removed) {
+        Impl::Self_remove(&arena, index);
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        typename Impl::Self_iter_const iter = Impl::Self_get_iter_const(&arena);
+        for (typename Impl::Self_iter_const_item item = Impl::Self_iter_const_next(&iter);
+             !Impl::Self_iter_const_empty_item(&item); item = Impl::Self_iter_const_next(&iter)) {
+            sum += *item.value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["present"] = static_cast<double>(Impl::Self_size(&arena));
+    Impl::Self_delete(&arena);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(arena_iterate, Contiguous)->Apply(iterate::range);
+BENCHMARK_TEMPLATE(arena_iterate, Chunked)->Apply(iterate::range);
+BENCHMARK_TEMPLATE(arena_iterate, Geometric)->Apply(iterate::range);
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <derive-cpp/meta/labels.hpp>
+
+#include <derive-c/container/arena/chunked/includes.h>
+#include <derive-c/container/arena/contiguous/includes.h>
+#include <derive-c/container/arena/geometric/includes.h>
+
+template <typename T>
+concept ArenaCase = requires {
+    typename T::Self;
+    typename T::Self_index_t;
+    { T::impl_name } -> std::convertible_to<const char*>;
+};
+
+struct Contiguous {
+    LABEL_ADD(derive_c_arena_contiguous);
+    static constexpr const char* impl_name = "derive-c/arena/contiguous";
+#define EXPAND_IN_STRUCT
+#define INDEX_BITS 32
+#define VALUE uint64_t
+#define NAME Self
+#include <derive-c/container/arena/contiguous/template.h>
+};
+
+struct Chunked {
+    LABEL_ADD(derive_c_arena_chunked);
+    static constexpr const char* impl_name = "derive-c/arena/chunked";
+#define EXPAND_IN_STRUCT
+#define INDEX_BITS 32
+#define BLOCK_INDEX_BITS 12
+#define VALUE uint64_t
+#define NAME Self
+#include <derive-c/container/arena/chunked/template.h>
+};
+
+struct Geometric {
+    LABEL_ADD(derive_c_arena_geometric);
+    static constexpr const char* impl_name = "derive-c/arena/geometric";
+#define EXPAND_IN_STRUCT
+#define INDEX_BITS 32
+#define VALUE uint64_t
+#define NAME Self
+#include <derive-c/container/arena/geometric/template.h>
+};
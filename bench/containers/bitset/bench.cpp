@@ -0,0 +1,11 @@
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/bulk.hpp"
+#include "benchmarks/clear.hpp"
+#include "benchmarks/concurrent.hpp"
+#include "benchmarks/density.hpp"
+#include "benchmarks/roaring.hpp"
+#include "benchmarks/set_range.hpp"
+#include "benchmarks/sparse.hpp"
+
+BENCHMARK_MAIN();
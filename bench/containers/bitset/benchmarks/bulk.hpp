@@ -0,0 +1,176 @@
+/// @file bulk.hpp
+/// @brief Intersecting, unioning and counting runtime sized bitsets, from 1K to 100M bits
+///
+/// Checking Regressions For:
+/// - Word at a time (and AVX2) `and`/`or`, in place and into an existing bitset
+/// - `count_and` (vectorised popcount) and `any_and` (early exit, here scanning all words)
+/// - Versus the same operations on `std::vector<bool>`
+///
+/// Representative:
+/// Representative of filter engines, combining per predicate row masks over large tables.
+
+#pragma once
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace bulk {
+// JUSTIFY: Sizes from 1K to 100M bits
+//  - From fitting in L1 (128 bytes), to far exceeding the last level cache (12.5MB).
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    for (int64_t const bits : {1 << 10, 1 << 13, 1 << 16, 1 << 20, 1 << 23, 100'000'000}) {
+        benchmark->Arg(bits);
+    }
+}
+
+// JUSTIFY: `odd` selects disjoint halves of the indices
+//  - So `any_and` of the two bitsets must scan every word.
+template <BitsetCase Impl> typename Impl::Self build(size_t n, bool odd) {
+    U32XORShiftGen gen(SEED);
+    if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+        typename Impl::Self b = Impl::Self_new_with_end(n, stdalloc_get_ref());
+        for (size_t i = odd ? 1 : 0; i < n; i += 2) {
+            Impl::Self_set(&b, i, gen.next() % 2 == 0);
+        }
+        return b;
+    } else if constexpr (LABEL_CHECK(Impl, stl_vector_bool)) {
+        typename Impl::Self b(n);
+        for (size_t i = odd ? 1 : 0; i < n; i += 2) {
+            b[i] = gen.next() % 2 == 0;
+        }
+        return b;
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+
+template <BitsetCase Impl> void destroy(typename Impl::Self* b) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+        Impl::Self_delete(b);
+    }
+}
+} // namespace bulk
+
+template <BitsetCase Impl> void bulk_and_assign(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self left = bulk::build<Impl>(n, false);
+    typename Impl::Self right = bulk::build<Impl>(n, true);
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            Impl::Self_and_assign(&left, &right);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector_bool)) {
+            std::transform(left.begin(), left.end(), right.begin(), left.begin(),
+                           std::logical_and<>());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(&left);
+        benchmark::ClobberMemory();
+    }
+
+    bulk::destroy<Impl>(&left);
+    bulk::destroy<Impl>(&right);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <BitsetCase Impl> void bulk_or(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self left = bulk::build<Impl>(n, false);
+    typename Impl::Self right = bulk::build<Impl>(n, true);
+    typename Impl::Self out = bulk::build<Impl>(n, false);
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            Impl::Self_or(&left, &right, &out);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector_bool)) {
+            std::transform(left.begin(), left.end(), right.begin(), out.begin(),
+                           std::logical_or<>());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(&out);
+        benchmark::ClobberMemory();
+    }
+
+    bulk::destroy<Impl>(&left);
+    bulk::destroy<Impl>(&right);
+    bulk::destroy<Impl>(&out);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <BitsetCase Impl> void bulk_count_and(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self left = bulk::build<Impl>(n, false);
+    typename Impl::Self right = bulk::build<Impl>(n, false);
+
+    for (auto _ : state) {
+        size_t count = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            count = Impl::Self_count_and(&left, &right);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector_bool)) {
+            for (size_t i = 0; i < n; i++) {
+                count += (left[i] && right[i]) ? 1 : 0;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+
+    bulk::destroy<Impl>(&left);
+    bulk::destroy<Impl>(&right);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <BitsetCase Impl> void bulk_any_and(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self left = bulk::build<Impl>(n, false);
+    typename Impl::Self right = bulk::build<Impl>(n, true);
+
+    for (auto _ : state) {
+        bool any = false;
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            any = Impl::Self_any_and(&left, &right);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector_bool)) {
+            for (size_t i = 0; i < n && !any; i++) {
+                any = left[i] && right[i];
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(any);
+    }
+
+    bulk::destroy<Impl>(&left);
+    bulk::destroy<Impl>(&right);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(bulk_and_assign, __VA_ARGS__)->Apply(bulk::range);                          \
+    BENCHMARK_TEMPLATE(bulk_or, __VA_ARGS__)->Apply(bulk::range);                                  \
+    BENCHMARK_TEMPLATE(bulk_count_and, __VA_ARGS__)->Apply(bulk::range);                           \
+    BENCHMARK_TEMPLATE(bulk_any_and, __VA_ARGS__)->Apply(bulk::range)
+
+BENCH(Dynamic<0>);
+BENCH(StdVectorBool<0>);
+
+#undef BENCH
@@ -0,0 +1,120 @@
+/// @file clear.hpp
+/// @brief Repeatedly adding, checking and clearing a few ids, from a universe of 64K to 16M
+///
+/// Checking Regressions For:
+/// - `clear` of the sparse set being O(1), whatever the universe
+/// - Clearing the flat bitset (every word), the hierarchical bitset (only nonzero words), and
+///   replacing a swiss set
+/// - `add` and `contains` of the sparse set, versus setting and getting bits
+///
+/// Representative:
+/// Representative of per frame or per query scratch sets of entity ids, such as visited sets.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace clear {
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"live"});
+    for (int64_t const live : {64, 4096}) {
+        benchmark->Arg(live);
+    }
+}
+
+/// Random ids to add, then the same number of random ids to check (about `live / capacity` of
+/// which are present).
+template <size_t Capacity> std::vector<uint32_t> ids(size_t count) {
+    U32XORShiftGen gen(SEED);
+    std::vector<uint32_t> result(count);
+    for (uint32_t& id : result) {
+        id = gen.next() % Capacity;
+    }
+    return result;
+}
+
+template <BitsetCase Impl> typename Impl::Self create(size_t live) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_sparse)) {
+        return Impl::Self_new_with_universe(Impl::capacity, stdalloc_get_ref());
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+        return Impl::Self_new_with_capacity_for(live, stdalloc_get_ref());
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic) ||
+                         LABEL_CHECK(Impl, derive_c_hierarchical)) {
+        return Impl::Self_new_with_end(Impl::capacity, stdalloc_get_ref());
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+} // namespace clear
+
+template <BitsetCase Impl> void clear_heavy(benchmark::State& state) {
+    size_t const live = static_cast<size_t>(state.range(0));
+    std::vector<uint32_t> const ids = clear::ids<Impl::capacity>(live * 2);
+    typename Impl::Self set = clear::create<Impl>(live);
+
+    for (auto _ : state) {
+        size_t found = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_sparse) || LABEL_CHECK(Impl, derive_c_swiss)) {
+            for (size_t i = 0; i < live; i++) {
+                Impl::Self_try_add(&set, ids[i]);
+            }
+            for (size_t i = live; i < ids.size(); i++) {
+                found += Impl::Self_contains(&set, ids[i]) ? 1 : 0;
+            }
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic) ||
+                             LABEL_CHECK(Impl, derive_c_hierarchical)) {
+            for (size_t i = 0; i < live; i++) {
+                Impl::Self_set(&set, ids[i], true);
+            }
+            for (size_t i = live; i < ids.size(); i++) {
+                found += Impl::Self_get(&set, ids[i]) ? 1 : 0;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(found);
+
+        if constexpr (LABEL_CHECK(Impl, derive_c_sparse)) {
+            Impl::Self_clear(&set);
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+            Impl::Self_delete(&set);
+            set = clear::create<Impl>(live);
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            Impl::Self_set_range(&set, 0, Impl::capacity, false);
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_hierarchical)) {
+            Impl::Self_clear_all(&set);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    Impl::Self_delete(&set);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ids.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...) BENCHMARK_TEMPLATE(clear_heavy, __VA_ARGS__)->Apply(clear::range)
+
+BENCH(SparseSet<1 << 16>);
+BENCH(SwissSet<1 << 16>);
+BENCH(Dynamic<1 << 16>);
+BENCH(Hierarchical<1 << 16>);
+BENCH(SparseSet<1 << 24>);
+BENCH(SwissSet<1 << 24>);
+BENCH(Dynamic<1 << 24>);
+BENCH(Hierarchical<1 << 24>);
+
+#undef BENCH
@@ -0,0 +1,111 @@
+/// @file concurrent.hpp
+/// @brief Threads claiming and releasing slots of a shared pool
+///
+/// Checking Regressions For:
+/// - `claim_first_clear` and `test_and_clear` on the atomic bitset, with and without spreading
+///   threads' hints across the pool
+/// - Versus a static bitset behind a mutex
+///
+/// Representative:
+/// Representative of worker threads claiming slots (e.g. buffers, connections) from a shared pool.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "../instances.hpp"
+
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace concurrent {
+// JUSTIFY: Each thread holds 64 slots at a time
+//  - So threads claim from partially filled words, rather than each claim and release of a single
+//    slot reusing the same index.
+static constexpr size_t held = 64;
+
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"spread"});
+    benchmark->Args({0});
+    benchmark->Args({1});
+    benchmark->ThreadRange(1, 8);
+    benchmark->UseRealTime();
+}
+
+template <BitsetCase Impl>
+size_t claim(typename Impl::Self* pool, size_t hint, std::mutex& lock) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_atomic)) {
+        return Impl::Self_claim_first_clear(pool, hint);
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_static)) {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t const words = sizeof(pool->words) / sizeof(pool->words[0]);
+        size_t const start = (hint % Impl::capacity) / 64;
+        for (size_t step = 0; step < words; step++) {
+            size_t const word = (start + step) % words;
+            if (~pool->words[word] != 0) {
+                size_t const offset = static_cast<size_t>(__builtin_ctzll(~pool->words[word]));
+                pool->words[word] |= uint64_t{1} << offset;
+                return (word * 64) + offset;
+            }
+        }
+        return Impl::capacity;
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+
+template <BitsetCase Impl> void release(typename Impl::Self* pool, size_t index, std::mutex& lock) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_atomic)) {
+        Impl::Self_test_and_clear(pool, static_cast<typename Impl::Self_index_t>(index));
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_static)) {
+        std::lock_guard<std::mutex> guard(lock);
+        Impl::Self_set(pool, static_cast<typename Impl::Self_index_t>(index), false);
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+} // namespace concurrent
+
+// JUSTIFY: A pool shared by all threads of a run
+//  - Reset by the first thread before the timed loop, which all threads start together.
+// JUSTIFY: The locked static bitset also searches from the hint's word
+//  - So spreading hints reduces contention on the same words for both, and the difference between
+//    them is the lock.
+template <BitsetCase Impl> void concurrent_claim_release(benchmark::State& state) {
+    static typename Impl::Self pool;
+    static std::mutex lock;
+    if (state.thread_index() == 0) {
+        pool = Impl::Self_new();
+    }
+
+    bool const spread = state.range(0) != 0;
+    size_t const hint =
+        spread ? static_cast<size_t>(state.thread_index()) *
+                     (Impl::capacity / static_cast<size_t>(state.threads()))
+               : 0;
+    std::vector<size_t> claimed;
+    claimed.reserve(concurrent::held);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < concurrent::held; i++) {
+            claimed.push_back(concurrent::claim<Impl>(&pool, hint, lock));
+        }
+        benchmark::DoNotOptimize(claimed.data());
+        for (size_t index : claimed) {
+            concurrent::release<Impl>(&pool, index, lock);
+        }
+        claimed.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(concurrent::held));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(concurrent_claim_release, Atomic64K)->Apply(concurrent::range);
+BENCHMARK_TEMPLATE(concurrent_claim_release, Static64K)->Apply(concurrent::range);
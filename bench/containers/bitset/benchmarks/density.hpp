@@ -0,0 +1,158 @@
+/// @file density.hpp
+/// @brief Iterating, searching and counting the set indices of a 64K bitset, at several densities
+///
+/// Checking Regressions For:
+/// - Iteration cost proportional to the set indices (and words), not to the capacity
+/// - `find_first_set`/`find_next_set` skipping unset words
+/// - Word level popcount for `size`
+///
+/// Representative:
+/// Representative of sparse membership sets (e.g. dirty pages, active ids) scanned periodically.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace density {
+// JUSTIFY: Densities in parts per thousand
+//  - From one set index per 16 words (very sparse), to half of all indices set.
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    for (int64_t const per_mille : {1, 10, 100, 500}) {
+        benchmark->Arg(per_mille);
+    }
+}
+
+template <BitsetCase Impl> typename Impl::Self build(size_t per_mille) {
+    U32XORShiftGen gen(SEED);
+    if constexpr (LABEL_CHECK(Impl, derive_c_static)) {
+        typename Impl::Self b = Impl::Self_new();
+        for (size_t i = 0; i < Impl::capacity; i++) {
+            if (gen.next() % 1000 < per_mille) {
+                Impl::Self_set(&b, static_cast<typename Impl::Self_index_t>(i), true);
+            }
+        }
+        return b;
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+        typename Impl::Self b = Impl::Self_new_with_end(Impl::capacity, stdalloc_get_ref());
+        for (size_t i = 0; i < Impl::capacity; i++) {
+            if (gen.next() % 1000 < per_mille) {
+                Impl::Self_set(&b, i, true);
+            }
+        }
+        return b;
+    } else if constexpr (LABEL_CHECK(Impl, stl_bitset)) {
+        typename Impl::Self b;
+        for (size_t i = 0; i < Impl::capacity; i++) {
+            if (gen.next() % 1000 < per_mille) {
+                b.set(i);
+            }
+        }
+        return b;
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+
+template <BitsetCase Impl> void destroy(typename Impl::Self* b) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_static) || LABEL_CHECK(Impl, derive_c_dynamic)) {
+        Impl::Self_delete(b);
+    }
+}
+} // namespace density
+
+template <BitsetCase Impl> void density_iterate(benchmark::State& state) {
+    typename Impl::Self b = density::build<Impl>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_static) || LABEL_CHECK(Impl, derive_c_dynamic)) {
+            typename Impl::Self_iter_const iter = Impl::Self_get_iter_const(&b);
+            while (!Impl::Self_iter_const_empty(&iter)) {
+                sum += Impl::Self_iter_const_next(&iter);
+            }
+        } else if constexpr (LABEL_CHECK(Impl, stl_bitset)) {
+            for (size_t i = 0; i < Impl::capacity; i++) {
+                if (b.test(i)) {
+                    sum += i;
+                }
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    density::destroy<Impl>(&b);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Impl::capacity));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <BitsetCase Impl> void density_find_next(benchmark::State& state) {
+    typename Impl::Self b = density::build<Impl>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_static)) {
+            for (size_t index = Impl::Self_find_first_set(&b);
+                 index != Impl::Self_exclusive_end_index;
+                 index = Impl::Self_find_next_set(&b, index + 1)) {
+                sum += index;
+            }
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            for (size_t index = Impl::Self_find_first_set(&b);
+                 index != Impl::Self_exclusive_end_index(&b);
+                 index = Impl::Self_find_next_set(&b, index + 1)) {
+                sum += index;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    density::destroy<Impl>(&b);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Impl::capacity));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <BitsetCase Impl> void density_size(benchmark::State& state) {
+    typename Impl::Self b = density::build<Impl>(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        size_t size;
+        if constexpr (LABEL_CHECK(Impl, derive_c_static) || LABEL_CHECK(Impl, derive_c_dynamic)) {
+            size = Impl::Self_size(&b);
+        } else if constexpr (LABEL_CHECK(Impl, stl_bitset)) {
+            size = b.count();
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(size);
+        benchmark::ClobberMemory();
+    }
+
+    density::destroy<Impl>(&b);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(Impl::capacity));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(density_iterate, Static64K)->Apply(density::range);
+BENCHMARK_TEMPLATE(density_iterate, Dynamic<65536>)->Apply(density::range);
+BENCHMARK_TEMPLATE(density_iterate, StdBitset<65536>)->Apply(density::range);
+BENCHMARK_TEMPLATE(density_find_next, Static64K)->Apply(density::range);
+BENCHMARK_TEMPLATE(density_find_next, Dynamic<65536>)->Apply(density::range);
+BENCHMARK_TEMPLATE(density_size, Static64K)->Apply(density::range);
+BENCHMARK_TEMPLATE(density_size, Dynamic<65536>)->Apply(density::range);
+BENCHMARK_TEMPLATE(density_size, StdBitset<65536>)->Apply(density::range);
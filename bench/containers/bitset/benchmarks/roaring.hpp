@@ -0,0 +1,258 @@
+/// @file roaring.hpp
+/// @brief Memory and set operations for sets of indices in a 16M universe, as a roaring bitmap,
+/// a flat bitset and a swiss set
+///
+/// Checking Regressions For:
+/// - `roaring` memory per index, from sparse (arrays) to dense (bitmaps) and clustered (runs)
+/// - `and`, `or` and `count_and` only combining the chunks present in both inputs
+/// - `get` with a binary search over chunks, then within an array or runs
+///
+/// Representative:
+/// Representative of posting lists and id sets, with densities varying by orders of magnitude.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace roaring {
+static constexpr size_t capacity = 1 << 24;
+
+// JUSTIFY: Clustered sets include runs of 1024 consecutive indices
+//  - So the roaring chunks are stored as runs, while the flat bitset and swiss set are unchanged.
+static constexpr size_t cluster = 1024;
+
+// JUSTIFY: Densities in parts per 100000, random or clustered
+//  - 0.01% (arrays with ~6 indices each), 1% (arrays with ~650), 50% (bitmaps), and 50%
+//    clustered (runs).
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"per_100k", "clustered"});
+    benchmark->Args({10, 0});
+    benchmark->Args({1000, 0});
+    benchmark->Args({50000, 0});
+    benchmark->Args({50000, 1});
+}
+
+// JUSTIFY: Only sparse sets for the swiss set
+//  - At 50% density the swiss set holds 8M indices, and each operation takes seconds.
+inline void sparse_range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"per_100k", "clustered"});
+    benchmark->Args({10, 0});
+    benchmark->Args({1000, 0});
+}
+
+inline std::vector<uint32_t> indices(benchmark::State const& state, uint32_t seed) {
+    U32XORShiftGen gen(SEED + seed);
+    size_t const per_100k = static_cast<size_t>(state.range(0));
+    bool const clustered = state.range(1) != 0;
+    size_t const step = clustered ? cluster : 1;
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i < capacity; i += step) {
+        if (gen.next() % 100000 < per_100k) {
+            for (size_t index = i; index < i + step; index++) {
+                result.push_back(static_cast<uint32_t>(index));
+            }
+        }
+    }
+    return result;
+}
+
+// JUSTIFY: Optimising roaring bitmaps to runs after building
+//  - Runs are only created by `run_optimize`, as for other roaring bitmap implementations.
+template <BitsetCase Impl> typename Impl::Self build(std::vector<uint32_t> const& indices) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_roaring)) {
+        typename Impl::Self b = Impl::Self_new(stdalloc_get_ref());
+        for (uint32_t index : indices) {
+            Impl::Self_set(&b, index, true);
+        }
+        Impl::Self_run_optimize(&b);
+        return b;
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+        typename Impl::Self b = Impl::Self_new_with_end(capacity, stdalloc_get_ref());
+        for (uint32_t index : indices) {
+            Impl::Self_set(&b, index, true);
+        }
+        return b;
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+        typename Impl::Self b = Impl::Self_new(stdalloc_get_ref());
+        for (uint32_t index : indices) {
+            Impl::Self_add(&b, index);
+        }
+        return b;
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+
+// JUSTIFY: Swiss set bytes as one slot and one control byte per bucket
+//  - Ignoring the trailing group of control bytes, which is constant.
+template <BitsetCase Impl> size_t bytes(typename Impl::Self const* b) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_roaring)) {
+        return Impl::Self_capacity_bytes(b);
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+        return b->words_capacity * sizeof(uint64_t);
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+        return b->map.capacity * (sizeof(uint32_t) + 1);
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+
+template <BitsetCase Impl>
+void finish(benchmark::State& state, typename Impl::Self* left, typename Impl::Self* right,
+            size_t items) {
+    state.counters["bytes_per_index"] =
+        static_cast<double>(bytes<Impl>(left)) / static_cast<double>(Impl::Self_size(left));
+    Impl::Self_delete(left);
+    Impl::Self_delete(right);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(items));
+    state.SetLabel(Impl::impl_name);
+}
+} // namespace roaring
+
+// JUSTIFY: The swiss set intersection is built in a new set
+//  - As the roaring intersection allocates its result, while the flat bitset writes to `out`.
+template <BitsetCase Impl> void roaring_and(benchmark::State& state) {
+    std::vector<uint32_t> const left_indices = roaring::indices(state, 0);
+    std::vector<uint32_t> const right_indices = roaring::indices(state, 1);
+    typename Impl::Self left = roaring::build<Impl>(left_indices);
+    typename Impl::Self right = roaring::build<Impl>(right_indices);
+
+    if constexpr (LABEL_CHECK(Impl, derive_c_roaring) || LABEL_CHECK(Impl, derive_c_dynamic)) {
+        typename Impl::Self out = Impl::Self_clone(&left);
+        for (auto _ : state) {
+            Impl::Self_and(&left, &right, &out);
+            benchmark::DoNotOptimize(&out);
+            benchmark::ClobberMemory();
+        }
+        Impl::Self_delete(&out);
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+        for (auto _ : state) {
+            typename Impl::Self out = Impl::Self_new(stdalloc_get_ref());
+            typename Impl::Self_iter_const iter = Impl::Self_get_iter_const(&left);
+            while (!Impl::Self_iter_const_empty(&iter)) {
+                uint32_t const index = *Impl::Self_iter_const_next(&iter);
+                if (Impl::Self_contains(&right, index)) {
+                    Impl::Self_add(&out, index);
+                }
+            }
+            benchmark::DoNotOptimize(&out);
+            Impl::Self_delete(&out);
+        }
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+
+    roaring::finish<Impl>(state, &left, &right, left_indices.size() + right_indices.size());
+}
+
+template <BitsetCase Impl> void roaring_or(benchmark::State& state) {
+    std::vector<uint32_t> const left_indices = roaring::indices(state, 0);
+    std::vector<uint32_t> const right_indices = roaring::indices(state, 1);
+    typename Impl::Self left = roaring::build<Impl>(left_indices);
+    typename Impl::Self right = roaring::build<Impl>(right_indices);
+
+    if constexpr (LABEL_CHECK(Impl, derive_c_roaring) || LABEL_CHECK(Impl, derive_c_dynamic)) {
+        typename Impl::Self out = Impl::Self_clone(&left);
+        for (auto _ : state) {
+            Impl::Self_or(&left, &right, &out);
+            benchmark::DoNotOptimize(&out);
+            benchmark::ClobberMemory();
+        }
+        Impl::Self_delete(&out);
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+        for (auto _ : state) {
+            typename Impl::Self out = Impl::Self_clone(&left);
+            typename Impl::Self_iter_const iter = Impl::Self_get_iter_const(&right);
+            while (!Impl::Self_iter_const_empty(&iter)) {
+                Impl::Self_try_add(&out, *Impl::Self_iter_const_next(&iter));
+            }
+            benchmark::DoNotOptimize(&out);
+            Impl::Self_delete(&out);
+        }
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+
+    roaring::finish<Impl>(state, &left, &right, left_indices.size() + right_indices.size());
+}
+
+template <BitsetCase Impl> void roaring_count_and(benchmark::State& state) {
+    std::vector<uint32_t> const left_indices = roaring::indices(state, 0);
+    std::vector<uint32_t> const right_indices = roaring::indices(state, 1);
+    typename Impl::Self left = roaring::build<Impl>(left_indices);
+    typename Impl::Self right = roaring::build<Impl>(right_indices);
+
+    for (auto _ : state) {
+        size_t count = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_roaring) ||
+                      LABEL_CHECK(Impl, derive_c_dynamic)) {
+            count = Impl::Self_count_and(&left, &right);
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+            typename Impl::Self_iter_const iter = Impl::Self_get_iter_const(&left);
+            while (!Impl::Self_iter_const_empty(&iter)) {
+                count += Impl::Self_contains(&right, *Impl::Self_iter_const_next(&iter)) ? 1 : 0;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+
+    roaring::finish<Impl>(state, &left, &right, left_indices.size() + right_indices.size());
+}
+
+// JUSTIFY: Probing uniformly random indices
+//  - Most probes miss at low densities, so this includes the cost of finding no chunk.
+template <BitsetCase Impl> void roaring_get(benchmark::State& state) {
+    std::vector<uint32_t> const left_indices = roaring::indices(state, 0);
+    typename Impl::Self left = roaring::build<Impl>(left_indices);
+    typename Impl::Self right = roaring::build<Impl>({});
+
+    std::vector<uint32_t> probes;
+    U32XORShiftGen gen(SEED + 2);
+    for (size_t i = 0; i < (1 << 16); i++) {
+        probes.push_back(gen.next() % roaring::capacity);
+    }
+
+    for (auto _ : state) {
+        size_t found = 0;
+        for (uint32_t probe : probes) {
+            if constexpr (LABEL_CHECK(Impl, derive_c_roaring) ||
+                          LABEL_CHECK(Impl, derive_c_dynamic)) {
+                found += Impl::Self_get(&left, probe) ? 1 : 0;
+            } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+                found += Impl::Self_contains(&left, probe) ? 1 : 0;
+            } else {
+                static_assert_unreachable<Impl>();
+            }
+        }
+        benchmark::DoNotOptimize(found);
+    }
+
+    roaring::finish<Impl>(state, &left, &right, probes.size());
+}
+
+#define BENCH(RANGE, ...)                                                                          \
+    BENCHMARK_TEMPLATE(roaring_and, __VA_ARGS__)->Apply(RANGE);                                    \
+    BENCHMARK_TEMPLATE(roaring_or, __VA_ARGS__)->Apply(RANGE);                                     \
+    BENCHMARK_TEMPLATE(roaring_count_and, __VA_ARGS__)->Apply(RANGE);                              \
+    BENCHMARK_TEMPLATE(roaring_get, __VA_ARGS__)->Apply(RANGE)
+
+BENCH(roaring::range, Roaring<roaring::capacity>);
+BENCH(roaring::range, Dynamic<roaring::capacity>);
+BENCH(roaring::sparse_range, SwissSet<roaring::capacity>);
+
+#undef BENCH
@@ -0,0 +1,84 @@
+/// @file set_range.hpp
+/// @brief Setting and clearing ranges of a runtime sized bitset
+///
+/// Checking Regressions For:
+/// - Word at a time `set_range`, including the partial first and last words
+/// - Versus per index `set` on the same bitset, and `std::fill` on a `std::vector<bool>`
+///
+/// Representative:
+/// Representative of per-query row masks, initialised from row ranges (e.g. sorted key ranges).
+
+#pragma once
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../instances.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+// JUSTIFY: Setting all indices, then clearing the middle half
+//  - Both ends of the cleared range are (for most sizes) partial words.
+template <BitsetCase Impl> void set_range_fill(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+        typename Impl::Self b = Impl::Self_new_with_end(n, stdalloc_get_ref());
+        for (auto _ : state) {
+            Impl::Self_set_range(&b, 0, n, true);
+            Impl::Self_set_range(&b, n / 4, n - (n / 4), false);
+            benchmark::DoNotOptimize(&b);
+            benchmark::ClobberMemory();
+        }
+        Impl::Self_delete(&b);
+    } else if constexpr (LABEL_CHECK(Impl, stl_vector_bool)) {
+        typename Impl::Self b(n);
+        for (auto _ : state) {
+            std::fill(b.begin(), b.end(), true);
+            std::fill(b.begin() + static_cast<std::ptrdiff_t>(n / 4),
+                      b.end() - static_cast<std::ptrdiff_t>(n / 4), false);
+            benchmark::DoNotOptimize(&b);
+            benchmark::ClobberMemory();
+        }
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <BitsetCase Impl> void set_range_per_index(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+        typename Impl::Self b = Impl::Self_new_with_end(n, stdalloc_get_ref());
+        for (auto _ : state) {
+            for (size_t i = 0; i < n; i++) {
+                Impl::Self_set(&b, i, true);
+            }
+            for (size_t i = n / 4; i < n - (n / 4); i++) {
+                Impl::Self_set(&b, i, false);
+            }
+            benchmark::DoNotOptimize(&b);
+            benchmark::ClobberMemory();
+        }
+        Impl::Self_delete(&b);
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(set_range_fill, Dynamic<0>)->Apply(range::exponential<65536>);
+BENCHMARK_TEMPLATE(set_range_fill, StdVectorBool<0>)->Apply(range::exponential<65536>);
+BENCHMARK_TEMPLATE(set_range_per_index, Dynamic<0>)->Apply(range::exponential<65536>);
@@ -0,0 +1,142 @@
+/// @file sparse.hpp
+/// @brief Searching, iterating and clearing a 16M bitset at 0.01% to 10% density, with and
+/// without summary levels
+///
+/// Checking Regressions For:
+/// - `find_next_set` and iteration skipping empty words with the summaries of `hierarchical`
+/// - `clear_all` touching only nonzero words, versus clearing every word of the flat bitset
+/// - The cost of maintaining the summaries on `set`
+///
+/// Representative:
+/// Representative of slot occupancy masks over large tables, with few occupied slots.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace sparse {
+static constexpr size_t capacity = 1 << 24;
+
+// JUSTIFY: Densities in parts per 100000
+//  - From 0.01% (one set index per ~150 words) to 10%.
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    for (int64_t const per_100k : {10, 100, 1000, 10000}) {
+        benchmark->Arg(per_100k);
+    }
+}
+
+inline std::vector<size_t> indices(size_t per_100k) {
+    U32XORShiftGen gen(SEED);
+    std::vector<size_t> result;
+    for (size_t i = 0; i < capacity; i++) {
+        if (gen.next() % 100000 < per_100k) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+template <BitsetCase Impl> typename Impl::Self build(std::vector<size_t> const& indices) {
+    typename Impl::Self b = Impl::Self_new_with_end(capacity, stdalloc_get_ref());
+    for (size_t index : indices) {
+        Impl::Self_set(&b, index, true);
+    }
+    return b;
+}
+} // namespace sparse
+
+template <BitsetCase Impl> void sparse_find_next(benchmark::State& state) {
+    std::vector<size_t> const indices = sparse::indices(static_cast<size_t>(state.range(0)));
+    typename Impl::Self b = sparse::build<Impl>(indices);
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic) ||
+                      LABEL_CHECK(Impl, derive_c_hierarchical)) {
+            for (size_t index = Impl::Self_find_first_set(&b);
+                 index != Impl::Self_exclusive_end_index(&b);
+                 index = Impl::Self_find_next_set(&b, index + 1)) {
+                sum += index;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    Impl::Self_delete(&b);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(indices.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <BitsetCase Impl> void sparse_iterate(benchmark::State& state) {
+    std::vector<size_t> const indices = sparse::indices(static_cast<size_t>(state.range(0)));
+    typename Impl::Self b = sparse::build<Impl>(indices);
+
+    for (auto _ : state) {
+        size_t sum = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic) ||
+                      LABEL_CHECK(Impl, derive_c_hierarchical)) {
+            typename Impl::Self_iter_const iter = Impl::Self_get_iter_const(&b);
+            while (!Impl::Self_iter_const_empty(&iter)) {
+                sum += Impl::Self_iter_const_next(&iter);
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    Impl::Self_delete(&b);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(indices.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+// JUSTIFY: Setting the indices, then clearing all
+//  - Each iteration starts from the same bitset, and includes the cost of the summaries on `set`.
+template <BitsetCase Impl> void sparse_set_clear_all(benchmark::State& state) {
+    std::vector<size_t> const indices = sparse::indices(static_cast<size_t>(state.range(0)));
+    typename Impl::Self b = Impl::Self_new_with_end(sparse::capacity, stdalloc_get_ref());
+
+    for (auto _ : state) {
+        for (size_t index : indices) {
+            Impl::Self_set(&b, index, true);
+        }
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            Impl::Self_set_range(&b, 0, sparse::capacity, false);
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_hierarchical)) {
+            Impl::Self_clear_all(&b);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(&b);
+        benchmark::ClobberMemory();
+    }
+
+    Impl::Self_delete(&b);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(indices.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(sparse_find_next, __VA_ARGS__)->Apply(sparse::range);                       \
+    BENCHMARK_TEMPLATE(sparse_iterate, __VA_ARGS__)->Apply(sparse::range);                         \
+    BENCHMARK_TEMPLATE(sparse_set_clear_all, __VA_ARGS__)->Apply(sparse::range)
+
+BENCH(Dynamic<sparse::capacity>);
+BENCH(Hierarchical<sparse::capacity>);
+
+#undef BENCH
@@ -0,0 +1,111 @@
+#pragma once
+#include <bitset>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <derive-cpp/meta/labels.hpp>
+
+#include <derive-c/algorithm/hash/id.h>
+#include <derive-c/container/bitset/atomic/includes.h>
+#include <derive-c/container/bitset/dynamic/includes.h>
+#include <derive-c/container/bitset/hierarchical/includes.h>
+#include <derive-c/container/bitset/roaring/includes.h>
+#include <derive-c/container/bitset/static/includes.h>
+#include <derive-c/container/set/sparse/includes.h>
+#include <derive-c/container/set/swiss/includes.h>
+
+template <typename T>
+concept BitsetCase = requires {
+    typename T::Self;
+    { T::impl_name } -> std::convertible_to<const char*>;
+    { T::capacity } -> std::convertible_to<size_t>;
+};
+
+// JUSTIFY: Not a template on the capacity
+//  - `EXCLUSIVE_END_INDEX` is used in preprocessor conditions, so must be a literal.
+struct Static64K {
+    LABEL_ADD(derive_c_static);
+    static constexpr const char* impl_name = "derive-c/static";
+    static constexpr size_t capacity = 65536;
+#define EXPAND_IN_STRUCT
+#define EXCLUSIVE_END_INDEX 65536
+#define NAME Self
+#include <derive-c/container/bitset/static/template.h>
+};
+
+struct Atomic64K {
+    LABEL_ADD(derive_c_atomic);
+    static constexpr const char* impl_name = "derive-c/atomic";
+    static constexpr size_t capacity = 65536;
+#define EXPAND_IN_STRUCT
+#define EXCLUSIVE_END_INDEX 65536
+#define NAME Self
+#include <derive-c/container/bitset/atomic/template.h>
+};
+
+template <size_t Capacity> struct StdBitset {
+    LABEL_ADD(stl_bitset);
+    static constexpr const char* impl_name = "std/bitset";
+    static constexpr size_t capacity = Capacity;
+    using Self = std::bitset<Capacity>;
+};
+
+template <size_t Capacity> struct Dynamic {
+    LABEL_ADD(derive_c_dynamic);
+    static constexpr const char* impl_name = "derive-c/dynamic";
+    static constexpr size_t capacity = Capacity;
+#define EXPAND_IN_STRUCT
+#define NAME Self
+#include <derive-c/container/bitset/dynamic/template.h>
+};
+
+template <size_t Capacity> struct Hierarchical {
+    LABEL_ADD(derive_c_hierarchical);
+    static constexpr const char* impl_name = "derive-c/hierarchical";
+    static constexpr size_t capacity = Capacity;
+#define EXPAND_IN_STRUCT
+#define NAME Self
+#include <derive-c/container/bitset/hierarchical/template.h>
+};
+
+template <size_t Capacity> struct Roaring {
+    LABEL_ADD(derive_c_roaring);
+    static constexpr const char* impl_name = "derive-c/roaring";
+    static constexpr size_t capacity = Capacity;
+#define EXPAND_IN_STRUCT
+#define NAME Self
+#include <derive-c/container/bitset/roaring/template.h>
+};
+
+// JUSTIFY: A swiss set of indices
+//  - The alternative to a bitset for sparse sets of ids, compared on memory and set operations.
+template <size_t Capacity> struct SwissSet {
+    LABEL_ADD(derive_c_swiss);
+    static constexpr const char* impl_name = "derive-c/swiss";
+    static constexpr size_t capacity = Capacity;
+#define EXPAND_IN_STRUCT
+#define ITEM uint32_t
+#define ITEM_HASH uint32_t_hash_id
+#define NAME Self
+#include <derive-c/container/set/swiss/template.h>
+};
+
+// JUSTIFY: A sparse set of indices
+//  - The alternative to a bitset for sets of ids cleared often, as clearing is O(1).
+template <size_t Capacity> struct SparseSet {
+    LABEL_ADD(derive_c_sparse);
+    static constexpr const char* impl_name = "derive-c/sparse";
+    static constexpr size_t capacity = Capacity;
+#define EXPAND_IN_STRUCT
+#define INDEX_BITS 32
+#define NAME Self
+#include <derive-c/container/set/sparse/template.h>
+};
+
+template <size_t Capacity> struct StdVectorBool {
+    LABEL_ADD(stl_vector_bool);
+    static constexpr const char* impl_name = "std/vector<bool>";
+    static constexpr size_t capacity = Capacity;
+    using Self = std::vector<bool>;
+};
@@ -0,0 +1,6 @@
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/remove.hpp"
+#include "benchmarks/throughput.hpp"
+
+BENCHMARK_MAIN();
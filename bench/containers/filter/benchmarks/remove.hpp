@@ -0,0 +1,50 @@
+/// @file remove.hpp
+/// @brief Removing every item from a full cuckoo filter
+///
+/// Checking Regressions For:
+/// - `remove` on the cuckoo filter, for each fingerprint width, as the filter empties from a load
+///   factor of at most 95%
+///
+/// Representative:
+/// Representative of evicting entries from a cache whose admission is tracked by the filter.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "throughput.hpp"
+
+#include <derive-c/prelude.h>
+
+template <FilterCase Impl> void filter_remove(benchmark::State& state) {
+    size_t const count = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> const items = throughput::items(count, 0);
+    typename Impl::Self full = throughput::build<Impl>(items);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        typename Impl::Self filter = Impl::Self_clone(&full);
+        state.ResumeTiming();
+
+        for (uint64_t item : items) {
+            bool const removed = Impl::Self_remove(&filter, item);
+            benchmark::DoNotOptimize(removed);
+        }
+
+        state.PauseTiming();
+        Impl::Self_delete(&filter);
+        state.ResumeTiming();
+    }
+
+    Impl::Self_delete(&full);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(filter_remove, Cuckoo8)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_remove, Cuckoo12)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_remove, Cuckoo16)->Apply(throughput::cuckoo_range);
@@ -0,0 +1,190 @@
+/// @file throughput.hpp
+/// @brief Adding to and querying filters, one item at a time and in bulk
+///
+/// Checking Regressions For:
+/// - `add` and `contains` on the bloom filter, a single cache line access each
+/// - `add_many` and `contains_many`, prefetching the blocks of a batch of items
+/// - `try_add` and `contains` on the cuckoo filter, for each fingerprint width, at a load factor of
+///   at most 95%
+/// - Versus `contains` on a swiss set of the same items, the check the filter avoids
+///
+/// Representative:
+/// Representative of a negative check in front of a larger lookup, with most queries absent.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace throughput {
+static constexpr double false_positive_rate = 0.01;
+static constexpr size_t queries = 1 << 16;
+
+// JUSTIFY: From a filter in cache, to one of 10MB (for 2^23 items)
+//  - Where the cache misses dominate, and the bulk operations' prefetching matters.
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"items", "bulk"});
+    for (int64_t items : {1 << 16, 1 << 20, 1 << 23}) {
+        benchmark->Args({items, 0});
+        benchmark->Args({items, 1});
+    }
+}
+
+// JUSTIFY: No bulk operations for the cuckoo filter
+//  - Each add may kick fingerprints through several buckets, so cannot be prefetched ahead.
+inline void cuckoo_range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"items", "bulk"});
+    for (int64_t items : {1 << 16, 1 << 20, 1 << 23}) {
+        benchmark->Args({items, 0});
+    }
+}
+
+// JUSTIFY: At most 2^20 items for the swiss set
+//  - As building larger sets dominates the benchmark's run time.
+inline void swiss_range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"items", "bulk"});
+    benchmark->Args({1 << 16, 0});
+    benchmark->Args({1 << 20, 0});
+}
+
+inline std::vector<uint64_t> items(size_t count, uint32_t seed) {
+    U32XORShiftGen gen(SEED + seed);
+    std::vector<uint64_t> result(count);
+    for (uint64_t& item : result) {
+        item = (static_cast<uint64_t>(gen.next()) << 32) | gen.next();
+    }
+    return result;
+}
+
+template <FilterCase Impl> typename Impl::Self empty(size_t items) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_bloom)) {
+        return Impl::Self_new_for(items, false_positive_rate, stdalloc_get_ref());
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_cuckoo)) {
+        return Impl::Self_new_for(items, stdalloc_get_ref());
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+
+template <FilterCase Impl> typename Impl::Self build(std::vector<uint64_t> const& items) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_bloom)) {
+        typename Impl::Self filter = empty<Impl>(items.size());
+        Impl::Self_add_many(&filter, items.data(), items.size());
+        return filter;
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_cuckoo)) {
+        typename Impl::Self filter = empty<Impl>(items.size());
+        for (uint64_t item : items) {
+            Impl::Self_add(&filter, item);
+        }
+        return filter;
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_swiss)) {
+        typename Impl::Self set =
+            Impl::Self_new_with_capacity_for(items.size(), stdalloc_get_ref());
+        for (uint64_t item : items) {
+            Impl::Self_add(&set, item);
+        }
+        return set;
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+} // namespace throughput
+
+template <FilterCase Impl> void filter_add(benchmark::State& state) {
+    size_t const count = static_cast<size_t>(state.range(0));
+    bool const bulk = state.range(1) != 0;
+    std::vector<uint64_t> const items = throughput::items(count, 0);
+
+    for (auto _ : state) {
+        typename Impl::Self filter = throughput::empty<Impl>(count);
+        if constexpr (LABEL_CHECK(Impl, derive_c_bloom)) {
+            if (bulk) {
+                Impl::Self_add_many(&filter, items.data(), items.size());
+            } else {
+                for (uint64_t item : items) {
+                    Impl::Self_add(&filter, item);
+                }
+            }
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_cuckoo)) {
+            for (uint64_t item : items) {
+                bool const added = Impl::Self_try_add(&filter, item);
+                benchmark::DoNotOptimize(added);
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(&filter);
+        Impl::Self_delete(&filter);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetLabel(Impl::impl_name);
+}
+
+// JUSTIFY: 1 in 8 queries present
+//  - So most queries are absent, as for a filter placed in front of a lookup that usually misses.
+template <FilterCase Impl> void filter_contains(benchmark::State& state) {
+    size_t const count = static_cast<size_t>(state.range(0));
+    bool const bulk = state.range(1) != 0;
+    std::vector<uint64_t> const items = throughput::items(count, 0);
+    std::vector<uint64_t> queries = throughput::items(throughput::queries, 1);
+    for (size_t i = 0; i < queries.size(); i += 8) {
+        queries[i] = items[(i * 7919) % items.size()];
+    }
+    typename Impl::Self filter = throughput::build<Impl>(items);
+    std::unique_ptr<bool[]> found = std::make_unique<bool[]>(queries.size());
+
+    size_t positives = 0;
+    for (auto _ : state) {
+        positives = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_bloom)) {
+            if (bulk) {
+                positives = Impl::Self_contains_many(&filter, queries.data(), queries.size(),
+                                                     found.get());
+            } else {
+                for (uint64_t query : queries) {
+                    positives += Impl::Self_contains(&filter, query) ? 1 : 0;
+                }
+            }
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_cuckoo) ||
+                             LABEL_CHECK(Impl, derive_c_swiss)) {
+            for (uint64_t query : queries) {
+                positives += Impl::Self_contains(&filter, query) ? 1 : 0;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(positives);
+        benchmark::DoNotOptimize(found.get());
+    }
+
+    size_t const present = (queries.size() + 7) / 8;
+    state.counters["false_positive_rate"] = static_cast<double>(positives - present) /
+                                            static_cast<double>(queries.size() - present);
+    Impl::Self_delete(&filter);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(filter_add, Bloom)->Apply(throughput::range);
+BENCHMARK_TEMPLATE(filter_contains, Bloom)->Apply(throughput::range);
+BENCHMARK_TEMPLATE(filter_add, Cuckoo8)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_add, Cuckoo12)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_add, Cuckoo16)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_contains, Cuckoo8)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_contains, Cuckoo12)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_contains, Cuckoo16)->Apply(throughput::cuckoo_range);
+BENCHMARK_TEMPLATE(filter_contains, SwissSet)->Apply(throughput::swiss_range);
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <derive-cpp/meta/labels.hpp>
+
+#include <derive-c/algorithm/hash/id.h>
+#include <derive-c/container/filter/bloom/includes.h>
+#include <derive-c/container/filter/cuckoo/includes.h>
+#include <derive-c/container/set/swiss/includes.h>
+
+template <typename T>
+concept FilterCase = requires {
+    typename T::Self;
+    { T::impl_name } -> std::convertible_to<const char*>;
+};
+
+struct Bloom {
+    LABEL_ADD(derive_c_bloom);
+    static constexpr const char* impl_name = "derive-c/bloom";
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define NAME Self
+#include <derive-c/container/filter/bloom/template.h>
+};
+
+struct Cuckoo8 {
+    LABEL_ADD(derive_c_cuckoo);
+    static constexpr const char* impl_name = "derive-c/cuckoo/8";
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define FINGERPRINT_BITS 8
+#define NAME Self
+#include <derive-c/container/filter/cuckoo/template.h>
+};
+
+struct Cuckoo12 {
+    LABEL_ADD(derive_c_cuckoo);
+    static constexpr const char* impl_name = "derive-c/cuckoo/12";
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define FINGERPRINT_BITS 12
+#define NAME Self
+#include <derive-c/container/filter/cuckoo/template.h>
+};
+
+struct Cuckoo16 {
+    LABEL_ADD(derive_c_cuckoo);
+    static constexpr const char* impl_name = "derive-c/cuckoo/16";
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define FINGERPRINT_BITS 16
+#define NAME Self
+#include <derive-c/container/filter/cuckoo/template.h>
+};
+
+// JUSTIFY: A swiss set of the same items
+//  - The exact check the filter is placed in front of, for comparing the cost of a query.
+struct SwissSet {
+    LABEL_ADD(derive_c_swiss);
+    static constexpr const char* impl_name = "derive-c/swiss";
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define NAME Self
+#include <derive-c/container/set/swiss/template.h>
+};
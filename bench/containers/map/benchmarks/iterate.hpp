@@ -5,7 +5,7 @@
 /// - Key-value pair iteration performance
 /// - Iterator correctness with sequential keys (worst-case collisions)
 /// - Decomposed storage vs paired storage layouts
-/// - StaticLinear iteration up to capacity vs size
+/// - StaticLinear and StaticSwiss iteration up to capacity vs size
 /// - Limited key space behavior (uint8_t wraparound)
 ///
 /// Representative:
@@ -159,7 +159,8 @@ template <MapCase Impl> void iterate(benchmark::State& state) {
                           LABEL_CHECK(Impl, derive_c_ankerl_small) ||
                           LABEL_CHECK(Impl, derive_c_decomposed)) {
                 iterate_case_derive_c<Impl>(state, max_n, gen);
-            } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear)) {
+            } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear) ||
+                                 LABEL_CHECK(Impl, derive_c_staticswiss)) {
                 iterate_case_derive_c_staticlinear<Impl>(state, max_n, gen);
             } else if constexpr (LABEL_CHECK(Impl, stl_unordered_map)) {
                 iterate_case_stl_unordered_map<Impl>(state, max_n, gen);
@@ -182,7 +183,8 @@ template <MapCase Impl> void iterate(benchmark::State& state) {
                           LABEL_CHECK(Impl, derive_c_ankerl_small) ||
                           LABEL_CHECK(Impl, derive_c_decomposed)) {
                 iterate_case_derive_c<Impl>(state, max_n, gen);
-            } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear)) {
+            } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear) ||
+                                 LABEL_CHECK(Impl, derive_c_staticswiss)) {
                 iterate_case_derive_c_staticlinear<Impl>(state, max_n, gen);
             } else if constexpr (LABEL_CHECK(Impl, stl_unordered_map)) {
                 iterate_case_stl_unordered_map<Impl>(state, max_n, gen);
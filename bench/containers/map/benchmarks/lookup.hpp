@@ -5,7 +5,7 @@
 /// - Lookup performance after insertion
 /// - Hash table lookup efficiency
 /// - Decomposed vs paired storage lookup overhead
-/// - StaticLinear lookup performance
+/// - StaticLinear and StaticSwiss (inline storage) lookup performance
 /// - Lookup performance with different key/value sizes
 ///
 /// Representative:
@@ -219,7 +219,8 @@ template <MapCase Impl> void lookup(benchmark::State& state) {
                       LABEL_CHECK(Impl, derive_c_ankerl_small) ||
                       LABEL_CHECK(Impl, derive_c_decomposed)) {
             lookup_case_derive_c<Impl>(state, max_n, gen);
-        } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear)) {
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear) ||
+                             LABEL_CHECK(Impl, derive_c_staticswiss)) {
             lookup_case_derive_c_staticlinear<Impl>(state, max_n, gen);
         } else if constexpr (LABEL_CHECK(Impl, stl_unordered_map)) {
             lookup_case_stl_unordered_map<Impl>(state, max_n, gen);
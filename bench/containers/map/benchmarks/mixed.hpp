@@ -7,6 +7,7 @@
 /// - Deletion and re-insertion patterns
 /// - Lookup performance for present vs missing keys
 /// - Steady-state behavior with weighted operation ratios
+/// - In place tombstone cleanup of StaticSwiss
 ///
 /// Representative:
 /// Not production representative. Weighted action distribution creates
@@ -485,7 +486,8 @@ template <MapCase Impl> void mixed(benchmark::State& state) {
                       LABEL_CHECK(Impl, derive_c_ankerl_small) ||
                       LABEL_CHECK(Impl, derive_c_decomposed)) {
             mixed_case_derive_c<Impl>(state, max_n, key_gen, action_gen);
-        } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear)) {
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_staticlinear) ||
+                             LABEL_CHECK(Impl, derive_c_staticswiss)) {
             mixed_case_derive_c_staticlinear<Impl>(state, max_n, key_gen, action_gen);
         } else if constexpr (LABEL_CHECK(Impl, stl_unordered_map)) {
             mixed_case_stl_unordered_map<Impl>(state, max_n, key_gen, action_gen);
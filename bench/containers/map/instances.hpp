@@ -10,6 +10,7 @@
 #include <derive-c/container/map/ankerl/includes.h>
 #include <derive-c/container/map/decomposed/includes.h>
 #include <derive-c/container/map/staticlinear/includes.h>
+#include <derive-c/container/map/staticswiss/includes.h>
 
 #include <ankerl/unordered_dense.h>
 #include <absl/container/flat_hash_map.h>
@@ -80,6 +81,18 @@ template <typename Key, typename Value, size_t (*)(Key const*)> struct StaticLin
 #include <derive-c/container/map/staticlinear/template.h>
 };
 
+template <typename Key, typename Value, size_t (*key_hash)(Key const*)> struct StaticSwiss {
+    LABEL_ADD(derive_c_staticswiss);
+    static constexpr const char* impl_name = "derive-c/staticswiss";
+#define EXPAND_IN_STRUCT
+#define KEY Key
+#define KEY_HASH key_hash
+#define VALUE Value
+#define CAPACITY 1024
+#define NAME Self
+#include <derive-c/container/map/staticswiss/template.h>
+};
+
 template <typename Key, typename Value, size_t (*key_hash)(Key const*)> struct StdUnorderedMap {
     LABEL_ADD(stl_unordered_map);
     static constexpr const char* impl_name = "std/unordered_map";
@@ -165,4 +178,5 @@ template <typename Key, typename Value, size_t (*key_hash)(Key const*)> struct B
     CASE(AbseilSwiss);                                                                             \
     CASE(BoostFlat);                                                                               \
     CASE(StaticLinear);                                                                            \
+    CASE(StaticSwiss);                                                                             \
     CASE(StdMap)
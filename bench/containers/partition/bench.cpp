@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/unite.hpp"
+
+BENCHMARK_MAIN();
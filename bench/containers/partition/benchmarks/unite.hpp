@@ -0,0 +1,147 @@
+/// @file unite.hpp
+/// @brief Uniting sets of a union-find, from random and adversarial sequences of pairs
+///
+/// Checking Regressions For:
+/// - `unite` and `union_pairs` (prefetching a batch of pairs) on random pairs
+/// - Adversarial pairs, uniting sets of equal rank so trees reach the maximum depth, then finding
+///   random indices
+/// - `find_all` over the forest left by random pairs
+/// - With 32 and 64 bit indices, for the memory per index
+///
+/// Representative:
+/// Representative of clustering a graph's nodes by its edges.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+namespace unite {
+// JUSTIFY: From a forest in cache, to one of 2^23 indices (32MB of 32 bit parents)
+//  - Where every step of a find is a cache miss, and prefetching matters.
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"size", "bulk"});
+    for (int64_t size : {1 << 16, 1 << 20, 1 << 23}) {
+        benchmark->Args({size, 0});
+        benchmark->Args({size, 1});
+    }
+}
+
+inline void size_range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"size"});
+    for (int64_t size : {1 << 16, 1 << 20, 1 << 23}) {
+        benchmark->Args({size});
+    }
+}
+
+/// As many random pairs as indices, which leaves most indices in one set.
+template <PartitionCase Impl> std::vector<typename Impl::Self_pair> random_pairs(size_t size) {
+    U32XORShiftGen gen(SEED);
+    std::vector<typename Impl::Self_pair> pairs(size);
+    for (typename Impl::Self_pair& pair : pairs) {
+        pair.left = gen.next() % size;
+        pair.right = gen.next() % size;
+    }
+    return pairs;
+}
+
+/// Pairs uniting sets of equal rank, with the pairs of each round scattered across the indices.
+template <PartitionCase Impl> std::vector<typename Impl::Self_pair> adversarial_pairs(size_t size) {
+    using index_t = typename Impl::Self_index_t;
+    std::vector<typename Impl::Self_pair> pairs;
+    for (size_t stride = 1; stride < size; stride *= 2) {
+        for (size_t index = 0; index + stride < size; index += 2 * stride) {
+            pairs.push_back({.left = static_cast<index_t>(index + stride),
+                             .right = static_cast<index_t>(index)});
+        }
+    }
+    return pairs;
+}
+
+template <PartitionCase Impl>
+void unite_all(typename Impl::Self* union_find,
+               std::vector<typename Impl::Self_pair> const& pairs, bool bulk) {
+    if (bulk) {
+        Impl::Self_union_pairs(union_find, pairs.data(), pairs.size());
+    } else {
+        for (typename Impl::Self_pair const& pair : pairs) {
+            Impl::Self_unite(union_find, pair.left, pair.right);
+        }
+    }
+}
+} // namespace unite
+
+template <PartitionCase Impl> void union_find_random(benchmark::State& state) {
+    size_t const size = static_cast<size_t>(state.range(0));
+    bool const bulk = state.range(1) != 0;
+    auto const pairs = unite::random_pairs<Impl>(size);
+
+    for (auto _ : state) {
+        typename Impl::Self union_find = Impl::Self_new(size, stdalloc_get_ref());
+        unite::unite_all<Impl>(&union_find, pairs, bulk);
+        benchmark::DoNotOptimize(Impl::Self_sets(&union_find));
+        Impl::Self_delete(&union_find);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(pairs.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <PartitionCase Impl> void union_find_adversarial(benchmark::State& state) {
+    size_t const size = static_cast<size_t>(state.range(0));
+    bool const bulk = state.range(1) != 0;
+    auto const pairs = unite::adversarial_pairs<Impl>(size);
+    auto const queries = unite::random_pairs<Impl>(size);
+
+    for (auto _ : state) {
+        typename Impl::Self union_find = Impl::Self_new(size, stdalloc_get_ref());
+        unite::unite_all<Impl>(&union_find, pairs, bulk);
+        for (typename Impl::Self_pair const& query : queries) {
+            benchmark::DoNotOptimize(Impl::Self_find(&union_find, query.left));
+        }
+        Impl::Self_delete(&union_find);
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(pairs.size() + queries.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <PartitionCase Impl> void union_find_find_all(benchmark::State& state) {
+    size_t const size = static_cast<size_t>(state.range(0));
+    auto const pairs = unite::random_pairs<Impl>(size);
+    auto roots = std::make_unique<typename Impl::Self_index_t[]>(size);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        typename Impl::Self union_find = Impl::Self_new(size, stdalloc_get_ref());
+        Impl::Self_union_pairs(&union_find, pairs.data(), pairs.size());
+        state.ResumeTiming();
+
+        Impl::Self_find_all(&union_find, roots.get());
+        benchmark::DoNotOptimize(roots.get());
+
+        state.PauseTiming();
+        Impl::Self_delete(&union_find);
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(union_find_random, UnionFind32)->Apply(unite::range);
+BENCHMARK_TEMPLATE(union_find_random, UnionFind64)->Apply(unite::range);
+BENCHMARK_TEMPLATE(union_find_adversarial, UnionFind32)->Apply(unite::range);
+BENCHMARK_TEMPLATE(union_find_find_all, UnionFind32)->Apply(unite::size_range);
+BENCHMARK_TEMPLATE(union_find_find_all, UnionFind64)->Apply(unite::size_range);
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <derive-cpp/meta/labels.hpp>
+
+#include <derive-c/container/partition/union_find/includes.h>
+
+template <typename T>
+concept PartitionCase = requires {
+    typename T::Self;
+    typename T::Self_pair;
+    { T::impl_name } -> std::convertible_to<const char*>;
+};
+
+struct UnionFind32 {
+    static constexpr const char* impl_name = "derive-c/union_find/32";
+#define EXPAND_IN_STRUCT
+#define INDEX_BITS 32
+#define NAME Self
+#include <derive-c/container/partition/union_find/template.h>
+};
+
+struct UnionFind64 {
+    static constexpr const char* impl_name = "derive-c/union_find/64";
+#define EXPAND_IN_STRUCT
+#define INDEX_BITS 64
+#define NAME Self
+#include <derive-c/container/partition/union_find/template.h>
+};
@@ -6,5 +6,7 @@
 #include "benchmarks/access_ends.hpp"
 #include "benchmarks/fifo_streaming.hpp"
 #include "benchmarks/pathological_rebalance.hpp"
+#include "benchmarks/heap.hpp"
+#include "benchmarks/timing_wheel.hpp"
 
 BENCHMARK_MAIN();
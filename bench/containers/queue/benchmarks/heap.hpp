@@ -0,0 +1,168 @@
+/// @file heap.hpp
+/// @brief Priority queue push/pop and decrease-key throughput
+///
+/// Checking Regressions For:
+/// - Sift-up and sift-down cost for binary, 4-ary and 8-ary heaps
+/// - Overhead of maintaining handle positions in indexed heaps
+/// - Decrease-key versus the lazy re-insertion needed with std::priority_queue
+///
+/// Representative:
+/// Moderately representative. Random keys pushed then drained resemble batch
+/// scheduling, and the decrease-key loop resembles the relaxation step of
+/// Dijkstra's algorithm.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+template <QueueCase NS> void heap_push_pop_case_derive_c_heap(size_t max_n) {
+    U32XORShiftGen gen(SEED);
+    typename NS::Self heap = NS::Self_new(stdalloc_get_ref());
+
+    for (size_t i = 0; i < max_n; i++) {
+        NS::Self_push(&heap, gen.next());
+    }
+
+    while (!NS::Self_empty(&heap)) {
+        typename NS::Self_item_t item = NS::Self_pop(&heap);
+        benchmark::DoNotOptimize(item);
+    }
+
+    NS::Self_delete(&heap);
+}
+
+template <QueueCase Impl> void heap_push_pop_case_stl_priority_queue(size_t max_n) {
+    U32XORShiftGen gen(SEED);
+    typename Impl::Self heap;
+
+    for (size_t i = 0; i < max_n; i++) {
+        heap.push(gen.next());
+    }
+
+    while (!heap.empty()) {
+        typename Impl::Self_item_t item = heap.top();
+        heap.pop();
+        benchmark::DoNotOptimize(item);
+    }
+}
+
+template <QueueCase Impl> void heap_push_pop(benchmark::State& state) {
+    const std::size_t max_n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_heap) || LABEL_CHECK(Impl, derive_c_indexed_heap)) {
+            heap_push_pop_case_derive_c_heap<Impl>(max_n);
+        } else if constexpr (LABEL_CHECK(Impl, stl_priority_queue)) {
+            heap_push_pop_case_stl_priority_queue<Impl>(max_n);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(max_n) * 2);
+    state.SetLabel(Impl::impl_name);
+}
+
+template <QueueCase NS> void heap_decrease_key_case_derive_c_indexed_heap(size_t max_n) {
+    U32XORShiftGen gen(SEED);
+    typename NS::Self heap = NS::Self_new(stdalloc_get_ref());
+    std::vector<typename NS::Self_handle_t> handles;
+    handles.reserve(max_n);
+
+    for (size_t i = 0; i < max_n; i++) {
+        handles.push_back(NS::Self_push(&heap, gen.next()));
+    }
+
+    for (auto const& handle : handles) {
+        typename NS::Self_item_t const current = *NS::Self_read(&heap, handle);
+        NS::Self_decrease_key(&heap, handle, current / 2);
+    }
+
+    while (!NS::Self_empty(&heap)) {
+        typename NS::Self_item_t item = NS::Self_pop(&heap);
+        benchmark::DoNotOptimize(item);
+    }
+
+    NS::Self_delete(&heap);
+}
+
+/// Without decrease-key, the std::priority_queue must push the reduced key, and skip stale
+/// entries on pop.
+template <QueueCase Impl> void heap_decrease_key_case_stl_priority_queue(size_t max_n) {
+    U32XORShiftGen gen(SEED);
+    std::priority_queue<std::pair<uint32_t, size_t>, std::vector<std::pair<uint32_t, size_t>>,
+                        std::greater<>>
+        heap;
+    std::vector<uint32_t> current(max_n);
+
+    for (size_t i = 0; i < max_n; i++) {
+        current[i] = gen.next();
+        heap.emplace(current[i], i);
+    }
+
+    for (size_t i = 0; i < max_n; i++) {
+        current[i] /= 2;
+        heap.emplace(current[i], i);
+    }
+
+    while (!heap.empty()) {
+        auto const [key, index] = heap.top();
+        heap.pop();
+        if (key == current[index]) {
+            current[index] = UINT32_MAX;
+            benchmark::DoNotOptimize(key);
+        }
+    }
+}
+
+template <QueueCase Impl> void heap_decrease_key(benchmark::State& state) {
+    const std::size_t max_n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_indexed_heap)) {
+            heap_decrease_key_case_derive_c_indexed_heap<Impl>(max_n);
+        } else if constexpr (LABEL_CHECK(Impl, stl_priority_queue)) {
+            heap_decrease_key_case_stl_priority_queue<Impl>(max_n);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(max_n) * 3);
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(heap_push_pop, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(Heap<std::uint32_t, 2>);
+BENCH(Heap<std::uint32_t, 4>);
+BENCH(Heap<std::uint32_t, 8>);
+BENCH(IndexedHeap<std::uint32_t, 4>);
+BENCH(StdPriorityQueue<std::uint32_t>);
+
+#undef BENCH
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(heap_decrease_key, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(IndexedHeap<std::uint32_t, 2>);
+BENCH(IndexedHeap<std::uint32_t, 4>);
+BENCH(IndexedHeap<std::uint32_t, 8>);
+BENCH(StdPriorityQueue<std::uint32_t>);
+
+#undef BENCH
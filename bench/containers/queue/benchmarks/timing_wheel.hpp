@@ -0,0 +1,151 @@
+/// @file timing_wheel.hpp
+/// @brief Timer schedule, cancel and expiry throughput
+///
+/// Checking Regressions For:
+/// - O(1) scheduling and cancellation in the timing wheel
+/// - Cascading timers between wheel levels, and batched expiry per tick
+/// - Versus an indexed heap, and a std::multimap keyed by expiry
+///
+/// Representative:
+/// Highly representative of connection timeouts. A window of in-flight requests each holds a
+/// timeout, most of which are cancelled when the request completes before expiring.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace timers {
+static constexpr size_t operations = size_t{1} << 21;
+static constexpr size_t ops_per_tick = 16;
+static constexpr uint32_t max_delay = 2048;
+} // namespace timers
+
+template <QueueCase NS> void timers_case_derive_c_timing_wheel(size_t window) {
+    U32XORShiftGen gen(SEED);
+    typename NS::Self wheel = NS::Self_new(stdalloc_get_ref());
+    std::vector<typename NS::Self_handle_t> handles(window);
+    std::vector<bool> live(window, false);
+
+    for (size_t op = 0; op < timers::operations; op++) {
+        size_t const slot = op % window;
+        if (live[slot]) {
+            uint32_t cancelled;
+            NS::Self_try_cancel(&wheel, handles[slot], &cancelled);
+        }
+        handles[slot] = NS::Self_schedule(&wheel, 1 + (gen.next() % timers::max_delay),
+                                          static_cast<uint32_t>(slot));
+        live[slot] = true;
+
+        if (op % timers::ops_per_tick == 0) {
+            NS::Self_advance(&wheel, 1);
+            uint32_t expired;
+            while (NS::Self_try_pop_expired(&wheel, &expired)) {
+                live[expired] = false;
+                benchmark::DoNotOptimize(expired);
+            }
+        }
+    }
+
+    NS::Self_delete(&wheel);
+}
+
+/// Keys are the expiry in the upper bits, and the window slot in the lower.
+template <QueueCase NS> void timers_case_derive_c_indexed_heap(size_t window) {
+    U32XORShiftGen gen(SEED);
+    typename NS::Self heap = NS::Self_new(stdalloc_get_ref());
+    std::vector<typename NS::Self_handle_t> handles(window);
+    std::vector<bool> live(window, false);
+    uint64_t now = 0;
+
+    for (size_t op = 0; op < timers::operations; op++) {
+        size_t const slot = op % window;
+        if (live[slot]) {
+            NS::Self_remove(&heap, handles[slot]);
+        }
+        uint64_t const expiry = now + 1 + (gen.next() % timers::max_delay);
+        handles[slot] = NS::Self_push(&heap, (expiry << 32) | slot);
+        live[slot] = true;
+
+        if (op % timers::ops_per_tick == 0) {
+            now++;
+            while (!NS::Self_empty(&heap) && (*NS::Self_peek(&heap) >> 32) <= now) {
+                uint64_t const expired = NS::Self_pop(&heap);
+                live[expired & UINT32_MAX] = false;
+                benchmark::DoNotOptimize(expired);
+            }
+        }
+    }
+
+    NS::Self_delete(&heap);
+}
+
+template <QueueCase Impl> void timers_case_stl_multimap_timers(size_t window) {
+    U32XORShiftGen gen(SEED);
+    typename Impl::Self by_expiry;
+    std::vector<typename Impl::Self::iterator> handles(window);
+    std::vector<bool> live(window, false);
+    uint64_t now = 0;
+
+    for (size_t op = 0; op < timers::operations; op++) {
+        size_t const slot = op % window;
+        if (live[slot]) {
+            by_expiry.erase(handles[slot]);
+        }
+        uint64_t const expiry = now + 1 + (gen.next() % timers::max_delay);
+        handles[slot] = by_expiry.emplace(expiry, static_cast<uint32_t>(slot));
+        live[slot] = true;
+
+        if (op % timers::ops_per_tick == 0) {
+            now++;
+            while (!by_expiry.empty() && by_expiry.begin()->first <= now) {
+                uint32_t const expired = by_expiry.begin()->second;
+                by_expiry.erase(by_expiry.begin());
+                live[expired] = false;
+                benchmark::DoNotOptimize(expired);
+            }
+        }
+    }
+}
+
+template <QueueCase Impl> void timers_schedule_cancel_expire(benchmark::State& state) {
+    const std::size_t window = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_timing_wheel)) {
+            timers_case_derive_c_timing_wheel<Impl>(window);
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_indexed_heap)) {
+            timers_case_derive_c_indexed_heap<Impl>(window);
+        } else if constexpr (LABEL_CHECK(Impl, stl_multimap_timers)) {
+            timers_case_stl_multimap_timers<Impl>(window);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(timers::operations));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(timers_schedule_cancel_expire, __VA_ARGS__)                                 \
+        ->Apply(range::exponential<65536>)
+
+BENCH(TimingWheel<std::uint32_t>);
+BENCH(IndexedHeap<std::uint64_t, 4>);
+BENCH(StdMultimapTimers<std::uint32_t>);
+
+#undef BENCH
@@ -1,12 +1,18 @@
 #pragma once
+#include <cstdint>
 #include <deque>
+#include <functional>
+#include <map>
 #include <queue>
 #include <type_traits>
+#include <vector>
 
 #include <derive-cpp/meta/labels.hpp>
 
 #include <derive-c/container/queue/circular/includes.h>
 #include <derive-c/container/queue/deque/includes.h>
+#include <derive-c/container/queue/heap/includes.h>
+#include <derive-c/container/queue/timing_wheel/includes.h>
 
 template <typename T>
 concept QueueCase = requires {
@@ -36,6 +42,29 @@ template <typename Item> struct Deque {
 #include <derive-c/container/queue/deque/template.h>
 };
 
+// D-ary heap wrapper
+template <typename Item, size_t Arity> struct Heap {
+    LABEL_ADD(derive_c_heap);
+    static constexpr const char* impl_name = "derive-c/heap";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define ARITY Arity
+#define NAME Self
+#include <derive-c/container/queue/heap/template.h>
+};
+
+// D-ary heap wrapper, with handles for each item
+template <typename Item, size_t Arity> struct IndexedHeap {
+    LABEL_ADD(derive_c_indexed_heap);
+    static constexpr const char* impl_name = "derive-c/heap (indexed)";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define ARITY Arity
+#define INDEXED
+#define NAME Self
+#include <derive-c/container/queue/heap/template.h>
+};
+
 // std::deque wrapper
 template <typename Item> struct StdDeque {
     LABEL_ADD(stl_deque);
@@ -53,3 +82,31 @@ template <typename Item> struct StdQueue {
     using Self_item_t = Item;
     using Self = std::queue<Item>;
 };
+
+// std::priority_queue wrapper (min-heap, to match derive-c's default ordering)
+template <typename Item> struct StdPriorityQueue {
+    LABEL_ADD(stl_priority_queue);
+    static constexpr const char* impl_name = "std/priority_queue";
+
+    using Self_item_t = Item;
+    using Self = std::priority_queue<Item, std::vector<Item>, std::greater<Item>>;
+};
+
+// Hierarchical timing wheel wrapper
+template <typename Item> struct TimingWheel {
+    LABEL_ADD(derive_c_timing_wheel);
+    static constexpr const char* impl_name = "derive-c/timing_wheel";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define NAME Self
+#include <derive-c/container/queue/timing_wheel/template.h>
+};
+
+// std::multimap wrapper, keyed by expiry with iterators as cancellation handles
+template <typename Item> struct StdMultimapTimers {
+    LABEL_ADD(stl_multimap_timers);
+    static constexpr const char* impl_name = "std/multimap";
+
+    using Self_item_t = Item;
+    using Self = std::multimap<uint64_t, Item>;
+};
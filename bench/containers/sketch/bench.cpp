@@ -0,0 +1,5 @@
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/update.hpp"
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+/// @file update.hpp
+/// @brief Adding a stream of items to sketches, and querying the count-min sketch
+///
+/// Checking Regressions For:
+/// - `add` on the hyperloglog, while sparse (few distinct items) and dense
+/// - `add` (with conservative update) and `estimate` on the count-min sketch
+///
+/// Representative:
+/// Representative of traffic telemetry, counting the distinct keys and the frequency of each key
+/// in a stream.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace update {
+static constexpr size_t stream = 1 << 20;
+static constexpr double epsilon = 0.001;
+static constexpr double delta = 0.01;
+
+// JUSTIFY: From few distinct items to every item distinct
+//  - Few distinct items keep the hyperloglog sparse, and the count-min sketch's counters hot.
+inline void range(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"distinct"});
+    for (int64_t distinct : {1 << 8, 1 << 14, 1 << 20}) {
+        benchmark->Args({distinct});
+    }
+}
+
+/// A stream of items drawn from `distinct` items.
+inline std::vector<uint64_t> items(size_t distinct) {
+    U32XORShiftGen gen(SEED);
+    std::vector<uint64_t> keys(distinct);
+    for (uint64_t& key : keys) {
+        key = (static_cast<uint64_t>(gen.next()) << 32) | gen.next();
+    }
+    std::vector<uint64_t> result(stream);
+    for (size_t i = 0; i < stream; i++) {
+        result[i] = keys[i < distinct ? i : gen.next() % distinct];
+    }
+    return result;
+}
+
+template <SketchCase Impl> typename Impl::Self empty() {
+    if constexpr (LABEL_CHECK(Impl, derive_c_count_min)) {
+        return Impl::Self_new_for(epsilon, delta, stdalloc_get_ref());
+    } else if constexpr (LABEL_CHECK(Impl, derive_c_hyperloglog)) {
+        return Impl::Self_new(stdalloc_get_ref());
+    } else {
+        static_assert_unreachable<Impl>();
+    }
+}
+} // namespace update
+
+template <SketchCase Impl> void sketch_add(benchmark::State& state) {
+    size_t const distinct = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> const items = update::items(distinct);
+
+    double estimate = 0.0;
+    for (auto _ : state) {
+        typename Impl::Self sketch = update::empty<Impl>();
+        for (uint64_t item : items) {
+            Impl::Self_add(&sketch, item);
+        }
+        if constexpr (LABEL_CHECK(Impl, derive_c_hyperloglog)) {
+            state.PauseTiming();
+            estimate = Impl::Self_estimate(&sketch);
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(&sketch);
+        Impl::Self_delete(&sketch);
+    }
+
+    if constexpr (LABEL_CHECK(Impl, derive_c_hyperloglog)) {
+        state.counters["relative_error"] =
+            std::abs(estimate - static_cast<double>(distinct)) / static_cast<double>(distinct);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(items.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <SketchCase Impl> void sketch_estimate(benchmark::State& state) {
+    size_t const distinct = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> const items = update::items(distinct);
+    typename Impl::Self sketch = update::empty<Impl>();
+    for (uint64_t item : items) {
+        Impl::Self_add(&sketch, item);
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (uint64_t item : items) {
+            sum += Impl::Self_estimate(&sketch, item);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    Impl::Self_delete(&sketch);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(items.size()));
+    state.SetLabel(Impl::impl_name);
+}
+
+BENCHMARK_TEMPLATE(sketch_add, HyperLogLog)->Apply(update::range);
+BENCHMARK_TEMPLATE(sketch_add, CountMin)->Apply(update::range);
+BENCHMARK_TEMPLATE(sketch_estimate, CountMin)->Apply(update::range);
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <derive-cpp/meta/labels.hpp>
+
+#include <derive-c/algorithm/hash/id.h>
+#include <derive-c/container/sketch/count_min/includes.h>
+#include <derive-c/container/sketch/hyperloglog/includes.h>
+
+template <typename T>
+concept SketchCase = requires {
+    typename T::Self;
+    { T::impl_name } -> std::convertible_to<const char*>;
+};
+
+struct CountMin {
+    LABEL_ADD(derive_c_count_min);
+    static constexpr const char* impl_name = "derive-c/count_min";
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define NAME Self
+#include <derive-c/container/sketch/count_min/template.h>
+};
+
+struct HyperLogLog {
+    LABEL_ADD(derive_c_hyperloglog);
+    static constexpr const char* impl_name = "derive-c/hyperloglog";
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define PRECISION 14
+#define NAME Self
+#include <derive-c/container/sketch/hyperloglog/template.h>
+};
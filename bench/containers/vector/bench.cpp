@@ -2,5 +2,13 @@
 
 #include "benchmarks/mixed.hpp"
 #include "benchmarks/iter_mut.hpp"
+#include "benchmarks/small.hpp"
+#include "benchmarks/bulk.hpp"
+#include "benchmarks/retain.hpp"
+#include "benchmarks/segmented.hpp"
+#include "benchmarks/soa.hpp"
+#include "benchmarks/packed.hpp"
+#include "benchmarks/growth.hpp"
+#include "benchmarks/option.hpp"
 
 BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+/// @file bulk.hpp
+/// @brief Building a vector in bulk, versus one push per item
+///
+/// Checking Regressions For:
+/// - Per-item overhead of push (invariant checks, capacity branch, memory tracking)
+/// - Single reservation and copy in extend
+/// - In-place fills through resize_uninit (as from fread or recv)
+/// - Generator overhead in extend_with
+///
+/// Representative:
+/// Highly representative of loading data (files, network buffers, query results) into a vector.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace bulk {
+inline std::vector<uint32_t> source(size_t n) {
+    U32XORShiftGen gen(SEED);
+    std::vector<uint32_t> items(n);
+    for (auto& item : items) {
+        item = gen.next();
+    }
+    return items;
+}
+
+inline uint32_t generate(size_t index, void* /* ctx */) {
+    return static_cast<uint32_t>(index * 2654435761U);
+}
+} // namespace bulk
+
+template <VectorCase Impl> void bulk_push_each(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<uint32_t> const items = bulk::source(n);
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            typename Impl::Self v = Impl::Self_new(stdalloc_get_ref());
+            for (uint32_t item : items) {
+                Impl::Self_push(&v, item);
+            }
+            benchmark::DoNotOptimize(Impl::Self_data(&v));
+            Impl::Self_delete(&v);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector)) {
+            typename Impl::Self v;
+            for (uint32_t item : items) {
+                v.push_back(item);
+            }
+            benchmark::DoNotOptimize(v.data());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <VectorCase Impl> void bulk_extend(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<uint32_t> const items = bulk::source(n);
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            typename Impl::Self v = Impl::Self_new(stdalloc_get_ref());
+            Impl::Self_extend(&v, items.data(), n);
+            benchmark::DoNotOptimize(Impl::Self_data(&v));
+            Impl::Self_delete(&v);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector)) {
+            typename Impl::Self v;
+            v.insert(v.end(), items.begin(), items.end());
+            benchmark::DoNotOptimize(v.data());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+/// The std::vector must value-initialise on resize, before the fill overwrites it.
+template <VectorCase Impl> void bulk_resize_uninit(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<uint32_t> const items = bulk::source(n);
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            typename Impl::Self v = Impl::Self_new(stdalloc_get_ref());
+            uint32_t* fill = Impl::Self_resize_uninit(&v, n);
+            memcpy(fill, items.data(), n * sizeof(uint32_t));
+            benchmark::DoNotOptimize(Impl::Self_data(&v));
+            Impl::Self_delete(&v);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector)) {
+            typename Impl::Self v;
+            v.resize(n);
+            memcpy(v.data(), items.data(), n * sizeof(uint32_t));
+            benchmark::DoNotOptimize(v.data());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <VectorCase Impl> void bulk_extend_with(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            typename Impl::Self v = Impl::Self_new(stdalloc_get_ref());
+            Impl::Self_extend_with(&v, n, bulk::generate, nullptr);
+            benchmark::DoNotOptimize(Impl::Self_data(&v));
+            Impl::Self_delete(&v);
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector)) {
+            typename Impl::Self v;
+            v.reserve(n);
+            for (size_t i = 0; i < n; i++) {
+                v.push_back(bulk::generate(i, nullptr));
+            }
+            benchmark::DoNotOptimize(v.data());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(bulk_push_each, __VA_ARGS__)->Apply(range::exponential<65536>);             \
+    BENCHMARK_TEMPLATE(bulk_extend, __VA_ARGS__)->Apply(range::exponential<65536>);                \
+    BENCHMARK_TEMPLATE(bulk_resize_uninit, __VA_ARGS__)->Apply(range::exponential<65536>);         \
+    BENCHMARK_TEMPLATE(bulk_extend_with, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(Dynamic<std::uint32_t>);
+BENCH(Std<std::uint32_t>);
+
+#undef BENCH
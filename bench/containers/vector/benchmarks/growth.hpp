@@ -0,0 +1,121 @@
+/// @file growth.hpp
+/// @brief Pushing into `vector/dynamic` with each of the built in growth policies
+///
+/// Checking Regressions For:
+/// - Push throughput, dominated by the number of reallocations
+/// - Memory used per item after pushing (the capacity left unused by the policy)
+/// - Cost of `shrink_to_fit` after pushing
+///
+/// Representative:
+/// Representative of buffers built by appending an unknown number of items, then kept.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../instances.hpp"
+#include "../../../utils/counting_alloc.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+template <typename Item> struct GrowthDouble {
+    LABEL_ADD(derive_c_growth);
+    static constexpr const char* impl_name = "derive-c/dynamic/double";
+#define EXPAND_IN_STRUCT
+#define ALLOC countingalloc
+#define ITEM Item
+#define GROWTH_POLICY dc_growth_double
+#define NAME Self
+#include <derive-c/container/vector/dynamic/template.h>
+};
+
+template <typename Item> struct GrowthOneAndHalf {
+    LABEL_ADD(derive_c_growth);
+    static constexpr const char* impl_name = "derive-c/dynamic/one_and_half";
+#define EXPAND_IN_STRUCT
+#define ALLOC countingalloc
+#define ITEM Item
+#define GROWTH_POLICY dc_growth_one_and_half
+#define NAME Self
+#include <derive-c/container/vector/dynamic/template.h>
+};
+
+template <typename Item> struct GrowthDoubleThenLinear {
+    LABEL_ADD(derive_c_growth);
+    static constexpr const char* impl_name = "derive-c/dynamic/double_then_linear";
+    // JUSTIFY: Linear growth past 4096 items
+    //  - Bounds unused capacity to a few pages, for the item sizes benchmarked.
+    DC_GROWTH_DOUBLE_THEN_LINEAR(policy, 4096)
+#define EXPAND_IN_STRUCT
+#define ALLOC countingalloc
+#define ITEM Item
+#define GROWTH_POLICY policy
+#define NAME Self
+#include <derive-c/container/vector/dynamic/template.h>
+};
+
+template <VectorCase Impl> void growth_push(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    counting_alloc_allocations = 0;
+    size_t capacity = 0;
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_growth)) {
+            typename Impl::Self v = Impl::Self_new(countingalloc_get_ref());
+            for (size_t i = 0; i < n; i++) {
+                Impl::Self_push(&v, static_cast<typename Impl::Self_item_t>(i));
+            }
+            benchmark::DoNotOptimize(Impl::Self_data(&v));
+            capacity = v.capacity;
+            Impl::Self_delete(&v);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.counters["bytes_per_item"] =
+        static_cast<double>(capacity * sizeof(typename Impl::Self_item_t)) /
+        static_cast<double>(n);
+    state.counters["allocs_per_item"] =
+        static_cast<double>(counting_alloc_allocations) /
+        static_cast<double>(state.iterations() * static_cast<int64_t>(n));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <VectorCase Impl> void growth_push_shrink(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_growth)) {
+            typename Impl::Self v = Impl::Self_new(countingalloc_get_ref());
+            for (size_t i = 0; i < n; i++) {
+                Impl::Self_push(&v, static_cast<typename Impl::Self_item_t>(i));
+            }
+            Impl::Self_shrink_to_fit(&v);
+            benchmark::DoNotOptimize(Impl::Self_data(&v));
+            Impl::Self_delete(&v);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(growth_push, __VA_ARGS__)->Apply(range::exponential<65536>);                \
+    BENCHMARK_TEMPLATE(growth_push_shrink, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(GrowthDouble<uint32_t>);
+BENCH(GrowthOneAndHalf<uint32_t>);
+BENCH(GrowthDoubleThenLinear<uint32_t>);
+
+#undef BENCH
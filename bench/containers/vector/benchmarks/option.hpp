@@ -0,0 +1,133 @@
+/// @file option.hpp
+/// @brief Scanning vectors of options, with a `present` flag versus a niche value
+///
+/// Checking Regressions For:
+/// - The size of niche options (the same as their item)
+/// - Scan throughput of vectors of pointer and index options, as the flag doubles their size
+///
+/// Representative:
+/// Representative of optional links (parent pointers, arena indices) stored per entry, and
+/// scanned to aggregate over those present.
+
+#pragma once
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-c/utils/option/includes.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+template <typename Item> struct FlaggedOption {
+    LABEL_ADD(derive_c_option_flagged);
+    static constexpr const char* impl_name = "derive-c/option";
+    using Self_item_t = Item;
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define NAME Self
+#include <derive-c/utils/option/template.h>
+};
+
+template <typename Item, Item Niche> struct NicheOption {
+    LABEL_ADD(derive_c_option_niche);
+    static constexpr const char* impl_name = "derive-c/option (niche)";
+    using Self_item_t = Item;
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define ITEM_NICHE Niche
+#define NAME Self
+#include <derive-c/utils/option/template.h>
+};
+
+static_assert(sizeof(NicheOption<uint32_t const*, nullptr>::Self) == sizeof(uint32_t const*));
+static_assert(sizeof(NicheOption<uint32_t, UINT32_MAX>::Self) == sizeof(uint32_t));
+static_assert(sizeof(FlaggedOption<uint32_t const*>::Self) == 2 * sizeof(uint32_t const*));
+
+namespace option {
+// JUSTIFY: Pointers into a table of 256 values
+//  - Small enough to stay in L1, so the scan measures the options, not the pointer chasing.
+static uint32_t const* table() {
+    static std::array<uint32_t, 256> const values = [] {
+        std::array<uint32_t, 256> init{};
+        for (uint32_t i = 0; i < 256; i++) {
+            init[i] = i;
+        }
+        return init;
+    }();
+    return values.data();
+}
+
+template <typename Item> Item payload(uint32_t random) {
+    if constexpr (std::is_pointer_v<Item>) {
+        return &table()[random & 0xFFU];
+    } else {
+        return static_cast<Item>(random & 0xFFFFU);
+    }
+}
+
+template <typename Item> uint64_t value(Item item) {
+    if constexpr (std::is_pointer_v<Item>) {
+        return *item;
+    } else {
+        return item;
+    }
+}
+} // namespace option
+
+/// Three quarters of the options are present.
+template <typename Opt> void option_scan(benchmark::State& state) {
+    using Vec = Dynamic<typename Opt::Self>;
+    using Item = typename Opt::Self_item_t;
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    U32XORShiftGen gen(SEED);
+    typename Vec::Self v = Vec::Self_new(stdalloc_get_ref());
+    for (size_t i = 0; i < n; i++) {
+        uint32_t const random = gen.next();
+        Vec::Self_push(&v, random % 4 == 0 ? Opt::Self_empty()
+                                           : Opt::Self_from(option::payload<Item>(random >> 2)));
+    }
+
+    for (auto _ : state) {
+        typename Opt::Self const* options = Vec::Self_data(&v);
+        uint64_t sum = 0;
+        if constexpr (LABEL_CHECK(Opt, derive_c_option_flagged) ||
+                      LABEL_CHECK(Opt, derive_c_option_niche)) {
+            for (size_t i = 0; i < n; i++) {
+                Item const* item = Opt::Self_get_const(&options[i]);
+                if (item != nullptr) {
+                    sum += option::value<Item>(*item);
+                }
+            }
+        } else {
+            static_assert_unreachable<Opt>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["bytes_per_item"] = static_cast<double>(sizeof(typename Opt::Self));
+    Vec::Self_delete(&v);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Opt::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(option_scan, __VA_ARGS__)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22)
+
+BENCH(FlaggedOption<uint32_t const*>);
+BENCH(NicheOption<uint32_t const*, nullptr>);
+BENCH(FlaggedOption<uint32_t>);
+BENCH(NicheOption<uint32_t, UINT32_MAX>);
+
+#undef BENCH
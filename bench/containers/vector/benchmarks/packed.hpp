@@ -0,0 +1,127 @@
+/// @file packed.hpp
+/// @brief Scanning 12 bit codes, bit packed versus stored in a `uint16_t` vector
+///
+/// Checking Regressions For:
+/// - Bulk decode throughput of `unpack` (AVX2 gather, and scalar)
+/// - Random access cost of `get` across word boundaries
+/// - Memory per value
+///
+/// Representative:
+/// Representative of dictionary encoded columns, scanned in blocks to aggregate or filter.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-c/container/vector/packed/includes.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+struct PackedU12 {
+    LABEL_ADD(derive_c_packed);
+    static constexpr const char* impl_name = "derive-c/packed";
+    using Self_item_t = uint32_t;
+#define EXPAND_IN_STRUCT
+#define BITS 12
+#define NAME Self
+#include <derive-c/container/vector/packed/template.h>
+};
+
+namespace packed {
+// JUSTIFY: Unpacking in blocks of 256
+//  - Small enough for the block to stay in L1, large enough to amortise the dispatch.
+static constexpr size_t block = 256;
+
+template <VectorCase Impl> typename Impl::Self build(size_t n) {
+    U32XORShiftGen gen(SEED);
+    typename Impl::Self v = Impl::Self_new(stdalloc_get_ref());
+    for (size_t i = 0; i < n; i++) {
+        Impl::Self_push(&v, static_cast<uint16_t>(gen.next() & 0xFFFU));
+    }
+    return v;
+}
+
+template <VectorCase Impl> size_t bytes(typename Impl::Self const* v) {
+    if constexpr (LABEL_CHECK(Impl, derive_c_packed)) {
+        return Impl::Self_capacity_bytes(v);
+    } else {
+        return v->capacity * sizeof(typename Impl::Self_item_t);
+    }
+}
+} // namespace packed
+
+template <VectorCase Impl> void packed_scan(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self v = packed::build<Impl>(n);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_packed)) {
+            uint32_t values[packed::block];
+            for (size_t from = 0; from < n; from += packed::block) {
+                size_t const count = n - from < packed::block ? n - from : packed::block;
+                Impl::Self_unpack(&v, from, count, values);
+                for (size_t i = 0; i < count; i++) {
+                    sum += values[i];
+                }
+            }
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            typename Impl::Self_item_t const* values = Impl::Self_data(&v);
+            for (size_t i = 0; i < n; i++) {
+                sum += values[i];
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["bytes_per_item"] =
+        static_cast<double>(packed::bytes<Impl>(&v)) / static_cast<double>(n);
+    Impl::Self_delete(&v);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <VectorCase Impl> void packed_get(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self v = packed::build<Impl>(n);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; i++) {
+            if constexpr (LABEL_CHECK(Impl, derive_c_packed)) {
+                sum += Impl::Self_get(&v, i);
+            } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+                sum += *Impl::Self_read(&v, i);
+            } else {
+                static_assert_unreachable<Impl>();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    Impl::Self_delete(&v);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(packed_scan, __VA_ARGS__)->Apply(range::exponential<65536>);                \
+    BENCHMARK_TEMPLATE(packed_get, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(Dynamic<uint16_t>);
+BENCH(PackedU12);
+
+#undef BENCH
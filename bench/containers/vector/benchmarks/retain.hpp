@@ -0,0 +1,124 @@
+/// @file retain.hpp
+/// @brief Removing items by predicate, at several drop ratios
+///
+/// Checking Regressions For:
+/// - Single pass compaction in retain
+/// - The quadratic cost of repeated remove_at, each memmoving the tail
+/// - Versus std::erase_if
+///
+/// Representative:
+/// Highly representative of filtering (e.g. dropping expired or invalidated entries) in place.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+template <uint32_t DropPercent> bool retain_keep(uint32_t const* item, void* /* ctx */) {
+    return (*item % 100) >= DropPercent;
+}
+
+template <VectorCase NS> typename NS::Self retain_fill(size_t n) {
+    U32XORShiftGen gen(SEED);
+    typename NS::Self v = NS::Self_new_with_capacity(n, stdalloc_get_ref());
+    for (size_t i = 0; i < n; i++) {
+        NS::Self_push(&v, gen.next());
+    }
+    return v;
+}
+
+template <VectorCase Impl, uint32_t DropPercent> void retain(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            state.PauseTiming();
+            typename Impl::Self v = retain_fill<Impl>(n);
+            state.ResumeTiming();
+
+            Impl::Self_retain(&v, retain_keep<DropPercent>, nullptr);
+            benchmark::DoNotOptimize(Impl::Self_size(&v));
+
+            state.PauseTiming();
+            Impl::Self_delete(&v);
+            state.ResumeTiming();
+        } else if constexpr (LABEL_CHECK(Impl, stl_vector)) {
+            state.PauseTiming();
+            U32XORShiftGen gen(SEED);
+            typename Impl::Self v(n);
+            for (auto& item : v) {
+                item = gen.next();
+            }
+            state.ResumeTiming();
+
+            std::erase_if(v, [](uint32_t const& item) {
+                return !retain_keep<DropPercent>(&item, nullptr);
+            });
+            benchmark::DoNotOptimize(v.size());
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+/// The baseline before retain: one remove_at per dropped item.
+template <VectorCase Impl, uint32_t DropPercent> void retain_by_remove_at(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            state.PauseTiming();
+            typename Impl::Self v = retain_fill<Impl>(n);
+            state.ResumeTiming();
+
+            size_t index = 0;
+            while (index < Impl::Self_size(&v)) {
+                if (retain_keep<DropPercent>(Impl::Self_read(&v, index), nullptr)) {
+                    index++;
+                } else {
+                    Impl::Self_remove_at(&v, index, 1);
+                }
+            }
+            benchmark::DoNotOptimize(Impl::Self_size(&v));
+
+            state.PauseTiming();
+            Impl::Self_delete(&v);
+            state.ResumeTiming();
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(DROP_PERCENT)                                                                        \
+    BENCHMARK_TEMPLATE(retain, Dynamic<std::uint32_t>, DROP_PERCENT)                               \
+        ->Apply(range::exponential<65536>);                                                        \
+    BENCHMARK_TEMPLATE(retain, Std<std::uint32_t>, DROP_PERCENT)                                   \
+        ->Apply(range::exponential<65536>);                                                        \
+    BENCHMARK_TEMPLATE(retain_by_remove_at, Dynamic<std::uint32_t>, DROP_PERCENT)                  \
+        ->Apply(range::exponential<16384>)
+
+BENCH(10);
+BENCH(50);
+BENCH(90);
+
+#undef BENCH
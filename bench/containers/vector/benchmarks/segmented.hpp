@@ -0,0 +1,143 @@
+/// @file segmented.hpp
+/// @brief Segmented vectors (stable addresses) against contiguous vectors and deques
+///
+/// Checking Regressions For:
+/// - Push cost without copying on growth (new segments only)
+/// - Indexing cost of the most significant bit segment lookup
+/// - Iteration cost across segment boundaries
+///
+/// Representative:
+/// Representative of tables of records referenced by pointer (e.g. by intrusive indexes), which
+/// are appended to and scanned, but never moved.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+namespace segmented {
+template <VectorCase Impl> typename Impl::Self build(size_t n) {
+    U32XORShiftGen gen(SEED);
+    if constexpr (LABEL_CHECK(Impl, stl_deque)) {
+        typename Impl::Self v;
+        for (size_t i = 0; i < n; i++) {
+            v.push_back(gen.next());
+        }
+        return v;
+    } else {
+        typename Impl::Self v = Impl::Self_new(stdalloc_get_ref());
+        for (size_t i = 0; i < n; i++) {
+            Impl::Self_push(&v, gen.next());
+        }
+        return v;
+    }
+}
+
+template <VectorCase Impl> void destroy(typename Impl::Self& v) {
+    if constexpr (!LABEL_CHECK(Impl, stl_deque)) {
+        Impl::Self_delete(&v);
+    }
+}
+} // namespace segmented
+
+template <VectorCase Impl> void segmented_push(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_dynamic) ||
+                      LABEL_CHECK(Impl, derive_c_segmented) || LABEL_CHECK(Impl, stl_deque)) {
+            typename Impl::Self v = segmented::build<Impl>(n);
+            benchmark::DoNotOptimize(&v);
+            segmented::destroy<Impl>(v);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <VectorCase Impl> void segmented_index(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self v = segmented::build<Impl>(n);
+
+    // JUSTIFY: Strided rather than sequential indexes
+    //  - Defeats hoisting the segment lookup out of the loop.
+    size_t const stride = 7919;
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        size_t index = 0;
+        for (size_t i = 0; i < n; i++) {
+            if constexpr (LABEL_CHECK(Impl, stl_deque)) {
+                sum += v[index];
+            } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic) ||
+                                 LABEL_CHECK(Impl, derive_c_segmented)) {
+                sum += *Impl::Self_read(&v, index);
+            } else {
+                static_assert_unreachable<Impl>();
+            }
+            index += stride;
+            if (index >= n) {
+                index -= n;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    segmented::destroy<Impl>(v);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <VectorCase Impl> void segmented_iterate(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self v = segmented::build<Impl>(n);
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        if constexpr (LABEL_CHECK(Impl, stl_deque)) {
+            for (uint32_t item : v) {
+                sum += item;
+            }
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic) ||
+                             LABEL_CHECK(Impl, derive_c_segmented)) {
+            typename Impl::Self_iter_const iter = Impl::Self_get_iter_const(&v);
+            uint32_t const* item;
+            while ((item = Impl::Self_iter_const_next(&iter))) {
+                sum += *item;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    segmented::destroy<Impl>(v);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(segmented_push, __VA_ARGS__)->Apply(range::exponential<65536>);             \
+    BENCHMARK_TEMPLATE(segmented_index, __VA_ARGS__)->Apply(range::exponential<65536>);            \
+    BENCHMARK_TEMPLATE(segmented_iterate, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(Dynamic<uint32_t>);
+BENCH(Segmented<uint32_t>);
+BENCH(StdDeque<uint32_t>);
+
+#undef BENCH
@@ -0,0 +1,89 @@
+/// @file small.hpp
+/// @brief Many short-lived vectors, mostly below the inline capacity
+///
+/// Checking Regressions For:
+/// - Pushes to inline storage avoiding the allocator
+/// - Spilling to the allocator when the inline capacity is exceeded
+/// - Allocation counts versus vector/dynamic, absl::InlinedVector and std::vector
+///
+/// Representative:
+/// Highly representative of per-record vectors (e.g. tags, children, or edges of a node), where
+/// most records hold only a few elements.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../instances.hpp"
+#include "../../../utils/counting_alloc.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/prelude.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+// JUSTIFY: Record sizes in [0, 12)
+//  - Most records fit within an inline capacity of 8, with a third spilling.
+static constexpr uint32_t small_max_record_size = 12;
+
+template <VectorCase NS> void small_records_case_derive_c(size_t records, U32XORShiftGen& gen) {
+    for (size_t record = 0; record < records; record++) {
+        typename NS::Self v = NS::Self_new(countingalloc_get_ref());
+        uint32_t const size = gen.next() % small_max_record_size;
+        for (uint32_t i = 0; i < size; i++) {
+            NS::Self_push(&v, i);
+        }
+        benchmark::DoNotOptimize(NS::Self_size(&v));
+        NS::Self_delete(&v);
+    }
+}
+
+template <VectorCase Std> void small_records_case_stl(size_t records, U32XORShiftGen& gen) {
+    for (size_t record = 0; record < records; record++) {
+        typename Std::Self v;
+        uint32_t const size = gen.next() % small_max_record_size;
+        for (uint32_t i = 0; i < size; i++) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.size());
+    }
+}
+
+template <VectorCase Impl> void small_records(benchmark::State& state) {
+    const std::size_t records = static_cast<std::size_t>(state.range(0));
+    U32XORShiftGen gen(SEED);
+    counting_alloc_allocations = 0;
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_small) ||
+                      LABEL_CHECK(Impl, derive_c_counted_dynamic)) {
+            small_records_case_derive_c<Impl>(records, gen);
+        } else if constexpr (LABEL_CHECK(Impl, absl_inlined_vector) ||
+                             LABEL_CHECK(Impl, stl_counted_vector)) {
+            small_records_case_stl<Impl>(records, gen);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.counters["allocs_per_record"] =
+        static_cast<double>(counting_alloc_allocations) /
+        static_cast<double>(state.iterations() * static_cast<int64_t>(records));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(records));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(small_records, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(Small<std::uint32_t, 8>);
+BENCH(CountedDynamic<std::uint32_t>);
+BENCH(AbslInlined<std::uint32_t, 8>);
+BENCH(CountedStd<std::uint32_t>);
+
+#undef BENCH
@@ -0,0 +1,130 @@
+/// @file soa.hpp
+/// @brief Summing one field of wide records, stored as structure of arrays versus array of structs
+///
+/// Checking Regressions For:
+/// - Column scans over `vector/soa` only touching the scanned field's memory
+/// - Vectorisation of loops over a column
+/// - Push cost of scattering each record across its columns
+///
+/// Representative:
+/// Representative of analytics over tables of wide records, which aggregate one or two fields.
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../instances.hpp"
+#include "../../../utils/seed.hpp"
+#include "../../../utils/generator.hpp"
+#include "../../../utils/range.hpp"
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/prelude.h>
+
+#include <derive-c/container/vector/soa/includes.h>
+
+#include <derive-cpp/meta/labels.hpp>
+#include <derive-cpp/meta/unreachable.hpp>
+
+// JUSTIFY: A 64 byte record
+//  - One record per cache line, so an array of structs scan of one field loads 8x the bytes.
+#define WideRecord_REFLECT(F)                                                                      \
+    F(uint64_t, id)                                                                                \
+    F(uint64_t, account)                                                                           \
+    F(uint64_t, timestamp)                                                                         \
+    F(uint64_t, quantity)                                                                          \
+    F(double, price)                                                                               \
+    F(double, fee)                                                                                 \
+    F(uint64_t, venue)                                                                             \
+    F(uint64_t, flags)
+
+DC_DERIVE_STRUCT(WideRecord)
+
+struct SoaRecords {
+    LABEL_ADD(derive_c_soa);
+    static constexpr const char* impl_name = "derive-c/soa";
+#define EXPAND_IN_STRUCT
+#define ITEM WideRecord
+#define NAME Self
+#include <derive-c/container/vector/soa/template.h>
+};
+
+namespace soa {
+inline WideRecord record(U32XORShiftGen& gen) {
+    uint64_t const value = gen.next();
+    return WideRecord{
+        .id = value,
+        .account = value >> 3,
+        .timestamp = value * 7,
+        .quantity = value % 1000,
+        .price = static_cast<double>(value % 10000) * 0.01,
+        .fee = 0.1,
+        .venue = value % 16,
+        .flags = 0,
+    };
+}
+
+template <VectorCase Impl> typename Impl::Self build(size_t n) {
+    U32XORShiftGen gen(SEED);
+    typename Impl::Self v = Impl::Self_new(stdalloc_get_ref());
+    for (size_t i = 0; i < n; i++) {
+        Impl::Self_push(&v, record(gen));
+    }
+    return v;
+}
+} // namespace soa
+
+template <VectorCase Impl> void soa_column_sum(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    typename Impl::Self v = soa::build<Impl>(n);
+
+    for (auto _ : state) {
+        double sum = 0;
+        if constexpr (LABEL_CHECK(Impl, derive_c_soa)) {
+            double const* prices = Impl::Self_column_const_price(&v);
+            for (size_t i = 0; i < n; i++) {
+                sum += prices[i];
+            }
+        } else if constexpr (LABEL_CHECK(Impl, derive_c_dynamic)) {
+            WideRecord const* records = Impl::Self_data(&v);
+            for (size_t i = 0; i < n; i++) {
+                sum += records[i].price;
+            }
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    Impl::Self_delete(&v);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+template <VectorCase Impl> void soa_push(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        if constexpr (LABEL_CHECK(Impl, derive_c_soa) || LABEL_CHECK(Impl, derive_c_dynamic)) {
+            typename Impl::Self v = soa::build<Impl>(n);
+            benchmark::DoNotOptimize(&v);
+            Impl::Self_delete(&v);
+        } else {
+            static_assert_unreachable<Impl>();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+    state.SetLabel(Impl::impl_name);
+}
+
+#define BENCH(...)                                                                                 \
+    BENCHMARK_TEMPLATE(soa_column_sum, __VA_ARGS__)->Apply(range::exponential<65536>);             \
+    BENCHMARK_TEMPLATE(soa_push, __VA_ARGS__)->Apply(range::exponential<65536>)
+
+BENCH(Dynamic<WideRecord>);
+BENCH(SoaRecords);
+
+#undef BENCH
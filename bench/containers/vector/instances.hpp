@@ -1,11 +1,18 @@
 #pragma once
+#include <deque>
 #include <vector>
 #include <type_traits>
 
+#include <absl/container/inlined_vector.h>
+
 #include <derive-cpp/meta/labels.hpp>
 #include <derive-c/container/vector/dynamic/includes.h>
+#include <derive-c/container/vector/segmented/includes.h>
+#include <derive-c/container/vector/small/includes.h>
 #include <derive-c/container/vector/static/includes.h>
 
+#include "../../utils/counting_alloc.hpp"
+
 template <typename T>
 concept VectorCase = requires {
     typename T::Self;
@@ -53,3 +60,54 @@ template <typename Item> struct Std {
     using Self_item_t = Item;
     using Self = std::vector<Item>;
 };
+
+template <typename Item, size_t InlineCapacity> struct Small {
+    LABEL_ADD(derive_c_small);
+    static constexpr const char* impl_name = "derive-c/small";
+#define EXPAND_IN_STRUCT
+#define ALLOC countingalloc
+#define ITEM Item
+#define INLINE_CAPACITY InlineCapacity
+#define NAME Self
+#include <derive-c/container/vector/small/template.h>
+};
+
+template <typename Item> struct CountedDynamic {
+    LABEL_ADD(derive_c_counted_dynamic);
+    static constexpr const char* impl_name = "derive-c/dynamic";
+#define EXPAND_IN_STRUCT
+#define ALLOC countingalloc
+#define ITEM Item
+#define NAME Self
+#include <derive-c/container/vector/dynamic/template.h>
+};
+
+template <typename Item, size_t InlineCapacity> struct AbslInlined {
+    LABEL_ADD(absl_inlined_vector);
+    static constexpr const char* impl_name = "absl/inlined_vector";
+    using Self_item_t = Item;
+    using Self = absl::InlinedVector<Item, InlineCapacity, CountingAllocator<Item>>;
+};
+
+template <typename Item> struct CountedStd {
+    LABEL_ADD(stl_counted_vector);
+    static constexpr const char* impl_name = "std/vector";
+    using Self_item_t = Item;
+    using Self = std::vector<Item, CountingAllocator<Item>>;
+};
+
+template <typename Item> struct Segmented {
+    LABEL_ADD(derive_c_segmented);
+    static constexpr const char* impl_name = "derive-c/segmented";
+#define EXPAND_IN_STRUCT
+#define ITEM Item
+#define NAME Self
+#include <derive-c/container/vector/segmented/template.h>
+};
+
+template <typename Item> struct StdDeque {
+    LABEL_ADD(stl_deque);
+    static constexpr const char* impl_name = "std/deque";
+    using Self_item_t = Item;
+    using Self = std::deque<Item>;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/alloc/trait.h>
+#include <derive-c/core/prelude.h>
+
+// JUSTIFY: Counting allocations
+//  - Containers avoiding allocation (e.g. small vectors) are only fairly compared by the number
+//    of calls to the allocator, as well as by time.
+//  - A single global counter, shared by the derive-c and std allocators below.
+inline size_t counting_alloc_allocations = 0;
+
+DC_ZERO_SIZED(countingalloc);
+static countingalloc countingalloc_instance = {};
+DC_TRAIT_REFERENCABLE_SINGLETON(countingalloc, countingalloc_instance);
+
+DC_PUBLIC static void* NS(countingalloc, allocate_uninit)(countingalloc_ref /* ref */,
+                                                          size_t size) {
+    counting_alloc_allocations++;
+    return NS(stdalloc, allocate_uninit)(stdalloc_get_ref(), size);
+}
+
+DC_PUBLIC static void* NS(countingalloc, allocate_zeroed)(countingalloc_ref /* ref */,
+                                                          size_t size) {
+    counting_alloc_allocations++;
+    return NS(stdalloc, allocate_zeroed)(stdalloc_get_ref(), size);
+}
+
+DC_PUBLIC static void* NS(countingalloc, reallocate)(countingalloc_ref /* ref */, void* ptr,
+                                                     size_t old_size, size_t new_size) {
+    counting_alloc_allocations++;
+    return NS(stdalloc, reallocate)(stdalloc_get_ref(), ptr, old_size, new_size);
+}
+
+DC_PUBLIC static void NS(countingalloc, deallocate)(countingalloc_ref /* ref */, void* ptr,
+                                                    size_t size) {
+    NS(stdalloc, deallocate)(stdalloc_get_ref(), ptr, size);
+}
+
+DC_PUBLIC static void NS(countingalloc, debug)(countingalloc const* self, dc_debug_fmt /* fmt */,
+                                               FILE* stream) {
+    fprintf(stream, "countingalloc@%p { allocations: %zu }", (void*)self,
+            counting_alloc_allocations);
+}
+
+DC_PUBLIC static void NS(countingalloc, delete)(countingalloc* self) { DC_ASSUME(self); }
+
+DC_TRAIT_ALLOC(countingalloc);
+
+/// A std allocator counting into the same counter as `countingalloc`.
+template <typename T> struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U> CountingAllocator(CountingAllocator<U> const& /* other */) {}
+
+    T* allocate(size_t n) {
+        counting_alloc_allocations++;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t /* n */) { ::operator delete(ptr); }
+
+    template <typename U> bool operator==(CountingAllocator<U> const& /* other */) const {
+        return true;
+    }
+};
@@ -8,6 +8,19 @@
 #define NAME bitset
 #include <derive-c/container/bitset/static/template.h>
 
+#define NAME row_mask
+#include <derive-c/container/bitset/dynamic/template.h>
+
+#define NAME slot_mask
+#include <derive-c/container/bitset/hierarchical/template.h>
+
+#define NAME posting_list
+#include <derive-c/container/bitset/roaring/template.h>
+
+#define EXCLUSIVE_END_INDEX 256
+#define NAME slot_pool
+#include <derive-c/container/bitset/atomic/template.h>
+
 static void example_basic(DC_LOGGER* parent) {
     DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
     DC_SCOPED(bitset) bs = bitset_new();
@@ -27,6 +40,87 @@ static void example_basic(DC_LOGGER* parent) {
     DC_FOR_CONST(bitset, &bs, iter, index) { DC_LOG(log, DC_INFO, "iterated index: %u", index); }
 }
 
+static void example_dynamic(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(row_mask) rows = row_mask_new_with_end(1000, stdalloc_get_ref());
+
+    DC_LOG(log, DC_INFO, "selecting rows [100, 200), then removing [150, 190)");
+    row_mask_set_range(&rows, 100, 200, true);
+    row_mask_set_range(&rows, 150, 190, false);
+    DC_LOG(log, DC_INFO, "selected %zu rows", row_mask_size(&rows));
+
+    DC_LOG(log, DC_INFO, "growing to 2000 rows");
+    row_mask_resize(&rows, 2000);
+    row_mask_set(&rows, 1999, true);
+
+    for (size_t index = row_mask_find_first_set(&rows); index < row_mask_exclusive_end_index(&rows);
+         index = row_mask_find_next_set(&rows, index + 1)) {
+        if (index % 10 == 0) {
+            DC_LOG(log, DC_INFO, "selected row: %zu", index);
+        }
+    }
+}
+
+static void example_hierarchical(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(slot_mask) slots = slot_mask_new_with_end(1000000, stdalloc_get_ref());
+
+    DC_LOG(log, DC_INFO, "occupying 3 of %zu slots", slot_mask_exclusive_end_index(&slots));
+    slot_mask_set(&slots, 17, true);
+    slot_mask_set(&slots, 500000, true);
+    slot_mask_set(&slots, 999999, true);
+    DC_LOG(log, DC_INFO, "%u levels, %zu occupied", slot_mask_levels(&slots),
+           slot_mask_size(&slots));
+
+    DC_FOR_CONST(slot_mask, &slots, iter, index) {
+        DC_LOG(log, DC_INFO, "occupied slot: %zu", index);
+    }
+
+    slot_mask_clear_all(&slots);
+    DC_LOG(log, DC_INFO, "after clearing, %zu occupied", slot_mask_size(&slots));
+}
+
+static void example_roaring(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(posting_list) red = posting_list_new(stdalloc_get_ref());
+    DC_SCOPED(posting_list) large = posting_list_new(stdalloc_get_ref());
+    DC_SCOPED(posting_list) both = posting_list_new(stdalloc_get_ref());
+
+    DC_LOG(log, DC_INFO, "documents [0, 100000) are red, and every 1000th document is large");
+    for (uint32_t document = 0; document < 100000; document++) {
+        posting_list_set(&red, document, true);
+    }
+    for (uint32_t document = 0; document < 10000000; document += 1000) {
+        posting_list_set(&large, document, true);
+    }
+    posting_list_run_optimize(&red);
+    DC_LOG(log, DC_INFO, "red uses %zu bytes, large uses %zu bytes",
+           posting_list_capacity_bytes(&red), posting_list_capacity_bytes(&large));
+
+    posting_list_and(&red, &large, &both);
+    DC_LOG(log, DC_INFO, "%zu documents are red and large", posting_list_size(&both));
+    DC_LOG(log, DC_INFO, "document 42000 is red and large: %s",
+           posting_list_get(&both, 42000) ? "true" : "false");
+}
+
+static void example_atomic(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(slot_pool) pool = slot_pool_new();
+
+    DC_LOG(log, DC_INFO, "workers claim from different quarters of the pool, without a lock");
+    for (size_t worker = 0; worker < 4; worker++) {
+        size_t const hint = worker * (slot_pool_exclusive_end_index / 4);
+        DC_LOG(log, DC_INFO, "worker %zu claimed slot %zu", worker,
+               slot_pool_claim_first_clear(&pool, hint));
+    }
+
+    DC_LOG(log, DC_INFO, "releasing slot 64: %s",
+           slot_pool_test_and_clear(&pool, 64) ? "true" : "false");
+    DC_LOG(log, DC_INFO, "releasing slot 64 again: %s",
+           slot_pool_test_and_clear(&pool, 64) ? "true" : "false");
+    DC_LOG(log, DC_INFO, "%zu slots claimed", slot_pool_size(&pool));
+}
+
 int main() {
     DC_SCOPED(DC_LOGGER)
     root = NS(DC_LOGGER,
@@ -34,5 +128,9 @@ int main() {
                           (dc_log_id){"bitset"});
 
     example_basic(&root);
+    example_dynamic(&root);
+    example_hierarchical(&root);
+    example_roaring(&root);
+    example_atomic(&root);
     return 0;
 }
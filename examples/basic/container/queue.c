@@ -45,6 +45,50 @@ static void example_deque(DC_LOGGER* parent) {
     int_deque_pop_front(&deque);
 }
 
+#define ITEM int
+#define INDEXED
+#define NAME int_heap
+#include <derive-c/container/queue/heap/template.h>
+
+static void example_heap(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(int_heap) heap = int_heap_new(stdalloc_get_ref());
+
+    DC_LOG(log, DC_INFO, "pushing 30, 10, 20, then decreasing 30 to 5");
+    int_heap_handle_t handle = int_heap_push(&heap, 30);
+    int_heap_push(&heap, 10);
+    int_heap_push(&heap, 20);
+    int_heap_decrease_key(&heap, handle, 5);
+
+    while (!int_heap_empty(&heap)) {
+        DC_LOG(log, DC_INFO, "popped: %d", int_heap_pop(&heap));
+    }
+}
+
+#define ITEM int
+#define NAME int_timers
+#include <derive-c/container/queue/timing_wheel/template.h>
+
+static void example_timing_wheel(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(int_timers) timers = int_timers_new(stdalloc_get_ref());
+
+    DC_LOG(log, DC_INFO, "scheduling 1, 2 and 3 at ticks 10, 500, 20, then cancelling 3");
+    int_timers_schedule(&timers, 10, 1);
+    int_timers_schedule(&timers, 500, 2);
+    int_timers_handle_t handle = int_timers_schedule(&timers, 20, 3);
+    int_timers_cancel(&timers, handle);
+
+    size_t const expired = int_timers_advance(&timers, 1000);
+    DC_LOG(log, DC_INFO, "advanced to tick %lu, %lu expired", (size_t)int_timers_now(&timers),
+           expired);
+
+    int item;
+    while (int_timers_try_pop_expired(&timers, &item)) {
+        DC_LOG(log, DC_INFO, "expired: %d", item);
+    }
+}
+
 struct message {
     char* data;
     int length;
@@ -97,6 +141,8 @@ int main() {
 
     example_queue(&root);
     example_deque(&root);
+    example_heap(&root);
+    example_timing_wheel(&root);
     example_custom(&root);
     return 0;
 }
@@ -63,6 +63,43 @@ static void example_static(DC_LOGGER* parent) {
     DC_FOR_CONST(static_vec, &vec, iter, item) { DC_LOG(log, DC_INFO, "item: %d", *item); }
 }
 
+#define ITEM int
+#define INLINE_CAPACITY 4
+#define NAME small_vec
+#include <derive-c/container/vector/small/template.h>
+
+static void example_small(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(small_vec) vec = small_vec_new(stdalloc_get_ref());
+
+    DC_LOG(log, DC_INFO, "pushing 4 integers to small vec (inline capacity 4)");
+    for (int i = 0; i < 4; i++) {
+        small_vec_push(&vec, i);
+    }
+    DC_LOG(log, DC_INFO, "inline: %s", small_vec_is_inline(&vec) ? "true" : "false");
+
+    small_vec_push(&vec, 4);
+    DC_LOG(log, DC_INFO, "after spilling: %s", DC_DEBUG(small_vec_debug, &vec));
+}
+
+#define ITEM int
+#define INITIAL_SEGMENT_INDEX_BITS 2
+#define NAME segmented_vec
+#include <derive-c/container/vector/segmented/template.h>
+
+static void example_segmented(DC_LOGGER* parent) {
+    DC_SCOPED(DC_LOGGER) log = DC_LOGGER_NEW(parent, "%s", __func__);
+    DC_SCOPED(segmented_vec) vec = segmented_vec_new(stdalloc_get_ref());
+
+    int* first = segmented_vec_push(&vec, 0);
+    DC_LOG(log, DC_INFO, "pushing 20 more integers to segmented vec (first segment of 4)");
+    for (int i = 1; i <= 20; i++) {
+        segmented_vec_push(&vec, i);
+    }
+    DC_ASSERT(first == segmented_vec_write(&vec, 0));
+    DC_LOG(log, DC_INFO, "first item not moved: %s", DC_DEBUG(segmented_vec_debug, &vec));
+}
+
 #define ITEM char*
 #define ITEM_DELETE(ptr_to_str) free(*ptr_to_str)
 #define NAME char_vec
@@ -105,6 +142,8 @@ int main() {
     example_basic(&root);
     example_dynamic(&root);
     example_static(&root);
+    example_small(&root);
+    example_segmented(&root);
     example_map(&root);
     return 0;
 }
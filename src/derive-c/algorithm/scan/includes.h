@@ -0,0 +1,10 @@
+#pragma once
+
+// [DERIVE-C] stdlib includes
+#include <stdbool.h> // IWYU pragma: export
+#include <stddef.h>  // IWYU pragma: export
+#include <stdint.h>  // IWYU pragma: export
+
+// [DERIVE-C] lib includes
+#include <derive-c/algorithm/scan/simd.h> // IWYU pragma: export
+#include <derive-c/core/prelude.h>        // IWYU pragma: export
@@ -0,0 +1,494 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <derive-c/core/prelude.h>
+#include <derive-c/test/mock.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define DC_SCAN_X86
+    #include <immintrin.h>
+#endif
+
+/// Vectorised linear scans over arrays of the std numeric types.
+///  - `TYPE_scan_find` and `TYPE_scan_count` compare with `==`, so for floats `NaN` matches
+///    nothing, and `-0.0` matches `0.0`.
+///  - `TYPE_scan_min` and `TYPE_scan_max` give the index of the first minimum/maximum by `<` and
+///    `>`, with the same result as a scalar loop keeping the best item seen from `items[0]`.
+///  - Each returns `count` when there is no such item.
+///  - On x86 the AVX2 or SSE2 kernels are selected at runtime with `dc_cpu_features_get`, other
+///    targets use the scalar loops.
+
+typedef enum {
+    DC_SCAN_ISA_SCALAR,
+    DC_SCAN_ISA_SSE2,
+    DC_SCAN_ISA_AVX2,
+} dc_scan_isa;
+
+// JUSTIFY: Mockable
+//  - So tests can check each of the kernels, on a machine supporting all of them.
+DC_MOCKABLE(dc_scan_isa, dc_scan_isa_get, (void)) {
+#if defined DC_SCAN_X86
+    dc_cpu_features const features = dc_cpu_features_get();
+    if (features.AVX2.compiled_with || features.AVX2.runtime_supported) {
+        return DC_SCAN_ISA_AVX2;
+    }
+    if (features.SSE2.compiled_with || features.SSE2.runtime_supported) {
+        return DC_SCAN_ISA_SSE2;
+    }
+#endif
+    return DC_SCAN_ISA_SCALAR;
+}
+
+// JUSTIFY: No -Wfloat-equal
+//  - Exact comparison is the intended behaviour for the float kernels, matching `DC_MEM_EQ`.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+
+#define _DC_SCAN_SCALAR_KERNELS(TYPE)                                                              \
+    DC_PUBLIC static size_t _dc_scan_##TYPE##_find_scalar(TYPE const* items, size_t from,          \
+                                                          size_t count, TYPE value) {              \
+        for (size_t i = from; i < count; i++) {                                                    \
+            if (items[i] == value) {                                                               \
+                return i;                                                                          \
+            }                                                                                      \
+        }                                                                                          \
+        return count;                                                                              \
+    }                                                                                              \
+    DC_PUBLIC static size_t _dc_scan_##TYPE##_count_scalar(TYPE const* items, size_t from,         \
+                                                           size_t count, TYPE value) {             \
+        size_t matches = 0;                                                                        \
+        for (size_t i = from; i < count; i++) {                                                    \
+            matches += (items[i] == value) ? 1 : 0;                                                \
+        }                                                                                          \
+        return matches;                                                                            \
+    }                                                                                              \
+    DC_PUBLIC static TYPE _dc_scan_##TYPE##_min_scalar(TYPE const* items, size_t from,             \
+                                                       size_t count, TYPE best) {                  \
+        for (size_t i = from; i < count; i++) {                                                    \
+            if (items[i] < best) {                                                                 \
+                best = items[i];                                                                   \
+            }                                                                                      \
+        }                                                                                          \
+        return best;                                                                               \
+    }                                                                                              \
+    DC_PUBLIC static TYPE _dc_scan_##TYPE##_max_scalar(TYPE const* items, size_t from,             \
+                                                       size_t count, TYPE best) {                  \
+        for (size_t i = from; i < count; i++) {                                                    \
+            if (items[i] > best) {                                                                 \
+                best = items[i];                                                                   \
+            }                                                                                      \
+        }                                                                                          \
+        return best;                                                                               \
+    }
+
+_DC_SCAN_SCALAR_KERNELS(uint8_t)
+_DC_SCAN_SCALAR_KERNELS(int8_t)
+_DC_SCAN_SCALAR_KERNELS(uint16_t)
+_DC_SCAN_SCALAR_KERNELS(int16_t)
+_DC_SCAN_SCALAR_KERNELS(uint32_t)
+_DC_SCAN_SCALAR_KERNELS(int32_t)
+_DC_SCAN_SCALAR_KERNELS(uint64_t)
+_DC_SCAN_SCALAR_KERNELS(int64_t)
+_DC_SCAN_SCALAR_KERNELS(float)
+_DC_SCAN_SCALAR_KERNELS(double)
+
+#pragma GCC diagnostic pop
+
+#if defined DC_SCAN_X86
+
+    // JUSTIFY: Byte masks for all lane widths
+    //  - `movemask_epi8` gives `sizeof(TYPE)` bits per matching lane, so the lane index is the
+    //    trailing zero count divided by `sizeof(TYPE)` (and likewise for the popcount).
+    #define _DC_SCAN_EQ_KERNELS(TYPE, ISA, TARGET, VEC, LOAD, SET1, EQ, MOVEMASK)                  \
+        DC_PUBLIC __attribute__((target(TARGET))) static size_t _dc_scan_##TYPE##_find_##ISA(      \
+            TYPE const* items, size_t count, TYPE value) {                                         \
+            size_t const lanes = sizeof(VEC) / sizeof(TYPE);                                       \
+            VEC const needle = SET1(value);                                                        \
+            size_t const vector_end = count - (count % lanes);                                     \
+            size_t i = 0;                                                                          \
+            for (; i < vector_end; i += lanes) {                                                   \
+                uint32_t const mask = (uint32_t)MOVEMASK(EQ(LOAD(&items[i]), needle));             \
+                if (mask != 0) {                                                                   \
+                    return i + ((size_t)__builtin_ctz(mask) / sizeof(TYPE));                       \
+                }                                                                                  \
+            }                                                                                      \
+            return _dc_scan_##TYPE##_find_scalar(items, i, count, value);                          \
+        }                                                                                          \
+        DC_PUBLIC __attribute__((target(TARGET))) static size_t _dc_scan_##TYPE##_count_##ISA(     \
+            TYPE const* items, size_t count, TYPE value) {                                         \
+            size_t const lanes = sizeof(VEC) / sizeof(TYPE);                                       \
+            VEC const needle = SET1(value);                                                        \
+            size_t matched_bytes = 0;                                                              \
+            size_t const vector_end = count - (count % lanes);                                     \
+            size_t i = 0;                                                                          \
+            for (; i < vector_end; i += lanes) {                                                   \
+                uint32_t const mask = (uint32_t)MOVEMASK(EQ(LOAD(&items[i]), needle));             \
+                matched_bytes += (size_t)__builtin_popcount(mask);                                 \
+            }                                                                                      \
+            return (matched_bytes / sizeof(TYPE)) +                                                \
+                   _dc_scan_##TYPE##_count_scalar(items, i, count, value);                         \
+        }
+
+    // JUSTIFY: Every lane starts from `items[0]`
+    //  - Matches the scalar loop for floats, a `NaN` is never selected unless it is `items[0]`.
+    #define _DC_SCAN_ORD_KERNELS(TYPE, ISA, TARGET, VEC, LOAD, SET1, LT, SELECT, STORE)            \
+        DC_PUBLIC __attribute__((target(TARGET))) static TYPE _dc_scan_##TYPE##_min_##ISA(         \
+            TYPE const* items, size_t count) {                                                     \
+            size_t const lanes = sizeof(VEC) / sizeof(TYPE);                                       \
+            VEC acc = SET1(items[0]);                                                              \
+            size_t const vector_end = count - (count % lanes);                                     \
+            size_t i = 0;                                                                          \
+            for (; i < vector_end; i += lanes) {                                                   \
+                VEC const next = LOAD(&items[i]);                                                  \
+                acc = SELECT(LT(next, acc), next, acc);                                            \
+            }                                                                                      \
+            TYPE lane_values[sizeof(VEC) / sizeof(TYPE)];                                          \
+            STORE(lane_values, acc);                                                               \
+            TYPE const best = _dc_scan_##TYPE##_min_scalar(lane_values, 0, lanes, items[0]);       \
+            return _dc_scan_##TYPE##_min_scalar(items, i, count, best);                            \
+        }                                                                                          \
+        DC_PUBLIC __attribute__((target(TARGET))) static TYPE _dc_scan_##TYPE##_max_##ISA(         \
+            TYPE const* items, size_t count) {                                                     \
+            size_t const lanes = sizeof(VEC) / sizeof(TYPE);                                       \
+            VEC acc = SET1(items[0]);                                                              \
+            size_t const vector_end = count - (count % lanes);                                     \
+            size_t i = 0;                                                                          \
+            for (; i < vector_end; i += lanes) {                                                   \
+                VEC const next = LOAD(&items[i]);                                                  \
+                acc = SELECT(LT(acc, next), next, acc);                                            \
+            }                                                                                      \
+            TYPE lane_values[sizeof(VEC) / sizeof(TYPE)];                                          \
+            STORE(lane_values, acc);                                                               \
+            TYPE const best = _dc_scan_##TYPE##_max_scalar(lane_values, 0, lanes, items[0]);       \
+            return _dc_scan_##TYPE##_max_scalar(items, i, count, best);                            \
+        }
+
+    // JUSTIFY: No SSE2 64 bit ordering
+    //  - 64 bit lane comparisons (`pcmpgtq`) are only available from SSE4.2.
+    #define _DC_SCAN_ORD_SCALAR_ONLY(TYPE, ISA)                                                    \
+        DC_PUBLIC static TYPE _dc_scan_##TYPE##_min_##ISA(TYPE const* items, size_t count) {       \
+            return _dc_scan_##TYPE##_min_scalar(items, 1, count, items[0]);                        \
+        }                                                                                          \
+        DC_PUBLIC static TYPE _dc_scan_##TYPE##_max_##ISA(TYPE const* items, size_t count) {       \
+            return _dc_scan_##TYPE##_max_scalar(items, 1, count, items[0]);                        \
+        }
+
+    // [DERIVE-C] AVX2 integer lanes
+    #define _DC_SCAN_AVX2_LOAD(ptr) _mm256_loadu_si256((__m256i const*)(ptr))
+    #define _DC_SCAN_AVX2_STORE(ptr, vec) _mm256_storeu_si256((__m256i*)(ptr), (vec))
+    #define _DC_SCAN_AVX2_SELECT(mask, a, b) _mm256_blendv_epi8((b), (a), (mask))
+    #define _DC_SCAN_AVX2_SET1_8(value) _mm256_set1_epi8((char)(value))
+    #define _DC_SCAN_AVX2_SET1_16(value) _mm256_set1_epi16((short)(value))
+    #define _DC_SCAN_AVX2_SET1_32(value) _mm256_set1_epi32((int)(value))
+    #define _DC_SCAN_AVX2_SET1_64(value) _mm256_set1_epi64x((long long)(value))
+    #define _DC_SCAN_AVX2_LT_I8(a, b) _mm256_cmpgt_epi8((b), (a))
+    #define _DC_SCAN_AVX2_LT_I16(a, b) _mm256_cmpgt_epi16((b), (a))
+    #define _DC_SCAN_AVX2_LT_I32(a, b) _mm256_cmpgt_epi32((b), (a))
+    #define _DC_SCAN_AVX2_LT_I64(a, b) _mm256_cmpgt_epi64((b), (a))
+    #define _DC_SCAN_AVX2_FLIP(vec, bits)                                                          \
+        _mm256_xor_si256((vec), _DC_SCAN_AVX2_SET1_##bits(INT##bits##_MIN))
+    #define _DC_SCAN_AVX2_LT_U8(a, b)                                                              \
+        _DC_SCAN_AVX2_LT_I8(_DC_SCAN_AVX2_FLIP(a, 8), _DC_SCAN_AVX2_FLIP(b, 8))
+    #define _DC_SCAN_AVX2_LT_U16(a, b)                                                             \
+        _DC_SCAN_AVX2_LT_I16(_DC_SCAN_AVX2_FLIP(a, 16), _DC_SCAN_AVX2_FLIP(b, 16))
+    #define _DC_SCAN_AVX2_LT_U32(a, b)                                                             \
+        _DC_SCAN_AVX2_LT_I32(_DC_SCAN_AVX2_FLIP(a, 32), _DC_SCAN_AVX2_FLIP(b, 32))
+    #define _DC_SCAN_AVX2_LT_U64(a, b)                                                             \
+        _DC_SCAN_AVX2_LT_I64(_DC_SCAN_AVX2_FLIP(a, 64), _DC_SCAN_AVX2_FLIP(b, 64))
+
+    // [DERIVE-C] AVX2 float lanes
+    #define _DC_SCAN_AVX2_EQ_PS(a, b) _mm256_castps_si256(_mm256_cmp_ps((a), (b), _CMP_EQ_OQ))
+    #define _DC_SCAN_AVX2_LT_PS(a, b) _mm256_cmp_ps((a), (b), _CMP_LT_OQ)
+    #define _DC_SCAN_AVX2_SELECT_PS(mask, a, b) _mm256_blendv_ps((b), (a), (mask))
+    #define _DC_SCAN_AVX2_EQ_PD(a, b) _mm256_castpd_si256(_mm256_cmp_pd((a), (b), _CMP_EQ_OQ))
+    #define _DC_SCAN_AVX2_LT_PD(a, b) _mm256_cmp_pd((a), (b), _CMP_LT_OQ)
+    #define _DC_SCAN_AVX2_SELECT_PD(mask, a, b) _mm256_blendv_pd((b), (a), (mask))
+
+    #define _DC_SCAN_AVX2_INT(TYPE, BITS, SIGN)                                                    \
+        _DC_SCAN_EQ_KERNELS(TYPE, avx2, "avx2,popcnt", __m256i, _DC_SCAN_AVX2_LOAD,                \
+                            _DC_SCAN_AVX2_SET1_##BITS, _mm256_cmpeq_epi##BITS,                     \
+                            _mm256_movemask_epi8)                                                  \
+        _DC_SCAN_ORD_KERNELS(TYPE, avx2, "avx2,popcnt", __m256i, _DC_SCAN_AVX2_LOAD,               \
+                             _DC_SCAN_AVX2_SET1_##BITS, _DC_SCAN_AVX2_LT_##SIGN##BITS,             \
+                             _DC_SCAN_AVX2_SELECT, _DC_SCAN_AVX2_STORE)
+
+_DC_SCAN_AVX2_INT(uint8_t, 8, U)
+_DC_SCAN_AVX2_INT(int8_t, 8, I)
+_DC_SCAN_AVX2_INT(uint16_t, 16, U)
+_DC_SCAN_AVX2_INT(int16_t, 16, I)
+_DC_SCAN_AVX2_INT(uint32_t, 32, U)
+_DC_SCAN_AVX2_INT(int32_t, 32, I)
+_DC_SCAN_AVX2_INT(uint64_t, 64, U)
+_DC_SCAN_AVX2_INT(int64_t, 64, I)
+
+_DC_SCAN_EQ_KERNELS(float, avx2, "avx2,popcnt", __m256, _mm256_loadu_ps, _mm256_set1_ps,
+                    _DC_SCAN_AVX2_EQ_PS, _mm256_movemask_epi8)
+_DC_SCAN_ORD_KERNELS(float, avx2, "avx2,popcnt", __m256, _mm256_loadu_ps, _mm256_set1_ps,
+                     _DC_SCAN_AVX2_LT_PS, _DC_SCAN_AVX2_SELECT_PS, _mm256_storeu_ps)
+_DC_SCAN_EQ_KERNELS(double, avx2, "avx2,popcnt", __m256d, _mm256_loadu_pd, _mm256_set1_pd,
+                    _DC_SCAN_AVX2_EQ_PD, _mm256_movemask_epi8)
+_DC_SCAN_ORD_KERNELS(double, avx2, "avx2,popcnt", __m256d, _mm256_loadu_pd, _mm256_set1_pd,
+                     _DC_SCAN_AVX2_LT_PD, _DC_SCAN_AVX2_SELECT_PD, _mm256_storeu_pd)
+
+    // [DERIVE-C] SSE2 integer lanes
+    #define _DC_SCAN_SSE2_LOAD(ptr) _mm_loadu_si128((__m128i const*)(ptr))
+    #define _DC_SCAN_SSE2_STORE(ptr, vec) _mm_storeu_si128((__m128i*)(ptr), (vec))
+    #define _DC_SCAN_SSE2_SELECT(mask, a, b)                                                       \
+        _mm_or_si128(_mm_and_si128((mask), (a)), _mm_andnot_si128((mask), (b)))
+    #define _DC_SCAN_SSE2_SET1_8(value) _mm_set1_epi8((char)(value))
+    #define _DC_SCAN_SSE2_SET1_16(value) _mm_set1_epi16((short)(value))
+    #define _DC_SCAN_SSE2_SET1_32(value) _mm_set1_epi32((int)(value))
+    #define _DC_SCAN_SSE2_SET1_64(value) _mm_set1_epi64x((long long)(value))
+    #define _DC_SCAN_SSE2_EQ_64(a, b) _DC_SCAN_SSE2_EQ_64_HALVES(_mm_cmpeq_epi32((a), (b)))
+    #define _DC_SCAN_SSE2_EQ_64_HALVES(eq)                                                         \
+        _mm_and_si128((eq), _mm_shuffle_epi32((eq), _MM_SHUFFLE(2, 3, 0, 1)))
+    #define _DC_SCAN_SSE2_LT_I8(a, b) _mm_cmplt_epi8((a), (b))
+    #define _DC_SCAN_SSE2_LT_I16(a, b) _mm_cmplt_epi16((a), (b))
+    #define _DC_SCAN_SSE2_LT_I32(a, b) _mm_cmplt_epi32((a), (b))
+    #define _DC_SCAN_SSE2_FLIP(vec, bits)                                                          \
+        _mm_xor_si128((vec), _DC_SCAN_SSE2_SET1_##bits(INT##bits##_MIN))
+    #define _DC_SCAN_SSE2_LT_U8(a, b)                                                              \
+        _DC_SCAN_SSE2_LT_I8(_DC_SCAN_SSE2_FLIP(a, 8), _DC_SCAN_SSE2_FLIP(b, 8))
+    #define _DC_SCAN_SSE2_LT_U16(a, b)                                                             \
+        _DC_SCAN_SSE2_LT_I16(_DC_SCAN_SSE2_FLIP(a, 16), _DC_SCAN_SSE2_FLIP(b, 16))
+    #define _DC_SCAN_SSE2_LT_U32(a, b)                                                             \
+        _DC_SCAN_SSE2_LT_I32(_DC_SCAN_SSE2_FLIP(a, 32), _DC_SCAN_SSE2_FLIP(b, 32))
+
+    // [DERIVE-C] SSE2 float lanes
+    #define _DC_SCAN_SSE2_EQ_PS(a, b) _mm_castps_si128(_mm_cmpeq_ps((a), (b)))
+    #define _DC_SCAN_SSE2_SELECT_PS(mask, a, b)                                                    \
+        _mm_or_ps(_mm_and_ps((mask), (a)), _mm_andnot_ps((mask), (b)))
+    #define _DC_SCAN_SSE2_EQ_PD(a, b) _mm_castpd_si128(_mm_cmpeq_pd((a), (b)))
+    #define _DC_SCAN_SSE2_SELECT_PD(mask, a, b)                                                    \
+        _mm_or_pd(_mm_and_pd((mask), (a)), _mm_andnot_pd((mask), (b)))
+
+    #define _DC_SCAN_SSE2_INT(TYPE, BITS, SIGN)                                                    \
+        _DC_SCAN_EQ_KERNELS(TYPE, sse2, "sse2", __m128i, _DC_SCAN_SSE2_LOAD,                       \
+                            _DC_SCAN_SSE2_SET1_##BITS, _mm_cmpeq_epi##BITS, _mm_movemask_epi8)     \
+        _DC_SCAN_ORD_KERNELS(TYPE, sse2, "sse2", __m128i, _DC_SCAN_SSE2_LOAD,                      \
+                             _DC_SCAN_SSE2_SET1_##BITS, _DC_SCAN_SSE2_LT_##SIGN##BITS,             \
+                             _DC_SCAN_SSE2_SELECT, _DC_SCAN_SSE2_STORE)
+
+_DC_SCAN_SSE2_INT(uint8_t, 8, U)
+_DC_SCAN_SSE2_INT(int8_t, 8, I)
+_DC_SCAN_SSE2_INT(uint16_t, 16, U)
+_DC_SCAN_SSE2_INT(int16_t, 16, I)
+_DC_SCAN_SSE2_INT(uint32_t, 32, U)
+_DC_SCAN_SSE2_INT(int32_t, 32, I)
+
+_DC_SCAN_EQ_KERNELS(uint64_t, sse2, "sse2", __m128i, _DC_SCAN_SSE2_LOAD, _DC_SCAN_SSE2_SET1_64,
+                    _DC_SCAN_SSE2_EQ_64, _mm_movemask_epi8)
+_DC_SCAN_ORD_SCALAR_ONLY(uint64_t, sse2)
+_DC_SCAN_EQ_KERNELS(int64_t, sse2, "sse2", __m128i, _DC_SCAN_SSE2_LOAD, _DC_SCAN_SSE2_SET1_64,
+                    _DC_SCAN_SSE2_EQ_64, _mm_movemask_epi8)
+_DC_SCAN_ORD_SCALAR_ONLY(int64_t, sse2)
+
+_DC_SCAN_EQ_KERNELS(float, sse2, "sse2", __m128, _mm_loadu_ps, _mm_set1_ps, _DC_SCAN_SSE2_EQ_PS,
+                    _mm_movemask_epi8)
+_DC_SCAN_ORD_KERNELS(float, sse2, "sse2", __m128, _mm_loadu_ps, _mm_set1_ps, _mm_cmplt_ps,
+                     _DC_SCAN_SSE2_SELECT_PS, _mm_storeu_ps)
+_DC_SCAN_EQ_KERNELS(double, sse2, "sse2", __m128d, _mm_loadu_pd, _mm_set1_pd, _DC_SCAN_SSE2_EQ_PD,
+                    _mm_movemask_epi8)
+_DC_SCAN_ORD_KERNELS(double, sse2, "sse2", __m128d, _mm_loadu_pd, _mm_set1_pd, _mm_cmplt_pd,
+                     _DC_SCAN_SSE2_SELECT_PD, _mm_storeu_pd)
+
+    #define _DC_SCAN_SELECT_ISA(TYPE, OP, ...)                                                     \
+        switch (dc_scan_isa_get()) {                                                               \
+        case DC_SCAN_ISA_AVX2:                                                                     \
+            return _dc_scan_##TYPE##_##OP##_avx2(__VA_ARGS__);                                     \
+        case DC_SCAN_ISA_SSE2:                                                                     \
+            return _dc_scan_##TYPE##_##OP##_sse2(__VA_ARGS__);                                     \
+        case DC_SCAN_ISA_SCALAR:                                                                   \
+            break;                                                                                 \
+        }
+#else
+    #define _DC_SCAN_SELECT_ISA(TYPE, OP, ...)
+#endif
+
+// JUSTIFY: Scalar for fewer items than an AVX2 vector
+//  - Avoids the runtime dispatch for tiny arrays, where it costs more than the scan.
+#define _DC_SCAN_MIN_VECTOR_ITEMS(TYPE) (32 / sizeof(TYPE))
+
+// JUSTIFY: Returning `0` when the best item is not found
+//  - Only occurs when the best is `NaN`, which is only kept when it is `items[0]`.
+#define _DC_SCAN_DISPATCH(TYPE)                                                                    \
+    DC_PUBLIC static size_t TYPE##_scan_find(TYPE const* items, size_t count, TYPE value) {        \
+        DC_ASSUME(items || count == 0);                                                            \
+        if (count >= _DC_SCAN_MIN_VECTOR_ITEMS(TYPE)) {                                            \
+            _DC_SCAN_SELECT_ISA(TYPE, find, items, count, value)                                   \
+        }                                                                                          \
+        return _dc_scan_##TYPE##_find_scalar(items, 0, count, value);                              \
+    }                                                                                              \
+    DC_PUBLIC static size_t TYPE##_scan_count(TYPE const* items, size_t count, TYPE value) {       \
+        DC_ASSUME(items || count == 0);                                                            \
+        if (count >= _DC_SCAN_MIN_VECTOR_ITEMS(TYPE)) {                                            \
+            _DC_SCAN_SELECT_ISA(TYPE, count, items, count, value)                                  \
+        }                                                                                          \
+        return _dc_scan_##TYPE##_count_scalar(items, 0, count, value);                             \
+    }                                                                                              \
+    DC_PUBLIC static TYPE _dc_scan_##TYPE##_min_value(TYPE const* items, size_t count) {           \
+        DC_ASSUME(count > 0);                                                                      \
+        if (count >= _DC_SCAN_MIN_VECTOR_ITEMS(TYPE)) {                                            \
+            _DC_SCAN_SELECT_ISA(TYPE, min, items, count)                                           \
+        }                                                                                          \
+        return _dc_scan_##TYPE##_min_scalar(items, 1, count, items[0]);                            \
+    }                                                                                              \
+    DC_PUBLIC static TYPE _dc_scan_##TYPE##_max_value(TYPE const* items, size_t count) {           \
+        DC_ASSUME(count > 0);                                                                      \
+        if (count >= _DC_SCAN_MIN_VECTOR_ITEMS(TYPE)) {                                            \
+            _DC_SCAN_SELECT_ISA(TYPE, max, items, count)                                           \
+        }                                                                                          \
+        return _dc_scan_##TYPE##_max_scalar(items, 1, count, items[0]);                            \
+    }                                                                                              \
+    DC_PUBLIC static size_t TYPE##_scan_min(TYPE const* items, size_t count) {                     \
+        DC_ASSUME(items || count == 0);                                                            \
+        if (count == 0) {                                                                          \
+            return 0;                                                                              \
+        }                                                                                          \
+        size_t const index =                                                                       \
+            TYPE##_scan_find(items, count, _dc_scan_##TYPE##_min_value(items, count));             \
+        return index == count ? 0 : index;                                                         \
+    }                                                                                              \
+    DC_PUBLIC static size_t TYPE##_scan_max(TYPE const* items, size_t count) {                     \
+        DC_ASSUME(items || count == 0);                                                            \
+        if (count == 0) {                                                                          \
+            return 0;                                                                              \
+        }                                                                                          \
+        size_t const index =                                                                       \
+            TYPE##_scan_find(items, count, _dc_scan_##TYPE##_max_value(items, count));             \
+        return index == count ? 0 : index;                                                         \
+    }
+
+_DC_SCAN_DISPATCH(uint8_t)
+_DC_SCAN_DISPATCH(int8_t)
+_DC_SCAN_DISPATCH(uint16_t)
+_DC_SCAN_DISPATCH(int16_t)
+_DC_SCAN_DISPATCH(uint32_t)
+_DC_SCAN_DISPATCH(int32_t)
+_DC_SCAN_DISPATCH(uint64_t)
+_DC_SCAN_DISPATCH(int64_t)
+_DC_SCAN_DISPATCH(float)
+_DC_SCAN_DISPATCH(double)
+
+/// Selects the `TYPE_scan_OP` kernel for the type pointed to by `ITEMS`, or `FALLBACK` for any
+/// other type, for use in templates.
+#if defined DC_GENERIC_KEYWORD_SUPPORTED
+    #define _DC_SCAN_KERNEL(OP, ITEMS, FALLBACK)                                                   \
+        _Generic((ITEMS),                                                                          \
+            uint8_t const*: uint8_t_scan_##OP,                                                     \
+            int8_t const*: int8_t_scan_##OP,                                                       \
+            uint16_t const*: uint16_t_scan_##OP,                                                   \
+            int16_t const*: int16_t_scan_##OP,                                                     \
+            uint32_t const*: uint32_t_scan_##OP,                                                   \
+            int32_t const*: int32_t_scan_##OP,                                                     \
+            uint64_t const*: uint64_t_scan_##OP,                                                   \
+            int64_t const*: int64_t_scan_##OP,                                                     \
+            float const*: float_scan_##OP,                                                         \
+            double const*: double_scan_##OP,                                                       \
+            default: FALLBACK)
+#else
+    #include <type_traits>
+
+namespace dc::scan {
+
+template <typename T> struct kernels {};
+
+    #define _DC_SCAN_CPP_KERNELS(TYPE)                                                             \
+        template <> struct kernels<TYPE> {                                                         \
+            static constexpr auto find = TYPE##_scan_find;                                         \
+            static constexpr auto count = TYPE##_scan_count;                                       \
+            static constexpr auto min = TYPE##_scan_min;                                           \
+            static constexpr auto max = TYPE##_scan_max;                                           \
+        };
+
+_DC_SCAN_CPP_KERNELS(uint8_t)
+_DC_SCAN_CPP_KERNELS(int8_t)
+_DC_SCAN_CPP_KERNELS(uint16_t)
+_DC_SCAN_CPP_KERNELS(int16_t)
+_DC_SCAN_CPP_KERNELS(uint32_t)
+_DC_SCAN_CPP_KERNELS(int32_t)
+_DC_SCAN_CPP_KERNELS(uint64_t)
+_DC_SCAN_CPP_KERNELS(int64_t)
+_DC_SCAN_CPP_KERNELS(float)
+_DC_SCAN_CPP_KERNELS(double)
+
+    #undef _DC_SCAN_CPP_KERNELS
+
+    #define _DC_SCAN_CPP_SELECT(OP)                                                                \
+        template <typename T, typename F> constexpr auto select_##OP(F fallback) {                 \
+            if constexpr (requires { kernels<T>::OP; }) {                                          \
+                return kernels<T>::OP;                                                             \
+            } else {                                                                               \
+                return fallback;                                                                   \
+            }                                                                                      \
+        }
+
+_DC_SCAN_CPP_SELECT(find)
+_DC_SCAN_CPP_SELECT(count)
+_DC_SCAN_CPP_SELECT(min)
+_DC_SCAN_CPP_SELECT(max)
+
+    #undef _DC_SCAN_CPP_SELECT
+
+} // namespace dc::scan
+
+    #define _DC_SCAN_KERNEL(OP, ITEMS, FALLBACK)                                                   \
+        ::dc::scan::select_##OP<std::remove_cvref_t<decltype(*(ITEMS))>>(FALLBACK)
+#endif
+
+#undef _DC_SCAN_DISPATCH
+#undef _DC_SCAN_MIN_VECTOR_ITEMS
+#undef _DC_SCAN_SELECT_ISA
+#undef _DC_SCAN_SCALAR_KERNELS
+#if defined DC_SCAN_X86
+    #undef _DC_SCAN_SSE2_INT
+    #undef _DC_SCAN_SSE2_SELECT_PD
+    #undef _DC_SCAN_SSE2_EQ_PD
+    #undef _DC_SCAN_SSE2_SELECT_PS
+    #undef _DC_SCAN_SSE2_EQ_PS
+    #undef _DC_SCAN_SSE2_LT_U32
+    #undef _DC_SCAN_SSE2_LT_U16
+    #undef _DC_SCAN_SSE2_LT_U8
+    #undef _DC_SCAN_SSE2_FLIP
+    #undef _DC_SCAN_SSE2_LT_I32
+    #undef _DC_SCAN_SSE2_LT_I16
+    #undef _DC_SCAN_SSE2_LT_I8
+    #undef _DC_SCAN_SSE2_EQ_64_HALVES
+    #undef _DC_SCAN_SSE2_EQ_64
+    #undef _DC_SCAN_SSE2_SET1_64
+    #undef _DC_SCAN_SSE2_SET1_32
+    #undef _DC_SCAN_SSE2_SET1_16
+    #undef _DC_SCAN_SSE2_SET1_8
+    #undef _DC_SCAN_SSE2_SELECT
+    #undef _DC_SCAN_SSE2_STORE
+    #undef _DC_SCAN_SSE2_LOAD
+    #undef _DC_SCAN_AVX2_INT
+    #undef _DC_SCAN_AVX2_SELECT_PD
+    #undef _DC_SCAN_AVX2_LT_PD
+    #undef _DC_SCAN_AVX2_EQ_PD
+    #undef _DC_SCAN_AVX2_SELECT_PS
+    #undef _DC_SCAN_AVX2_LT_PS
+    #undef _DC_SCAN_AVX2_EQ_PS
+    #undef _DC_SCAN_AVX2_LT_U64
+    #undef _DC_SCAN_AVX2_LT_U32
+    #undef _DC_SCAN_AVX2_LT_U16
+    #undef _DC_SCAN_AVX2_LT_U8
+    #undef _DC_SCAN_AVX2_FLIP
+    #undef _DC_SCAN_AVX2_LT_I64
+    #undef _DC_SCAN_AVX2_LT_I32
+    #undef _DC_SCAN_AVX2_LT_I16
+    #undef _DC_SCAN_AVX2_LT_I8
+    #undef _DC_SCAN_AVX2_SET1_64
+    #undef _DC_SCAN_AVX2_SET1_32
+    #undef _DC_SCAN_AVX2_SET1_16
+    #undef _DC_SCAN_AVX2_SET1_8
+    #undef _DC_SCAN_AVX2_SELECT
+    #undef _DC_SCAN_AVX2_STORE
+    #undef _DC_SCAN_AVX2_LOAD
+    #undef _DC_SCAN_ORD_SCALAR_ONLY
+    #undef _DC_SCAN_ORD_KERNELS
+    #undef _DC_SCAN_EQ_KERNELS
+#endif
@@ -0,0 +1,146 @@
+/// @brief Linear scans (find, count, contains, min and max) specialised for a single item type.
+///  - `ITEM_EQ(a, b)` for find, count and contains, and `ITEM_ORD(a, b)` (strict "less than") for
+///    min and max.
+///  - When these are left as the defaults, and the item is one of the std integer or float types,
+///    the vectorised kernels from `simd.h` are used (AVX2 or SSE2, selected at runtime).
+///  - Otherwise each falls back to a scalar loop over `ITEM_EQ` or `ITEM_ORD`.
+///
+/// Each returns an index into the items, or `count` when there is no such item. Operates on any
+/// contiguous items, e.g. `NS(VEC, data)(&vec)` and `NS(VEC, size)(&vec)`.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+
+typedef struct {
+    int x;
+} item_t;
+    #define ITEM item_t
+
+    #define ITEM_EQ item_eq
+static bool ITEM_EQ(item_t const* self_1, item_t const* self_2) { return self_1->x == self_2->x; }
+    #define ITEM_ORD item_ord
+static bool ITEM_ORD(item_t const* self_1, item_t const* self_2) { return self_1->x < self_2->x; }
+#endif
+
+#if !defined ITEM_EQ
+    #define ITEM_EQ DC_MEM_EQ
+    #define SIMD_EQ
+#endif
+
+#if !defined ITEM_ORD
+    #define ITEM_ORD DC_MEM_LT
+    #define SIMD_ORD
+#endif
+
+typedef ITEM NS(SELF, item_t);
+
+// JUSTIFY: No -Wfloat-equal
+//  - With the default `ITEM_EQ`, float items are compared exactly, as in the `simd.h` kernels.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+
+DC_PUBLIC static size_t PRIV(NS(SELF, find_scalar))(ITEM const* items, size_t count, ITEM value) {
+    for (size_t i = 0; i < count; i++) {
+        if (ITEM_EQ(&items[i], &value)) {
+            return i;
+        }
+    }
+    return count;
+}
+
+DC_PUBLIC static size_t PRIV(NS(SELF, count_scalar))(ITEM const* items, size_t count, ITEM value) {
+    size_t matches = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (ITEM_EQ(&items[i], &value)) {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+#pragma GCC diagnostic pop
+
+DC_PUBLIC static size_t PRIV(NS(SELF, min_scalar))(ITEM const* items, size_t count) {
+    size_t best = 0;
+    for (size_t i = 1; i < count; i++) {
+        if (ITEM_ORD(&items[i], &items[best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+DC_PUBLIC static size_t PRIV(NS(SELF, max_scalar))(ITEM const* items, size_t count) {
+    size_t best = 0;
+    for (size_t i = 1; i < count; i++) {
+        if (ITEM_ORD(&items[best], &items[i])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+DC_PUBLIC static size_t NS(SELF, find)(ITEM const* items, size_t count, ITEM value) {
+    DC_ASSUME(items || count == 0);
+#if defined SIMD_EQ
+    return _DC_SCAN_KERNEL(find, items, PRIV(NS(SELF, find_scalar)))(items, count, value);
+#else
+    return PRIV(NS(SELF, find_scalar))(items, count, value);
+#endif
+}
+
+DC_PUBLIC static size_t NS(SELF, count)(ITEM const* items, size_t count, ITEM value) {
+    DC_ASSUME(items || count == 0);
+#if defined SIMD_EQ
+    return _DC_SCAN_KERNEL(count, items, PRIV(NS(SELF, count_scalar)))(items, count, value);
+#else
+    return PRIV(NS(SELF, count_scalar))(items, count, value);
+#endif
+}
+
+DC_PUBLIC static bool NS(SELF, contains)(ITEM const* items, size_t count, ITEM value) {
+    return NS(SELF, find)(items, count, value) != count;
+}
+
+DC_PUBLIC static size_t NS(SELF, min)(ITEM const* items, size_t count) {
+    DC_ASSUME(items || count == 0);
+    if (count == 0) {
+        return count;
+    }
+#if defined SIMD_ORD
+    return _DC_SCAN_KERNEL(min, items, PRIV(NS(SELF, min_scalar)))(items, count);
+#else
+    return PRIV(NS(SELF, min_scalar))(items, count);
+#endif
+}
+
+DC_PUBLIC static size_t NS(SELF, max)(ITEM const* items, size_t count) {
+    DC_ASSUME(items || count == 0);
+    if (count == 0) {
+        return count;
+    }
+#if defined SIMD_ORD
+    return _DC_SCAN_KERNEL(max, items, PRIV(NS(SELF, max_scalar)))(items, count);
+#else
+    return PRIV(NS(SELF, max_scalar))(items, count);
+#endif
+}
+
+#undef SIMD_ORD
+#undef SIMD_EQ
+
+#undef ITEM_ORD
+#undef ITEM_EQ
+#undef ITEM
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/includes/undef.h>
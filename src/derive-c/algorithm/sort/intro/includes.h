@@ -0,0 +1,9 @@
+#pragma once
+
+// [DERIVE-C] stdlib includes
+#include <stdbool.h> // IWYU pragma: export
+#include <stddef.h>  // IWYU pragma: export
+#include <stdint.h>  // IWYU pragma: export
+
+// [DERIVE-C] lib includes
+#include <derive-c/core/prelude.h> // IWYU pragma: export
@@ -0,0 +1,232 @@
+/// @brief An in-place, unstable comparison sort specialised for a single item type.
+///  - `ITEM_ORD(a, b)` is a strict ordering, true when `a` should be placed before `b`. It is
+///    inlined into the sort, rather than called through a function pointer as with `qsort`.
+///    Defaults to `DC_MEM_LT`, and `NS(TYPE, lt)` from `DC_DERIVE_ORD` can be used for structs.
+///  - Introsort: quicksort with a median of three (or ninther) pivot, insertion sort for small
+///    ranges, and a heapsort fallback after `2 * log2(n)` levels, so the worst case is O(n log n).
+///  - As in pdqsort, a partition that moved no items is followed by an attempted (bounded)
+///    insertion sort of both sides, so sorted and nearly sorted input completes in O(n).
+///  - All scans are bounds checked, so an inconsistent `ITEM_ORD` can leave items unsorted, but
+///    never reads out of bounds.
+///
+/// Operates on any contiguous items, e.g. `NS(VEC, data)(&vec)` and `NS(VEC, size)(&vec)`.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+
+typedef struct {
+    int x;
+} item_t;
+    #define ITEM item_t
+
+    #define ITEM_ORD item_ord
+static bool ITEM_ORD(item_t const* self_1, item_t const* self_2) { return self_1->x < self_2->x; }
+#endif
+
+#if !defined ITEM_ORD
+    #define ITEM_ORD DC_MEM_LT
+#endif
+
+typedef ITEM NS(SELF, item_t);
+
+#define INSERTION_THRESHOLD 24
+#define NINTHER_THRESHOLD 128
+#define PARTIAL_INSERTION_LIMIT 8
+
+DC_PUBLIC static DC_INLINE void PRIV(NS(SELF, swap))(ITEM* DC_RESTRICT a, ITEM* DC_RESTRICT b) {
+    ITEM tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+DC_PUBLIC static DC_INLINE void PRIV(NS(SELF, sort2))(ITEM* items, size_t a, size_t b) {
+    if (ITEM_ORD(&items[b], &items[a])) {
+        PRIV(NS(SELF, swap))(&items[a], &items[b]);
+    }
+}
+
+/// Sorts the items at `a`, `b` and `c`, leaving the median at `b`.
+DC_PUBLIC static DC_INLINE void PRIV(NS(SELF, sort3))(ITEM* items, size_t a, size_t b, size_t c) {
+    PRIV(NS(SELF, sort2))(items, a, b);
+    PRIV(NS(SELF, sort2))(items, b, c);
+    PRIV(NS(SELF, sort2))(items, a, b);
+}
+
+DC_PUBLIC static void PRIV(NS(SELF, insertion_sort))(ITEM* items, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        if (!ITEM_ORD(&items[i], &items[i - 1])) {
+            continue;
+        }
+        ITEM tmp = items[i];
+        size_t j = i;
+        do {
+            items[j] = items[j - 1];
+            j--;
+        } while (j > 0 && ITEM_ORD(&tmp, &items[j - 1]));
+        items[j] = tmp;
+    }
+}
+
+/// An insertion sort that gives up once more than `PARTIAL_INSERTION_LIMIT` items have been
+/// moved, returning whether the items are now sorted.
+DC_PUBLIC static bool PRIV(NS(SELF, partial_insertion_sort))(ITEM* items, size_t count) {
+    size_t moved = 0;
+    for (size_t i = 1; i < count; i++) {
+        if (!ITEM_ORD(&items[i], &items[i - 1])) {
+            continue;
+        }
+        ITEM tmp = items[i];
+        size_t j = i;
+        do {
+            items[j] = items[j - 1];
+            j--;
+        } while (j > 0 && ITEM_ORD(&tmp, &items[j - 1]));
+        items[j] = tmp;
+
+        moved += i - j;
+        if (moved > PARTIAL_INSERTION_LIMIT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DC_PUBLIC static void PRIV(NS(SELF, sift_down))(ITEM* items, size_t root, size_t count) {
+    ITEM tmp = items[root];
+    for (;;) {
+        size_t child = (2 * root) + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && ITEM_ORD(&items[child], &items[child + 1])) {
+            child++;
+        }
+        if (!ITEM_ORD(&tmp, &items[child])) {
+            break;
+        }
+        items[root] = items[child];
+        root = child;
+    }
+    items[root] = tmp;
+}
+
+DC_PUBLIC static void PRIV(NS(SELF, heap_sort))(ITEM* items, size_t count) {
+    for (size_t i = count / 2; i > 0; i--) {
+        PRIV(NS(SELF, sift_down))(items, i - 1, count);
+    }
+    for (size_t end = count; end > 1; end--) {
+        PRIV(NS(SELF, swap))(&items[0], &items[end - 1]);
+        PRIV(NS(SELF, sift_down))(items, 0, end - 1);
+    }
+}
+
+/// Moves a pivot to `items[0]`, then partitions about it (Hoare style, stopping on items equal to
+/// the pivot so runs of duplicates are split evenly). Returns the final index of the pivot.
+DC_PUBLIC static size_t PRIV(NS(SELF, partition))(ITEM* items, size_t count,
+                                                  bool* already_partitioned) {
+    DC_ASSUME(count > INSERTION_THRESHOLD);
+    size_t const mid = count / 2;
+    if (count > NINTHER_THRESHOLD) {
+        PRIV(NS(SELF, sort3))(items, 0, mid, count - 1);
+        PRIV(NS(SELF, sort3))(items, 1, mid - 1, count - 2);
+        PRIV(NS(SELF, sort3))(items, 2, mid + 1, count - 3);
+        PRIV(NS(SELF, sort3))(items, mid - 1, mid, mid + 1);
+    } else {
+        PRIV(NS(SELF, sort3))(items, 0, mid, count - 1);
+    }
+    PRIV(NS(SELF, swap))(&items[0], &items[mid]);
+
+    ITEM const pivot = items[0];
+    size_t left = 0;
+    size_t right = count;
+    bool swapped = false;
+    for (;;) {
+        do {
+            left++;
+        } while (left < count && ITEM_ORD(&items[left], &pivot));
+        do {
+            right--;
+        } while (right > 0 && ITEM_ORD(&pivot, &items[right]));
+
+        if (left >= right) {
+            break;
+        }
+        PRIV(NS(SELF, swap))(&items[left], &items[right]);
+        swapped = true;
+    }
+
+    items[0] = items[right];
+    items[right] = pivot;
+    *already_partitioned = !swapped;
+    return right;
+}
+
+DC_PUBLIC static void PRIV(NS(SELF, introsort))(ITEM* items, size_t count, size_t depth_limit) {
+    while (count > INSERTION_THRESHOLD) {
+        if (depth_limit == 0) {
+            PRIV(NS(SELF, heap_sort))(items, count);
+            return;
+        }
+        depth_limit--;
+
+        bool already_partitioned;
+        size_t const pivot = PRIV(NS(SELF, partition))(items, count, &already_partitioned);
+        ITEM* const right = items + pivot + 1;
+        size_t const right_count = count - pivot - 1;
+
+        if (already_partitioned && PRIV(NS(SELF, partial_insertion_sort))(items, pivot) &&
+            PRIV(NS(SELF, partial_insertion_sort))(right, right_count)) {
+            return;
+        }
+
+        // JUSTIFY: Recurse on the smaller side
+        //  - Bounds the stack depth to O(log n), the larger side is handled by the loop.
+        if (pivot < right_count) {
+            PRIV(NS(SELF, introsort))(items, pivot, depth_limit);
+            items = right;
+            count = right_count;
+        } else {
+            PRIV(NS(SELF, introsort))(right, right_count, depth_limit);
+            count = pivot;
+        }
+    }
+    PRIV(NS(SELF, insertion_sort))(items, count);
+}
+
+DC_PUBLIC static void NS(SELF, sort)(ITEM* items, size_t count) {
+    DC_ASSUME(items || count == 0);
+    if (count < 2) {
+        return;
+    }
+    size_t const depth_limit = 2 * ((size_t)DC_MATH_MSB_INDEX((uint64_t)count) + 1);
+    PRIV(NS(SELF, introsort))(items, count, depth_limit);
+}
+
+DC_PUBLIC static bool NS(SELF, is_sorted)(ITEM const* items, size_t count) {
+    DC_ASSUME(items || count == 0);
+    for (size_t i = 1; i < count; i++) {
+        if (ITEM_ORD(&items[i], &items[i - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#undef PARTIAL_INSERTION_LIMIT
+#undef NINTHER_THRESHOLD
+#undef INSERTION_THRESHOLD
+
+#undef ITEM_ORD
+#undef ITEM
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,12 @@
+#pragma once
+
+// [DERIVE-C] stdlib includes
+#include <stdbool.h> // IWYU pragma: export
+#include <stddef.h>  // IWYU pragma: export
+#include <stdint.h>  // IWYU pragma: export
+#include <string.h>  // IWYU pragma: export
+
+// [DERIVE-C] lib includes
+#include <derive-c/algorithm/sort/radix/keys.h> // IWYU pragma: export
+#include <derive-c/core/prelude.h>              // IWYU pragma: export
+#include <derive-c/alloc/std.h>                 // IWYU pragma: export
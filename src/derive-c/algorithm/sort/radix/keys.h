@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <derive-c/core/prelude.h>
+
+/// Radix sort keys for the std numeric types.
+///  - Each maps a value to an unsigned integer of the same width, with the same ordering, for use
+///    as `ITEM_KEY` in a radix sort.
+///  - Signed integers have their sign bit flipped.
+///  - Floats have their sign bit flipped when positive, and all bits flipped when negative (so
+///    `-0.0` sorts before `0.0`, and NaNs sort before or after all numbers, by their sign).
+
+#define _DC_RADIX_KEY_UNSIGNED(TYPE, ...)                                                          \
+    DC_PUBLIC static DC_INLINE DC_CONST TYPE TYPE##_radix_key(TYPE value) { return value; }
+
+#define _DC_RADIX_KEY_SIGNED(TYPE, KEY_TYPE)                                                       \
+    DC_PUBLIC static DC_INLINE DC_CONST KEY_TYPE TYPE##_radix_key(TYPE value) {                    \
+        KEY_TYPE const sign = (KEY_TYPE)((KEY_TYPE)1 << ((sizeof(KEY_TYPE) * 8) - 1));             \
+        return (KEY_TYPE)((KEY_TYPE)value ^ sign);                                                 \
+    }
+
+#define _DC_RADIX_KEY_FLOAT(TYPE, KEY_TYPE)                                                        \
+    DC_PUBLIC static DC_INLINE KEY_TYPE TYPE##_radix_key(TYPE value) {                             \
+        KEY_TYPE bits;                                                                             \
+        memcpy(&bits, &value, sizeof(bits));                                                       \
+        KEY_TYPE const sign = (KEY_TYPE)((KEY_TYPE)1 << ((sizeof(KEY_TYPE) * 8) - 1));             \
+        return (bits & sign) ? (KEY_TYPE)~bits : (KEY_TYPE)(bits | sign);                          \
+    }
+
+_DC_RADIX_KEY_UNSIGNED(uint8_t)
+_DC_RADIX_KEY_UNSIGNED(uint16_t)
+_DC_RADIX_KEY_UNSIGNED(uint32_t)
+_DC_RADIX_KEY_UNSIGNED(uint64_t)
+_DC_RADIX_KEY_SIGNED(int8_t, uint8_t)
+_DC_RADIX_KEY_SIGNED(int16_t, uint16_t)
+_DC_RADIX_KEY_SIGNED(int32_t, uint32_t)
+_DC_RADIX_KEY_SIGNED(int64_t, uint64_t)
+_DC_RADIX_KEY_FLOAT(float, uint32_t)
+_DC_RADIX_KEY_FLOAT(double, uint64_t)
+
+#undef _DC_RADIX_KEY_FLOAT
+#undef _DC_RADIX_KEY_SIGNED
+#undef _DC_RADIX_KEY_UNSIGNED
@@ -0,0 +1,156 @@
+/// @brief A stable LSD radix sort, for items ordered by an unsigned integer key.
+///  - `KEY` is the unsigned integer key type (`uint8_t` to `uint64_t`), one 8 bit digit is sorted
+///    per byte of key.
+///  - `ITEM_KEY(item)` gets the key for an item pointer. Defaults to the item itself, and the
+///    `TYPE_radix_key` functions (e.g. `int32_t_radix_key`, `float_radix_key`) map signed and
+///    float values to order preserving unsigned keys.
+///  - O(n * sizeof(KEY)), with a counting pass for all digits, then one scatter pass per digit.
+///    Digits that are the same for every item are skipped.
+///  - Needs a scratch buffer of `count` items, either passed in, or allocated from `ALLOC`.
+///
+/// Operates on any contiguous items, e.g. `NS(VEC, data)(&vec)` and `NS(VEC, size)(&vec)`.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+
+typedef struct {
+    uint32_t key;
+    int value;
+} item_t;
+    #define ITEM item_t
+    #define KEY uint32_t
+    #define ITEM_KEY(item) ((item)->key)
+#endif
+
+#if !defined KEY
+    #define KEY ITEM
+#endif
+
+#if !defined ITEM_KEY
+    #define ITEM_KEY(item) (*(item))
+#endif
+
+DC_STATIC_ASSERT((KEY)(-1) > (KEY)0, "The radix sort KEY must be an unsigned integer");
+DC_STATIC_ASSERT(sizeof(KEY) <= sizeof(uint64_t), "The radix sort KEY must be at most 64 bits");
+
+typedef ITEM NS(SELF, item_t);
+typedef KEY NS(SELF, key_t);
+typedef ALLOC NS(SELF, alloc_t);
+
+#define DIGIT_BITS 8
+#define DIGIT_VALUES 256
+#define DIGITS sizeof(KEY)
+#define INSERTION_THRESHOLD 32
+
+DC_PUBLIC static DC_INLINE uint8_t PRIV(NS(SELF, digit))(KEY key, size_t digit) {
+    return (uint8_t)(key >> (digit * DIGIT_BITS));
+}
+
+/// For few items, a stable insertion sort by key is faster than the counting passes.
+DC_PUBLIC static void PRIV(NS(SELF, insertion_sort))(ITEM* items, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        KEY const key = ITEM_KEY(&items[i]);
+        if (!(key < ITEM_KEY(&items[i - 1]))) {
+            continue;
+        }
+        ITEM tmp = items[i];
+        size_t j = i;
+        do {
+            items[j] = items[j - 1];
+            j--;
+        } while (j > 0 && key < ITEM_KEY(&items[j - 1]));
+        items[j] = tmp;
+    }
+}
+
+/// Sorts the items, using `scratch` (which must not overlap `items`) for `count` items.
+DC_PUBLIC static void NS(SELF, sort_with_scratch)(ITEM* DC_RESTRICT items,
+                                                  ITEM* DC_RESTRICT scratch, size_t count) {
+    DC_ASSUME(items || count == 0);
+    if (count <= INSERTION_THRESHOLD) {
+        PRIV(NS(SELF, insertion_sort))(items, count);
+        return;
+    }
+    DC_ASSUME(scratch);
+
+    size_t counts[DIGITS][DIGIT_VALUES];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i < count; i++) {
+        KEY const key = ITEM_KEY(&items[i]);
+        for (size_t digit = 0; digit < DIGITS; digit++) {
+            counts[digit][PRIV(NS(SELF, digit))(key, digit)]++;
+        }
+    }
+
+    ITEM* from = items;
+    ITEM* to = scratch;
+    for (size_t digit = 0; digit < DIGITS; digit++) {
+        size_t* const digit_counts = counts[digit];
+        if (digit_counts[PRIV(NS(SELF, digit))(ITEM_KEY(&from[0]), digit)] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t value = 0; value < DIGIT_VALUES; value++) {
+            size_t const value_count = digit_counts[value];
+            digit_counts[value] = offset;
+            offset += value_count;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            to[digit_counts[PRIV(NS(SELF, digit))(ITEM_KEY(&from[i]), digit)]++] = from[i];
+        }
+
+        ITEM* const swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != items) {
+        memcpy(items, from, count * sizeof(ITEM));
+    }
+}
+
+DC_PUBLIC static void NS(SELF, sort)(ITEM* items, size_t count, NS(ALLOC, ref) alloc_ref) {
+    DC_ASSUME(items || count == 0);
+    if (count <= INSERTION_THRESHOLD) {
+        PRIV(NS(SELF, insertion_sort))(items, count);
+        return;
+    }
+    ITEM* scratch = (ITEM*)NS(ALLOC, allocate_uninit)(alloc_ref, count * sizeof(ITEM));
+    NS(SELF, sort_with_scratch)(items, scratch, count);
+    NS(ALLOC, deallocate)(alloc_ref, scratch, count * sizeof(ITEM));
+}
+
+DC_PUBLIC static bool NS(SELF, is_sorted)(ITEM const* items, size_t count) {
+    DC_ASSUME(items || count == 0);
+    for (size_t i = 1; i < count; i++) {
+        if (ITEM_KEY(&items[i]) < ITEM_KEY(&items[i - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#undef INSERTION_THRESHOLD
+#undef DIGITS
+#undef DIGIT_VALUES
+#undef DIGIT_BITS
+
+#undef ITEM_KEY
+#undef KEY
+#undef ITEM
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
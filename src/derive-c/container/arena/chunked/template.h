@@ -1,3 +1,9 @@
+/// @brief An arena of fixed size blocks, so entries are never moved.
+///
+/// An occupancy bitmap (a bit per index, over all blocks) is kept alongside the blocks, so
+/// iteration skips empty slots a word (64 slots) at a time, rather than reading the `present` flag
+/// of each.
+
 #include <derive-c/core/includes/def.h>
 #if !defined(SKIP_INCLUDES)
     #include "includes.h"
@@ -82,6 +88,10 @@ typedef struct {
     INDEX_TYPE block_current;
     INDEX_TYPE block_current_exclusive_end;
 
+    // INVARIANT: Bit `index` is set iff the slot at `index` is present, with a bit for every slot
+    //            of every block
+    uint64_t* occupied;
+
     NS(ALLOC, ref) alloc_ref;
     dc_gdb_marker derive_c_arena_basic;
     mutation_tracker iterator_invalidation_tracker;
@@ -89,6 +99,7 @@ typedef struct {
 
 #define INVARIANT_CHECK(self)                                                                      \
     DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->occupied);                                                                   \
     DC_ASSUME(((self))->count <= MAX_INDEX);                                                       \
     DC_ASSUME(((self)->block_current_exclusive_end) <=                                             \
               DC_ARENA_CHUNKED_BLOCK_SIZE(BLOCK_INDEX_BITS));                                      \
@@ -98,6 +109,14 @@ typedef struct {
                            (self)->block_current_exclusive_end)),                                  \
               "All slots are full if the free list is empty");
 
+#define OCCUPIED_WORDS(blocks)                                                                     \
+    DC_BITSET_WORDS_FOR_BITS((size_t)(blocks) * DC_ARENA_CHUNKED_BLOCK_SIZE(BLOCK_INDEX_BITS))
+
+#define EXCLUSIVE_END(self)                                                                        \
+    ((size_t)DC_ARENA_CHUNKED_BLOCK_OFFSET_TO_INDEX((size_t)(self)->block_current,                 \
+                                                    (self)->block_current_exclusive_end,           \
+                                                    BLOCK_INDEX_BITS))
+
 DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
     PRIV(NS(SELF, block))* first_block = (PRIV(NS(SELF, block))*)NS(ALLOC, allocate_uninit)(
         alloc_ref, sizeof(PRIV(NS(SELF, block))));
@@ -117,6 +136,8 @@ DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
         .blocks = blocks,
         .block_current = 0,
         .block_current_exclusive_end = 0,
+        .occupied = (uint64_t*)NS(ALLOC, allocate_zeroed)(alloc_ref,
+                                                          OCCUPIED_WORDS(1) * sizeof(uint64_t)),
         .alloc_ref = alloc_ref,
         .derive_c_arena_basic = dc_gdb_marker_new(),
         .iterator_invalidation_tracker = mutation_tracker_new(),
@@ -141,6 +162,7 @@ DC_PUBLIC static INDEX NS(SELF, insert)(SELF* self, VALUE value) {
         self->free_list = slot->next_free;
 
         NS(SLOT, fill)(slot, value);
+        dc_bitset_words_set(self->occupied, free_index);
 
         self->count++;
         return (INDEX){.index = free_index};
@@ -161,6 +183,15 @@ DC_PUBLIC static INDEX NS(SELF, insert)(SELF* self, VALUE value) {
 
         self->blocks[self->block_current] = new_block;
 
+        size_t const old_words = OCCUPIED_WORDS(self->block_current);
+        size_t const new_words = OCCUPIED_WORDS((size_t)self->block_current + 1);
+        if (new_words > old_words) {
+            self->occupied = (uint64_t*)NS(ALLOC, reallocate)(self->alloc_ref, self->occupied,
+                                                              old_words * sizeof(uint64_t),
+                                                              new_words * sizeof(uint64_t));
+            memset(&self->occupied[old_words], 0, (new_words - old_words) * sizeof(uint64_t));
+        }
+
         for (size_t offset = 0; offset < DC_ARENA_CHUNKED_BLOCK_SIZE(BLOCK_INDEX_BITS); offset++) {
             NS(SLOT, memory_tracker_empty)(&(*new_block)[offset]);
         }
@@ -171,6 +202,7 @@ DC_PUBLIC static INDEX NS(SELF, insert)(SELF* self, VALUE value) {
 
     INDEX_TYPE index = (INDEX_TYPE)DC_ARENA_CHUNKED_BLOCK_OFFSET_TO_INDEX(
         self->block_current, self->block_current_exclusive_end, BLOCK_INDEX_BITS);
+    dc_bitset_words_set(self->occupied, index);
     self->count++;
     self->block_current_exclusive_end++;
 
@@ -237,12 +269,18 @@ DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
         NS(SLOT, clone_from)(&(*from_current_block)[i], &(*to_current_block)[i]);
     }
 
+    size_t const words = OCCUPIED_WORDS((size_t)self->block_current + 1);
+    uint64_t* occupied =
+        (uint64_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref, words * sizeof(uint64_t));
+    memcpy(occupied, self->occupied, words * sizeof(uint64_t));
+
     return (SELF){
         .count = self->count,
         .free_list = self->free_list,
         .blocks = blocks,
         .block_current = self->block_current,
         .block_current_exclusive_end = self->block_current_exclusive_end,
+        .occupied = occupied,
         .alloc_ref = self->alloc_ref,
         .derive_c_arena_basic = dc_gdb_marker_new(),
         .iterator_invalidation_tracker = mutation_tracker_new(),
@@ -281,6 +319,7 @@ DC_PUBLIC static bool NS(SELF, try_remove)(SELF* self, INDEX index, VALUE* desti
         *destination = entry->value;
 
         NS(SLOT, set_empty)(entry, self->free_list);
+        dc_bitset_words_reset(self->occupied, index.index);
 
         self->free_list = index.index;
         self->count--;
@@ -299,24 +338,12 @@ DC_PUBLIC static VALUE NS(SELF, remove)(SELF* self, INDEX index) {
     return value;
 }
 
+/// The next present index from the `cursor`, or `INDEX_NONE` if there is none.
 DC_PUBLIC static INDEX_TYPE PRIV(NS(SELF, next_index_value))(SELF const* self,
-                                                             INDEX_TYPE from_index) {
-    for (INDEX_TYPE next_index = from_index + 1;; next_index++) {
-        INDEX_TYPE block = DC_ARENA_CHUNKED_INDEX_TO_BLOCK(next_index, BLOCK_INDEX_BITS);
-        INDEX_TYPE offset = DC_ARENA_CHUNKED_INDEX_TO_OFFSET(next_index, BLOCK_INDEX_BITS);
-
-        if (block > self->block_current ||
-            (block == self->block_current && offset >= self->block_current_exclusive_end)) {
-            return INDEX_NONE;
-        }
-
-        /* Fix wrong indexing: use &(*self->blocks[block])[offset] rather than
-           self->blocks[block][offset] which indexes by block-sized strides. */
-        SLOT* slot = &(*self->blocks[block])[offset];
-        if (slot->present) {
-            return next_index;
-        }
-    }
+                                                             dc_bitset_words_cursor* cursor) {
+    size_t const end = EXCLUSIVE_END(self);
+    size_t const index = dc_bitset_words_cursor_next(cursor, self->occupied, end);
+    return index == end ? INDEX_NONE : (INDEX_TYPE)index;
 }
 
 #define ITER NS(SELF, iter)
@@ -324,6 +351,7 @@ DC_PUBLIC static INDEX_TYPE PRIV(NS(SELF, next_index_value))(SELF const* self,
 
 typedef struct {
     SELF* arena;
+    dc_bitset_words_cursor cursor;
     INDEX_TYPE next_index;
     mutation_version version;
 } ITER;
@@ -360,29 +388,27 @@ DC_PUBLIC static IV_PAIR NS(ITER, next)(ITER* iter) {
         return NS(SELF, iv_empty)();
     }
 
-    INDEX index = {.index = iter->next_index};
+    // JUSTIFY: Reading the slot directly
+    //  - The occupancy bitmap only yields present indices, so the checks of `read` are redundant.
+    INDEX_TYPE block = DC_ARENA_CHUNKED_INDEX_TO_BLOCK(iter->next_index, BLOCK_INDEX_BITS);
+    INDEX_TYPE offset = DC_ARENA_CHUNKED_INDEX_TO_OFFSET(iter->next_index, BLOCK_INDEX_BITS);
     IV_PAIR result = (IV_PAIR){
-        .index = index,
-        .value = NS(SELF, write)(iter->arena, index),
+        .index = (INDEX){.index = iter->next_index},
+        .value = &(*iter->arena->blocks[block])[offset].value,
     };
 
-    iter->next_index = PRIV(NS(SELF, next_index_value))(iter->arena, iter->next_index);
+    iter->next_index = PRIV(NS(SELF, next_index_value))(iter->arena, &iter->cursor);
     return result;
 }
 
 DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
     INVARIANT_CHECK(self);
-
-    // Check if index 0 is present, otherwise find the next valid index
-    INDEX_TYPE first_index;
-    if (self->block_current_exclusive_end > 0 && (*self->blocks[0])[0].present) {
-        first_index = 0;
-    } else {
-        first_index = PRIV(NS(SELF, next_index_value))(self, 0);
-    }
+    dc_bitset_words_cursor cursor = dc_bitset_words_cursor_new(self->occupied, EXCLUSIVE_END(self));
+    INDEX_TYPE const first_index = PRIV(NS(SELF, next_index_value))(self, &cursor);
 
     return (ITER){
         .arena = self,
+        .cursor = cursor,
         .next_index = first_index,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
@@ -402,6 +428,8 @@ DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
     }
     NS(ALLOC, deallocate)(self->alloc_ref, (void*)self->blocks,
                           self->block_current * sizeof(PRIV(NS(SELF, block))*));
+    NS(ALLOC, deallocate)(self->alloc_ref, self->occupied,
+                          OCCUPIED_WORDS((size_t)self->block_current + 1) * sizeof(uint64_t));
 }
 
 #undef ITER_INVARIANT_CHECK
@@ -413,6 +441,7 @@ DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
 
 typedef struct {
     SELF const* arena;
+    dc_bitset_words_cursor cursor;
     INDEX_TYPE next_index;
     mutation_version version;
 } ITER_CONST;
@@ -451,29 +480,27 @@ DC_PUBLIC static IV_PAIR_CONST NS(ITER_CONST, next)(ITER_CONST* iter) {
         return NS(SELF, iv_const_empty)();
     }
 
-    INDEX index = {.index = iter->next_index};
+    // JUSTIFY: Reading the slot directly
+    //  - The occupancy bitmap only yields present indices, so the checks of `read` are redundant.
+    INDEX_TYPE block = DC_ARENA_CHUNKED_INDEX_TO_BLOCK(iter->next_index, BLOCK_INDEX_BITS);
+    INDEX_TYPE offset = DC_ARENA_CHUNKED_INDEX_TO_OFFSET(iter->next_index, BLOCK_INDEX_BITS);
     IV_PAIR_CONST result = (IV_PAIR_CONST){
-        .index = index,
-        .value = NS(SELF, read)(iter->arena, index),
+        .index = (INDEX){.index = iter->next_index},
+        .value = &(*iter->arena->blocks[block])[offset].value,
     };
 
-    iter->next_index = PRIV(NS(SELF, next_index_value))(iter->arena, iter->next_index);
+    iter->next_index = PRIV(NS(SELF, next_index_value))(iter->arena, &iter->cursor);
     return result;
 }
 
 DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
     INVARIANT_CHECK(self);
-
-    // Check if index 0 is present, otherwise find the next valid index
-    INDEX_TYPE first_index;
-    if (self->block_current_exclusive_end > 0 && (*self->blocks[0])[0].present) {
-        first_index = 0;
-    } else {
-        first_index = PRIV(NS(SELF, next_index_value))(self, 0);
-    }
+    dc_bitset_words_cursor cursor = dc_bitset_words_cursor_new(self->occupied, EXCLUSIVE_END(self));
+    INDEX_TYPE const first_index = PRIV(NS(SELF, next_index_value))(self, &cursor);
 
     return (ITER_CONST){
         .arena = self,
+        .cursor = cursor,
         .next_index = first_index,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
@@ -538,6 +565,8 @@ DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE*
 #undef IV_PAIR_CONST
 #undef ITER_CONST
 
+#undef EXCLUSIVE_END
+#undef OCCUPIED_WORDS
 #undef INVARIANT_CHECK
 #undef SLOT
 
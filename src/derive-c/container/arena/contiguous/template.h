@@ -1,4 +1,7 @@
 /// @brief A vector-backed arena, with support for small indices.
+///
+/// An occupancy bitmap (a bit per slot) is kept alongside the slots, so iteration skips empty
+/// slots a word (64 slots) at a time, rather than reading the `present` flag of each.
 
 #include <derive-c/core/includes/def.h>
 #if !defined(SKIP_INCLUDES)
@@ -45,15 +48,15 @@ DC_STATIC_ASSERT(sizeof(VALUE), "VALUE must be a non-zero sized type");
     #define VALUE_DEBUG DC_DEFAULT_DEBUG
 #endif
 
+#if !defined GROWTH_POLICY
+    #define GROWTH_POLICY dc_growth_double
+#endif
+
 #include <derive-c/core/index/bits_to_type/def.h>
 #include <derive-c/core/index/type_to_strong/def.h>
 
 #define CHECK_ACCESS_INDEX(self, index) ((index).index < (self)->exclusive_end)
 
-// JUSTIFY: Macro rather than static
-//           - Avoids the need to cast to the INDEX_TYPE
-#define RESIZE_FACTOR 2
-
 typedef VALUE NS(SELF, value_t);
 typedef ALLOC NS(SELF, alloc_t);
 
@@ -69,6 +72,8 @@ typedef ALLOC NS(SELF, alloc_t);
 
 typedef struct {
     SLOT* slots;
+    // INVARIANT: Bit `i` is set iff `slots[i]` is present, with `capacity` bits
+    uint64_t* occupied;
     size_t capacity;
     INDEX_TYPE free_list;
 
@@ -89,6 +94,7 @@ typedef struct {
 
 #define INVARIANT_CHECK(self)                                                                      \
     DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->occupied);                                                                   \
     DC_ASSUME((self)->count <= (self)->capacity);                                                  \
     DC_ASSUME((self)->exclusive_end >= (self)->count);                                             \
     DC_ASSUME((self)->count <= MAX_INDEX);
@@ -108,6 +114,8 @@ DC_PUBLIC static SELF NS(SELF, new_with_capacity_for)(INDEX_TYPE items, NS(ALLOC
 
     return (SELF){
         .slots = slots,
+        .occupied = (uint64_t*)NS(ALLOC, allocate_zeroed)(
+            alloc_ref, DC_BITSET_WORDS_FOR_BITS(capacity) * sizeof(uint64_t)),
         .capacity = (INDEX_TYPE)capacity,
         .free_list = INDEX_NONE,
         .exclusive_end = 0,
@@ -132,22 +140,38 @@ DC_PUBLIC static INDEX NS(SELF, insert)(SELF* self, VALUE value) {
 
         self->free_list = slot->next_free;
         NS(SLOT, fill)(slot, value);
+        dc_bitset_words_set(self->occupied, free_index);
 
         self->count++;
         return (INDEX){.index = free_index};
     }
 
     if (self->exclusive_end == self->capacity) {
-        DC_ASSERT(self->capacity <= (CAPACITY_EXCLUSIVE_UPPER / RESIZE_FACTOR),
+        DC_ASSERT(self->capacity < CAPACITY_EXCLUSIVE_UPPER,
                   "Cannot increase capacity for new item {capacity=%lu, max_capacity=%lu, item=%s}",
                   (size_t)self->capacity, (size_t)CAPACITY_EXCLUSIVE_UPPER,
                   DC_DEBUG(VALUE_DEBUG, &value));
+        size_t new_capacity = GROWTH_POLICY(self->capacity, self->capacity + 1);
+        DC_ASSERT(new_capacity > self->capacity,
+                  "Growth policy did not fit the required capacity {capacity=%lu, "
+                  "new_capacity=%lu}",
+                  (size_t)self->capacity, (size_t)new_capacity);
+        if (new_capacity > CAPACITY_EXCLUSIVE_UPPER) {
+            new_capacity = CAPACITY_EXCLUSIVE_UPPER;
+        }
         size_t old_size = self->capacity * sizeof(SLOT);
-        self->capacity *= RESIZE_FACTOR;
+        size_t const old_words = DC_BITSET_WORDS_FOR_BITS(self->capacity);
+        size_t const new_words = DC_BITSET_WORDS_FOR_BITS(new_capacity);
+        self->capacity = new_capacity;
         SLOT* new_alloc = (SLOT*)NS(ALLOC, reallocate)(self->alloc_ref, self->slots, old_size,
                                                        self->capacity * sizeof(SLOT));
         self->slots = new_alloc;
 
+        self->occupied = (uint64_t*)NS(ALLOC, reallocate)(self->alloc_ref, self->occupied,
+                                                          old_words * sizeof(uint64_t),
+                                                          new_words * sizeof(uint64_t));
+        memset(&self->occupied[old_words], 0, (new_words - old_words) * sizeof(uint64_t));
+
         for (size_t index = self->exclusive_end; index < self->capacity; index++) {
             NS(SLOT, memory_tracker_empty)(&self->slots[index]);
         }
@@ -156,6 +180,7 @@ DC_PUBLIC static INDEX NS(SELF, insert)(SELF* self, VALUE value) {
     INDEX_TYPE new_index = (INDEX_TYPE)self->exclusive_end;
     SLOT* slot = &self->slots[new_index];
     NS(SLOT, fill)(slot, value);
+    dc_bitset_words_set(self->occupied, new_index);
 
     self->count++;
     self->exclusive_end++;
@@ -206,8 +231,14 @@ DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
         NS(SLOT, clone_from)(&self->slots[index], &slots[index]);
     }
 
+    size_t const words = DC_BITSET_WORDS_FOR_BITS(self->capacity);
+    uint64_t* occupied =
+        (uint64_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref, words * sizeof(uint64_t));
+    memcpy(occupied, self->occupied, words * sizeof(uint64_t));
+
     return (SELF){
         .slots = slots,
+        .occupied = occupied,
         .capacity = self->capacity,
         .free_list = self->free_list,
         .exclusive_end = self->exclusive_end,
@@ -248,6 +279,7 @@ DC_PUBLIC static bool NS(SELF, try_remove)(SELF* self, INDEX index, VALUE* desti
         *destination = entry->value;
 
         NS(SLOT, set_empty)(entry, self->free_list);
+        dc_bitset_words_reset(self->occupied, index.index);
 
         self->free_list = index.index;
         self->count--;
@@ -284,6 +316,8 @@ DC_PUBLIC static bool NS(ITER, empty_item)(IV_PAIR const* item) { return item->v
 
 typedef struct {
     SELF* arena;
+    dc_bitset_words_cursor cursor;
+    // INVARIANT: A present entry, or the exclusive end (at most `MAX_INDEX`, so fits the type)
     INDEX_TYPE next_index;
     mutation_version version;
 } ITER;
@@ -293,46 +327,35 @@ DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
     mutation_version_check(&iter->version);
     // JUSTIFY: If no entries are left, then the previous '.._next' call moved
     //          the index to the exclusive end
-    // NOTE: `index + 1 > exclusive_end` implies `index >= exclusive_end`
-    return iter->next_index == INDEX_NONE || iter->next_index >= iter->arena->exclusive_end;
+    return iter->next_index >= iter->arena->exclusive_end;
 }
 
 DC_PUBLIC static IV_PAIR NS(ITER, next)(ITER* iter) {
     DC_ASSUME(iter);
     mutation_version_check(&iter->version);
 
-    while (iter->next_index < INDEX_NONE && iter->next_index < iter->arena->exclusive_end) {
-        IV_PAIR result = {
-            .index = (INDEX){.index = iter->next_index},
-            .value = &iter->arena->slots[iter->next_index].value,
-        };
-
-        iter->next_index++;
-        // advance to next present entry
-        while (iter->next_index < INDEX_NONE && iter->next_index < iter->arena->exclusive_end &&
-               !iter->arena->slots[iter->next_index].present) {
-            iter->next_index++;
-        }
-
-        if (result.value && result.value == &iter->arena->slots[result.index.index].value &&
-            iter->arena->slots[result.index.index].present) {
-            return result;
-        }
+    if (iter->next_index >= iter->arena->exclusive_end) {
+        return NS(SELF, iv_empty)();
     }
 
-    return NS(SELF, iv_empty)();
+    IV_PAIR result = {
+        .index = (INDEX){.index = iter->next_index},
+        .value = &iter->arena->slots[iter->next_index].value,
+    };
+    iter->next_index = (INDEX_TYPE)dc_bitset_words_cursor_next(
+        &iter->cursor, iter->arena->occupied, iter->arena->exclusive_end);
+    return result;
 }
 
 DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
     INVARIANT_CHECK(self);
-    INDEX_TYPE index = 0;
-    while (index < INDEX_NONE && index < self->exclusive_end && !self->slots[index].present) {
-        index++;
-    }
-
+    dc_bitset_words_cursor cursor = dc_bitset_words_cursor_new(self->occupied, self->exclusive_end);
+    INDEX_TYPE const first_index =
+        (INDEX_TYPE)dc_bitset_words_cursor_next(&cursor, self->occupied, self->exclusive_end);
     return (ITER){
         .arena = self,
-        .next_index = index,
+        .cursor = cursor,
+        .next_index = first_index,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
 }
@@ -347,6 +370,8 @@ DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
     }
 
     NS(ALLOC, deallocate)(self->alloc_ref, self->slots, self->capacity * sizeof(SLOT));
+    NS(ALLOC, deallocate)(self->alloc_ref, self->occupied,
+                          DC_BITSET_WORDS_FOR_BITS(self->capacity) * sizeof(uint64_t));
 }
 
 #undef ITER
@@ -374,6 +399,7 @@ DC_PUBLIC static bool NS(ITER_CONST, empty_item)(IV_PAIR_CONST const* item) {
 
 typedef struct {
     SELF const* arena;
+    dc_bitset_words_cursor cursor;
     INDEX_TYPE next_index;
     IV_PAIR_CONST curr;
     mutation_version version;
@@ -382,42 +408,35 @@ typedef struct {
 DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
     DC_ASSUME(iter);
     mutation_version_check(&iter->version);
-    return iter->next_index == INDEX_NONE || iter->next_index >= iter->arena->exclusive_end;
+    return iter->next_index >= iter->arena->exclusive_end;
 }
 
 DC_PUBLIC static IV_PAIR_CONST NS(ITER_CONST, next)(ITER_CONST* iter) {
     DC_ASSUME(iter);
     mutation_version_check(&iter->version);
 
-    while (iter->next_index < INDEX_NONE && iter->next_index < iter->arena->exclusive_end) {
-        IV_PAIR_CONST result = {
-            .index = (INDEX){.index = iter->next_index},
-            .value = &iter->arena->slots[iter->next_index].value,
-        };
-        iter->next_index++;
-        while (iter->next_index != INDEX_NONE && iter->next_index < iter->arena->exclusive_end &&
-               !iter->arena->slots[iter->next_index].present) {
-            iter->next_index++;
-        }
-
-        if (result.value && iter->arena->slots[result.index.index].present) {
-            return result;
-        }
+    if (iter->next_index >= iter->arena->exclusive_end) {
+        return NS(SELF, iv_const_empty)();
     }
 
-    return NS(SELF, iv_const_empty)();
+    IV_PAIR_CONST result = {
+        .index = (INDEX){.index = iter->next_index},
+        .value = &iter->arena->slots[iter->next_index].value,
+    };
+    iter->next_index = (INDEX_TYPE)dc_bitset_words_cursor_next(
+        &iter->cursor, iter->arena->occupied, iter->arena->exclusive_end);
+    return result;
 }
 
 DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
     INVARIANT_CHECK(self);
-    INDEX_TYPE index = 0;
-    while (index < INDEX_NONE && index < self->exclusive_end && !self->slots[index].present) {
-        index++;
-    }
-
+    dc_bitset_words_cursor cursor = dc_bitset_words_cursor_new(self->occupied, self->exclusive_end);
+    INDEX_TYPE const first_index =
+        (INDEX_TYPE)dc_bitset_words_cursor_next(&cursor, self->occupied, self->exclusive_end);
     return (ITER_CONST){
         .arena = self,
-        .next_index = index,
+        .cursor = cursor,
+        .next_index = first_index,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
 }
@@ -465,12 +484,12 @@ DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE*
 
 #undef INVARIANT_CHECK
 #undef SLOT
-#undef RESIZE_FACTOR
 #undef CHECK_ACCESS_INDEX
 
 #include <derive-c/core/index/type_to_strong/undef.h>
 #include <derive-c/core/index/bits_to_type/undef.h>
 
+#undef GROWTH_POLICY
 #undef VALUE_DEBUG
 #undef VALUE_CLONE
 #undef VALUE_DELETE
@@ -25,6 +25,10 @@
 /// | 10000000 |   128 |     128 |      0 |     5 |
 /// | 11111111 |   255 |         |    127 |     5 |
 ///
+/// As indices are contiguous over the blocks, an occupancy bitmap (a bit per index) is kept
+/// alongside them, so iteration skips empty slots a word (64 slots) at a time, rather than
+/// reading the `present` flag of each.
+///
 
 #include <derive-c/core/includes/def.h>
 #if !defined(SKIP_INCLUDES)
@@ -112,14 +116,31 @@ typedef struct {
     //  - We can have at most 63 blocks, as we can have 64 bit indices, with an initial 1 bit size.
     uint8_t block_current;
     SLOT* blocks[DC_ARENA_GEO_MAX_NUM_BLOCKS(INDEX_BITS, INITIAL_BLOCK_INDEX_BITS)];
+
+    // INVARIANT: Bit `index` is set iff the slot at `index` is present, with a bit for every slot
+    //            of every block
+    uint64_t* occupied;
 } SELF;
 
 #define INVARIANT_CHECK(self)                                                                      \
     DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->occupied);                                                                   \
     DC_ASSUME(DC_ARENA_GEO_BLOCK_TO_SIZE((self)->block_current, INITIAL_BLOCK_INDEX_BITS) >=       \
               (self)->block_current_exclusive_end);                                                \
     DC_ASSUME((self)->count <= MAX_INDEX);
 
+// JUSTIFY: Bitmap sized by the blocks allocated
+//  - The blocks up to and including `block` hold exactly the indices below the end of `block`.
+#define OCCUPIED_WORDS(block)                                                                      \
+    DC_BITSET_WORDS_FOR_BITS(DC_ARENA_GEO_BLOCK_OFFSET_TO_INDEX(                                   \
+        (size_t)(block), DC_ARENA_GEO_BLOCK_TO_SIZE((size_t)(block), INITIAL_BLOCK_INDEX_BITS),    \
+        INITIAL_BLOCK_INDEX_BITS))
+
+#define EXCLUSIVE_END(self)                                                                        \
+    ((size_t)DC_ARENA_GEO_BLOCK_OFFSET_TO_INDEX((size_t)(self)->block_current,                     \
+                                                (self)->block_current_exclusive_end,               \
+                                                INITIAL_BLOCK_INDEX_BITS))
+
 DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
     uint8_t initial_block = 0;
     size_t initial_block_items =
@@ -139,6 +160,8 @@ DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
             {
                 initial_block_slots,
             },
+        .occupied = (uint64_t*)NS(ALLOC, allocate_zeroed)(
+            alloc_ref, OCCUPIED_WORDS(initial_block) * sizeof(uint64_t)),
     };
 
     return self;
@@ -163,6 +186,7 @@ DC_PUBLIC static INDEX NS(SELF, insert)(SELF* self, VALUE value) {
         self->free_list = free_slot->next_free;
 
         NS(SLOT, fill)(free_slot, value);
+        dc_bitset_words_set(self->occupied, free_index);
 
         self->count++;
 
@@ -181,12 +205,22 @@ DC_PUBLIC static INDEX NS(SELF, insert)(SELF* self, VALUE value) {
 
         self->blocks[self->block_current] = block_slots;
         self->block_current_exclusive_end = 0;
+
+        size_t const old_words = OCCUPIED_WORDS(self->block_current - 1);
+        size_t const new_words = OCCUPIED_WORDS(self->block_current);
+        if (new_words > old_words) {
+            self->occupied = (uint64_t*)NS(ALLOC, reallocate)(self->alloc_ref, self->occupied,
+                                                              old_words * sizeof(uint64_t),
+                                                              new_words * sizeof(uint64_t));
+            memset(&self->occupied[old_words], 0, (new_words - old_words) * sizeof(uint64_t));
+        }
     }
 
     size_t offset = self->block_current_exclusive_end;
     NS(SLOT, fill)(&self->blocks[self->block_current][offset], value);
     INDEX_TYPE new_index = (INDEX_TYPE)(DC_ARENA_GEO_BLOCK_OFFSET_TO_INDEX(
         self->block_current, offset, INITIAL_BLOCK_INDEX_BITS));
+    dc_bitset_words_set(self->occupied, new_index);
 
     self->block_current_exclusive_end++;
     self->count++;
@@ -249,7 +283,11 @@ DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
         .block_current_exclusive_end = self->block_current_exclusive_end,
         .block_current = self->block_current,
         .blocks = {},
+        .occupied = (uint64_t*)NS(ALLOC, allocate_uninit)(
+            self->alloc_ref, OCCUPIED_WORDS(self->block_current) * sizeof(uint64_t)),
     };
+    memcpy(new_self.occupied, self->occupied,
+           OCCUPIED_WORDS(self->block_current) * sizeof(uint64_t));
 
     for (size_t block_index = 0; block_index <= self->block_current; block_index++) {
         size_t block_items = DC_ARENA_GEO_BLOCK_TO_SIZE(block_index, INITIAL_BLOCK_INDEX_BITS);
@@ -290,6 +328,7 @@ DC_PUBLIC static bool NS(SELF, try_remove)(SELF* self, INDEX index, VALUE* desti
         *destination = slot->value;
 
         NS(SLOT, set_empty)(slot, self->free_list);
+        dc_bitset_words_reset(self->occupied, index.index);
         self->free_list = index.index;
         self->count--;
         return true;
@@ -310,18 +349,19 @@ DC_PUBLIC static VALUE NS(SELF, remove)(SELF* self, INDEX index) {
 DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
     INVARIANT_CHECK(self);
 
-    for (uint8_t block = 0; block <= self->block_current; block++) {
-        size_t const to_offset = block == self->block_current
-                                     ? self->block_current_exclusive_end
-                                     : DC_ARENA_GEO_BLOCK_TO_SIZE(block, INITIAL_BLOCK_INDEX_BITS);
+    size_t const end = EXCLUSIVE_END(self);
+    dc_bitset_words_cursor cursor = dc_bitset_words_cursor_new(self->occupied, end);
+    for (size_t index = dc_bitset_words_cursor_next(&cursor, self->occupied, end); index < end;
+         index = dc_bitset_words_cursor_next(&cursor, self->occupied, end)) {
+        uint8_t block = DC_ARENA_GEO_INDEX_TO_BLOCK(index, INITIAL_BLOCK_INDEX_BITS);
+        size_t offset = DC_ARENA_GEO_INDEX_TO_OFFSET(index, block, INITIAL_BLOCK_INDEX_BITS);
+        VALUE_DELETE(&self->blocks[block][offset].value);
+    }
 
-        for (size_t offset = 0; offset < to_offset; offset++) {
-            SLOT* slot = &self->blocks[block][offset];
-            if (slot->present) {
-                VALUE_DELETE(&slot->value);
-            }
-        }
+    NS(ALLOC, deallocate)(self->alloc_ref, self->occupied,
+                          OCCUPIED_WORDS(self->block_current) * sizeof(uint64_t));
 
+    for (uint8_t block = 0; block <= self->block_current; block++) {
         size_t block_size =
             DC_ARENA_GEO_BLOCK_TO_SIZE(block, INITIAL_BLOCK_INDEX_BITS) * sizeof(SLOT);
         dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE,
@@ -352,6 +392,8 @@ DC_PUBLIC static bool NS(ITER_CONST, empty_item)(IV_PAIR_CONST const* item) {
 
 typedef struct {
     SELF const* arena;
+    dc_bitset_words_cursor cursor;
+    // INVARIANT: A present entry, or the exclusive end (at most `MAX_INDEX`, so fits the type)
     INDEX_TYPE next_index;
     mutation_version version;
 } ITER_CONST;
@@ -360,67 +402,39 @@ DC_PUBLIC static IV_PAIR_CONST NS(ITER_CONST, next)(ITER_CONST* iter) {
     DC_ASSUME(iter);
     mutation_version_check(&iter->version);
 
-    while (iter->next_index < MAX_INDEX) {
-        uint8_t block = DC_ARENA_GEO_INDEX_TO_BLOCK(iter->next_index, INITIAL_BLOCK_INDEX_BITS);
-        size_t offset =
-            DC_ARENA_GEO_INDEX_TO_OFFSET(iter->next_index, block, INITIAL_BLOCK_INDEX_BITS);
-
-        if ((block == iter->arena->block_current &&
-             offset >= iter->arena->block_current_exclusive_end) ||
-            (block > iter->arena->block_current)) {
-            break;
-        }
-
-        SLOT* slot = &iter->arena->blocks[block][offset];
-        if (slot->present) {
-            IV_PAIR_CONST const result = {
-                .index = (INDEX){.index = iter->next_index},
-                .value = &slot->value,
-            };
-            iter->next_index++;
-            return result;
-        }
-
-        iter->next_index++;
+    size_t const end = EXCLUSIVE_END(iter->arena);
+    if (iter->next_index >= end) {
+        return NS(SELF, iv_const_empty)();
     }
 
-    return NS(SELF, iv_const_empty)();
+    uint8_t block = DC_ARENA_GEO_INDEX_TO_BLOCK(iter->next_index, INITIAL_BLOCK_INDEX_BITS);
+    size_t offset = DC_ARENA_GEO_INDEX_TO_OFFSET(iter->next_index, block, INITIAL_BLOCK_INDEX_BITS);
+    IV_PAIR_CONST const result = {
+        .index = (INDEX){.index = iter->next_index},
+        .value = &iter->arena->blocks[block][offset].value,
+    };
+    iter->next_index =
+        (INDEX_TYPE)dc_bitset_words_cursor_next(&iter->cursor, iter->arena->occupied, end);
+    return result;
 }
 
 DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
     DC_ASSUME(iter);
     mutation_version_check(&iter->version);
-
-    // Scan forward to see if there are any present slots remaining
-    INDEX_TYPE search_index = iter->next_index;
-    while (search_index < MAX_INDEX) {
-        uint8_t block = DC_ARENA_GEO_INDEX_TO_BLOCK(search_index, INITIAL_BLOCK_INDEX_BITS);
-        size_t offset = DC_ARENA_GEO_INDEX_TO_OFFSET(search_index, block, INITIAL_BLOCK_INDEX_BITS);
-
-        // Check if we're past the valid range
-        if ((block == iter->arena->block_current &&
-             offset >= iter->arena->block_current_exclusive_end) ||
-            (block > iter->arena->block_current)) {
-            return true;
-        }
-
-        SLOT* slot = &iter->arena->blocks[block][offset];
-        if (slot->present) {
-            return false;
-        }
-
-        search_index++;
-    }
-
-    return true;
+    return iter->next_index >= EXCLUSIVE_END(iter->arena);
 }
 
 DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
     INVARIANT_CHECK(self);
+    size_t const end = EXCLUSIVE_END(self);
+    dc_bitset_words_cursor cursor = dc_bitset_words_cursor_new(self->occupied, end);
+    INDEX_TYPE const first_index =
+        (INDEX_TYPE)dc_bitset_words_cursor_next(&cursor, self->occupied, end);
 
     return (ITER_CONST){
         .arena = self,
-        .next_index = 0,
+        .cursor = cursor,
+        .next_index = first_index,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
 }
@@ -513,6 +527,8 @@ DC_PUBLIC static bool NS(ITER, empty_item)(IV_PAIR const* item) { return item->v
 
 typedef struct {
     SELF* arena;
+    dc_bitset_words_cursor cursor;
+    // INVARIANT: A present entry, or the exclusive end (at most `MAX_INDEX`, so fits the type)
     INDEX_TYPE next_index;
     mutation_version version;
 } ITER;
@@ -521,73 +537,47 @@ DC_PUBLIC static IV_PAIR NS(ITER, next)(ITER* iter) {
     DC_ASSUME(iter);
     mutation_version_check(&iter->version);
 
-    while (iter->next_index < MAX_INDEX) {
-        uint8_t block = DC_ARENA_GEO_INDEX_TO_BLOCK(iter->next_index, INITIAL_BLOCK_INDEX_BITS);
-        size_t offset =
-            DC_ARENA_GEO_INDEX_TO_OFFSET(iter->next_index, block, INITIAL_BLOCK_INDEX_BITS);
-
-        if ((block == iter->arena->block_current &&
-             offset >= iter->arena->block_current_exclusive_end) ||
-            (block > iter->arena->block_current)) {
-            break;
-        }
-
-        SLOT* slot = &iter->arena->blocks[block][offset];
-        if (slot->present) {
-            IV_PAIR result = {
-                .index = (INDEX){.index = iter->next_index},
-                .value = &slot->value,
-            };
-            iter->next_index++;
-            return result;
-        }
-
-        iter->next_index++;
+    size_t const end = EXCLUSIVE_END(iter->arena);
+    if (iter->next_index >= end) {
+        return NS(SELF, iv_empty)();
     }
 
-    return NS(SELF, iv_empty)();
+    uint8_t block = DC_ARENA_GEO_INDEX_TO_BLOCK(iter->next_index, INITIAL_BLOCK_INDEX_BITS);
+    size_t offset = DC_ARENA_GEO_INDEX_TO_OFFSET(iter->next_index, block, INITIAL_BLOCK_INDEX_BITS);
+    IV_PAIR result = {
+        .index = (INDEX){.index = iter->next_index},
+        .value = &iter->arena->blocks[block][offset].value,
+    };
+    iter->next_index =
+        (INDEX_TYPE)dc_bitset_words_cursor_next(&iter->cursor, iter->arena->occupied, end);
+    return result;
 }
 
 DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
     DC_ASSUME(iter);
     mutation_version_check(&iter->version);
-
-    // Scan forward to see if there are any present slots remaining
-    INDEX_TYPE search_index = iter->next_index;
-    while (search_index < MAX_INDEX) {
-        uint8_t block = DC_ARENA_GEO_INDEX_TO_BLOCK(search_index, INITIAL_BLOCK_INDEX_BITS);
-        size_t offset = DC_ARENA_GEO_INDEX_TO_OFFSET(search_index, block, INITIAL_BLOCK_INDEX_BITS);
-
-        // Check if we're past the valid range
-        if ((block == iter->arena->block_current &&
-             offset >= iter->arena->block_current_exclusive_end) ||
-            (block > iter->arena->block_current)) {
-            return true;
-        }
-
-        SLOT* slot = &iter->arena->blocks[block][offset];
-        if (slot->present) {
-            return false;
-        }
-
-        search_index++;
-    }
-
-    return true;
+    return iter->next_index >= EXCLUSIVE_END(iter->arena);
 }
 
 DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
     INVARIANT_CHECK(self);
+    size_t const end = EXCLUSIVE_END(self);
+    dc_bitset_words_cursor cursor = dc_bitset_words_cursor_new(self->occupied, end);
+    INDEX_TYPE const first_index =
+        (INDEX_TYPE)dc_bitset_words_cursor_next(&cursor, self->occupied, end);
 
     return (ITER){
         .arena = self,
-        .next_index = 0,
+        .cursor = cursor,
+        .next_index = first_index,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
 }
 
 #undef ITER
 #undef IV_PAIR
+#undef EXCLUSIVE_END
+#undef OCCUPIED_WORDS
 #undef INVARIANT_CHECK
 #undef SLOT
 #undef INITIAL_BLOCK_INDEX_BITS
@@ -0,0 +1,342 @@
+/// @brief A bitset for indexes `[0, EXCLUSIVE_END_INDEX)`, statically allocated, that threads can
+/// set, clear and claim indices of concurrently without a lock.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/self/def.h>
+
+#if !defined EXCLUSIVE_END_INDEX
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("no EXCLUSIVE_END_INDEX")
+    #endif
+    #define EXCLUSIVE_END_INDEX 32
+#endif
+
+DC_STATIC_ASSERT(
+    EXCLUSIVE_END_INDEX > 0,
+    DC_EXPAND_STRING(SELF) " EXCLUSIVE_END_INDEX must be larger than 0 for nonempty bitset");
+
+#define INDICES_CAPACITY EXCLUSIVE_END_INDEX
+
+#include <derive-c/core/index/capacity_to_bits/def.h>
+#include <derive-c/core/index/bits_to_type/def.h>
+
+typedef INDEX_TYPE NS(SELF, index_t);
+
+DC_STATIC_CONSTANT INDEX_TYPE NS(SELF, max_index) = EXCLUSIVE_END_INDEX - 1;
+DC_STATIC_CONSTANT INDEX_TYPE NS(SELF, min_index) = 0;
+
+/// Returned by `claim_first_clear` when every index is set.
+DC_STATIC_CONSTANT size_t NS(SELF, exclusive_end_index) = EXCLUSIVE_END_INDEX;
+
+#define WORDS DC_BITSET_STATIC_CAPACITY_TO_WORDS(EXCLUSIVE_END_INDEX)
+
+// JUSTIFY: A mask of the indices in the last word
+//  - Bits past the `EXCLUSIVE_END_INDEX` are never set, so must not be claimed.
+#if EXCLUSIVE_END_INDEX % 64 == 0
+    #define LAST_WORD_MASK (~(uint64_t)0)
+#else
+    #define LAST_WORD_MASK (DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(EXCLUSIVE_END_INDEX % 64) - 1)
+#endif
+
+// JUSTIFY: Words accessed with the `__atomic` builtins
+//  - Rather than `_Atomic uint64_t`, which is not available in C++, where the templates are also
+//    instantiated.
+// JUSTIFY: No iterator invalidation tracker
+//  - Threads are expected to mutate concurrently with iteration (e.g. a monitor walking the
+//    claimed indices), and the tracker is not atomic.
+//  - Each word is loaded once by an iterator, so each index is seen as it was at that load.
+typedef struct {
+    uint64_t words[WORDS];
+    dc_gdb_marker derive_c_bitset_atomic;
+} SELF;
+
+#define INVARIANT_CHECK(self) DC_ASSUME(self);
+
+// JUSTIFY: Acquire loads, and acquire-release read-modify-writes
+//  - So a thread claiming an index sees the writes made by the thread that released it, before it
+//    was released. For example, to the slot of a pool the index refers to.
+
+DC_PUBLIC static SELF NS(SELF, new)() {
+    return (SELF){
+        .words = {},
+        .derive_c_bitset_atomic = dc_gdb_marker_new(),
+    };
+}
+
+/// Sets `index` to `value`, returning its previous value.
+#define UPDATE NS(SELF, update)
+static bool PRIV(UPDATE)(SELF* self, INDEX_TYPE index, bool value) {
+    INVARIANT_CHECK(self);
+    size_t word = DC_BITSET_STATIC_INDEX_TO_WORDS((size_t)index);
+    uint64_t mask =
+        DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index));
+
+    if (value) {
+        return (__atomic_fetch_or(&self->words[word], mask, __ATOMIC_ACQ_REL) & mask) != 0;
+    }
+    return (__atomic_fetch_and(&self->words[word], ~mask, __ATOMIC_ACQ_REL) & mask) != 0;
+}
+
+DC_PUBLIC static bool NS(SELF, try_set)(SELF* self, INDEX_TYPE index, bool value) {
+    INVARIANT_CHECK(self);
+
+    // JUSTIFY: Only checking if the end index could be smaller than max
+    //  - As for the static bitset, if the index type cannot represent the end index, every index
+    //    is in bounds.
+#if EXCLUSIVE_END_INDEX <= MAX_INDEX
+    if (index >= EXCLUSIVE_END_INDEX) {
+        return false;
+    }
+#endif
+
+    PRIV(UPDATE)(self, index, value);
+    return true;
+}
+
+DC_PUBLIC static void NS(SELF, set)(SELF* self, INDEX_TYPE index, bool value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(NS(SELF, try_set)(self, index, value),
+              "Failed to set index {index=%lu, value=%d, exclusive_end_index=%lu}", (size_t)index,
+              value, (size_t)EXCLUSIVE_END_INDEX);
+}
+
+DC_PUBLIC static bool NS(SELF, get)(SELF const* self, INDEX_TYPE index) {
+    INVARIANT_CHECK(self);
+
+#if EXCLUSIVE_END_INDEX <= MAX_INDEX
+    DC_ASSERT(index < EXCLUSIVE_END_INDEX,
+              "Index out of bounds {index=%lu, exclusive_end_index=%lu}", (size_t)index,
+              (size_t)EXCLUSIVE_END_INDEX);
+#endif
+
+    size_t word = DC_BITSET_STATIC_INDEX_TO_WORDS((size_t)index);
+    uint64_t mask =
+        DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index));
+    return (__atomic_load_n(&self->words[word], __ATOMIC_ACQUIRE) & mask) != 0;
+}
+
+/// Sets `index`, returning whether it was already set. So only the thread for which this returns
+/// `false` has claimed the index.
+DC_PUBLIC static bool NS(SELF, test_and_set)(SELF* self, INDEX_TYPE index) {
+    INVARIANT_CHECK(self);
+#if EXCLUSIVE_END_INDEX <= MAX_INDEX
+    DC_ASSERT(index < EXCLUSIVE_END_INDEX,
+              "Index out of bounds {index=%lu, exclusive_end_index=%lu}", (size_t)index,
+              (size_t)EXCLUSIVE_END_INDEX);
+#endif
+    return PRIV(UPDATE)(self, index, true);
+}
+
+/// Clears `index`, returning whether it was set. So only the thread for which this returns `true`
+/// has released the index.
+DC_PUBLIC static bool NS(SELF, test_and_clear)(SELF* self, INDEX_TYPE index) {
+    INVARIANT_CHECK(self);
+#if EXCLUSIVE_END_INDEX <= MAX_INDEX
+    DC_ASSERT(index < EXCLUSIVE_END_INDEX,
+              "Index out of bounds {index=%lu, exclusive_end_index=%lu}", (size_t)index,
+              (size_t)EXCLUSIVE_END_INDEX);
+#endif
+    return PRIV(UPDATE)(self, index, false);
+}
+
+#undef UPDATE
+
+// JUSTIFY: Starting the search from the word containing `hint`
+//  - Threads all searching from the first word would contend on the same CAS, and on the same
+//    cache line. Threads passing different hints (e.g. their last claimed index, or their thread
+//    number times `EXCLUSIVE_END_INDEX / threads`) start on different words.
+//  - The search wraps around, so every clear index is found whatever the hint.
+// JUSTIFY: Retrying the CAS within the same word on failure
+//  - A failed CAS loads the word's new value, so the next clear bit of that word can be tried
+//    without reloading it.
+
+/// Sets the lowest clear index found searching from the word containing `hint`, and returns it, or
+/// returns `exclusive_end_index` if every index is set.
+DC_PUBLIC static size_t NS(SELF, claim_first_clear)(SELF* self, size_t hint) {
+    INVARIANT_CHECK(self);
+    size_t const start = DC_BITSET_STATIC_INDEX_TO_WORDS(hint % EXCLUSIVE_END_INDEX);
+
+    for (size_t step = 0; step < WORDS; step++) {
+        size_t const word_index = start + step < WORDS ? start + step : start + step - WORDS;
+        uint64_t const usable = word_index == WORDS - 1 ? LAST_WORD_MASK : ~(uint64_t)0;
+        uint64_t word = __atomic_load_n(&self->words[word_index], __ATOMIC_RELAXED);
+
+        while ((~word & usable) != 0) {
+            uint64_t const clear = ~word & usable;
+            uint64_t const mask = clear & (~clear + 1);
+            if (__atomic_compare_exchange_n(&self->words[word_index], &word, word | mask, true,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                return (word_index * 64) + (size_t)__builtin_ctzll(mask);
+            }
+        }
+    }
+    return EXCLUSIVE_END_INDEX;
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    size_t size = 0;
+    for (size_t word = 0; word < WORDS; word++) {
+        size += (size_t)__builtin_popcountll(__atomic_load_n(&self->words[word], __ATOMIC_ACQUIRE));
+    }
+    return size;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new)();
+    for (size_t word = 0; word < WORDS; word++) {
+        new_self.words[word] = __atomic_load_n(&self->words[word], __ATOMIC_ACQUIRE);
+    }
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) { INVARIANT_CHECK(self); }
+
+// JUSTIFY: Larger iter index type if the exclusive end is larger than the max representable index.
+//  - We need to represent the none index.
+#if EXCLUSIVE_END_INDEX < MAX_INDEX
+    #define ITER_INDEX_TYPE INDEX_TYPE
+#else
+    #define ITER_INDEX_TYPE INDEX_LARGER_TYPE
+#endif
+
+#define ITER_ADVANCE NS(SELF, iter_advance)
+static void PRIV(ITER_ADVANCE)(SELF const* bitset, size_t* word_index, uint64_t* word,
+                               ITER_INDEX_TYPE* next_index) {
+    while (*word == 0) {
+        (*word_index)++;
+        if (*word_index >= WORDS) {
+            *next_index = EXCLUSIVE_END_INDEX;
+            return;
+        }
+        *word = __atomic_load_n(&bitset->words[*word_index], __ATOMIC_ACQUIRE);
+    }
+    *next_index = (ITER_INDEX_TYPE)((*word_index * 64) + (size_t)__builtin_ctzll(*word));
+    *word &= *word - 1;
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef struct {
+    SELF const* bitset;
+    size_t word_index;
+    uint64_t word;
+    ITER_INDEX_TYPE next_index;
+} ITER_CONST;
+typedef ITER_INDEX_TYPE NS(ITER_CONST, item);
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(ITER_INDEX_TYPE const* item) {
+    return *item == EXCLUSIVE_END_INDEX;
+}
+
+DC_PUBLIC static ITER_INDEX_TYPE NS(ITER_CONST, next)(ITER_CONST* iter) {
+    DC_ASSUME(iter);
+    if (iter->next_index == EXCLUSIVE_END_INDEX) {
+        return EXCLUSIVE_END_INDEX;
+    }
+
+    ITER_INDEX_TYPE next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    return iter->next_index >= EXCLUSIVE_END_INDEX;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+
+    ITER_CONST iter = {
+        .bitset = self,
+        .word_index = 0,
+        .word = __atomic_load_n(&self->words[0], __ATOMIC_ACQUIRE),
+        .next_index = EXCLUSIVE_END_INDEX,
+    };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+
+    dc_debug_fmt_print(fmt, stream, "indices: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    ITER_CONST iter = NS(SELF, get_iter_const)(self);
+    while (!NS(ITER_CONST, empty)(&iter)) {
+        dc_debug_fmt_print(fmt, stream, "%lu,\n", (size_t)NS(ITER_CONST, next)(&iter));
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef ITER_CONST
+
+#define ITER NS(SELF, iter)
+typedef struct {
+    SELF* bitset;
+    size_t word_index;
+    uint64_t word;
+    ITER_INDEX_TYPE next_index;
+} ITER;
+typedef ITER_INDEX_TYPE NS(ITER, item);
+
+DC_PUBLIC static bool NS(ITER, empty_item)(ITER_INDEX_TYPE const* item) {
+    return *item == EXCLUSIVE_END_INDEX;
+}
+
+DC_PUBLIC static ITER_INDEX_TYPE NS(ITER, next)(ITER* iter) {
+    DC_ASSUME(iter);
+    if (iter->next_index == EXCLUSIVE_END_INDEX) {
+        return EXCLUSIVE_END_INDEX;
+    }
+
+    ITER_INDEX_TYPE next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
+    DC_ASSUME(iter);
+    return iter->next_index >= EXCLUSIVE_END_INDEX;
+}
+
+DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
+    INVARIANT_CHECK(self);
+
+    ITER iter = {
+        .bitset = self,
+        .word_index = 0,
+        .word = __atomic_load_n(&self->words[0], __ATOMIC_ACQUIRE),
+        .next_index = EXCLUSIVE_END_INDEX,
+    };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
+}
+
+#undef ITER
+#undef ITER_ADVANCE
+#undef ITER_INDEX_TYPE
+#undef INVARIANT_CHECK
+#undef LAST_WORD_MASK
+#undef WORDS
+
+#include <derive-c/core/index/bits_to_type/undef.h>
+#include <derive-c/core/index/capacity_to_bits/undef.h>
+
+#undef INDICES_CAPACITY
+#undef EXCLUSIVE_END_INDEX
+
+DC_TRAIT_BITSET(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,456 @@
+/// @brief A bitset for indexes `[0, exclusive_end_index)`, sized at runtime and allocated through
+/// `ALLOC`.
+///
+/// Stored as 64 bit words, as for `bitset/static`:
+///  - Iteration and `find_next_set` skip unset words, and use `ctz` per set index.
+///  - `set_range` sets or clears whole words at a time.
+///  - `resize` grows the storage geometrically, so repeatedly growing by one index is amortised.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+typedef size_t NS(SELF, index_t);
+
+// JUSTIFY: Max index leaves room for a partial last word
+//  - So the number of words for any valid exclusive end index does not overflow.
+DC_STATIC_CONSTANT size_t NS(SELF, max_index) = SIZE_MAX - 64;
+DC_STATIC_CONSTANT size_t NS(SELF, min_index) = 0;
+
+typedef struct {
+    uint64_t* words;
+    size_t words_capacity;
+    size_t exclusive_end_index;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_bitset_dynamic;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+// INVARIANT: All bits at or after the `exclusive_end_index` are unset
+//  - So growing never needs to clear bits, and word operations can ignore the end.
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME(DC_BITSET_STATIC_CAPACITY_TO_WORDS((self)->exclusive_end_index) <=                   \
+              (self)->words_capacity);                                                             \
+    DC_ASSUME(DC_WHEN(!((self)->words), (self)->words_capacity == 0));
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .words = NULL,
+        .words_capacity = 0,
+        .exclusive_end_index = 0,
+        .alloc_ref = alloc_ref,
+        .derive_c_bitset_dynamic = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+// JUSTIFY: Zeroed storage, and no memory tracking of unused words
+//  - Unused words are kept zeroed (see the invariant), and are read by word operations.
+static void PRIV(NS(SELF, reserve_words))(SELF* self, size_t words) {
+    if (words <= self->words_capacity) {
+        return;
+    }
+    size_t const new_capacity = dc_growth_double(self->words_capacity, words);
+    if (self->words == NULL) {
+        self->words = (uint64_t*)NS(ALLOC, allocate_zeroed)(self->alloc_ref,
+                                                            new_capacity * sizeof(uint64_t));
+    } else {
+        self->words = (uint64_t*)NS(ALLOC, reallocate)(self->alloc_ref, self->words,
+                                                       self->words_capacity * sizeof(uint64_t),
+                                                       new_capacity * sizeof(uint64_t));
+        memset(&self->words[self->words_capacity], 0,
+               (new_capacity - self->words_capacity) * sizeof(uint64_t));
+    }
+    self->words_capacity = new_capacity;
+}
+
+DC_PUBLIC static SELF NS(SELF, new_with_end)(size_t exclusive_end_index,
+                                             NS(ALLOC, ref) alloc_ref) {
+    DC_ASSERT(exclusive_end_index <= NS(SELF, max_index) + 1,
+              "Cannot create bitset, end index too large {exclusive_end_index=%lu}",
+              (size_t)exclusive_end_index);
+    SELF self = NS(SELF, new)(alloc_ref);
+    size_t const words = DC_BITSET_STATIC_CAPACITY_TO_WORDS(exclusive_end_index);
+    if (words > 0) {
+        self.words = (uint64_t*)NS(ALLOC, allocate_zeroed)(alloc_ref, words * sizeof(uint64_t));
+        self.words_capacity = words;
+    }
+    self.exclusive_end_index = exclusive_end_index;
+    return self;
+}
+
+DC_PUBLIC static size_t NS(SELF, exclusive_end_index)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->exclusive_end_index;
+}
+
+/// Sets (or clears) all indices in `[from, to)`, a word at a time.
+DC_PUBLIC static void NS(SELF, set_range)(SELF* self, size_t from, size_t to, bool value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(from <= to && to <= self->exclusive_end_index,
+              "Cannot set range, out of bounds {from=%lu, to=%lu, exclusive_end_index=%lu}",
+              (size_t)from, (size_t)to, (size_t)self->exclusive_end_index);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+    if (from == to) {
+        return;
+    }
+
+    size_t const last_index = to - 1;
+    size_t const first = DC_BITSET_STATIC_INDEX_TO_WORDS(from);
+    size_t const last = DC_BITSET_STATIC_INDEX_TO_WORDS(last_index);
+    uint64_t const first_mask = ~(uint64_t)0 << DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(from);
+    uint64_t const last_mask =
+        ~(uint64_t)0 >> (63 - DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(last_index));
+
+    if (first == last) {
+        uint64_t const mask = first_mask & last_mask;
+        self->words[first] = value ? (self->words[first] | mask) : (self->words[first] & ~mask);
+        return;
+    }
+
+    self->words[first] =
+        value ? (self->words[first] | first_mask) : (self->words[first] & ~first_mask);
+    memset(&self->words[first + 1], value ? 0xFF : 0x00, (last - first - 1) * sizeof(uint64_t));
+    self->words[last] = value ? (self->words[last] | last_mask) : (self->words[last] & ~last_mask);
+}
+
+/// Sets the exclusive end index. New indices are unset, and indices past the new end are
+/// discarded.
+DC_PUBLIC static void NS(SELF, resize)(SELF* self, size_t exclusive_end_index) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(exclusive_end_index <= NS(SELF, max_index) + 1,
+              "Cannot resize bitset, end index too large {exclusive_end_index=%lu}",
+              (size_t)exclusive_end_index);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (exclusive_end_index < self->exclusive_end_index) {
+        NS(SELF, set_range)(self, exclusive_end_index, self->exclusive_end_index, false);
+    } else {
+        PRIV(NS(SELF, reserve_words))(self,
+                                      DC_BITSET_STATIC_CAPACITY_TO_WORDS(exclusive_end_index));
+    }
+    self->exclusive_end_index = exclusive_end_index;
+}
+
+DC_PUBLIC static bool NS(SELF, try_set)(SELF* self, size_t index, bool value) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (index >= self->exclusive_end_index) {
+        return false;
+    }
+
+    size_t word = DC_BITSET_STATIC_INDEX_TO_WORDS(index);
+    uint64_t mask =
+        DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index));
+
+    if (value) {
+        self->words[word] = self->words[word] | mask;
+    } else {
+        self->words[word] = self->words[word] & (~mask);
+    }
+    return true;
+}
+
+DC_PUBLIC static void NS(SELF, set)(SELF* self, size_t index, bool value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(NS(SELF, try_set)(self, index, value),
+              "Failed to set index {index=%lu, value=%d, exclusive_end_index=%lu}", (size_t)index,
+              value, (size_t)self->exclusive_end_index);
+}
+
+DC_PUBLIC static bool NS(SELF, get)(SELF const* self, size_t index) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(index < self->exclusive_end_index,
+              "Index out of bounds {index=%lu, exclusive_end_index=%lu}", (size_t)index,
+              (size_t)self->exclusive_end_index);
+
+    size_t word = DC_BITSET_STATIC_INDEX_TO_WORDS(index);
+    uint64_t mask =
+        DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index));
+    return (self->words[word] & mask) != 0;
+}
+
+/// Returns the first set index at or after `from`, or `exclusive_end_index` if there is none.
+DC_PUBLIC static size_t NS(SELF, find_next_set)(SELF const* self, size_t from) {
+    INVARIANT_CHECK(self);
+    if (from >= self->exclusive_end_index) {
+        return self->exclusive_end_index;
+    }
+
+    size_t const words = DC_BITSET_STATIC_CAPACITY_TO_WORDS(self->exclusive_end_index);
+    size_t word_index = DC_BITSET_STATIC_INDEX_TO_WORDS(from);
+    uint64_t word =
+        self->words[word_index] & (~(uint64_t)0 << DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(from));
+    while (word == 0) {
+        word_index++;
+        if (word_index == words) {
+            return self->exclusive_end_index;
+        }
+        word = self->words[word_index];
+    }
+    return (word_index * 64) + (size_t)__builtin_ctzll(word);
+}
+
+/// Returns the first set index, or `exclusive_end_index` if there is none.
+DC_PUBLIC static size_t NS(SELF, find_first_set)(SELF const* self) {
+    return NS(SELF, find_next_set)(self, 0);
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    size_t const words = DC_BITSET_STATIC_CAPACITY_TO_WORDS(self->exclusive_end_index);
+    size_t size = 0;
+    for (size_t word = 0; word < words; word++) {
+        size += (size_t)__builtin_popcountll(self->words[word]);
+    }
+    return size;
+}
+
+// JUSTIFY: Bulk operations write to an `out` bitset
+//  - So results can be written to existing bitsets without allocating, and `out` may be `left` or
+//    `right` for an in place operation (as the `_assign` variants do).
+//  - Bits past the `exclusive_end_index` are unset in both inputs, so remain unset in `out`.
+static size_t PRIV(NS(SELF, bulk_words))(SELF const* left, SELF const* right, SELF const* out) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    INVARIANT_CHECK(out);
+    DC_ASSERT(left->exclusive_end_index == right->exclusive_end_index &&
+                  left->exclusive_end_index == out->exclusive_end_index,
+              "Bitsets must have the same end index {left=%lu, right=%lu, out=%lu}",
+              (size_t)left->exclusive_end_index, (size_t)right->exclusive_end_index,
+              (size_t)out->exclusive_end_index);
+    return DC_BITSET_STATIC_CAPACITY_TO_WORDS(left->exclusive_end_index);
+}
+
+/// Sets `out` to `left & right`. All three must have the same end index.
+DC_PUBLIC static void NS(SELF, and)(SELF const* left, SELF const* right, SELF* out) {
+    size_t const words = PRIV(NS(SELF, bulk_words))(left, right, out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_and(out->words, left->words, right->words, words);
+}
+
+/// Sets `out` to `left | right`. All three must have the same end index.
+DC_PUBLIC static void NS(SELF, or)(SELF const* left, SELF const* right, SELF* out) {
+    size_t const words = PRIV(NS(SELF, bulk_words))(left, right, out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_or(out->words, left->words, right->words, words);
+}
+
+/// Sets `out` to `left ^ right`. All three must have the same end index.
+DC_PUBLIC static void NS(SELF, xor)(SELF const* left, SELF const* right, SELF* out) {
+    size_t const words = PRIV(NS(SELF, bulk_words))(left, right, out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_xor(out->words, left->words, right->words, words);
+}
+
+/// Sets `out` to `left & ~right`, the indices of `left` not in `right`. All three must have the
+/// same end index.
+DC_PUBLIC static void NS(SELF, andnot)(SELF const* left, SELF const* right, SELF* out) {
+    size_t const words = PRIV(NS(SELF, bulk_words))(left, right, out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_andnot(out->words, left->words, right->words, words);
+}
+
+DC_PUBLIC static void NS(SELF, and_assign)(SELF* self, SELF const* other) {
+    NS(SELF, and)(self, other, self);
+}
+
+DC_PUBLIC static void NS(SELF, or_assign)(SELF* self, SELF const* other) {
+    NS(SELF, or)(self, other, self);
+}
+
+DC_PUBLIC static void NS(SELF, xor_assign)(SELF* self, SELF const* other) {
+    NS(SELF, xor)(self, other, self);
+}
+
+DC_PUBLIC static void NS(SELF, andnot_assign)(SELF* self, SELF const* other) {
+    NS(SELF, andnot)(self, other, self);
+}
+
+/// The number of indices set in both `left` and `right`, without building the intersection.
+DC_PUBLIC static size_t NS(SELF, count_and)(SELF const* left, SELF const* right) {
+    size_t const words = PRIV(NS(SELF, bulk_words))(left, right, right);
+    return dc_bitset_words_count_and(left->words, right->words, words);
+}
+
+/// Whether any index is set in both `left` and `right`, stopping at the first such word.
+DC_PUBLIC static bool NS(SELF, any_and)(SELF const* left, SELF const* right) {
+    size_t const words = PRIV(NS(SELF, bulk_words))(left, right, right);
+    return dc_bitset_words_any_and(left->words, right->words, words);
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new_with_end)(self->exclusive_end_index, self->alloc_ref);
+    if (new_self.words != NULL) {
+        memcpy(new_self.words, self->words, new_self.words_capacity * sizeof(uint64_t));
+    }
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    if (self->words != NULL) {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->words,
+                              self->words_capacity * sizeof(uint64_t));
+    }
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "exclusive_end_index: %lu,\n", self->exclusive_end_index);
+    dc_debug_fmt_print(fmt, stream, "words_capacity: %lu,\n", self->words_capacity);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "blocks: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    for (size_t index = NS(SELF, find_first_set)(self); index < self->exclusive_end_index;
+         index = NS(SELF, find_next_set)(self, index + 1)) {
+        dc_debug_fmt_print(fmt, stream, "{ byte: %lu, offset: %lu, index: %lu},\n",
+                           DC_BITSET_STATIC_INDEX_TO_BYTES(index),
+                           DC_BITSET_STATIC_INDEX_TO_OFFSET(index), index);
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+// JUSTIFY: `SIZE_MAX` as the iterator's empty item
+//  - The end index varies with the bitset, and the item has no reference to it.
+//  - Larger than the `max_index`, so is never a valid index.
+#define ITER_NONE SIZE_MAX
+
+// JUSTIFY: Iterating by clearing the lowest set bit of a copy of the current word
+//  - As for `bitset/static`, proportional to the number of set indices and words.
+#define ITER_ADVANCE NS(SELF, iter_advance)
+static void PRIV(ITER_ADVANCE)(SELF const* bitset, size_t* word_index, uint64_t* word,
+                               size_t* next_index) {
+    size_t const words = DC_BITSET_STATIC_CAPACITY_TO_WORDS(bitset->exclusive_end_index);
+    while (*word == 0) {
+        (*word_index)++;
+        if (*word_index >= words) {
+            *next_index = ITER_NONE;
+            return;
+        }
+        *word = bitset->words[*word_index];
+    }
+    *next_index = (*word_index * 64) + (size_t)__builtin_ctzll(*word);
+    *word &= *word - 1;
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef struct {
+    SELF const* bitset;
+    size_t word_index;
+    uint64_t word;
+    size_t next_index;
+    mutation_version version;
+} ITER_CONST;
+typedef size_t NS(ITER_CONST, item);
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(size_t const* item) {
+    return *item == ITER_NONE;
+}
+
+DC_PUBLIC static size_t NS(ITER_CONST, next)(ITER_CONST* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->next_index == ITER_NONE) {
+        return ITER_NONE;
+    }
+
+    size_t next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index == ITER_NONE;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+
+    ITER_CONST iter = {
+        .bitset = self,
+        .word_index = 0,
+        .word = self->exclusive_end_index > 0 ? self->words[0] : 0,
+        .next_index = ITER_NONE,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
+}
+
+#undef ITER_CONST
+
+#define ITER NS(SELF, iter)
+typedef struct {
+    SELF* bitset;
+    size_t word_index;
+    uint64_t word;
+    size_t next_index;
+    mutation_version version;
+} ITER;
+typedef size_t NS(ITER, item);
+
+DC_PUBLIC static bool NS(ITER, empty_item)(size_t const* item) { return *item == ITER_NONE; }
+
+DC_PUBLIC static size_t NS(ITER, next)(ITER* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->next_index == ITER_NONE) {
+        return ITER_NONE;
+    }
+
+    size_t next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index == ITER_NONE;
+}
+
+DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
+    INVARIANT_CHECK(self);
+
+    ITER iter = {
+        .bitset = self,
+        .word_index = 0,
+        .word = self->exclusive_end_index > 0 ? self->words[0] : 0,
+        .next_index = ITER_NONE,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
+}
+
+#undef ITER
+#undef ITER_ADVANCE
+#undef ITER_NONE
+#undef INVARIANT_CHECK
+
+DC_TRAIT_BITSET(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,415 @@
+/// @brief A bitset for indexes `[0, exclusive_end_index)`, with summary levels for sparse sets.
+///
+/// The leaf level stores the indices as 64 bit words, as for `bitset/dynamic`. Each level above
+/// has one bit per word of the level below, set when that word is nonzero, up to a single word:
+///  - `find_next_set` and iteration skip runs of unset words using the summaries, so cost
+///    `O(levels)` per set index, rather than being proportional to the unset words scanned.
+///  - `clear_all` only touches the nonzero words (found from the summaries).
+///  - `set` writes the leaf word and the first summary, and the levels above only when a summary
+///    word becomes empty or nonempty, so is `O(1)` amortised, and `O(levels)` at worst.
+///
+/// The end index is fixed on construction.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+typedef size_t NS(SELF, index_t);
+
+// JUSTIFY: Max index leaves room for a partial last word
+//  - So the number of words for any valid exclusive end index does not overflow.
+DC_STATIC_CONSTANT size_t NS(SELF, max_index) = SIZE_MAX - 64;
+DC_STATIC_CONSTANT size_t NS(SELF, min_index) = 0;
+
+// JUSTIFY: At most 11 levels
+//  - The leaf level has at most 2^58 words, and each level above has 64x fewer, so the 11th
+//    level is a single word.
+#define MAX_LEVELS 11
+
+typedef struct {
+    uint64_t* words;
+    size_t words_count;
+    uint64_t* levels[MAX_LEVELS];
+    size_t level_words[MAX_LEVELS];
+    uint8_t levels_count;
+    size_t exclusive_end_index;
+    size_t size;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_bitset_hierarchical;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+// INVARIANT: A summary bit is set if and only if the word below it is nonzero
+//  - All bits at or after the `exclusive_end_index` of each level are unset.
+//  - The top level is a single word (when there are any indices).
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->levels_count <= MAX_LEVELS);                                                 \
+    DC_ASSUME(DC_WHEN((self)->levels_count > 0,                                                    \
+                      (self)->level_words[(self)->levels_count - 1] == 1));                        \
+    DC_ASSUME(DC_WHEN(!((self)->words), (self)->words_count == 0));                                \
+    DC_ASSUME((self)->size <= (self)->exclusive_end_index);
+
+DC_PUBLIC static SELF NS(SELF, new_with_end)(size_t exclusive_end_index,
+                                             NS(ALLOC, ref) alloc_ref) {
+    DC_ASSERT(exclusive_end_index <= NS(SELF, max_index) + 1,
+              "Cannot create bitset, end index too large {exclusive_end_index=%lu}",
+              (size_t)exclusive_end_index);
+    SELF self = {
+        .words = NULL,
+        .words_count = 0,
+        .levels = {},
+        .level_words = {},
+        .levels_count = 0,
+        .exclusive_end_index = exclusive_end_index,
+        .size = 0,
+        .alloc_ref = alloc_ref,
+        .derive_c_bitset_hierarchical = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+
+    for (size_t words = DC_BITSET_STATIC_CAPACITY_TO_WORDS(exclusive_end_index); words > 0;
+         words = words == 1 ? 0 : DC_BITSET_STATIC_CAPACITY_TO_WORDS(words)) {
+        DC_ASSUME(self.levels_count < MAX_LEVELS);
+        self.level_words[self.levels_count] = words;
+        self.levels_count++;
+        self.words_count += words;
+    }
+
+    if (self.words_count > 0) {
+        self.words = (uint64_t*)NS(ALLOC, allocate_zeroed)(alloc_ref,
+                                                           self.words_count * sizeof(uint64_t));
+        uint64_t* level_start = self.words;
+        for (uint8_t level = 0; level < self.levels_count; level++) {
+            self.levels[level] = level_start;
+            level_start += self.level_words[level];
+        }
+    }
+    return self;
+}
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return NS(SELF, new_with_end)(0, alloc_ref);
+}
+
+DC_PUBLIC static size_t NS(SELF, exclusive_end_index)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->exclusive_end_index;
+}
+
+DC_PUBLIC static uint8_t NS(SELF, levels)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->levels_count;
+}
+
+DC_PUBLIC static bool NS(SELF, try_set)(SELF* self, size_t index, bool value) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (index >= self->exclusive_end_index) {
+        return false;
+    }
+
+    size_t word_index = DC_BITSET_STATIC_INDEX_TO_WORDS(index);
+    uint64_t const mask =
+        DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index));
+    uint64_t* word = &self->levels[0][word_index];
+    uint64_t const before = *word;
+    uint64_t const after = value ? (before | mask) : (before & ~mask);
+    if (after == before) {
+        return true;
+    }
+    *word = after;
+    self->size = value ? self->size + 1 : self->size - 1;
+
+    // JUSTIFY: Always writing the first summary, without branching on the leaf's emptiness
+    //  - Whether a leaf word becomes empty or nonempty is unpredictable for sparse sets, while
+    //    the summary word above almost never changes emptiness, so the loop exits predictably.
+    bool nonempty = after != 0;
+    for (uint8_t level = 1; level < self->levels_count; level++) {
+        size_t const offset = DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(word_index);
+        word_index = DC_BITSET_STATIC_INDEX_TO_WORDS(word_index);
+        word = &self->levels[level][word_index];
+        uint64_t const summary_before = *word;
+        uint64_t const summary_after =
+            (summary_before & ~DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(offset)) |
+            ((uint64_t)nonempty << offset);
+        *word = summary_after;
+        if ((summary_before == 0) == (summary_after == 0)) {
+            break;
+        }
+        nonempty = summary_after != 0;
+    }
+    return true;
+}
+
+DC_PUBLIC static void NS(SELF, set)(SELF* self, size_t index, bool value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(NS(SELF, try_set)(self, index, value),
+              "Failed to set index {index=%lu, value=%d, exclusive_end_index=%lu}", (size_t)index,
+              value, (size_t)self->exclusive_end_index);
+}
+
+DC_PUBLIC static bool NS(SELF, get)(SELF const* self, size_t index) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(index < self->exclusive_end_index,
+              "Index out of bounds {index=%lu, exclusive_end_index=%lu}", (size_t)index,
+              (size_t)self->exclusive_end_index);
+
+    size_t word = DC_BITSET_STATIC_INDEX_TO_WORDS(index);
+    uint64_t mask =
+        DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index));
+    return (self->levels[0][word] & mask) != 0;
+}
+
+/// Returns the first set index at or after `from`, or `exclusive_end_index` if there is none.
+///  - Ascends while the rest of the current word is empty (at most to the top level), then
+///    descends through the first set summary bits to the leaf.
+DC_PUBLIC static size_t NS(SELF, find_next_set)(SELF const* self, size_t from) {
+    INVARIANT_CHECK(self);
+    if (from >= self->exclusive_end_index) {
+        return self->exclusive_end_index;
+    }
+
+    size_t position = from;
+    uint8_t level = 0;
+    for (;;) {
+        if (level == self->levels_count) {
+            return self->exclusive_end_index;
+        }
+        size_t const word_index = DC_BITSET_STATIC_INDEX_TO_WORDS(position);
+        if (word_index >= self->level_words[level]) {
+            return self->exclusive_end_index;
+        }
+        uint64_t const word =
+            self->levels[level][word_index] &
+            (~(uint64_t)0 << DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(position));
+        if (word != 0) {
+            position = (word_index * 64) + (size_t)__builtin_ctzll(word);
+            break;
+        }
+        position = word_index + 1;
+        level++;
+    }
+
+    while (level > 0) {
+        level--;
+        uint64_t const word = self->levels[level][position];
+        DC_ASSUME(word != 0);
+        position = (position * 64) + (size_t)__builtin_ctzll(word);
+    }
+    return position;
+}
+
+/// Returns the first set index, or `exclusive_end_index` if there is none.
+DC_PUBLIC static size_t NS(SELF, find_first_set)(SELF const* self) {
+    return NS(SELF, find_next_set)(self, 0);
+}
+
+/// The number of set indices, tracked on `set`.
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+/// Unsets all indices, clearing only the words marked nonempty by the level above.
+DC_PUBLIC static void NS(SELF, clear_all)(SELF* self) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+    if (self->levels_count == 0) {
+        return;
+    }
+
+    for (uint8_t level = 0; level + 1 < self->levels_count; level++) {
+        uint64_t const* summary = self->levels[level + 1];
+        for (size_t summary_index = 0; summary_index < self->level_words[level + 1];
+             summary_index++) {
+            uint64_t bits = summary[summary_index];
+            while (bits != 0) {
+                self->levels[level][(summary_index * 64) + (size_t)__builtin_ctzll(bits)] = 0;
+                bits &= bits - 1;
+            }
+        }
+    }
+    self->levels[self->levels_count - 1][0] = 0;
+    self->size = 0;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new_with_end)(self->exclusive_end_index, self->alloc_ref);
+    if (new_self.words != NULL) {
+        memcpy(new_self.words, self->words, new_self.words_count * sizeof(uint64_t));
+    }
+    new_self.size = self->size;
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    if (self->words != NULL) {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->words, self->words_count * sizeof(uint64_t));
+    }
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "exclusive_end_index: %lu,\n", self->exclusive_end_index);
+    dc_debug_fmt_print(fmt, stream, "levels: %u,\n", (unsigned)self->levels_count);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "blocks: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    for (size_t index = NS(SELF, find_first_set)(self); index < self->exclusive_end_index;
+         index = NS(SELF, find_next_set)(self, index + 1)) {
+        dc_debug_fmt_print(fmt, stream, "{ byte: %lu, offset: %lu, index: %lu},\n",
+                           DC_BITSET_STATIC_INDEX_TO_BYTES(index),
+                           DC_BITSET_STATIC_INDEX_TO_OFFSET(index), index);
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+// JUSTIFY: `SIZE_MAX` as the iterator's empty item
+//  - The end index varies with the bitset, and the item has no reference to it.
+//  - Larger than the `max_index`, so is never a valid index.
+#define ITER_NONE SIZE_MAX
+
+// JUSTIFY: Iterating over a copy of the current leaf word, finding the next with the summaries
+//  - Each `next` is a `ctz` and a clear within a word, and `find_next_set` between words.
+#define ITER_ADVANCE NS(SELF, iter_advance)
+static void PRIV(ITER_ADVANCE)(SELF const* bitset, size_t* word_index, uint64_t* word,
+                               size_t* next_index) {
+    if (*word == 0) {
+        size_t const next_word_start = (*word_index + 1) * 64;
+        size_t const next = next_word_start < bitset->exclusive_end_index
+                                ? NS(SELF, find_next_set)(bitset, next_word_start)
+                                : bitset->exclusive_end_index;
+        if (next == bitset->exclusive_end_index) {
+            *next_index = ITER_NONE;
+            return;
+        }
+        *word_index = DC_BITSET_STATIC_INDEX_TO_WORDS(next);
+        *word = bitset->levels[0][*word_index];
+    }
+    *next_index = (*word_index * 64) + (size_t)__builtin_ctzll(*word);
+    *word &= *word - 1;
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef struct {
+    SELF const* bitset;
+    size_t word_index;
+    uint64_t word;
+    size_t next_index;
+    mutation_version version;
+} ITER_CONST;
+typedef size_t NS(ITER_CONST, item);
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(size_t const* item) {
+    return *item == ITER_NONE;
+}
+
+DC_PUBLIC static size_t NS(ITER_CONST, next)(ITER_CONST* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->next_index == ITER_NONE) {
+        return ITER_NONE;
+    }
+
+    size_t next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index == ITER_NONE;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+
+    ITER_CONST iter = {
+        .bitset = self,
+        .word_index = 0,
+        .word = self->exclusive_end_index > 0 ? self->levels[0][0] : 0,
+        .next_index = ITER_NONE,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
+}
+
+#undef ITER_CONST
+
+#define ITER NS(SELF, iter)
+typedef struct {
+    SELF* bitset;
+    size_t word_index;
+    uint64_t word;
+    size_t next_index;
+    mutation_version version;
+} ITER;
+typedef size_t NS(ITER, item);
+
+DC_PUBLIC static bool NS(ITER, empty_item)(size_t const* item) { return *item == ITER_NONE; }
+
+DC_PUBLIC static size_t NS(ITER, next)(ITER* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->next_index == ITER_NONE) {
+        return ITER_NONE;
+    }
+
+    size_t next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index == ITER_NONE;
+}
+
+DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
+    INVARIANT_CHECK(self);
+
+    ITER iter = {
+        .bitset = self,
+        .word_index = 0,
+        .word = self->exclusive_end_index > 0 ? self->levels[0][0] : 0,
+        .next_index = ITER_NONE,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
+}
+
+#undef ITER
+#undef ITER_ADVANCE
+#undef ITER_NONE
+#undef INVARIANT_CHECK
+#undef MAX_LEVELS
+
+DC_TRAIT_BITSET(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
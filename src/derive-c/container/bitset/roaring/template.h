@@ -0,0 +1,1023 @@
+/// @brief A compressed bitset of 32 bit indices, as a roaring bitmap.
+///
+/// The indices are split into chunks of 64K by their high 16 bits, held in a sorted array of
+/// chunks. Each chunk stores the low 16 bits of its indices in the smallest of (see `utils.h`):
+///  - A sorted array, for sparse chunks (at most `DC_ROARING_ARRAY_MAX` indices).
+///  - A bitmap of 1024 words, for dense chunks.
+///  - Runs of consecutive indices, only after `run_optimize` (or from `and`/`or` of runs).
+///
+/// So memory is proportional to the number of indices when sparse, to 1 bit per index when
+/// dense, and to the number of runs when clustered. `and`, `or` and `count_and` only combine the
+/// chunks with matching keys, using merges of arrays and the `bitset/words` kernels for bitmaps.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+typedef uint32_t NS(SELF, index_t);
+
+DC_STATIC_CONSTANT uint32_t NS(SELF, max_index) = UINT32_MAX;
+DC_STATIC_CONSTANT uint32_t NS(SELF, min_index) = 0;
+
+typedef struct {
+    dc_roaring_chunk* chunks;
+    uint32_t chunks_count;
+    uint32_t chunks_capacity;
+    size_t size;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_bitset_roaring;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+// INVARIANT: Chunks are sorted by key, and none are empty
+//  - Arrays hold at most `DC_ROARING_ARRAY_MAX` indices.
+//  - The `size` is the sum of the chunks' cardinalities.
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->chunks_count <= (self)->chunks_capacity);                                    \
+    DC_ASSUME(DC_WHEN(!((self)->chunks), (self)->chunks_capacity == 0));                           \
+    DC_ASSUME((self)->size >= (self)->chunks_count);
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .chunks = NULL,
+        .chunks_count = 0,
+        .chunks_capacity = 0,
+        .size = 0,
+        .alloc_ref = alloc_ref,
+        .derive_c_bitset_roaring = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+static size_t PRIV(NS(SELF, chunk_bytes))(dc_roaring_chunk const* chunk) {
+    switch (chunk->kind) {
+    case DC_ROARING_ARRAY:
+        return chunk->capacity * sizeof(uint16_t);
+    case DC_ROARING_BITMAP:
+        return DC_ROARING_BITMAP_WORDS * sizeof(uint64_t);
+    case DC_ROARING_RUNS:
+        return chunk->capacity * sizeof(dc_roaring_run);
+    }
+    DC_UNREACHABLE("Invalid roaring chunk kind");
+}
+
+static void PRIV(NS(SELF, chunk_free))(SELF* self, dc_roaring_chunk* chunk) {
+    size_t const bytes = PRIV(NS(SELF, chunk_bytes))(chunk);
+    switch (chunk->kind) {
+    case DC_ROARING_ARRAY:
+        NS(ALLOC, deallocate)(self->alloc_ref, chunk->array, bytes);
+        return;
+    case DC_ROARING_BITMAP:
+        NS(ALLOC, deallocate)(self->alloc_ref, chunk->bitmap, bytes);
+        return;
+    case DC_ROARING_RUNS:
+        NS(ALLOC, deallocate)(self->alloc_ref, chunk->runs, bytes);
+        return;
+    }
+}
+
+static bool PRIV(NS(SELF, chunk_contains))(dc_roaring_chunk const* chunk, uint16_t low) {
+    switch (chunk->kind) {
+    case DC_ROARING_ARRAY:
+        return dc_roaring_array_contains(chunk->array, chunk->length, low);
+    case DC_ROARING_BITMAP:
+        return dc_roaring_bitmap_contains(chunk->bitmap, low);
+    case DC_ROARING_RUNS:
+        return dc_roaring_runs_contains(chunk->runs, chunk->length, low);
+    }
+    DC_UNREACHABLE("Invalid roaring chunk kind");
+}
+
+// JUSTIFY: Bitmaps are used as is, arrays and runs are written to the `buffer`
+//  - So any pair of chunks can be combined with the `bitset/words` kernels.
+static uint64_t const* PRIV(NS(SELF, chunk_words))(dc_roaring_chunk const* chunk,
+                                                   uint64_t* buffer) {
+    if (chunk->kind == DC_ROARING_BITMAP) {
+        return chunk->bitmap;
+    }
+    memset(buffer, 0, DC_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (chunk->kind == DC_ROARING_ARRAY) {
+        dc_roaring_bitmap_set_array(buffer, chunk->array, chunk->length);
+    } else {
+        dc_roaring_bitmap_set_runs(buffer, chunk->runs, chunk->length);
+    }
+    return buffer;
+}
+
+static void PRIV(NS(SELF, chunk_to_bitmap))(SELF* self, dc_roaring_chunk* chunk) {
+    DC_ASSUME(chunk->kind != DC_ROARING_BITMAP);
+    uint64_t* words = (uint64_t*)NS(ALLOC, allocate_zeroed)(
+        self->alloc_ref, DC_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    if (chunk->kind == DC_ROARING_ARRAY) {
+        dc_roaring_bitmap_set_array(words, chunk->array, chunk->length);
+    } else {
+        dc_roaring_bitmap_set_runs(words, chunk->runs, chunk->length);
+    }
+    PRIV(NS(SELF, chunk_free))(self, chunk);
+    chunk->bitmap = words;
+    chunk->kind = DC_ROARING_BITMAP;
+    chunk->length = 0;
+    chunk->capacity = DC_ROARING_BITMAP_WORDS;
+}
+
+static void PRIV(NS(SELF, chunk_to_array))(SELF* self, dc_roaring_chunk* chunk) {
+    DC_ASSUME(chunk->kind != DC_ROARING_ARRAY);
+    DC_ASSUME(chunk->cardinality > 0 && chunk->cardinality <= DC_ROARING_ARRAY_MAX);
+    uint16_t* values = (uint16_t*)NS(ALLOC, allocate_uninit)(
+        self->alloc_ref, chunk->cardinality * sizeof(uint16_t));
+    uint32_t const length = chunk->kind == DC_ROARING_BITMAP
+                                ? dc_roaring_bitmap_to_array(chunk->bitmap, values)
+                                : dc_roaring_runs_to_array(chunk->runs, chunk->length, values);
+    DC_ASSUME(length == chunk->cardinality);
+    PRIV(NS(SELF, chunk_free))(self, chunk);
+    chunk->array = values;
+    chunk->kind = DC_ROARING_ARRAY;
+    chunk->length = length;
+    chunk->capacity = length;
+}
+
+static void PRIV(NS(SELF, chunk_to_runs))(SELF* self, dc_roaring_chunk* chunk, uint32_t runs) {
+    DC_ASSUME(chunk->kind != DC_ROARING_RUNS);
+    dc_roaring_run* values = (dc_roaring_run*)NS(ALLOC, allocate_uninit)(
+        self->alloc_ref, runs * sizeof(dc_roaring_run));
+    uint32_t const length = chunk->kind == DC_ROARING_BITMAP
+                                ? dc_roaring_bitmap_to_runs(chunk->bitmap, values)
+                                : dc_roaring_array_to_runs(chunk->array, chunk->length, values);
+    DC_ASSUME(length == runs);
+    PRIV(NS(SELF, chunk_free))(self, chunk);
+    chunk->runs = values;
+    chunk->kind = DC_ROARING_RUNS;
+    chunk->length = length;
+    chunk->capacity = length;
+}
+
+// JUSTIFY: Converting runs to an array or bitmap once they are larger
+//  - Setting and unsetting indices can split runs, so a chunk of runs may no longer be smallest.
+static void PRIV(NS(SELF, chunk_fit_runs))(SELF* self, dc_roaring_chunk* chunk) {
+    if (chunk->kind != DC_ROARING_RUNS || chunk->cardinality == 0) {
+        return;
+    }
+    size_t const runs_bytes = chunk->length * sizeof(dc_roaring_run);
+    if (chunk->cardinality <= DC_ROARING_ARRAY_MAX) {
+        if (runs_bytes > chunk->cardinality * sizeof(uint16_t)) {
+            PRIV(NS(SELF, chunk_to_array))(self, chunk);
+        }
+    } else if (runs_bytes > DC_ROARING_BITMAP_WORDS * sizeof(uint64_t)) {
+        PRIV(NS(SELF, chunk_to_bitmap))(self, chunk);
+    }
+}
+
+/// Grows the array or runs of a chunk to fit at least `required` values.
+static void PRIV(NS(SELF, chunk_reserve))(SELF* self, dc_roaring_chunk* chunk, uint32_t required) {
+    DC_ASSUME(chunk->kind != DC_ROARING_BITMAP);
+    if (required <= chunk->capacity) {
+        return;
+    }
+    size_t const item_size =
+        chunk->kind == DC_ROARING_ARRAY ? sizeof(uint16_t) : sizeof(dc_roaring_run);
+    uint32_t const max = chunk->kind == DC_ROARING_ARRAY ? DC_ROARING_ARRAY_MAX
+                                                         : DC_ROARING_CHUNK_INDICES / 2;
+    size_t const grown = dc_growth_double(chunk->capacity, required);
+    uint32_t const capacity = grown < max ? (uint32_t)grown : max;
+    DC_ASSUME(capacity >= required);
+
+    void* data = chunk->kind == DC_ROARING_ARRAY ? (void*)chunk->array : (void*)chunk->runs;
+    data = chunk->capacity == 0
+               ? NS(ALLOC, allocate_uninit)(self->alloc_ref, capacity * item_size)
+               : NS(ALLOC, reallocate)(self->alloc_ref, data, chunk->capacity * item_size,
+                                       capacity * item_size);
+    if (chunk->kind == DC_ROARING_ARRAY) {
+        chunk->array = (uint16_t*)data;
+    } else {
+        chunk->runs = (dc_roaring_run*)data;
+    }
+    chunk->capacity = capacity;
+}
+
+/// Adds the index to the chunk, returning whether it was newly added.
+static bool PRIV(NS(SELF, chunk_add))(SELF* self, dc_roaring_chunk* chunk, uint16_t low) {
+    switch (chunk->kind) {
+    case DC_ROARING_ARRAY: {
+        uint32_t const position = dc_roaring_array_lower_bound(chunk->array, chunk->length, low);
+        if (position < chunk->length && chunk->array[position] == low) {
+            return false;
+        }
+        if (chunk->length == DC_ROARING_ARRAY_MAX) {
+            PRIV(NS(SELF, chunk_to_bitmap))(self, chunk);
+            return PRIV(NS(SELF, chunk_add))(self, chunk, low);
+        }
+        PRIV(NS(SELF, chunk_reserve))(self, chunk, chunk->length + 1);
+        memmove(&chunk->array[position + 1], &chunk->array[position],
+                (chunk->length - position) * sizeof(uint16_t));
+        chunk->array[position] = low;
+        chunk->length++;
+        chunk->cardinality++;
+        return true;
+    }
+    case DC_ROARING_BITMAP: {
+        uint64_t const mask = (uint64_t)1 << (low % 64);
+        if ((chunk->bitmap[low / 64] & mask) != 0) {
+            return false;
+        }
+        chunk->bitmap[low / 64] |= mask;
+        chunk->cardinality++;
+        return true;
+    }
+    case DC_ROARING_RUNS: {
+        uint32_t const next = dc_roaring_runs_upper_bound(chunk->runs, chunk->length, low);
+        if (next > 0 && chunk->runs[next - 1].last >= low) {
+            return false;
+        }
+        bool const extends_previous =
+            next > 0 && (uint32_t)chunk->runs[next - 1].last + 1 == (uint32_t)low;
+        bool const extends_next =
+            next < chunk->length && (uint32_t)chunk->runs[next].start == (uint32_t)low + 1;
+
+        if (extends_previous && extends_next) {
+            chunk->runs[next - 1].last = chunk->runs[next].last;
+            memmove(&chunk->runs[next], &chunk->runs[next + 1],
+                    (chunk->length - next - 1) * sizeof(dc_roaring_run));
+            chunk->length--;
+        } else if (extends_previous) {
+            chunk->runs[next - 1].last = low;
+        } else if (extends_next) {
+            chunk->runs[next].start = low;
+        } else {
+            PRIV(NS(SELF, chunk_reserve))(self, chunk, chunk->length + 1);
+            memmove(&chunk->runs[next + 1], &chunk->runs[next],
+                    (chunk->length - next) * sizeof(dc_roaring_run));
+            chunk->runs[next] = (dc_roaring_run){.start = low, .last = low};
+            chunk->length++;
+        }
+        chunk->cardinality++;
+        PRIV(NS(SELF, chunk_fit_runs))(self, chunk);
+        return true;
+    }
+    }
+    DC_UNREACHABLE("Invalid roaring chunk kind");
+}
+
+// JUSTIFY: Bitmaps become arrays at half of `DC_ROARING_ARRAY_MAX`
+//  - Rather than at `DC_ROARING_ARRAY_MAX`, so alternately setting and unsetting an index at the
+//    boundary does not convert (and allocate) on every call.
+#define BITMAP_TO_ARRAY (DC_ROARING_ARRAY_MAX / 2)
+
+/// Removes the index from the chunk, returning whether it was present.
+static bool PRIV(NS(SELF, chunk_remove))(SELF* self, dc_roaring_chunk* chunk, uint16_t low) {
+    switch (chunk->kind) {
+    case DC_ROARING_ARRAY: {
+        uint32_t const position = dc_roaring_array_lower_bound(chunk->array, chunk->length, low);
+        if (position == chunk->length || chunk->array[position] != low) {
+            return false;
+        }
+        memmove(&chunk->array[position], &chunk->array[position + 1],
+                (chunk->length - position - 1) * sizeof(uint16_t));
+        chunk->length--;
+        chunk->cardinality--;
+        return true;
+    }
+    case DC_ROARING_BITMAP: {
+        uint64_t const mask = (uint64_t)1 << (low % 64);
+        if ((chunk->bitmap[low / 64] & mask) == 0) {
+            return false;
+        }
+        chunk->bitmap[low / 64] &= ~mask;
+        chunk->cardinality--;
+        if (chunk->cardinality > 0 && chunk->cardinality < BITMAP_TO_ARRAY) {
+            PRIV(NS(SELF, chunk_to_array))(self, chunk);
+        }
+        return true;
+    }
+    case DC_ROARING_RUNS: {
+        uint32_t const next = dc_roaring_runs_upper_bound(chunk->runs, chunk->length, low);
+        if (next == 0 || chunk->runs[next - 1].last < low) {
+            return false;
+        }
+        uint32_t const containing = next - 1;
+        dc_roaring_run const run = chunk->runs[containing];
+        if (run.start == run.last) {
+            memmove(&chunk->runs[containing], &chunk->runs[next],
+                    (chunk->length - next) * sizeof(dc_roaring_run));
+            chunk->length--;
+        } else if (low == run.start) {
+            chunk->runs[containing].start++;
+        } else if (low == run.last) {
+            chunk->runs[containing].last--;
+        } else {
+            PRIV(NS(SELF, chunk_reserve))(self, chunk, chunk->length + 1);
+            memmove(&chunk->runs[next + 1], &chunk->runs[next],
+                    (chunk->length - next) * sizeof(dc_roaring_run));
+            chunk->runs[containing].last = (uint16_t)(low - 1);
+            chunk->runs[next] = (dc_roaring_run){.start = (uint16_t)(low + 1), .last = run.last};
+            chunk->length++;
+        }
+        chunk->cardinality--;
+        PRIV(NS(SELF, chunk_fit_runs))(self, chunk);
+        return true;
+    }
+    }
+    DC_UNREACHABLE("Invalid roaring chunk kind");
+}
+
+#undef BITMAP_TO_ARRAY
+
+static dc_roaring_chunk PRIV(NS(SELF, chunk_clone))(SELF* self, dc_roaring_chunk const* chunk) {
+    dc_roaring_chunk cloned = *chunk;
+    size_t const bytes = PRIV(NS(SELF, chunk_bytes))(chunk);
+    void* data = NS(ALLOC, allocate_uninit)(self->alloc_ref, bytes);
+    switch (chunk->kind) {
+    case DC_ROARING_ARRAY:
+        memcpy(data, chunk->array, bytes);
+        cloned.array = (uint16_t*)data;
+        break;
+    case DC_ROARING_BITMAP:
+        memcpy(data, chunk->bitmap, bytes);
+        cloned.bitmap = (uint64_t*)data;
+        break;
+    case DC_ROARING_RUNS:
+        memcpy(data, chunk->runs, bytes);
+        cloned.runs = (dc_roaring_run*)data;
+        break;
+    }
+    return cloned;
+}
+
+/// Makes a chunk from an array of `length` values with space for `capacity`, unless empty.
+static bool PRIV(NS(SELF, chunk_from_array))(SELF* self, uint16_t key, uint16_t* values,
+                                             uint32_t length, uint32_t capacity,
+                                             dc_roaring_chunk* out) {
+    if (length == 0) {
+        NS(ALLOC, deallocate)(self->alloc_ref, values, capacity * sizeof(uint16_t));
+        return false;
+    }
+    out->array = values;
+    out->cardinality = length;
+    out->length = length;
+    out->capacity = capacity;
+    out->key = key;
+    out->kind = DC_ROARING_ARRAY;
+    return true;
+}
+
+/// Makes a chunk from `length` runs with space for `capacity`, unless empty.
+static bool PRIV(NS(SELF, chunk_from_runs))(SELF* self, uint16_t key, dc_roaring_run* runs,
+                                            uint32_t length, uint32_t capacity,
+                                            dc_roaring_chunk* out) {
+    if (length == 0) {
+        NS(ALLOC, deallocate)(self->alloc_ref, runs, capacity * sizeof(dc_roaring_run));
+        return false;
+    }
+    out->runs = runs;
+    out->cardinality = dc_roaring_runs_cardinality(runs, length);
+    out->length = length;
+    out->capacity = capacity;
+    out->key = key;
+    out->kind = DC_ROARING_RUNS;
+    PRIV(NS(SELF, chunk_fit_runs))(self, out);
+    return true;
+}
+
+/// Makes a chunk from a bitmap, as an array if it has few enough indices, unless empty.
+static bool PRIV(NS(SELF, chunk_from_bitmap))(SELF* self, uint16_t key, uint64_t* words,
+                                              dc_roaring_chunk* out) {
+    uint32_t const cardinality =
+        (uint32_t)dc_bitset_words_count_and(words, words, DC_ROARING_BITMAP_WORDS);
+    out->bitmap = words;
+    out->cardinality = cardinality;
+    out->length = 0;
+    out->capacity = DC_ROARING_BITMAP_WORDS;
+    out->key = key;
+    out->kind = DC_ROARING_BITMAP;
+    if (cardinality == 0) {
+        PRIV(NS(SELF, chunk_free))(self, out);
+        return false;
+    }
+    if (cardinality <= DC_ROARING_ARRAY_MAX) {
+        PRIV(NS(SELF, chunk_to_array))(self, out);
+    }
+    return true;
+}
+
+// JUSTIFY: Merging arrays of at most 64 values in total, otherwise probing a bitmap
+//  - Each step of a merge depends on the last (on which array advances), while probing is
+//    independent per value, so writing the other array to a bitmap pays off beyond a few dozen.
+#define ARRAY_MERGE_MAX 64
+
+/// Writes the values of the `array` chunk which are in `other`, `out` may be `NULL`.
+static uint32_t PRIV(NS(SELF, chunk_filter))(dc_roaring_chunk const* array,
+                                             dc_roaring_chunk const* other, uint16_t* out) {
+    DC_ASSUME(array->kind == DC_ROARING_ARRAY);
+    if (other->kind == DC_ROARING_ARRAY && array->length + other->length <= ARRAY_MERGE_MAX) {
+        return dc_roaring_array_and(array->array, array->length, other->array, other->length,
+                                    out);
+    }
+
+    uint64_t buffer[DC_ROARING_BITMAP_WORDS];
+    uint64_t const* words =
+        other->kind == DC_ROARING_RUNS ? NULL : PRIV(NS(SELF, chunk_words))(other, buffer);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < array->length; i++) {
+        uint16_t const value = array->array[i];
+        bool const contained = words != NULL
+                                   ? dc_roaring_bitmap_contains(words, value)
+                                   : dc_roaring_runs_contains(other->runs, other->length, value);
+        if (out) {
+            out[count] = value;
+        }
+        count += contained ? 1 : 0;
+    }
+    return count;
+}
+
+#undef ARRAY_MERGE_MAX
+
+// JUSTIFY: Intersecting with an array by filtering the (shorter) array
+//  - The intersection is at most the array, so costs at most a lookup per array index.
+static dc_roaring_chunk const* PRIV(NS(SELF, chunk_shorter_array))(dc_roaring_chunk const* left,
+                                                                   dc_roaring_chunk const* right) {
+    if (left->kind == DC_ROARING_ARRAY &&
+        (right->kind != DC_ROARING_ARRAY || left->length <= right->length)) {
+        return left;
+    }
+    return right->kind == DC_ROARING_ARRAY ? right : NULL;
+}
+
+static bool PRIV(NS(SELF, chunk_and))(SELF* self, dc_roaring_chunk const* left,
+                                      dc_roaring_chunk const* right, dc_roaring_chunk* out) {
+    DC_ASSUME(left->key == right->key);
+    dc_roaring_chunk const* array = PRIV(NS(SELF, chunk_shorter_array))(left, right);
+    if (array != NULL) {
+        dc_roaring_chunk const* other = array == left ? right : left;
+        uint16_t* values = (uint16_t*)NS(ALLOC, allocate_uninit)(
+            self->alloc_ref, array->length * sizeof(uint16_t));
+        uint32_t const length = PRIV(NS(SELF, chunk_filter))(array, other, values);
+        return PRIV(NS(SELF, chunk_from_array))(self, left->key, values, length, array->length,
+                                                out);
+    }
+
+    if (left->kind == DC_ROARING_RUNS && right->kind == DC_ROARING_RUNS) {
+        uint32_t const capacity = left->length + right->length;
+        dc_roaring_run* runs = (dc_roaring_run*)NS(ALLOC, allocate_uninit)(
+            self->alloc_ref, capacity * sizeof(dc_roaring_run));
+        uint32_t const length =
+            dc_roaring_runs_and(left->runs, left->length, right->runs, right->length, runs);
+        return PRIV(NS(SELF, chunk_from_runs))(self, left->key, runs, length, capacity, out);
+    }
+
+    uint64_t left_buffer[DC_ROARING_BITMAP_WORDS];
+    uint64_t right_buffer[DC_ROARING_BITMAP_WORDS];
+    uint64_t* words = (uint64_t*)NS(ALLOC, allocate_uninit)(
+        self->alloc_ref, DC_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    dc_bitset_words_and(words, PRIV(NS(SELF, chunk_words))(left, left_buffer),
+                        PRIV(NS(SELF, chunk_words))(right, right_buffer),
+                        DC_ROARING_BITMAP_WORDS);
+    return PRIV(NS(SELF, chunk_from_bitmap))(self, left->key, words, out);
+}
+
+static void PRIV(NS(SELF, chunk_or))(SELF* self, dc_roaring_chunk const* left,
+                                     dc_roaring_chunk const* right, dc_roaring_chunk* out) {
+    DC_ASSUME(left->key == right->key);
+    if (left->kind == DC_ROARING_ARRAY && right->kind == DC_ROARING_ARRAY &&
+        left->length + right->length <= DC_ROARING_ARRAY_MAX) {
+        uint32_t const capacity = left->length + right->length;
+        uint16_t* values = (uint16_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref,
+                                                                 capacity * sizeof(uint16_t));
+        uint32_t const length = dc_roaring_array_or(left->array, left->length, right->array,
+                                                    right->length, values);
+        DC_ASSERT(PRIV(NS(SELF, chunk_from_array))(self, left->key, values, length, capacity,
+                                                   out));
+        return;
+    }
+
+    if (left->kind == DC_ROARING_RUNS && right->kind == DC_ROARING_RUNS) {
+        uint32_t const capacity = left->length + right->length;
+        dc_roaring_run* runs = (dc_roaring_run*)NS(ALLOC, allocate_uninit)(
+            self->alloc_ref, capacity * sizeof(dc_roaring_run));
+        uint32_t const length =
+            dc_roaring_runs_or(left->runs, left->length, right->runs, right->length, runs);
+        DC_ASSERT(
+            PRIV(NS(SELF, chunk_from_runs))(self, left->key, runs, length, capacity, out));
+        return;
+    }
+
+    uint64_t left_buffer[DC_ROARING_BITMAP_WORDS];
+    uint64_t right_buffer[DC_ROARING_BITMAP_WORDS];
+    uint64_t* words = (uint64_t*)NS(ALLOC, allocate_uninit)(
+        self->alloc_ref, DC_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    dc_bitset_words_or(words, PRIV(NS(SELF, chunk_words))(left, left_buffer),
+                       PRIV(NS(SELF, chunk_words))(right, right_buffer), DC_ROARING_BITMAP_WORDS);
+    DC_ASSERT(PRIV(NS(SELF, chunk_from_bitmap))(self, left->key, words, out));
+}
+
+static uint32_t PRIV(NS(SELF, chunk_count_and))(dc_roaring_chunk const* left,
+                                                dc_roaring_chunk const* right) {
+    dc_roaring_chunk const* array = PRIV(NS(SELF, chunk_shorter_array))(left, right);
+    if (array != NULL) {
+        return PRIV(NS(SELF, chunk_filter))(array, array == left ? right : left, NULL);
+    }
+    if (left->kind == DC_ROARING_RUNS && right->kind == DC_ROARING_RUNS) {
+        return dc_roaring_runs_count_and(left->runs, left->length, right->runs, right->length);
+    }
+
+    uint64_t left_buffer[DC_ROARING_BITMAP_WORDS];
+    uint64_t right_buffer[DC_ROARING_BITMAP_WORDS];
+    return (uint32_t)dc_bitset_words_count_and(PRIV(NS(SELF, chunk_words))(left, left_buffer),
+                                               PRIV(NS(SELF, chunk_words))(right, right_buffer),
+                                               DC_ROARING_BITMAP_WORDS);
+}
+
+/// The position of the first chunk with a key not less than `key`, branchless as for arrays.
+static uint32_t PRIV(NS(SELF, chunk_lower_bound))(SELF const* self, uint16_t key) {
+    uint32_t length = self->chunks_count;
+    if (length == 0) {
+        return 0;
+    }
+    uint32_t base = 0;
+    while (length > 1) {
+        uint32_t const half = length / 2;
+        base = self->chunks[base + half - 1].key < key ? base + half : base;
+        length -= half;
+    }
+    return base + (self->chunks[base].key < key ? 1 : 0);
+}
+
+static void PRIV(NS(SELF, chunk_insert))(SELF* self, uint32_t position, dc_roaring_chunk chunk) {
+    if (self->chunks_count == self->chunks_capacity) {
+        uint32_t const capacity =
+            (uint32_t)dc_growth_double(self->chunks_capacity, self->chunks_count + 1);
+        self->chunks =
+            self->chunks == NULL
+                ? (dc_roaring_chunk*)NS(ALLOC, allocate_uninit)(
+                      self->alloc_ref, capacity * sizeof(dc_roaring_chunk))
+                : (dc_roaring_chunk*)NS(ALLOC, reallocate)(
+                      self->alloc_ref, self->chunks,
+                      self->chunks_capacity * sizeof(dc_roaring_chunk),
+                      capacity * sizeof(dc_roaring_chunk));
+        self->chunks_capacity = capacity;
+    }
+    memmove(&self->chunks[position + 1], &self->chunks[position],
+            (self->chunks_count - position) * sizeof(dc_roaring_chunk));
+    self->chunks[position] = chunk;
+    self->chunks_count++;
+    self->size += chunk.cardinality;
+}
+
+static void PRIV(NS(SELF, chunk_push))(SELF* self, dc_roaring_chunk chunk) {
+    PRIV(NS(SELF, chunk_insert))(self, self->chunks_count, chunk);
+}
+
+/// Sets the index (returning `true`). Every 32 bit index is valid.
+DC_PUBLIC static bool NS(SELF, try_set)(SELF* self, uint32_t index, bool value) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    uint16_t const key = DC_ROARING_INDEX_TO_KEY(index);
+    uint16_t const low = DC_ROARING_INDEX_TO_LOW(index);
+    uint32_t const position = PRIV(NS(SELF, chunk_lower_bound))(self, key);
+    bool const found = position < self->chunks_count && self->chunks[position].key == key;
+
+    if (!found) {
+        if (value) {
+            dc_roaring_chunk chunk = {
+                .array = NULL,
+                .cardinality = 0,
+                .length = 0,
+                .capacity = 0,
+                .key = key,
+                .kind = DC_ROARING_ARRAY,
+            };
+            PRIV(NS(SELF, chunk_reserve))(self, &chunk, 1);
+            chunk.array[0] = low;
+            chunk.length = 1;
+            chunk.cardinality = 1;
+            PRIV(NS(SELF, chunk_insert))(self, position, chunk);
+        }
+        return true;
+    }
+
+    dc_roaring_chunk* chunk = &self->chunks[position];
+    if (value) {
+        self->size += PRIV(NS(SELF, chunk_add))(self, chunk, low) ? 1 : 0;
+    } else if (PRIV(NS(SELF, chunk_remove))(self, chunk, low)) {
+        self->size--;
+        if (chunk->cardinality == 0) {
+            PRIV(NS(SELF, chunk_free))(self, chunk);
+            memmove(&self->chunks[position], &self->chunks[position + 1],
+                    (self->chunks_count - position - 1) * sizeof(dc_roaring_chunk));
+            self->chunks_count--;
+        }
+    }
+    return true;
+}
+
+DC_PUBLIC static void NS(SELF, set)(SELF* self, uint32_t index, bool value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(NS(SELF, try_set)(self, index, value), "Failed to set index {index=%u, value=%d}",
+              index, value);
+}
+
+DC_PUBLIC static bool NS(SELF, get)(SELF const* self, uint32_t index) {
+    INVARIANT_CHECK(self);
+    uint16_t const key = DC_ROARING_INDEX_TO_KEY(index);
+    uint32_t const position = PRIV(NS(SELF, chunk_lower_bound))(self, key);
+    return position < self->chunks_count && self->chunks[position].key == key &&
+           PRIV(NS(SELF, chunk_contains))(&self->chunks[position],
+                                          DC_ROARING_INDEX_TO_LOW(index));
+}
+
+/// The number of set indices, tracked on `set`.
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+/// The bytes allocated for the chunks array and each chunk's container.
+DC_PUBLIC static size_t NS(SELF, capacity_bytes)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    size_t bytes = self->chunks_capacity * sizeof(dc_roaring_chunk);
+    for (uint32_t i = 0; i < self->chunks_count; i++) {
+        bytes += PRIV(NS(SELF, chunk_bytes))(&self->chunks[i]);
+    }
+    return bytes;
+}
+
+/// Converts each chunk to runs, where the runs are smaller than its array or bitmap.
+///  - For indices set in ranges, which are otherwise stored one by one.
+DC_PUBLIC static void NS(SELF, run_optimize)(SELF* self) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+    for (uint32_t i = 0; i < self->chunks_count; i++) {
+        dc_roaring_chunk* chunk = &self->chunks[i];
+        if (chunk->kind == DC_ROARING_RUNS) {
+            continue;
+        }
+        uint32_t const runs =
+            chunk->kind == DC_ROARING_ARRAY
+                ? dc_roaring_array_to_runs(chunk->array, chunk->length, NULL)
+                : dc_roaring_bitmap_to_runs(chunk->bitmap, NULL);
+        size_t const bytes = chunk->kind == DC_ROARING_ARRAY
+                                 ? chunk->length * sizeof(uint16_t)
+                                 : DC_ROARING_BITMAP_WORDS * sizeof(uint64_t);
+        if (runs * sizeof(dc_roaring_run) < bytes) {
+            PRIV(NS(SELF, chunk_to_runs))(self, chunk, runs);
+        }
+    }
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    for (uint32_t i = 0; i < self->chunks_count; i++) {
+        PRIV(NS(SELF, chunk_free))(self, &self->chunks[i]);
+    }
+    if (self->chunks != NULL) {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->chunks,
+                              self->chunks_capacity * sizeof(dc_roaring_chunk));
+    }
+}
+
+// JUSTIFY: Bulk operations build the result, then replace `out` with it
+//  - So `out` may be `left` or `right` (as the `_assign` variants do), and its previous chunks
+//    are freed after the result is built.
+//  - The iterator invalidation tracker of `out` is kept, so iterators over it are invalidated.
+static void PRIV(NS(SELF, replace))(SELF* self, SELF* result) {
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+    NS(SELF, delete)(self);
+    self->chunks = result->chunks;
+    self->chunks_count = result->chunks_count;
+    self->chunks_capacity = result->chunks_capacity;
+    self->size = result->size;
+}
+
+/// Sets `out` to the indices in both `left` and `right`.
+DC_PUBLIC static void NS(SELF, and)(SELF const* left, SELF const* right, SELF* out) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    INVARIANT_CHECK(out);
+    SELF result = NS(SELF, new)(out->alloc_ref);
+
+    uint32_t l = 0;
+    uint32_t r = 0;
+    while (l < left->chunks_count && r < right->chunks_count) {
+        uint16_t const left_key = left->chunks[l].key;
+        uint16_t const right_key = right->chunks[r].key;
+        if (left_key < right_key) {
+            l++;
+        } else if (right_key < left_key) {
+            r++;
+        } else {
+            dc_roaring_chunk chunk;
+            if (PRIV(NS(SELF, chunk_and))(&result, &left->chunks[l], &right->chunks[r],
+                                          &chunk)) {
+                PRIV(NS(SELF, chunk_push))(&result, chunk);
+            }
+            l++;
+            r++;
+        }
+    }
+    PRIV(NS(SELF, replace))(out, &result);
+}
+
+/// Sets `out` to the indices in either `left` or `right`.
+DC_PUBLIC static void NS(SELF, or)(SELF const* left, SELF const* right, SELF* out) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    INVARIANT_CHECK(out);
+    SELF result = NS(SELF, new)(out->alloc_ref);
+
+    uint32_t l = 0;
+    uint32_t r = 0;
+    while (l < left->chunks_count || r < right->chunks_count) {
+        if (r == right->chunks_count ||
+            (l < left->chunks_count && left->chunks[l].key < right->chunks[r].key)) {
+            PRIV(NS(SELF, chunk_push))(&result,
+                                       PRIV(NS(SELF, chunk_clone))(&result, &left->chunks[l]));
+            l++;
+        } else if (l == left->chunks_count || right->chunks[r].key < left->chunks[l].key) {
+            PRIV(NS(SELF, chunk_push))(&result,
+                                       PRIV(NS(SELF, chunk_clone))(&result, &right->chunks[r]));
+            r++;
+        } else {
+            dc_roaring_chunk chunk;
+            PRIV(NS(SELF, chunk_or))(&result, &left->chunks[l], &right->chunks[r], &chunk);
+            PRIV(NS(SELF, chunk_push))(&result, chunk);
+            l++;
+            r++;
+        }
+    }
+    PRIV(NS(SELF, replace))(out, &result);
+}
+
+DC_PUBLIC static void NS(SELF, and_assign)(SELF* self, SELF const* other) {
+    NS(SELF, and)(self, other, self);
+}
+
+DC_PUBLIC static void NS(SELF, or_assign)(SELF* self, SELF const* other) {
+    NS(SELF, or)(self, other, self);
+}
+
+/// The number of indices set in both `left` and `right`, without building the intersection.
+DC_PUBLIC static size_t NS(SELF, count_and)(SELF const* left, SELF const* right) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    size_t count = 0;
+    uint32_t l = 0;
+    uint32_t r = 0;
+    while (l < left->chunks_count && r < right->chunks_count) {
+        uint16_t const left_key = left->chunks[l].key;
+        uint16_t const right_key = right->chunks[r].key;
+        if (left_key < right_key) {
+            l++;
+        } else if (right_key < left_key) {
+            r++;
+        } else {
+            count += PRIV(NS(SELF, chunk_count_and))(&left->chunks[l], &right->chunks[r]);
+            l++;
+            r++;
+        }
+    }
+    return count;
+}
+
+/// Whether any index is set in both `left` and `right`, stopping at the first such chunk.
+DC_PUBLIC static bool NS(SELF, any_and)(SELF const* left, SELF const* right) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    uint32_t l = 0;
+    uint32_t r = 0;
+    while (l < left->chunks_count && r < right->chunks_count) {
+        uint16_t const left_key = left->chunks[l].key;
+        uint16_t const right_key = right->chunks[r].key;
+        if (left_key < right_key) {
+            l++;
+        } else if (right_key < left_key) {
+            r++;
+        } else {
+            if (PRIV(NS(SELF, chunk_count_and))(&left->chunks[l], &right->chunks[r]) > 0) {
+                return true;
+            }
+            l++;
+            r++;
+        }
+    }
+    return false;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new)(self->alloc_ref);
+    for (uint32_t i = 0; i < self->chunks_count; i++) {
+        PRIV(NS(SELF, chunk_push))(&new_self,
+                                   PRIV(NS(SELF, chunk_clone))(&new_self, &self->chunks[i]));
+    }
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "chunks: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    for (uint32_t i = 0; i < self->chunks_count; i++) {
+        dc_roaring_chunk const* chunk = &self->chunks[i];
+        dc_debug_fmt_print(fmt, stream, "{ key: %u, kind: %s, cardinality: %u },\n",
+                           (unsigned)chunk->key, dc_roaring_kind_name(chunk->kind),
+                           chunk->cardinality);
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+// JUSTIFY: `size_t` items, with `SIZE_MAX` as the iterator's empty item
+//  - Every 32 bit index is valid, so none can mark the end of iteration.
+#define ITER_NONE SIZE_MAX
+
+// JUSTIFY: The iterator's `position` and `word` depend on the chunk's kind
+//  - Arrays: `position` is the next value's offset.
+//  - Bitmaps: `position` is the current word, and `word` the copy of it with unvisited bits.
+//  - Runs: `position` is the current run, and `word` its next value.
+#define ITER_ENTER NS(SELF, iter_enter)
+static void PRIV(ITER_ENTER)(SELF const* bitset, uint32_t chunk_index, uint32_t* position,
+                             uint64_t* word) {
+    *position = 0;
+    *word = 0;
+    if (chunk_index < bitset->chunks_count) {
+        dc_roaring_chunk const* chunk = &bitset->chunks[chunk_index];
+        if (chunk->kind == DC_ROARING_BITMAP) {
+            *word = chunk->bitmap[0];
+        } else if (chunk->kind == DC_ROARING_RUNS) {
+            *word = chunk->runs[0].start;
+        }
+    }
+}
+
+#define ITER_ADVANCE NS(SELF, iter_advance)
+static void PRIV(ITER_ADVANCE)(SELF const* bitset, uint32_t* chunk_index, uint32_t* position,
+                               uint64_t* word, size_t* next_index) {
+    while (*chunk_index < bitset->chunks_count) {
+        dc_roaring_chunk const* chunk = &bitset->chunks[*chunk_index];
+        size_t const base = (size_t)DC_ROARING_INDEX(chunk->key, 0);
+        switch (chunk->kind) {
+        case DC_ROARING_ARRAY:
+            if (*position < chunk->length) {
+                *next_index = base + chunk->array[*position];
+                (*position)++;
+                return;
+            }
+            break;
+        case DC_ROARING_BITMAP:
+            while (*word == 0 && *position + 1 < DC_ROARING_BITMAP_WORDS) {
+                (*position)++;
+                *word = chunk->bitmap[*position];
+            }
+            if (*word != 0) {
+                *next_index = base + ((size_t)*position * 64) + (size_t)__builtin_ctzll(*word);
+                *word &= *word - 1;
+                return;
+            }
+            break;
+        case DC_ROARING_RUNS:
+            if (*position < chunk->length) {
+                *next_index = base + (size_t)*word;
+                if (*word == chunk->runs[*position].last) {
+                    (*position)++;
+                    *word = *position < chunk->length ? chunk->runs[*position].start : 0;
+                } else {
+                    (*word)++;
+                }
+                return;
+            }
+            break;
+        }
+        (*chunk_index)++;
+        PRIV(ITER_ENTER)(bitset, *chunk_index, position, word);
+    }
+    *next_index = ITER_NONE;
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef struct {
+    SELF const* bitset;
+    uint32_t chunk_index;
+    uint32_t position;
+    uint64_t word;
+    size_t next_index;
+    mutation_version version;
+} ITER_CONST;
+typedef size_t NS(ITER_CONST, item);
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(size_t const* item) {
+    return *item == ITER_NONE;
+}
+
+DC_PUBLIC static size_t NS(ITER_CONST, next)(ITER_CONST* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->next_index == ITER_NONE) {
+        return ITER_NONE;
+    }
+
+    size_t next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->chunk_index, &iter->position, &iter->word,
+                       &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index == ITER_NONE;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+
+    ITER_CONST iter = {
+        .bitset = self,
+        .chunk_index = 0,
+        .position = 0,
+        .word = 0,
+        .next_index = ITER_NONE,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+    PRIV(ITER_ENTER)(self, 0, &iter.position, &iter.word);
+    PRIV(ITER_ADVANCE)(self, &iter.chunk_index, &iter.position, &iter.word, &iter.next_index);
+    return iter;
+}
+
+#undef ITER_CONST
+
+#define ITER NS(SELF, iter)
+typedef struct {
+    SELF* bitset;
+    uint32_t chunk_index;
+    uint32_t position;
+    uint64_t word;
+    size_t next_index;
+    mutation_version version;
+} ITER;
+typedef size_t NS(ITER, item);
+
+DC_PUBLIC static bool NS(ITER, empty_item)(size_t const* item) { return *item == ITER_NONE; }
+
+DC_PUBLIC static size_t NS(ITER, next)(ITER* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->next_index == ITER_NONE) {
+        return ITER_NONE;
+    }
+
+    size_t next_index = iter->next_index;
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->chunk_index, &iter->position, &iter->word,
+                       &iter->next_index);
+    return next_index;
+}
+
+DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index == ITER_NONE;
+}
+
+DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
+    INVARIANT_CHECK(self);
+
+    ITER iter = {
+        .bitset = self,
+        .chunk_index = 0,
+        .position = 0,
+        .word = 0,
+        .next_index = ITER_NONE,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+    PRIV(ITER_ENTER)(self, 0, &iter.position, &iter.word);
+    PRIV(ITER_ADVANCE)(self, &iter.chunk_index, &iter.position, &iter.word, &iter.next_index);
+    return iter;
+}
+
+#undef ITER
+#undef ITER_ADVANCE
+#undef ITER_ENTER
+#undef ITER_NONE
+#undef INVARIANT_CHECK
+
+DC_TRAIT_BITSET(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,377 @@
+/// @brief The chunk containers of `bitset/roaring`, and the set operations between them.
+///
+/// Each chunk holds the low 16 bits of the indices sharing the same high 16 bits (its `key`), as:
+///  - An array: the sorted low bits, for at most `DC_ROARING_ARRAY_MAX` indices.
+///  - A bitmap: 1024 words, one bit per low index.
+///  - Runs: sorted, disjoint and non adjacent inclusive ranges of low indices.
+///
+/// The functions here do not allocate, the template owns the chunk's memory. Functions producing
+/// arrays or runs write to `out` and return the count written (where noted, `out` may be `NULL`
+/// to only count).
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <derive-c/core/prelude.h>
+
+#define DC_ROARING_CHUNK_INDICES 65536
+#define DC_ROARING_BITMAP_WORDS 1024
+
+// JUSTIFY: Arrays of at most 4096 indices
+//  - At 4096 indices an array is the same size as a bitmap (8KB), after which the bitmap is
+//    smaller.
+#define DC_ROARING_ARRAY_MAX 4096
+
+#define DC_ROARING_INDEX_TO_KEY(INDEX) ((uint16_t)((INDEX) >> 16))
+#define DC_ROARING_INDEX_TO_LOW(INDEX) ((uint16_t)((INDEX) & 0xFFFF))
+#define DC_ROARING_INDEX(KEY, LOW) (((uint32_t)(KEY) << 16) | (uint32_t)(LOW))
+
+typedef enum {
+    DC_ROARING_ARRAY,
+    DC_ROARING_BITMAP,
+    DC_ROARING_RUNS,
+} dc_roaring_kind;
+
+typedef struct {
+    uint16_t start;
+    uint16_t last;
+} dc_roaring_run;
+
+typedef struct {
+    union {
+        uint16_t* array;
+        uint64_t* bitmap;
+        dc_roaring_run* runs;
+    };
+    uint32_t cardinality;
+    uint32_t length;
+    uint32_t capacity;
+    uint16_t key;
+    dc_roaring_kind kind;
+} dc_roaring_chunk;
+
+DC_PUBLIC static char const* dc_roaring_kind_name(dc_roaring_kind kind) {
+    switch (kind) {
+    case DC_ROARING_ARRAY:
+        return "array";
+    case DC_ROARING_BITMAP:
+        return "bitmap";
+    case DC_ROARING_RUNS:
+        return "runs";
+    }
+    DC_UNREACHABLE("Invalid roaring chunk kind");
+}
+
+// JUSTIFY: Branchless binary searches
+//  - Each comparison of a lookup is unpredictable, so selecting the half (as a conditional move)
+//    rather than branching avoids a mispredict per step.
+
+/// The position of the first value not less than `value`.
+DC_PUBLIC static uint32_t dc_roaring_array_lower_bound(uint16_t const* values, uint32_t length,
+                                                       uint16_t value) {
+    if (length == 0) {
+        return 0;
+    }
+    uint32_t base = 0;
+    while (length > 1) {
+        uint32_t const half = length / 2;
+        base = values[base + half - 1] < value ? base + half : base;
+        length -= half;
+    }
+    return base + (values[base] < value ? 1 : 0);
+}
+
+/// The number of runs starting at or before `value`, so the run containing `value` (if any) is
+/// the one before.
+DC_PUBLIC static uint32_t dc_roaring_runs_upper_bound(dc_roaring_run const* runs, uint32_t length,
+                                                      uint16_t value) {
+    if (length == 0) {
+        return 0;
+    }
+    uint32_t base = 0;
+    while (length > 1) {
+        uint32_t const half = length / 2;
+        base = runs[base + half - 1].start <= value ? base + half : base;
+        length -= half;
+    }
+    return base + (runs[base].start <= value ? 1 : 0);
+}
+
+DC_PUBLIC static bool dc_roaring_array_contains(uint16_t const* values, uint32_t length,
+                                                uint16_t value) {
+    uint32_t const position = dc_roaring_array_lower_bound(values, length, value);
+    return position < length && values[position] == value;
+}
+
+DC_PUBLIC static bool dc_roaring_runs_contains(dc_roaring_run const* runs, uint32_t length,
+                                               uint16_t value) {
+    uint32_t const position = dc_roaring_runs_upper_bound(runs, length, value);
+    return position > 0 && runs[position - 1].last >= value;
+}
+
+DC_PUBLIC static bool dc_roaring_bitmap_contains(uint64_t const* words, uint16_t value) {
+    return (words[value / 64] & ((uint64_t)1 << (value % 64))) != 0;
+}
+
+DC_PUBLIC static uint32_t dc_roaring_runs_cardinality(dc_roaring_run const* runs,
+                                                      uint32_t length) {
+    uint32_t cardinality = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        cardinality += (uint32_t)runs[i].last - (uint32_t)runs[i].start + 1;
+    }
+    return cardinality;
+}
+
+// JUSTIFY: Branchless merges of arrays
+//  - Whether the left or right value is smaller is unpredictable, so both positions advance by
+//    the result of a comparison, and each value is written before knowing if it is kept.
+//  - The comparisons are stored as integers, as otherwise gcc branches on them to advance `r`.
+
+/// Writes the values in both sorted arrays, `out` may be `NULL`.
+DC_PUBLIC static uint32_t dc_roaring_array_and(uint16_t const* left, uint32_t left_length,
+                                               uint16_t const* right, uint32_t right_length,
+                                               uint16_t* out) {
+    uint32_t count = 0;
+    uint32_t l = 0;
+    uint32_t r = 0;
+    if (out) {
+        while (l < left_length && r < right_length) {
+            uint16_t const left_value = left[l];
+            uint16_t const right_value = right[r];
+            uint32_t const advance_left = left_value <= right_value;
+            uint32_t const advance_right = right_value <= left_value;
+            out[count] = left_value;
+            count += advance_left & advance_right;
+            l += advance_left;
+            r += advance_right;
+        }
+    } else {
+        while (l < left_length && r < right_length) {
+            uint16_t const left_value = left[l];
+            uint16_t const right_value = right[r];
+            uint32_t const advance_left = left_value <= right_value;
+            uint32_t const advance_right = right_value <= left_value;
+            count += advance_left & advance_right;
+            l += advance_left;
+            r += advance_right;
+        }
+    }
+    return count;
+}
+
+/// Writes the values in either sorted array, to an `out` with space for both.
+DC_PUBLIC static uint32_t dc_roaring_array_or(uint16_t const* left, uint32_t left_length,
+                                              uint16_t const* right, uint32_t right_length,
+                                              uint16_t* out) {
+    uint32_t count = 0;
+    uint32_t l = 0;
+    uint32_t r = 0;
+    while (l < left_length && r < right_length) {
+        uint16_t const left_value = left[l];
+        uint16_t const right_value = right[r];
+        uint32_t const advance_left = left_value <= right_value;
+        uint32_t const advance_right = right_value <= left_value;
+        out[count++] = advance_left ? left_value : right_value;
+        l += advance_left;
+        r += advance_right;
+    }
+    memcpy(&out[count], &left[l], (left_length - l) * sizeof(uint16_t));
+    count += left_length - l;
+    memcpy(&out[count], &right[r], (right_length - r) * sizeof(uint16_t));
+    count += right_length - r;
+    return count;
+}
+
+/// Writes the overlaps of the runs, which are disjoint and non adjacent as the inputs' are, `out`
+/// may be `NULL`.
+DC_PUBLIC static uint32_t dc_roaring_runs_and(dc_roaring_run const* left, uint32_t left_length,
+                                              dc_roaring_run const* right, uint32_t right_length,
+                                              dc_roaring_run* out) {
+    uint32_t count = 0;
+    uint32_t l = 0;
+    uint32_t r = 0;
+    while (l < left_length && r < right_length) {
+        uint16_t const start = left[l].start > right[r].start ? left[l].start : right[r].start;
+        uint16_t const last = left[l].last < right[r].last ? left[l].last : right[r].last;
+        if (start <= last) {
+            if (out) {
+                out[count] = (dc_roaring_run){.start = start, .last = last};
+            }
+            count++;
+        }
+        if (left[l].last < right[r].last) {
+            l++;
+        } else {
+            r++;
+        }
+    }
+    return count;
+}
+
+/// The number of values in both runs, without writing the overlaps.
+DC_PUBLIC static uint32_t dc_roaring_runs_count_and(dc_roaring_run const* left,
+                                                    uint32_t left_length,
+                                                    dc_roaring_run const* right,
+                                                    uint32_t right_length) {
+    uint32_t cardinality = 0;
+    uint32_t l = 0;
+    uint32_t r = 0;
+    while (l < left_length && r < right_length) {
+        uint16_t const start = left[l].start > right[r].start ? left[l].start : right[r].start;
+        uint16_t const last = left[l].last < right[r].last ? left[l].last : right[r].last;
+        if (start <= last) {
+            cardinality += (uint32_t)last - (uint32_t)start + 1;
+        }
+        if (left[l].last < right[r].last) {
+            l++;
+        } else {
+            r++;
+        }
+    }
+    return cardinality;
+}
+
+/// Writes the union of the runs, merging overlapping and adjacent runs, `out` may be `NULL`.
+DC_PUBLIC static uint32_t dc_roaring_runs_or(dc_roaring_run const* left, uint32_t left_length,
+                                             dc_roaring_run const* right, uint32_t right_length,
+                                             dc_roaring_run* out) {
+    uint32_t count = 0;
+    uint32_t l = 0;
+    uint32_t r = 0;
+    dc_roaring_run current = {.start = 0, .last = 0};
+    bool has_current = false;
+    while (l < left_length || r < right_length) {
+        dc_roaring_run next;
+        if (r == right_length || (l < left_length && left[l].start <= right[r].start)) {
+            next = left[l++];
+        } else {
+            next = right[r++];
+        }
+
+        if (has_current && (uint32_t)next.start <= (uint32_t)current.last + 1) {
+            current.last = next.last > current.last ? next.last : current.last;
+        } else {
+            if (has_current) {
+                if (out) {
+                    out[count] = current;
+                }
+                count++;
+            }
+            current = next;
+            has_current = true;
+        }
+    }
+    if (has_current) {
+        if (out) {
+            out[count] = current;
+        }
+        count++;
+    }
+    return count;
+}
+
+/// Writes the runs of consecutive values in a sorted array, `out` may be `NULL`.
+DC_PUBLIC static uint32_t dc_roaring_array_to_runs(uint16_t const* values, uint32_t length,
+                                                   dc_roaring_run* out) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length;) {
+        uint32_t j = i;
+        while (j + 1 < length && values[j + 1] == values[j] + 1) {
+            j++;
+        }
+        if (out) {
+            out[count] = (dc_roaring_run){.start = values[i], .last = values[j]};
+        }
+        count++;
+        i = j + 1;
+    }
+    return count;
+}
+
+DC_PUBLIC static uint32_t dc_roaring_runs_to_array(dc_roaring_run const* runs, uint32_t length,
+                                                   uint16_t* out) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        for (uint32_t value = runs[i].start; value <= runs[i].last; value++) {
+            out[count++] = (uint16_t)value;
+        }
+    }
+    return count;
+}
+
+DC_PUBLIC static uint32_t dc_roaring_bitmap_to_array(uint64_t const* words, uint16_t* out) {
+    uint32_t count = 0;
+    for (uint32_t word_index = 0; word_index < DC_ROARING_BITMAP_WORDS; word_index++) {
+        uint64_t word = words[word_index];
+        while (word != 0) {
+            out[count++] = (uint16_t)((word_index * 64) + (uint32_t)__builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+    return count;
+}
+
+// JUSTIFY: Finding each run's start and end with `ctz`
+//  - Filling the bits below the lowest set bit makes the run the trailing ones of the word, so
+//    the end is the `ctz` of the complement, continuing into the next words while they are full.
+/// Writes the runs of set bits, `out` may be `NULL`.
+DC_PUBLIC static uint32_t dc_roaring_bitmap_to_runs(uint64_t const* words, dc_roaring_run* out) {
+    uint32_t count = 0;
+    uint32_t word_index = 0;
+    uint64_t word = words[0];
+    for (;;) {
+        while (word == 0) {
+            if (++word_index == DC_ROARING_BITMAP_WORDS) {
+                return count;
+            }
+            word = words[word_index];
+        }
+        uint32_t const start = (word_index * 64) + (uint32_t)__builtin_ctzll(word);
+
+        word |= word - 1;
+        while (word == ~(uint64_t)0) {
+            if (++word_index == DC_ROARING_BITMAP_WORDS) {
+                if (out) {
+                    out[count] = (dc_roaring_run){.start = (uint16_t)start, .last = UINT16_MAX};
+                }
+                return count + 1;
+            }
+            word = words[word_index];
+        }
+        uint32_t const end = (word_index * 64) + (uint32_t)__builtin_ctzll(~word);
+        if (out) {
+            out[count] = (dc_roaring_run){.start = (uint16_t)start, .last = (uint16_t)(end - 1)};
+        }
+        count++;
+        word &= word + 1;
+    }
+}
+
+DC_PUBLIC static void dc_roaring_bitmap_set_array(uint64_t* words, uint16_t const* values,
+                                                  uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        words[values[i] / 64] |= (uint64_t)1 << (values[i] % 64);
+    }
+}
+
+DC_PUBLIC static void dc_roaring_bitmap_set_runs(uint64_t* words, dc_roaring_run const* runs,
+                                                 uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        uint32_t const first_word = runs[i].start / 64;
+        uint32_t const last_word = runs[i].last / 64;
+        uint64_t const first_mask = ~(uint64_t)0 << (runs[i].start % 64);
+        uint64_t const last_mask = ~(uint64_t)0 >> (63 - (runs[i].last % 64));
+        if (first_word == last_word) {
+            words[first_word] |= first_mask & last_mask;
+        } else {
+            words[first_word] |= first_mask;
+            for (uint32_t word = first_word + 1; word < last_word; word++) {
+                words[word] = ~(uint64_t)0;
+            }
+            words[last_word] |= last_mask;
+        }
+    }
+}
@@ -6,6 +6,7 @@
 
 // [DERIVE-C] lib includes
 #include <derive-c/container/bitset/trait.h>      // IWYU pragma: export
+#include <derive-c/container/bitset/words.h>      // IWYU pragma: export
 #include <derive-c/core/debug/gdb_marker.h>       // IWYU pragma: export
 #include <derive-c/core/debug/mutation_tracker.h> // IWYU pragma: export
 #include <derive-c/core/prelude.h>                // IWYU pragma: export
@@ -28,8 +28,17 @@ typedef INDEX_TYPE NS(SELF, index_t);
 DC_STATIC_CONSTANT INDEX_TYPE NS(SELF, max_index) = EXCLUSIVE_END_INDEX - 1;
 DC_STATIC_CONSTANT INDEX_TYPE NS(SELF, min_index) = 0;
 
+/// Returned by `find_first_set` and `find_next_set` when there is no set index.
+DC_STATIC_CONSTANT size_t NS(SELF, exclusive_end_index) = EXCLUSIVE_END_INDEX;
+
+#define WORDS DC_BITSET_STATIC_CAPACITY_TO_WORDS(EXCLUSIVE_END_INDEX)
+
+// JUSTIFY: 64 bit words
+//  - Iteration, search and counting skip 64 unset indices per load, and use a single
+//    `ctz`/`popcount` per word.
+//  - Bits past the `EXCLUSIVE_END_INDEX` in the last word are never set.
 typedef struct {
-    uint8_t bits[DC_BITSET_STATIC_CAPACITY_TO_BYTES(EXCLUSIVE_END_INDEX)];
+    uint64_t words[WORDS];
     dc_gdb_marker derive_c_bitset_static;
     mutation_tracker iterator_invalidation_tracker;
 } SELF;
@@ -38,7 +47,7 @@ typedef struct {
 
 DC_PUBLIC static SELF NS(SELF, new)() {
     return (SELF){
-        .bits = {},
+        .words = {},
         .derive_c_bitset_static = dc_gdb_marker_new(),
         .iterator_invalidation_tracker = mutation_tracker_new(),
     };
@@ -58,14 +67,14 @@ DC_PUBLIC static bool NS(SELF, try_set)(SELF* self, INDEX_TYPE index, bool value
     }
 #endif
 
-    INDEX_TYPE byte = DC_BITSET_STATIC_INDEX_TO_BYTES(index);
-    INDEX_TYPE offset = DC_BITSET_STATIC_INDEX_TO_OFFSET(index);
-    uint8_t mask = DC_BITSET_STATIC_OFFSET_TO_MASK(offset);
+    size_t word = DC_BITSET_STATIC_INDEX_TO_WORDS((size_t)index);
+    INDEX_TYPE offset = DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index);
+    uint64_t mask = DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(offset);
 
     if (value) {
-        self->bits[byte] = self->bits[byte] | mask;
+        self->words[word] = self->words[word] | mask;
     } else {
-        self->bits[byte] = self->bits[byte] & (~mask);
+        self->words[word] = self->words[word] & (~mask);
     }
     return true;
 }
@@ -86,10 +95,35 @@ DC_PUBLIC static bool NS(SELF, get)(SELF const* self, INDEX_TYPE index) {
               EXCLUSIVE_END_INDEX);
 #endif
 
-    INDEX_TYPE byte = DC_BITSET_STATIC_INDEX_TO_BYTES(index);
-    INDEX_TYPE offset = DC_BITSET_STATIC_INDEX_TO_OFFSET(index);
-    uint8_t mask = DC_BITSET_STATIC_OFFSET_TO_MASK(offset);
-    return (self->bits[byte] & mask) != 0;
+    size_t word = DC_BITSET_STATIC_INDEX_TO_WORDS((size_t)index);
+    INDEX_TYPE offset = DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(index);
+    uint64_t mask = DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(offset);
+    return (self->words[word] & mask) != 0;
+}
+
+/// Returns the first set index at or after `from`, or `exclusive_end_index` if there is none.
+DC_PUBLIC static size_t NS(SELF, find_next_set)(SELF const* self, size_t from) {
+    INVARIANT_CHECK(self);
+    if (from >= EXCLUSIVE_END_INDEX) {
+        return EXCLUSIVE_END_INDEX;
+    }
+
+    size_t word_index = DC_BITSET_STATIC_INDEX_TO_WORDS(from);
+    uint64_t word =
+        self->words[word_index] & (~(uint64_t)0 << DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(from));
+    while (word == 0) {
+        word_index++;
+        if (word_index == WORDS) {
+            return EXCLUSIVE_END_INDEX;
+        }
+        word = self->words[word_index];
+    }
+    return (word_index * 64) + (size_t)__builtin_ctzll(word);
+}
+
+/// Returns the first set index, or `exclusive_end_index` if there is none.
+DC_PUBLIC static size_t NS(SELF, find_first_set)(SELF const* self) {
+    return NS(SELF, find_next_set)(self, 0);
 }
 
 DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
@@ -98,12 +132,11 @@ DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE*
 
     dc_debug_fmt_print(fmt, stream, "blocks: [\n");
     fmt = dc_debug_fmt_scope_begin(fmt);
-    for (size_t index = 0; index < EXCLUSIVE_END_INDEX; index++) {
-        if (NS(SELF, get)(self, (INDEX_TYPE)index)) {
-            dc_debug_fmt_print(fmt, stream, "{ byte: %lu, offset: %lu, index: %lu},\n",
-                               DC_BITSET_STATIC_INDEX_TO_BYTES(index),
-                               DC_BITSET_STATIC_INDEX_TO_OFFSET(index), index);
-        }
+    for (size_t index = NS(SELF, find_first_set)(self); index < EXCLUSIVE_END_INDEX;
+         index = NS(SELF, find_next_set)(self, index + 1)) {
+        dc_debug_fmt_print(fmt, stream, "{ byte: %lu, offset: %lu, index: %lu},\n",
+                           DC_BITSET_STATIC_INDEX_TO_BYTES(index),
+                           DC_BITSET_STATIC_INDEX_TO_OFFSET(index), index);
     }
     fmt = dc_debug_fmt_scope_end(fmt);
     dc_debug_fmt_print(fmt, stream, "],\n");
@@ -118,21 +151,90 @@ DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
         .derive_c_bitset_static = dc_gdb_marker_new(),
         .iterator_invalidation_tracker = mutation_tracker_new(),
     };
-    memcpy(&new_self.bits, &self->bits, sizeof(self->bits));
+    memcpy(&new_self.words, &self->words, sizeof(self->words));
     return new_self;
 }
 
 DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
     size_t size = 0;
-
-    for (INDEX_TYPE byte = 0;
-         byte < (INDEX_TYPE)DC_BITSET_STATIC_CAPACITY_TO_BYTES(EXCLUSIVE_END_INDEX); byte++) {
-        size += (uint32_t)__builtin_popcount((unsigned int)self->bits[byte]);
+    for (size_t word = 0; word < WORDS; word++) {
+        size += (size_t)__builtin_popcountll(self->words[word]);
     }
-
     return size;
 }
 
+// JUSTIFY: Bulk operations write to an `out` bitset
+//  - So results can be written to existing bitsets, and `out` may be `left` or `right` for an in
+//    place operation (as the `_assign` variants do).
+//  - Bits past the `EXCLUSIVE_END_INDEX` are unset in both inputs, so remain unset in `out`.
+
+/// Sets `out` to `left & right`.
+DC_PUBLIC static void NS(SELF, and)(SELF const* left, SELF const* right, SELF* out) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    INVARIANT_CHECK(out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_and(out->words, left->words, right->words, WORDS);
+}
+
+/// Sets `out` to `left | right`.
+DC_PUBLIC static void NS(SELF, or)(SELF const* left, SELF const* right, SELF* out) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    INVARIANT_CHECK(out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_or(out->words, left->words, right->words, WORDS);
+}
+
+/// Sets `out` to `left ^ right`.
+DC_PUBLIC static void NS(SELF, xor)(SELF const* left, SELF const* right, SELF* out) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    INVARIANT_CHECK(out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_xor(out->words, left->words, right->words, WORDS);
+}
+
+/// Sets `out` to `left & ~right`, the indices of `left` not in `right`.
+DC_PUBLIC static void NS(SELF, andnot)(SELF const* left, SELF const* right, SELF* out) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    INVARIANT_CHECK(out);
+    mutation_tracker_mutate(&out->iterator_invalidation_tracker);
+    dc_bitset_words_andnot(out->words, left->words, right->words, WORDS);
+}
+
+DC_PUBLIC static void NS(SELF, and_assign)(SELF* self, SELF const* other) {
+    NS(SELF, and)(self, other, self);
+}
+
+DC_PUBLIC static void NS(SELF, or_assign)(SELF* self, SELF const* other) {
+    NS(SELF, or)(self, other, self);
+}
+
+DC_PUBLIC static void NS(SELF, xor_assign)(SELF* self, SELF const* other) {
+    NS(SELF, xor)(self, other, self);
+}
+
+DC_PUBLIC static void NS(SELF, andnot_assign)(SELF* self, SELF const* other) {
+    NS(SELF, andnot)(self, other, self);
+}
+
+/// The number of indices set in both `left` and `right`, without building the intersection.
+DC_PUBLIC static size_t NS(SELF, count_and)(SELF const* left, SELF const* right) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    return dc_bitset_words_count_and(left->words, right->words, WORDS);
+}
+
+/// Whether any index is set in both `left` and `right`, stopping at the first such word.
+DC_PUBLIC static bool NS(SELF, any_and)(SELF const* left, SELF const* right) {
+    INVARIANT_CHECK(left);
+    INVARIANT_CHECK(right);
+    return dc_bitset_words_any_and(left->words, right->words, WORDS);
+}
+
 DC_PUBLIC static void NS(SELF, delete)(SELF* self) { INVARIANT_CHECK(self); }
 
 // JUSTIFY: Larger iter index type if the exclusive end is larger than the max representable index.
@@ -144,9 +246,30 @@ DC_PUBLIC static void NS(SELF, delete)(SELF* self) { INVARIANT_CHECK(self); }
     #define ITER_INDEX_TYPE INDEX_LARGER_TYPE
 #endif
 
+// JUSTIFY: Iterating by clearing the lowest set bit of a copy of the current word
+//  - Each `next` is a `ctz` and a clear, plus one load per word, so iteration is proportional to
+//    the number of set indices and words, rather than to the number of indices.
+//  - Copying the word is safe, as any mutation of the bitset invalidates the iterator.
+#define ITER_ADVANCE NS(SELF, iter_advance)
+static void PRIV(ITER_ADVANCE)(SELF const* bitset, size_t* word_index, uint64_t* word,
+                               ITER_INDEX_TYPE* next_index) {
+    while (*word == 0) {
+        (*word_index)++;
+        if (*word_index >= WORDS) {
+            *next_index = EXCLUSIVE_END_INDEX;
+            return;
+        }
+        *word = bitset->words[*word_index];
+    }
+    *next_index = (ITER_INDEX_TYPE)((*word_index * 64) + (size_t)__builtin_ctzll(*word));
+    *word &= *word - 1;
+}
+
 #define ITER_CONST NS(SELF, iter_const)
 typedef struct {
     SELF const* bitset;
+    size_t word_index;
+    uint64_t word;
     ITER_INDEX_TYPE next_index;
     mutation_version version;
 } ITER_CONST;
@@ -165,11 +288,7 @@ DC_PUBLIC static ITER_INDEX_TYPE NS(ITER_CONST, next)(ITER_CONST* iter) {
     }
 
     ITER_INDEX_TYPE next_index = iter->next_index;
-    iter->next_index++;
-    while (iter->next_index < EXCLUSIVE_END_INDEX &&
-           !NS(SELF, get)(iter->bitset, (INDEX_TYPE)iter->next_index)) {
-        iter->next_index++;
-    }
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
     return next_index;
 }
 
@@ -182,16 +301,15 @@ DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
 DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
     INVARIANT_CHECK(self);
 
-    ITER_INDEX_TYPE next_index = 0;
-    while (next_index < EXCLUSIVE_END_INDEX && !NS(SELF, get)(self, (INDEX_TYPE)next_index)) {
-        next_index++;
-    }
-
-    return (ITER_CONST){
+    ITER_CONST iter = {
         .bitset = self,
-        .next_index = next_index,
+        .word_index = 0,
+        .word = self->words[0],
+        .next_index = EXCLUSIVE_END_INDEX,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
 }
 
 #undef ITER_CONST
@@ -199,6 +317,8 @@ DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
 #define ITER NS(SELF, iter)
 typedef struct {
     SELF* bitset;
+    size_t word_index;
+    uint64_t word;
     ITER_INDEX_TYPE next_index;
     mutation_version version;
 } ITER;
@@ -217,11 +337,7 @@ DC_PUBLIC static ITER_INDEX_TYPE NS(ITER, next)(ITER* iter) {
     }
 
     ITER_INDEX_TYPE next_index = iter->next_index;
-    iter->next_index++;
-    while (iter->next_index < EXCLUSIVE_END_INDEX &&
-           !NS(SELF, get)(iter->bitset, (INDEX_TYPE)iter->next_index)) {
-        iter->next_index++;
-    }
+    PRIV(ITER_ADVANCE)(iter->bitset, &iter->word_index, &iter->word, &iter->next_index);
     return next_index;
 }
 
@@ -234,21 +350,22 @@ DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
 DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
     INVARIANT_CHECK(self);
 
-    ITER_INDEX_TYPE next_index = 0;
-    while (next_index < EXCLUSIVE_END_INDEX && !NS(SELF, get)(self, (INDEX_TYPE)next_index)) {
-        next_index++;
-    }
-
-    return (ITER){
+    ITER iter = {
         .bitset = self,
-        .next_index = next_index,
+        .word_index = 0,
+        .word = self->words[0],
+        .next_index = EXCLUSIVE_END_INDEX,
         .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
     };
+    PRIV(ITER_ADVANCE)(self, &iter.word_index, &iter.word, &iter.next_index);
+    return iter;
 }
 
 #undef ITER
+#undef ITER_ADVANCE
 #undef ITER_INDEX_TYPE
 #undef INVARIANT_CHECK
+#undef WORDS
 
 #include <derive-c/core/index/bits_to_type/undef.h>
 #include <derive-c/core/index/capacity_to_bits/undef.h>
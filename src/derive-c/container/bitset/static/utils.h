@@ -4,3 +4,8 @@
 #define DC_BITSET_STATIC_INDEX_TO_BYTES(INDEX) (INDEX >> (uint8_t)3)
 #define DC_BITSET_STATIC_INDEX_TO_OFFSET(INDEX) (INDEX & 0x7)
 #define DC_BITSET_STATIC_OFFSET_TO_MASK(OFFSET) (uint8_t)((uint8_t)1 << (uint8_t)OFFSET)
+
+#define DC_BITSET_STATIC_CAPACITY_TO_WORDS(CAPACITY) (((CAPACITY) + 63ULL) / 64ULL)
+#define DC_BITSET_STATIC_INDEX_TO_WORDS(INDEX) ((INDEX) >> (uint8_t)6)
+#define DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET(INDEX) ((INDEX) & 0x3F)
+#define DC_BITSET_STATIC_WORD_OFFSET_TO_MASK(OFFSET) (uint64_t)((uint64_t)1 << (uint8_t)(OFFSET))
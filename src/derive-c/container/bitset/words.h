@@ -0,0 +1,246 @@
+/// @brief Bulk operations over arrays of 64 bit bitset words, shared by the bitset templates.
+///
+/// Each operation takes `words` words from each input:
+///  - `and`, `or`, `xor` and `andnot` (`left & ~right`) write to `out`, which may be `left` or
+///    `right` (for in place operations), but must not otherwise overlap them.
+///  - `count_and` is the popcount of the intersection, `any_and` is whether it is nonempty.
+///  - `set`, `reset` and the `cursor` work on single bits, for containers (such as the arenas)
+///    keeping a bitmap alongside their storage.
+///  - On x86 the AVX2 kernels are selected at runtime with `dc_cpu_features_get`, otherwise the
+///    scalar word loops are used (which the compiler can vectorise for the enabled ISA).
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <derive-c/core/prelude.h>
+#include <derive-c/test/mock.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define DC_BITSET_WORDS_X86
+    #include <immintrin.h>
+#endif
+
+typedef enum {
+    DC_BITSET_ISA_SCALAR,
+    DC_BITSET_ISA_AVX2,
+} dc_bitset_isa;
+
+// JUSTIFY: Mockable
+//  - So tests can check the scalar and AVX2 kernels on a machine supporting both.
+DC_MOCKABLE(dc_bitset_isa, dc_bitset_isa_get, (void)) {
+#if defined DC_BITSET_WORDS_X86
+    dc_cpu_features const features = dc_cpu_features_get();
+    if (features.AVX2.compiled_with || features.AVX2.runtime_supported) {
+        return DC_BITSET_ISA_AVX2;
+    }
+#endif
+    return DC_BITSET_ISA_SCALAR;
+}
+
+#define _DC_BITSET_WORDS_SCALAR_BINARY(NAME, OP)                                                   \
+    DC_PUBLIC static void _dc_bitset_words_##NAME##_scalar(                                        \
+        uint64_t* out, uint64_t const* left, uint64_t const* right, size_t from, size_t words) {   \
+        for (size_t i = from; i < words; i++) {                                                    \
+            out[i] = OP(left[i], right[i]);                                                        \
+        }                                                                                          \
+    }
+
+#define _DC_BITSET_WORDS_AND(L, R) ((L) & (R))
+#define _DC_BITSET_WORDS_OR(L, R) ((L) | (R))
+#define _DC_BITSET_WORDS_XOR(L, R) ((L) ^ (R))
+#define _DC_BITSET_WORDS_ANDNOT(L, R) ((L) & ~(R))
+
+_DC_BITSET_WORDS_SCALAR_BINARY(and, _DC_BITSET_WORDS_AND)
+_DC_BITSET_WORDS_SCALAR_BINARY(or, _DC_BITSET_WORDS_OR)
+_DC_BITSET_WORDS_SCALAR_BINARY(xor, _DC_BITSET_WORDS_XOR)
+_DC_BITSET_WORDS_SCALAR_BINARY(andnot, _DC_BITSET_WORDS_ANDNOT)
+
+DC_PUBLIC static size_t _dc_bitset_words_count_and_scalar(uint64_t const* left,
+                                                          uint64_t const* right, size_t from,
+                                                          size_t words) {
+    size_t count = 0;
+    for (size_t i = from; i < words; i++) {
+        count += (size_t)__builtin_popcountll(left[i] & right[i]);
+    }
+    return count;
+}
+
+DC_PUBLIC static bool _dc_bitset_words_any_and_scalar(uint64_t const* left, uint64_t const* right,
+                                                      size_t from, size_t words) {
+    for (size_t i = from; i < words; i++) {
+        if ((left[i] & right[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined DC_BITSET_WORDS_X86
+
+    // JUSTIFY: Unaligned loads
+    //  - Bitset storage is only 8 byte aligned, and unaligned loads of aligned data are as fast.
+    #define _DC_BITSET_WORDS_AVX2_BINARY(NAME, VOP)                                                \
+        DC_PUBLIC __attribute__((target("avx2"))) static void _dc_bitset_words_##NAME##_avx2(      \
+            uint64_t* out, uint64_t const* left, uint64_t const* right, size_t words) {            \
+            size_t const vector_end = words - (words % 4);                                         \
+            for (size_t i = 0; i < vector_end; i += 4) {                                           \
+                __m256i const l = _mm256_loadu_si256((__m256i const*)&left[i]);                    \
+                __m256i const r = _mm256_loadu_si256((__m256i const*)&right[i]);                   \
+                _mm256_storeu_si256((__m256i*)&out[i], VOP(l, r));                                 \
+            }                                                                                      \
+            _dc_bitset_words_##NAME##_scalar(out, left, right, vector_end, words);                 \
+        }
+
+    // JUSTIFY: Swapped arguments
+    //  - `_mm256_andnot_si256(a, b)` is `~a & b`.
+    #define _DC_BITSET_WORDS_AVX2_ANDNOT(L, R) _mm256_andnot_si256(R, L)
+
+_DC_BITSET_WORDS_AVX2_BINARY(and, _mm256_and_si256)
+_DC_BITSET_WORDS_AVX2_BINARY(or, _mm256_or_si256)
+_DC_BITSET_WORDS_AVX2_BINARY(xor, _mm256_xor_si256)
+_DC_BITSET_WORDS_AVX2_BINARY(andnot, _DC_BITSET_WORDS_AVX2_ANDNOT)
+
+/// Counts with a nibble lookup table (`vpshufb`), summing the byte counts with `vpsadbw`.
+///  - AVX2 has no vector popcount, and this is faster than one `popcnt` per word.
+DC_PUBLIC __attribute__((target("avx2"))) static size_t
+_dc_bitset_words_count_and_avx2(uint64_t const* left, uint64_t const* right, size_t words) {
+    __m256i const lookup =
+        _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1,
+                         2, 2, 3, 2, 3, 3, 4);
+    __m256i const low_nibbles = _mm256_set1_epi8(0x0F);
+    __m256i totals = _mm256_setzero_si256();
+
+    size_t const vector_end = words - (words % 4);
+    for (size_t i = 0; i < vector_end; i += 4) {
+        __m256i const both =
+            _mm256_and_si256(_mm256_loadu_si256((__m256i const*)&left[i]),
+                             _mm256_loadu_si256((__m256i const*)&right[i]));
+        __m256i const low = _mm256_and_si256(both, low_nibbles);
+        __m256i const high = _mm256_and_si256(_mm256_srli_epi16(both, 4), low_nibbles);
+        __m256i const bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low),
+                                              _mm256_shuffle_epi8(lookup, high));
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    size_t const count = (size_t)_mm256_extract_epi64(totals, 0) +
+                         (size_t)_mm256_extract_epi64(totals, 1) +
+                         (size_t)_mm256_extract_epi64(totals, 2) +
+                         (size_t)_mm256_extract_epi64(totals, 3);
+    return count + _dc_bitset_words_count_and_scalar(left, right, vector_end, words);
+}
+
+DC_PUBLIC __attribute__((target("avx2"))) static bool
+_dc_bitset_words_any_and_avx2(uint64_t const* left, uint64_t const* right, size_t words) {
+    size_t const vector_end = words - (words % 4);
+    for (size_t i = 0; i < vector_end; i += 4) {
+        __m256i const l = _mm256_loadu_si256((__m256i const*)&left[i]);
+        __m256i const r = _mm256_loadu_si256((__m256i const*)&right[i]);
+        if (!_mm256_testz_si256(l, r)) {
+            return true;
+        }
+    }
+    return _dc_bitset_words_any_and_scalar(left, right, vector_end, words);
+}
+
+#endif
+
+#if defined DC_BITSET_WORDS_X86
+    #define _DC_BITSET_WORDS_DISPATCH_BINARY(NAME)                                                 \
+        DC_PUBLIC static void dc_bitset_words_##NAME(uint64_t* out, uint64_t const* left,          \
+                                                     uint64_t const* right, size_t words) {        \
+            if (words >= 4 && dc_bitset_isa_get() == DC_BITSET_ISA_AVX2) {                         \
+                _dc_bitset_words_##NAME##_avx2(out, left, right, words);                           \
+                return;                                                                            \
+            }                                                                                      \
+            _dc_bitset_words_##NAME##_scalar(out, left, right, 0, words);                          \
+        }
+#else
+    #define _DC_BITSET_WORDS_DISPATCH_BINARY(NAME)                                                 \
+        DC_PUBLIC static void dc_bitset_words_##NAME(uint64_t* out, uint64_t const* left,          \
+                                                     uint64_t const* right, size_t words) {        \
+            _dc_bitset_words_##NAME##_scalar(out, left, right, 0, words);                          \
+        }
+#endif
+
+_DC_BITSET_WORDS_DISPATCH_BINARY(and)
+_DC_BITSET_WORDS_DISPATCH_BINARY(or)
+_DC_BITSET_WORDS_DISPATCH_BINARY(xor)
+_DC_BITSET_WORDS_DISPATCH_BINARY(andnot)
+
+DC_PUBLIC static size_t dc_bitset_words_count_and(uint64_t const* left, uint64_t const* right,
+                                                  size_t words) {
+#if defined DC_BITSET_WORDS_X86
+    if (words >= 4 && dc_bitset_isa_get() == DC_BITSET_ISA_AVX2) {
+        return _dc_bitset_words_count_and_avx2(left, right, words);
+    }
+#endif
+    return _dc_bitset_words_count_and_scalar(left, right, 0, words);
+}
+
+DC_PUBLIC static bool dc_bitset_words_any_and(uint64_t const* left, uint64_t const* right,
+                                              size_t words) {
+#if defined DC_BITSET_WORDS_X86
+    if (words >= 4 && dc_bitset_isa_get() == DC_BITSET_ISA_AVX2) {
+        return _dc_bitset_words_any_and_avx2(left, right, words);
+    }
+#endif
+    return _dc_bitset_words_any_and_scalar(left, right, 0, words);
+}
+
+#define DC_BITSET_WORDS_FOR_BITS(BITS) (((BITS) + 63ULL) / 64ULL)
+
+DC_PUBLIC static void dc_bitset_words_set(uint64_t* words, size_t index) {
+    words[index / 64] |= (uint64_t)1 << (index % 64);
+}
+
+DC_PUBLIC static void dc_bitset_words_reset(uint64_t* words, size_t index) {
+    words[index / 64] &= ~((uint64_t)1 << (index % 64));
+}
+
+/// Visits the set bits of a bitmap in order, holding the unvisited bits of the current word.
+///  - Each step is a `ctz` and clearing the lowest set bit, without reloading the word, so even
+///    a full bitmap iterates as fast as checking a flag per entry.
+typedef struct {
+    size_t word_index;
+    uint64_t word;
+} dc_bitset_words_cursor;
+
+DC_PUBLIC static dc_bitset_words_cursor dc_bitset_words_cursor_new(uint64_t const* words,
+                                                                   size_t end) {
+    return (dc_bitset_words_cursor){
+        .word_index = 0,
+        .word = end > 0 ? words[0] : 0,
+    };
+}
+
+/// The next set bit in `[0, end)`, or `end` once all have been visited.
+DC_PUBLIC static size_t dc_bitset_words_cursor_next(dc_bitset_words_cursor* cursor,
+                                                    uint64_t const* words, size_t end) {
+    while (cursor->word == 0) {
+        if ((cursor->word_index + 1) * 64 >= end) {
+            return end;
+        }
+        cursor->word_index++;
+        cursor->word = words[cursor->word_index];
+    }
+    size_t const index = (cursor->word_index * 64) + (size_t)__builtin_ctzll(cursor->word);
+    if (index >= end) {
+        cursor->word = 0;
+        return end;
+    }
+    cursor->word &= cursor->word - 1;
+    return index;
+}
+
+#undef _DC_BITSET_WORDS_DISPATCH_BINARY
+#if defined DC_BITSET_WORDS_X86
+    #undef _DC_BITSET_WORDS_AVX2_ANDNOT
+    #undef _DC_BITSET_WORDS_AVX2_BINARY
+#endif
+#undef _DC_BITSET_WORDS_ANDNOT
+#undef _DC_BITSET_WORDS_XOR
+#undef _DC_BITSET_WORDS_OR
+#undef _DC_BITSET_WORDS_AND
+#undef _DC_BITSET_WORDS_SCALAR_BINARY
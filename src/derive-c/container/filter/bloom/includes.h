@@ -0,0 +1,16 @@
+#pragma once
+
+// [DERIVE-C] stdlib includes
+#include <stdbool.h> // IWYU pragma: export
+#include <stddef.h>  // IWYU pragma: export
+#include <stdint.h>  // IWYU pragma: export
+#include <stdio.h>   // IWYU pragma: export
+#include <string.h>  // IWYU pragma: export
+
+// [DERIVE-C] lib includes
+#include <derive-c/container/filter/bloom/utils.h> // IWYU pragma: export
+#include <derive-c/container/filter/trait.h>       // IWYU pragma: export
+#include <derive-c/core/debug/gdb_marker.h>        // IWYU pragma: export
+#include <derive-c/core/prelude.h>                 // IWYU pragma: export
+#include <derive-c/alloc/std.h>                    // IWYU pragma: export
+#include <derive-c/utils/debug/dump.h>             // IWYU pragma: export
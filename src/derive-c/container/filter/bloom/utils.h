@@ -0,0 +1,180 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <derive-c/container/filter/utils.h>
+#include <derive-c/core/prelude.h>
+#include <derive-c/test/mock.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define DC_BLOOM_X86
+    #include <immintrin.h>
+#endif
+
+// JUSTIFY: Blocks of one 64 byte cache line
+//  - Each item's bits are all within one block, so adding or querying touches a single cache line,
+//    rather than one per bit.
+#define DC_BLOOM_BLOCK_WORDS 8
+
+/// Blocks passed to the kernels must be aligned to their size, for the AVX2 kernels' aligned loads.
+typedef struct {
+    uint64_t words[DC_BLOOM_BLOCK_WORDS];
+} dc_bloom_block;
+
+// JUSTIFY: One bit per word of the block, chosen by multiplying by an odd salt
+//  - As for split block bloom filters (e.g. Parquet's), so the 8 bit positions are computed from
+//    one 32 bit hash with independent multiplies, as a single vector multiply.
+//  - The top 6 bits of each product select the bit in the word.
+static uint32_t const dc_bloom_salts[DC_BLOOM_BLOCK_WORDS] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+};
+
+typedef enum {
+    DC_BLOOM_ISA_SCALAR,
+    DC_BLOOM_ISA_AVX2,
+} dc_bloom_isa;
+
+// JUSTIFY: Mockable
+//  - So tests can check the scalar and AVX2 kernels on a machine supporting both.
+DC_MOCKABLE(dc_bloom_isa, dc_bloom_isa_get, (void)) {
+#if defined DC_BLOOM_X86
+    dc_cpu_features const features = dc_cpu_features_get();
+    if (features.AVX2.compiled_with || features.AVX2.runtime_supported) {
+        return DC_BLOOM_ISA_AVX2;
+    }
+#endif
+    return DC_BLOOM_ISA_SCALAR;
+}
+
+/// The bit of the `word` of a block that is set for an item with the `hash`.
+DC_PUBLIC static uint64_t dc_bloom_block_mask(uint32_t hash, size_t word) {
+    return (uint64_t)1 << ((hash * dc_bloom_salts[word]) >> 26);
+}
+
+DC_PUBLIC static void dc_bloom_block_add_scalar(dc_bloom_block* block, uint32_t hash) {
+    for (size_t i = 0; i < DC_BLOOM_BLOCK_WORDS; i++) {
+        block->words[i] |= dc_bloom_block_mask(hash, i);
+    }
+}
+
+// JUSTIFY: Accumulating the missing bits of every word
+//  - Rather than returning at the first missing bit, so there is no branch per word.
+DC_PUBLIC static bool dc_bloom_block_contains_scalar(dc_bloom_block const* block, uint32_t hash) {
+    uint64_t missing = 0;
+    for (size_t i = 0; i < DC_BLOOM_BLOCK_WORDS; i++) {
+        missing |= dc_bloom_block_mask(hash, i) & ~block->words[i];
+    }
+    return missing == 0;
+}
+
+#if defined DC_BLOOM_X86
+// JUSTIFY: AVX2 kernels
+//  - gcc does not vectorise the scalar loops, as each 32 bit product is widened to a 64 bit shift.
+//  - The 8 masks are two vectors of 4 words, from one multiply of the broadcast hash by the salts.
+DC_PUBLIC __attribute__((target("avx2"))) static void
+dc_bloom_block_masks_avx2(uint32_t hash, __m256i* low, __m256i* high) {
+    __m256i const salts = _mm256_loadu_si256((__m256i const*)dc_bloom_salts);
+    __m256i const shifts =
+        _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)hash), salts), 26);
+    __m256i const one = _mm256_set1_epi64x(1);
+    *low = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts)));
+    *high = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1)));
+}
+
+DC_PUBLIC __attribute__((target("avx2"))) static void
+dc_bloom_block_add_avx2(dc_bloom_block* block, uint32_t hash) {
+    __m256i low;
+    __m256i high;
+    dc_bloom_block_masks_avx2(hash, &low, &high);
+    __m256i* words = (__m256i*)block->words;
+    _mm256_store_si256(&words[0], _mm256_or_si256(_mm256_load_si256(&words[0]), low));
+    _mm256_store_si256(&words[1], _mm256_or_si256(_mm256_load_si256(&words[1]), high));
+}
+
+DC_PUBLIC __attribute__((target("avx2"))) static bool
+dc_bloom_block_contains_avx2(dc_bloom_block const* block, uint32_t hash) {
+    __m256i low;
+    __m256i high;
+    dc_bloom_block_masks_avx2(hash, &low, &high);
+    __m256i const* words = (__m256i const*)block->words;
+    return _mm256_testc_si256(_mm256_load_si256(&words[0]), low) &&
+           _mm256_testc_si256(_mm256_load_si256(&words[1]), high);
+}
+#endif
+
+// JUSTIFY: Taking the `isa`
+//  - So callers get it once per call (or batch) rather than once per block access.
+DC_PUBLIC static void dc_bloom_block_add(dc_bloom_block* block, uint32_t hash, dc_bloom_isa isa) {
+#if defined DC_BLOOM_X86
+    if (isa == DC_BLOOM_ISA_AVX2) {
+        dc_bloom_block_add_avx2(block, hash);
+        return;
+    }
+#endif
+    (void)isa;
+    dc_bloom_block_add_scalar(block, hash);
+}
+
+DC_PUBLIC static bool dc_bloom_block_contains(dc_bloom_block const* block, uint32_t hash,
+                                              dc_bloom_isa isa) {
+#if defined DC_BLOOM_X86
+    if (isa == DC_BLOOM_ISA_AVX2) {
+        return dc_bloom_block_contains_avx2(block, hash);
+    }
+#endif
+    (void)isa;
+    return dc_bloom_block_contains_scalar(block, hash);
+}
+
+// JUSTIFY: Selecting the block with the high 32 bits of the hash, by multiplying and shifting
+//  - Rather than a modulus, which is a slow division, or a power of 2 mask, which restricts sizes.
+//  - The low 32 bits are used for the bits within the block, so both are independent.
+DC_PUBLIC static size_t dc_bloom_block_index(uint64_t hash, size_t blocks) {
+    return (size_t)(((hash >> 32) * (uint64_t)blocks) >> 32);
+}
+
+/// The probability that a query matches a block with `items` added, as every word has the queried
+/// bit set.
+DC_PUBLIC static double dc_bloom_block_false_positive_rate(size_t items) {
+    double const bit_set = 1.0 - dc_filter_pow(63.0 / 64.0, items);
+    return dc_filter_pow(bit_set, DC_BLOOM_BLOCK_WORDS);
+}
+
+// JUSTIFY: Summing over the binomial distribution of items per block
+//  - Blocks receive different numbers of items, and fuller blocks contribute most of the false
+//    positives, so using the mean number of items per block underestimates the rate.
+//  - Computed without `libm`, so with each term from the previous one, and stopping once past the
+//    mean and the terms are negligible.
+// JUSTIFY: A rate of 1 when the probability of an empty block underflows
+//  - Which requires over 700 items per 512 bit block, at which every bit is effectively set.
+
+/// The expected false positive rate of a filter of `blocks` with `items` added.
+DC_PUBLIC static double dc_bloom_false_positive_rate(size_t blocks, size_t items) {
+    DC_ASSERT(blocks > 0, "A bloom filter has at least one block");
+    if (blocks == 1) {
+        return dc_bloom_block_false_positive_rate(items);
+    }
+
+    double const block_probability = 1.0 / (double)blocks;
+    double const mean = (double)items * block_probability;
+    double probability = dc_filter_pow(1.0 - block_probability, items);
+    if (probability <= 0.0) {
+        return 1.0;
+    }
+
+    double bit_clear = 1.0;
+    double rate = 0.0;
+    for (size_t count = 0; count <= items; count++) {
+        rate += probability * dc_filter_pow(1.0 - bit_clear, DC_BLOOM_BLOCK_WORDS);
+        if ((double)count > mean && probability < 1e-17) {
+            break;
+        }
+        probability *= ((double)(items - count) / (double)(count + 1)) *
+                       (block_probability / (1.0 - block_probability));
+        bit_clear *= 63.0 / 64.0;
+    }
+    return rate;
+}
@@ -0,0 +1,309 @@
+/// @brief A cuckoo filter, storing a fingerprint of each item in one of two buckets of 4 slots.
+///
+/// Unlike a bloom filter, items can be removed. Items are hashed once (see `utils.h`):
+///  - The high bits are the fingerprint, of `FINGERPRINT_BITS` (8, 12 or 16).
+///  - The low bits select the item's first bucket, and its second bucket is the first xored with
+///    the hash of the fingerprint.
+///
+/// Adding places the fingerprint in an empty slot of either bucket, or else kicks a fingerprint out
+/// to its other bucket, repeating up to `DC_CUCKOO_MAX_KICKS` times. If that fails, the last
+/// fingerprint kicked out is kept aside, and further adds fail until an item is removed.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+    #define ITEM cuckoo_item_t
+typedef size_t ITEM;
+#endif
+
+#if !defined ITEM_HASH
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM_HASH")
+    #endif
+
+    #define ITEM_HASH item_hash
+static size_t ITEM_HASH(ITEM const* item) { return *item; }
+#endif
+
+#if !defined FINGERPRINT_BITS
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("The number of bits (8,12,16) of each item's fingerprint")
+    #endif
+    #define FINGERPRINT_BITS 12
+#endif
+
+DC_STATIC_ASSERT(FINGERPRINT_BITS == 8 || FINGERPRINT_BITS == 12 || FINGERPRINT_BITS == 16,
+                 "Fingerprints must be 8, 12 or 16 bits");
+
+typedef ITEM NS(SELF, item_t);
+
+typedef struct {
+    uint8_t* buckets;
+    size_t buckets_mask;
+    size_t size;
+    struct {
+        size_t index;
+        uint32_t fingerprint;
+    } victim;
+    uint32_t kick_state;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_filter_cuckoo;
+} SELF;
+
+// INVARIANT: A zero victim fingerprint means there is no victim
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->buckets);                                                                    \
+    DC_ASSUME(DC_MATH_IS_POWER_OF_2((self)->buckets_mask + 1));                                    \
+    DC_ASSUME((self)->kick_state != 0);
+
+static size_t PRIV(NS(SELF, allocation_bytes))(size_t buckets) {
+    return (buckets * dc_cuckoo_bucket_bytes(FINGERPRINT_BITS)) + DC_CUCKOO_BUCKET_PADDING;
+}
+
+DC_PUBLIC static SELF NS(SELF, new_with_buckets)(size_t buckets, NS(ALLOC, ref) alloc_ref) {
+    DC_ASSERT(DC_MATH_IS_POWER_OF_2(buckets),
+              "A cuckoo filter needs a power of 2 number of buckets {buckets=%lu}", buckets);
+    return (SELF){
+        .buckets = (uint8_t*)NS(ALLOC, allocate_zeroed)(
+            alloc_ref, PRIV(NS(SELF, allocation_bytes))(buckets)),
+        .buckets_mask = buckets - 1,
+        .size = 0,
+        .victim = {.index = 0, .fingerprint = 0},
+        .kick_state = 0x9e3779b9U,
+        .alloc_ref = alloc_ref,
+        .derive_c_filter_cuckoo = dc_gdb_marker_new(),
+    };
+}
+
+/// A filter with the fewest buckets for `items` to be added at a load factor of at most
+/// `DC_CUCKOO_MAX_LOAD_FACTOR`.
+DC_PUBLIC static SELF NS(SELF, new_for)(size_t items, NS(ALLOC, ref) alloc_ref) {
+    size_t buckets = dc_math_next_power_of_2(
+        (items + DC_CUCKOO_BUCKET_SLOTS - 1) / DC_CUCKOO_BUCKET_SLOTS);
+    if ((double)items > DC_CUCKOO_MAX_LOAD_FACTOR * (double)(buckets * DC_CUCKOO_BUCKET_SLOTS)) {
+        buckets *= 2;
+    }
+    return NS(SELF, new_with_buckets)(buckets, alloc_ref);
+}
+
+static uint32_t PRIV(NS(SELF, next_kick))(SELF* self) {
+    // xorshift32
+    uint32_t state = self->kick_state;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    self->kick_state = state;
+    return state;
+}
+
+static bool PRIV(NS(SELF, try_place))(SELF* self, size_t index, uint32_t fingerprint) {
+    uint64_t const bucket = dc_cuckoo_bucket_load(self->buckets, index, FINGERPRINT_BITS);
+    uint64_t const empty = dc_cuckoo_zero_slots(bucket, FINGERPRINT_BITS);
+    if (empty == 0) {
+        return false;
+    }
+    unsigned const slot = dc_cuckoo_first_slot(empty, FINGERPRINT_BITS);
+    dc_cuckoo_bucket_store(self->buckets, index,
+                           dc_cuckoo_bucket_set(bucket, slot, fingerprint, FINGERPRINT_BITS),
+                           FINGERPRINT_BITS);
+    return true;
+}
+
+static void PRIV(NS(SELF, place))(SELF* self, size_t index, uint32_t fingerprint) {
+    DC_ASSUME(self->victim.fingerprint == 0);
+    if (PRIV(NS(SELF, try_place))(self, index, fingerprint)) {
+        return;
+    }
+    index = dc_cuckoo_alternate_index(index, fingerprint, self->buckets_mask);
+    if (PRIV(NS(SELF, try_place))(self, index, fingerprint)) {
+        return;
+    }
+
+    for (size_t kick = 0; kick < DC_CUCKOO_MAX_KICKS; kick++) {
+        unsigned const slot = PRIV(NS(SELF, next_kick))(self) % DC_CUCKOO_BUCKET_SLOTS;
+        uint64_t const bucket = dc_cuckoo_bucket_load(self->buckets, index, FINGERPRINT_BITS);
+        uint32_t const kicked = dc_cuckoo_bucket_get(bucket, slot, FINGERPRINT_BITS);
+        dc_cuckoo_bucket_store(self->buckets, index,
+                               dc_cuckoo_bucket_set(bucket, slot, fingerprint, FINGERPRINT_BITS),
+                               FINGERPRINT_BITS);
+
+        fingerprint = kicked;
+        index = dc_cuckoo_alternate_index(index, fingerprint, self->buckets_mask);
+        if (PRIV(NS(SELF, try_place))(self, index, fingerprint)) {
+            return;
+        }
+    }
+
+    self->victim.index = index;
+    self->victim.fingerprint = fingerprint;
+}
+
+/// Adds the `item`, unless the filter is full. Adding an item again adds another fingerprint to the
+/// same two buckets, so repeatedly adding one item fills the filter.
+DC_PUBLIC static bool NS(SELF, try_add)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    if (self->victim.fingerprint != 0) {
+        return false;
+    }
+    uint64_t const hash = dc_filter_mix((uint64_t)ITEM_HASH(&item));
+    PRIV(NS(SELF, place))(self, (size_t)hash & self->buckets_mask,
+                          dc_cuckoo_fingerprint(hash, FINGERPRINT_BITS));
+    self->size++;
+    return true;
+}
+
+DC_PUBLIC static void NS(SELF, add)(SELF* self, ITEM item) {
+    bool const added = NS(SELF, try_add)(self, item);
+    DC_ASSERT(added, "Cuckoo filter is full {size=%lu}", self->size);
+}
+
+/// Whether `item` may have been added. Never `false` for an added item that has not been removed.
+DC_PUBLIC static bool NS(SELF, contains)(SELF const* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    uint64_t const hash = dc_filter_mix((uint64_t)ITEM_HASH(&item));
+    uint32_t const fingerprint = dc_cuckoo_fingerprint(hash, FINGERPRINT_BITS);
+    size_t const index = (size_t)hash & self->buckets_mask;
+    size_t const alternate = dc_cuckoo_alternate_index(index, fingerprint, self->buckets_mask);
+
+    bool const found =
+        dc_cuckoo_bucket_contains(dc_cuckoo_bucket_load(self->buckets, index, FINGERPRINT_BITS),
+                                  fingerprint, FINGERPRINT_BITS) |
+        dc_cuckoo_bucket_contains(
+            dc_cuckoo_bucket_load(self->buckets, alternate, FINGERPRINT_BITS), fingerprint,
+            FINGERPRINT_BITS);
+    bool const victim = self->victim.fingerprint == fingerprint &&
+                        (self->victim.index == index || self->victim.index == alternate);
+    return found || victim;
+}
+
+static bool PRIV(NS(SELF, try_remove))(SELF* self, size_t index, uint32_t fingerprint) {
+    uint64_t const bucket = dc_cuckoo_bucket_load(self->buckets, index, FINGERPRINT_BITS);
+    uint64_t const matches = dc_cuckoo_zero_slots(
+        bucket ^ dc_cuckoo_broadcast(fingerprint, FINGERPRINT_BITS), FINGERPRINT_BITS);
+    if (matches == 0) {
+        return false;
+    }
+    unsigned const slot = dc_cuckoo_first_slot(matches, FINGERPRINT_BITS);
+    dc_cuckoo_bucket_store(self->buckets, index,
+                           dc_cuckoo_bucket_set(bucket, slot, 0, FINGERPRINT_BITS),
+                           FINGERPRINT_BITS);
+    return true;
+}
+
+// JUSTIFY: Only removing items that were added
+//  - Removing an item that was not added (but is a false positive) removes another item's
+//    fingerprint, which then is a false negative. So `remove` is for items known to be present.
+
+/// Removes one fingerprint of the `item`, returning `false` if there was none.
+DC_PUBLIC static bool NS(SELF, remove)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    uint64_t const hash = dc_filter_mix((uint64_t)ITEM_HASH(&item));
+    uint32_t const fingerprint = dc_cuckoo_fingerprint(hash, FINGERPRINT_BITS);
+    size_t const index = (size_t)hash & self->buckets_mask;
+    size_t const alternate = dc_cuckoo_alternate_index(index, fingerprint, self->buckets_mask);
+
+    if (self->victim.fingerprint == fingerprint &&
+        (self->victim.index == index || self->victim.index == alternate)) {
+        self->victim.fingerprint = 0;
+        self->size--;
+        return true;
+    }
+
+    if (!PRIV(NS(SELF, try_remove))(self, index, fingerprint) &&
+        !PRIV(NS(SELF, try_remove))(self, alternate, fingerprint)) {
+        return false;
+    }
+    self->size--;
+
+    // With a slot free, the victim may now be placed.
+    if (self->victim.fingerprint != 0) {
+        uint32_t const victim = self->victim.fingerprint;
+        self->victim.fingerprint = 0;
+        PRIV(NS(SELF, place))(self, self->victim.index, victim);
+    }
+    return true;
+}
+
+/// The number of items added, and not removed.
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+/// The number of fingerprint slots.
+DC_PUBLIC static size_t NS(SELF, capacity)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (self->buckets_mask + 1) * DC_CUCKOO_BUCKET_SLOTS;
+}
+
+DC_PUBLIC static size_t NS(SELF, capacity_bytes)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (self->buckets_mask + 1) * dc_cuckoo_bucket_bytes(FINGERPRINT_BITS);
+}
+
+/// The fraction of slots occupied.
+DC_PUBLIC static double NS(SELF, load_factor)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (double)self->size / (double)NS(SELF, capacity)(self);
+}
+
+/// An upper bound on the expected false positive rate, for the items added so far.
+DC_PUBLIC static double NS(SELF, false_positive_rate)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return dc_cuckoo_false_positive_rate(NS(SELF, load_factor)(self), FINGERPRINT_BITS);
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    size_t const bytes = PRIV(NS(SELF, allocation_bytes))(self->buckets_mask + 1);
+    uint8_t* buckets = (uint8_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref, bytes);
+    memcpy(buckets, self->buckets, bytes);
+    SELF new_self = *self;
+    new_self.buckets = buckets;
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    NS(ALLOC, deallocate)(self->alloc_ref, self->buckets,
+                          PRIV(NS(SELF, allocation_bytes))(self->buckets_mask + 1));
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "fingerprint_bits: %u,\n", (unsigned)FINGERPRINT_BITS);
+    dc_debug_fmt_print(fmt, stream, "buckets: %lu,\n", (size_t)(self->buckets_mask + 1));
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+    dc_debug_fmt_print(fmt, stream, "victim: %s,\n",
+                       self->victim.fingerprint != 0 ? "true" : "false");
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef INVARIANT_CHECK
+
+#undef FINGERPRINT_BITS
+#undef ITEM_HASH
+#undef ITEM
+
+DC_TRAIT_FILTER(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
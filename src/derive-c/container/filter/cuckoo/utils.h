@@ -0,0 +1,120 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <derive-c/container/filter/utils.h>
+#include <derive-c/core/prelude.h>
+
+// JUSTIFY: Buckets of 4 fingerprints
+//  - As in the cuckoo filter paper, 4 slots per bucket allow a load factor of 95% before inserts
+//    fail, while a lookup compares only 8 fingerprints.
+#define DC_CUCKOO_BUCKET_SLOTS 4
+
+// JUSTIFY: Bounding the kicks of an insert
+//  - Once above the maximum load factor, kick chains grow without bound, so after this many the
+//    last kicked fingerprint is kept aside as the filter's victim, and the filter reports full.
+#define DC_CUCKOO_MAX_KICKS 500
+
+#define DC_CUCKOO_MAX_LOAD_FACTOR 0.95
+
+// JUSTIFY: Buckets packed into bytes, and accessed as a 64 bit word
+//  - So 12 bit fingerprints use 6 bytes per bucket, rather than being padded to 16 bits.
+//  - A bucket is loaded with an unaligned 8 byte load, which reads past the last bucket, so
+//    allocations are padded by `DC_CUCKOO_BUCKET_PADDING` bytes.
+//  - The bucket is the low bits of the loaded word, so the byte order must be little endian.
+#define DC_CUCKOO_BUCKET_PADDING sizeof(uint64_t)
+DC_STATIC_ASSERT(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                 "cuckoo filter buckets are packed for little endian");
+
+DC_PUBLIC static size_t dc_cuckoo_bucket_bytes(unsigned bits) {
+    return (size_t)DC_CUCKOO_BUCKET_SLOTS * bits / 8;
+}
+
+DC_PUBLIC static uint64_t dc_cuckoo_bucket_mask(unsigned bits) {
+    return UINT64_MAX >> (64 - (DC_CUCKOO_BUCKET_SLOTS * bits));
+}
+
+/// A bucket with `fingerprint` in every slot.
+DC_PUBLIC static uint64_t dc_cuckoo_broadcast(uint32_t fingerprint, unsigned bits) {
+    uint64_t bucket = 0;
+    for (unsigned slot = 0; slot < DC_CUCKOO_BUCKET_SLOTS; slot++) {
+        bucket |= (uint64_t)fingerprint << (slot * bits);
+    }
+    return bucket;
+}
+
+// JUSTIFY: Finding zero slots without a loop, as for finding a zero byte in a word
+//  - Subtracting 1 from each slot borrows into the slot's top bit only when the slot was zero (or
+//    a lower slot borrowed into it), so the result is non-zero exactly when a slot is zero, and the
+//    lowest set bit is in the lowest zero slot.
+//  - A fingerprint is found by first xoring every slot with it.
+
+/// A word that is non-zero if any slot of the `bucket` is zero, with its lowest set bit in the
+/// lowest zero slot.
+DC_PUBLIC static uint64_t dc_cuckoo_zero_slots(uint64_t bucket, unsigned bits) {
+    uint64_t const low = dc_cuckoo_broadcast(1, bits);
+    uint64_t const high = low << (bits - 1);
+    return (bucket - low) & ~bucket & high;
+}
+
+/// The slot of the lowest set bit of the result of `dc_cuckoo_zero_slots`.
+DC_PUBLIC static unsigned dc_cuckoo_first_slot(uint64_t zero_slots, unsigned bits) {
+    DC_ASSUME(zero_slots != 0);
+    return (unsigned)__builtin_ctzll(zero_slots) / bits;
+}
+
+DC_PUBLIC static bool dc_cuckoo_bucket_contains(uint64_t bucket, uint32_t fingerprint,
+                                                unsigned bits) {
+    return dc_cuckoo_zero_slots(bucket ^ dc_cuckoo_broadcast(fingerprint, bits), bits) != 0;
+}
+
+DC_PUBLIC static uint32_t dc_cuckoo_bucket_get(uint64_t bucket, unsigned slot, unsigned bits) {
+    return (uint32_t)((bucket >> (slot * bits)) & ((UINT64_C(1) << bits) - 1));
+}
+
+DC_PUBLIC static uint64_t dc_cuckoo_bucket_set(uint64_t bucket, unsigned slot,
+                                               uint32_t fingerprint, unsigned bits) {
+    uint64_t const mask = ((UINT64_C(1) << bits) - 1) << (slot * bits);
+    return (bucket & ~mask) | ((uint64_t)fingerprint << (slot * bits));
+}
+
+DC_PUBLIC static uint64_t dc_cuckoo_bucket_load(uint8_t const* buckets, size_t index,
+                                                unsigned bits) {
+    uint64_t word;
+    memcpy(&word, &buckets[index * dc_cuckoo_bucket_bytes(bits)], sizeof(word));
+    return word & dc_cuckoo_bucket_mask(bits);
+}
+
+DC_PUBLIC static void dc_cuckoo_bucket_store(uint8_t* buckets, size_t index, uint64_t bucket,
+                                             unsigned bits) {
+    memcpy(&buckets[index * dc_cuckoo_bucket_bytes(bits)], &bucket, dc_cuckoo_bucket_bytes(bits));
+}
+
+// JUSTIFY: Fingerprints from the high bits of the hash, and the bucket from the low bits
+//  - So they are independent for filters of up to 2^(64 - bits) buckets.
+//  - Zero marks an empty slot, so a zero fingerprint is replaced by 1.
+DC_PUBLIC static uint32_t dc_cuckoo_fingerprint(uint64_t hash, unsigned bits) {
+    uint32_t const fingerprint = (uint32_t)(hash >> (64 - bits));
+    return fingerprint + (fingerprint == 0 ? 1 : 0);
+}
+
+// JUSTIFY: The alternate bucket from xoring with the hash of the fingerprint (partial-key cuckoo
+//          hashing)
+//  - So a fingerprint can be kicked to its other bucket without the item, and the alternate of the
+//    alternate is the original bucket.
+//  - Requires a power of 2 number of buckets.
+DC_PUBLIC static size_t dc_cuckoo_alternate_index(size_t index, uint32_t fingerprint,
+                                                  size_t buckets_mask) {
+    return (index ^ (size_t)((uint64_t)fingerprint * 0xc6a4a7935bd1e995ULL)) & buckets_mask;
+}
+
+/// An upper bound on the false positive rate at the `load_factor`, as each of the 8 slots compared
+/// is occupied with probability `load_factor`, and matches with probability `1 / (2^bits - 1)`.
+DC_PUBLIC static double dc_cuckoo_false_positive_rate(double load_factor, unsigned bits) {
+    double const rate = 2.0 * DC_CUCKOO_BUCKET_SLOTS * load_factor /
+                        (double)((UINT64_C(1) << bits) - 1);
+    return rate < 1.0 ? rate : 1.0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <derive-c/core/prelude.h>
+
+/// Probabilistic membership of items, which may report an item not added as contained (a false
+/// positive), but never reports an added item as not contained.
+#define DC_TRAIT_FILTER(SELF)                                                                      \
+    DC_REQUIRE_TYPE(SELF, item_t);                                                                 \
+    DC_REQUIRE_METHOD(void, SELF, add, (SELF*, NS(SELF, item_t)));                                 \
+    DC_REQUIRE_METHOD(bool, SELF, contains, (SELF const*, NS(SELF, item_t)));                      \
+    DC_REQUIRE_METHOD(size_t, SELF, size, (SELF const*));                                          \
+    DC_REQUIRE_METHOD(double, SELF, false_positive_rate, (SELF const*));                           \
+    DC_TRAIT_CLONEABLE(SELF);                                                                      \
+    DC_TRAIT_DELETABLE(SELF);                                                                      \
+    DC_TRAIT_DEBUGABLE(SELF)
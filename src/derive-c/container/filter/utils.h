@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <derive-c/core/prelude.h>
+
+// JUSTIFY: Mixing by multiplying with an odd constant (fibonacci hashing), then folding the high
+//           half into the low half
+//  - Hashes such as the identity hash leave the high bits zero for small integers, which would put
+//    every item in the first bloom filter block, or cuckoo filter bucket. The product's high bits
+//    depend on all of the hash's bits.
+//  - The product's low bits only depend on the hash's low bits, so for sequential integers they
+//    were correlated, and a bloom filter's false positive rate above the expected rate. Folding the
+//    high half in decorrelates them.
+//  - Rather than a full finalizer (e.g. MurmurHash3's), which doubled the time of a query to a
+//    bloom filter in cache.
+DC_PUBLIC static uint64_t dc_filter_mix(uint64_t hash) {
+    hash *= 0x9e3779b97f4a7c15ULL;
+    return hash ^ (hash >> 32);
+}
+
+/// `value` to the power of `exponent`, by squaring.
+DC_PUBLIC static double dc_filter_pow(double value, size_t exponent) {
+    double result = 1.0;
+    while (exponent != 0) {
+        if (exponent & 1) {
+            result *= value;
+        }
+        value *= value;
+        exponent >>= 1;
+    }
+    return result;
+}
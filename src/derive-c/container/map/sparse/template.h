@@ -0,0 +1,413 @@
+/// @brief A sparse set map, from integer keys in `[0, universe)` to values.
+///
+/// Entries are stored densely in insertion order (until removals), and a sparse array of the
+/// universe's size maps each key to its position in the dense entries:
+///  - `insert`, `read`, `remove` and `clear` are O(1) (plus deleting the values for `clear`).
+///  - Iteration is over exactly the live entries, contiguously.
+///  - Removal moves the last entry into the removed one's position, so does not preserve order.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined INDEX_BITS
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("The number of bits (8,16,32,64) to use for the map's keys")
+    #endif
+    #define INDEX_BITS 32
+#endif
+
+#if !defined VALUE
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No VALUE")
+    #endif
+typedef struct {
+    int x;
+} value_t;
+    #define VALUE value_t
+#endif
+
+#if !defined VALUE_DELETE
+    #define VALUE_DELETE DC_NO_DELETE
+#endif
+
+#if !defined VALUE_CLONE
+    #define VALUE_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined VALUE_DEBUG
+    #define VALUE_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+#if !defined GROWTH_POLICY
+    #define GROWTH_POLICY dc_growth_double
+#endif
+
+#include <derive-c/core/index/bits_to_type/def.h>
+
+typedef INDEX_TYPE NS(SELF, key_t);
+typedef VALUE NS(SELF, value_t);
+
+#define ENTRY NS(SELF, entry_t)
+typedef struct {
+    INDEX_TYPE key;
+    VALUE value;
+} ENTRY;
+
+typedef struct {
+    ENTRY* entries;
+    size_t size;
+    size_t capacity;
+    INDEX_TYPE* positions;
+    size_t universe;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_map_sparse;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+DC_STATIC_CONSTANT size_t NS(SELF, max_capacity) = (size_t)MAX_INDEX;
+
+// INVARIANT: Each live entry's position is its key's position
+//  - Positions of keys not in the map are stale (or zero), so a key is only present if its
+//    position is live, and that entry has the key.
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->entries);                                                                    \
+    DC_ASSUME((self)->positions);                                                                  \
+    DC_ASSUME((self)->size <= (self)->capacity);                                                   \
+    DC_ASSUME((self)->size <= (self)->universe);
+
+/// A map for keys in `[0, universe)`.
+DC_PUBLIC static SELF NS(SELF, new_with_universe)(size_t universe, NS(ALLOC, ref) alloc_ref) {
+    DC_ASSERT(universe > 0 && universe <= NS(SELF, max_capacity),
+              "Universe must be between 1 and the max capacity {universe=%lu, max_capacity=%lu}",
+              universe, NS(SELF, max_capacity));
+    size_t const capacity =
+        universe < DC_GROWTH_INITIAL_CAPACITY ? universe : DC_GROWTH_INITIAL_CAPACITY;
+    ENTRY* entries = (ENTRY*)NS(ALLOC, allocate_uninit)(alloc_ref, capacity * sizeof(ENTRY));
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE, entries,
+                          capacity * sizeof(ENTRY));
+
+    // JUSTIFY: Zeroed positions
+    //  - Stale positions are never trusted, but must still be initialised to be read.
+    return (SELF){
+        .entries = entries,
+        .size = 0,
+        .capacity = capacity,
+        .positions = (INDEX_TYPE*)NS(ALLOC, allocate_zeroed)(alloc_ref,
+                                                            universe * sizeof(INDEX_TYPE)),
+        .universe = universe,
+        .alloc_ref = alloc_ref,
+        .derive_c_map_sparse = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+static ENTRY* PRIV(NS(SELF, find))(SELF const* self, INDEX_TYPE key) {
+    if (key >= self->universe) {
+        return NULL;
+    }
+    INDEX_TYPE const position = self->positions[key];
+    if (position < self->size && self->entries[position].key == key) {
+        return &self->entries[position];
+    }
+    return NULL;
+}
+
+DC_NOINLINE static void PRIV(NS(SELF, grow))(SELF* self) {
+    size_t const capacity = GROWTH_POLICY(self->capacity, self->capacity + 1);
+    self->entries = (ENTRY*)NS(ALLOC, reallocate)(self->alloc_ref, self->entries,
+                                                  self->capacity * sizeof(ENTRY),
+                                                  capacity * sizeof(ENTRY));
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE,
+                          &self->entries[self->size], (capacity - self->size) * sizeof(ENTRY));
+    self->capacity = capacity;
+}
+
+DC_PUBLIC static VALUE* NS(SELF, try_insert)(SELF* self, INDEX_TYPE key, VALUE value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(key < self->universe, "Key outside of the universe {key=%lu, universe=%lu}",
+              (size_t)key, self->universe);
+    if (PRIV(NS(SELF, find))(self, key) != NULL) {
+        return NULL;
+    }
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (self->size == self->capacity) {
+        PRIV(NS(SELF, grow))(self);
+    }
+    ENTRY* entry = &self->entries[self->size];
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE, entry,
+                          sizeof(ENTRY));
+    entry->key = key;
+    entry->value = value;
+    self->positions[key] = (INDEX_TYPE)self->size;
+    self->size++;
+    return &entry->value;
+}
+
+DC_PUBLIC static VALUE* NS(SELF, insert)(SELF* self, INDEX_TYPE key, VALUE value) {
+    VALUE* placed = NS(SELF, try_insert)(self, key, value);
+    DC_ASSERT(placed, "Failed to insert item {key=%lu, value=%s}", (size_t)key,
+              DC_DEBUG(VALUE_DEBUG, &value));
+    return placed;
+}
+
+DC_PUBLIC static VALUE const* NS(SELF, try_read)(SELF const* self, INDEX_TYPE key) {
+    INVARIANT_CHECK(self);
+    ENTRY const* entry = PRIV(NS(SELF, find))(self, key);
+    return entry != NULL ? &entry->value : NULL;
+}
+
+DC_PUBLIC static VALUE const* NS(SELF, read)(SELF const* self, INDEX_TYPE key) {
+    VALUE const* value = NS(SELF, try_read)(self, key);
+    DC_ASSERT(value, "Cannot read item {key=%lu}", (size_t)key);
+    return value;
+}
+
+DC_PUBLIC static VALUE* NS(SELF, try_write)(SELF* self, INDEX_TYPE key) {
+    return (VALUE*)NS(SELF, try_read)(self, key);
+}
+
+DC_PUBLIC static VALUE* NS(SELF, write)(SELF* self, INDEX_TYPE key) {
+    VALUE* value = NS(SELF, try_write)(self, key);
+    DC_ASSERT(value, "Cannot write item {key=%lu}", (size_t)key);
+    return value;
+}
+
+DC_PUBLIC static bool NS(SELF, contains)(SELF const* self, INDEX_TYPE key) {
+    INVARIANT_CHECK(self);
+    return PRIV(NS(SELF, find))(self, key) != NULL;
+}
+
+DC_PUBLIC static bool NS(SELF, try_remove)(SELF* self, INDEX_TYPE key, VALUE* destination) {
+    INVARIANT_CHECK(self);
+    ENTRY* entry = PRIV(NS(SELF, find))(self, key);
+    if (entry == NULL) {
+        return false;
+    }
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    *destination = entry->value;
+    self->size--;
+    ENTRY* last = &self->entries[self->size];
+    if (entry != last) {
+        *entry = *last;
+        self->positions[entry->key] = (INDEX_TYPE)(entry - self->entries);
+    }
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE, last,
+                          sizeof(ENTRY));
+    return true;
+}
+
+DC_PUBLIC static VALUE NS(SELF, remove)(SELF* self, INDEX_TYPE key) {
+    VALUE value;
+    DC_ASSERT(NS(SELF, try_remove)(self, key, &value), "Failed to remove item {key=%lu}",
+              (size_t)key);
+    return value;
+}
+
+DC_PUBLIC static void NS(SELF, delete_entry)(SELF* self, INDEX_TYPE key) {
+    VALUE value = NS(SELF, remove)(self, key);
+    VALUE_DELETE(&value);
+}
+
+/// Removes all entries, without touching the positions, so in O(1) for values without a delete.
+DC_PUBLIC static void NS(SELF, clear)(SELF* self) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+    for (size_t index = 0; index < self->size; index++) {
+        VALUE_DELETE(&self->entries[index].value);
+    }
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE,
+                          self->entries, self->size * sizeof(ENTRY));
+    self->size = 0;
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+DC_PUBLIC static size_t NS(SELF, universe)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->universe;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    ENTRY* entries =
+        (ENTRY*)NS(ALLOC, allocate_uninit)(self->alloc_ref, self->capacity * sizeof(ENTRY));
+    INDEX_TYPE* positions = (INDEX_TYPE*)NS(ALLOC, allocate_zeroed)(
+        self->alloc_ref, self->universe * sizeof(INDEX_TYPE));
+    for (size_t index = 0; index < self->size; index++) {
+        entries[index].key = self->entries[index].key;
+        entries[index].value = VALUE_CLONE(&self->entries[index].value);
+        positions[entries[index].key] = (INDEX_TYPE)index;
+    }
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE,
+                          &entries[self->size], (self->capacity - self->size) * sizeof(ENTRY));
+    return (SELF){
+        .entries = entries,
+        .size = self->size,
+        .capacity = self->capacity,
+        .positions = positions,
+        .universe = self->universe,
+        .alloc_ref = self->alloc_ref,
+        .derive_c_map_sparse = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    for (size_t index = 0; index < self->size; index++) {
+        VALUE_DELETE(&self->entries[index].value);
+    }
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE,
+                          self->entries, self->capacity * sizeof(ENTRY));
+    NS(ALLOC, deallocate)(self->alloc_ref, self->entries, self->capacity * sizeof(ENTRY));
+    NS(ALLOC, deallocate)(self->alloc_ref, self->positions,
+                          self->universe * sizeof(INDEX_TYPE));
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "universe: %lu,\n", self->universe);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+    dc_debug_fmt_print(fmt, stream, "capacity: %lu,\n", self->capacity);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "entries: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    for (size_t index = 0; index < self->size; index++) {
+        dc_debug_fmt_print(fmt, stream, "{key: %lu, value: ", (size_t)self->entries[index].key);
+        VALUE_DEBUG(&self->entries[index].value, fmt, stream);
+        fprintf(stream, "},\n");
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+#define KV_PAIR_CONST NS(ITER_CONST, item)
+
+typedef struct {
+    SELF const* map;
+    size_t next_index;
+    mutation_version version;
+} ITER_CONST;
+
+typedef struct {
+    INDEX_TYPE const* key;
+    VALUE const* value;
+} KV_PAIR_CONST;
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(KV_PAIR_CONST const* item) {
+    return item->key == NULL && item->value == NULL;
+}
+
+DC_PUBLIC static KV_PAIR_CONST NS(ITER_CONST, next)(ITER_CONST* iter) {
+    mutation_version_check(&iter->version);
+    if (iter->next_index >= iter->map->size) {
+        return (KV_PAIR_CONST){.key = NULL, .value = NULL};
+    }
+    ENTRY const* entry = &iter->map->entries[iter->next_index];
+    iter->next_index++;
+    return (KV_PAIR_CONST){.key = &entry->key, .value = &entry->value};
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index >= iter->map->size;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (ITER_CONST){
+        .map = self,
+        .next_index = 0,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+#undef KV_PAIR_CONST
+#undef ITER_CONST
+
+#define ITER NS(SELF, iter)
+#define KV_PAIR NS(ITER, item)
+
+typedef struct {
+    SELF* map;
+    size_t next_index;
+    mutation_version version;
+} ITER;
+
+typedef struct {
+    INDEX_TYPE const* key;
+    VALUE* value;
+} KV_PAIR;
+
+DC_PUBLIC static bool NS(ITER, empty_item)(KV_PAIR const* item) {
+    return item->key == NULL && item->value == NULL;
+}
+
+DC_PUBLIC static KV_PAIR NS(ITER, next)(ITER* iter) {
+    mutation_version_check(&iter->version);
+    if (iter->next_index >= iter->map->size) {
+        return (KV_PAIR){.key = NULL, .value = NULL};
+    }
+    ENTRY* entry = &iter->map->entries[iter->next_index];
+    iter->next_index++;
+    return (KV_PAIR){.key = &entry->key, .value = &entry->value};
+}
+
+DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index >= iter->map->size;
+}
+
+DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
+    INVARIANT_CHECK(self);
+    return (ITER){
+        .map = self,
+        .next_index = 0,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+#undef KV_PAIR
+#undef ITER
+
+#undef INVARIANT_CHECK
+#undef ENTRY
+
+#include <derive-c/core/index/bits_to_type/undef.h>
+
+#undef GROWTH_POLICY
+
+#undef VALUE_DEBUG
+#undef VALUE_CLONE
+#undef VALUE_DELETE
+#undef VALUE
+
+#undef INDEX_BITS
+
+DC_TRAIT_MAP(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
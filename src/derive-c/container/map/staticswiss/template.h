@@ -0,0 +1,521 @@
+/// @brief A swiss table with its control bytes and slots stored inline, so with no allocator.
+///
+/// Probes groups of control bytes as for `map/swiss` (sharing its `utils.h`), but the capacity is
+/// fixed at compile time:
+///  - At most `CAPACITY - CAPACITY / 8` entries, so every probe finds an empty control byte.
+///  - Tombstones cannot be removed by rehashing into a new table, so are dropped in place when
+///    they would fill the table, or outnumber half of the entries.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/self/def.h>
+
+#if !defined CAPACITY
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No CAPACITY")
+    #endif
+    #define CAPACITY 64
+#endif
+
+DC_STATIC_ASSERT(DC_MATH_IS_POWER_OF_2(CAPACITY) && CAPACITY >= _DC_SWISS_SIMD_PROBE_SIZE,
+                 DC_EXPAND_STRING(SELF) " CAPACITY must be a power of 2, of at least 16");
+
+#if !defined KEY
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No KEY")
+    #endif
+    #define KEY map_key_t
+typedef size_t KEY;
+#endif
+
+#if !defined KEY_HASH
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No KEY_HASH")
+    #endif
+
+    #define KEY_HASH key_hash
+static size_t KEY_HASH(KEY const* key) { return *key; }
+#endif
+
+#if !defined KEY_EQ
+    #define KEY_EQ DC_MEM_EQ
+#endif
+
+#if !defined KEY_DELETE
+    #define KEY_DELETE DC_NO_DELETE
+#endif
+
+#if !defined KEY_CLONE
+    #define KEY_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined KEY_DEBUG
+    #define KEY_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+#if !defined VALUE
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No VALUE")
+    #endif
+typedef struct {
+    int x;
+} value_t;
+    #define VALUE value_t
+#endif
+
+#if !defined VALUE_DELETE
+    #define VALUE_DELETE DC_NO_DELETE
+#endif
+
+#if !defined VALUE_CLONE
+    #define VALUE_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined VALUE_DEBUG
+    #define VALUE_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+typedef KEY NS(SELF, key_t);
+typedef VALUE NS(SELF, value_t);
+
+#define SLOT NS(SELF, slot_t)
+typedef struct {
+    VALUE value;
+    KEY key;
+} SLOT;
+
+typedef struct {
+    size_t count;
+    size_t tombstones;
+    _dc_swiss_ctrl ctrl[CAPACITY + _DC_SWISS_SIMD_PROBE_SIZE];
+    SLOT slots[CAPACITY];
+
+    dc_gdb_marker derive_c_map_staticswiss;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+DC_STATIC_CONSTANT size_t NS(SELF, max_capacity) = (size_t)CAPACITY - ((size_t)CAPACITY / 8);
+
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->count <= NS(SELF, max_capacity));                                            \
+    DC_ASSUME((self)->count + (self)->tombstones <= NS(SELF, max_capacity));
+
+static void PRIV(NS(SELF, reset_ctrl))(SELF* self) {
+    memset(self->ctrl, DC_SWISS_VAL_EMPTY, sizeof(self->ctrl));
+    self->ctrl[CAPACITY] = DC_SWISS_VAL_SENTINEL;
+}
+
+DC_PUBLIC static SELF NS(SELF, new)() {
+    SELF self = {
+        .count = 0,
+        .tombstones = 0,
+        .derive_c_map_staticswiss = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+    PRIV(NS(SELF, reset_ctrl))(&self);
+    return self;
+}
+
+/// The slot of the `key`, or `_DC_SWISS_NO_INDEX`.
+static size_t PRIV(NS(SELF, find))(SELF const* self, KEY const* key) {
+    size_t const mask = CAPACITY - 1;
+    size_t const hash = KEY_HASH(key);
+    _dc_swiss_ctrl const id = _dc_swiss_ctrl_from_hash(hash);
+    size_t const start = hash & mask;
+
+    for (size_t step = 0;; step += _DC_SWISS_SIMD_PROBE_SIZE) {
+        size_t const group_start = (start + step) & mask;
+        _dc_swiss_ctrl_group const group = _dc_swiss_group_load(&self->ctrl[group_start]);
+        _dc_swiss_ctrl_group_bitmask const matches = _dc_swiss_group_match(group, id);
+
+        _DC_SWISS_BITMASK_FOR_EACH(matches, group_offset) {
+            size_t const index = _dc_swiss_group_index_to_slot(group_start, group_offset, CAPACITY);
+            if (index != _DC_SWISS_NO_INDEX && KEY_EQ(&self->slots[index].key, key)) {
+                return index;
+            }
+        }
+
+        if (_dc_swiss_group_match(group, DC_SWISS_VAL_EMPTY) != 0) {
+            return _DC_SWISS_NO_INDEX;
+        }
+    }
+}
+
+/// The first empty or deleted slot on the probe sequence of the `hash`.
+static size_t PRIV(NS(SELF, find_available))(SELF const* self, size_t hash) {
+    size_t const mask = CAPACITY - 1;
+    size_t const start = hash & mask;
+
+    for (size_t step = 0;; step += _DC_SWISS_SIMD_PROBE_SIZE) {
+        size_t const group_start = (start + step) & mask;
+        _dc_swiss_ctrl_group const group = _dc_swiss_group_load(&self->ctrl[group_start]);
+        _dc_swiss_ctrl_group_bitmask const available =
+            _dc_swiss_group_match(group, DC_SWISS_VAL_EMPTY) |
+            _dc_swiss_group_match(group, DC_SWISS_VAL_DELETED);
+        if (available != 0) {
+            // JUSTIFY: The lowest available byte is never the sentinel
+            //  - The sentinel matches neither empty nor deleted.
+            return _dc_swiss_group_index_to_slot(
+                group_start, _dc_swiss_ctrl_group_bitmask_lowest(available), CAPACITY);
+        }
+    }
+}
+
+// JUSTIFY: Dropping tombstones in place, as for abseil's `DropDeletesWithoutResize`
+//  - Present entries are marked deleted (to be reinserted), and tombstones marked empty.
+//  - Each marked entry moves to the first available slot on its probe sequence. If that slot
+//    holds another marked entry, they are swapped, and the swapped in entry is reinserted next.
+//  - Every step places one entry, and no entry is placed after a slot that is later emptied, so
+//    all entries stay reachable.
+DC_NOINLINE static void PRIV(NS(SELF, drop_tombstones))(SELF* self) {
+    for (size_t index = 0; index < CAPACITY; index++) {
+        self->ctrl[index] =
+            _dc_swiss_is_present(self->ctrl[index]) ? DC_SWISS_VAL_DELETED : DC_SWISS_VAL_EMPTY;
+    }
+    memcpy(&self->ctrl[CAPACITY + 1], self->ctrl, _DC_SWISS_SIMD_PROBE_SIZE - 1);
+
+    for (size_t index = 0; index < CAPACITY;) {
+        if (self->ctrl[index] != DC_SWISS_VAL_DELETED) {
+            index++;
+            continue;
+        }
+        size_t const hash = KEY_HASH(&self->slots[index].key);
+        _dc_swiss_ctrl const id = _dc_swiss_ctrl_from_hash(hash);
+        size_t const target = PRIV(NS(SELF, find_available))(self, hash);
+
+        if (target == index) {
+            _dc_swiss_ctrl_set_at(self->ctrl, CAPACITY, index, id);
+            index++;
+        } else if (self->ctrl[target] == DC_SWISS_VAL_EMPTY) {
+            self->slots[target] = self->slots[index];
+            _dc_swiss_ctrl_set_at(self->ctrl, CAPACITY, target, id);
+            _dc_swiss_ctrl_set_at(self->ctrl, CAPACITY, index, DC_SWISS_VAL_EMPTY);
+            index++;
+        } else {
+            SLOT const swapped = self->slots[target];
+            self->slots[target] = self->slots[index];
+            self->slots[index] = swapped;
+            _dc_swiss_ctrl_set_at(self->ctrl, CAPACITY, target, id);
+        }
+    }
+    self->tombstones = 0;
+}
+
+DC_PUBLIC static VALUE* NS(SELF, try_insert)(SELF* self, KEY key, VALUE value) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (self->count >= NS(SELF, max_capacity)) {
+        return NULL;
+    }
+    // JUSTIFY: Never doubling the capacity
+    //  - With no tombstones, the table is full only at the max capacity, checked above.
+    if (_dc_swiss_heuristic_should_extend(self->tombstones, self->count, CAPACITY) ==
+        DC_SWISS_CLEANUP_TOMBSONES) {
+        PRIV(NS(SELF, drop_tombstones))(self);
+    }
+
+    size_t const mask = CAPACITY - 1;
+    size_t const hash = KEY_HASH(&key);
+    _dc_swiss_ctrl const id = _dc_swiss_ctrl_from_hash(hash);
+    size_t const start = hash & mask;
+    size_t available = _DC_SWISS_NO_INDEX;
+
+    for (size_t step = 0;; step += _DC_SWISS_SIMD_PROBE_SIZE) {
+        size_t const group_start = (start + step) & mask;
+        _dc_swiss_ctrl_group const group = _dc_swiss_group_load(&self->ctrl[group_start]);
+        _dc_swiss_ctrl_group_bitmask const matches = _dc_swiss_group_match(group, id);
+
+        _DC_SWISS_BITMASK_FOR_EACH(matches, group_offset) {
+            size_t const index = _dc_swiss_group_index_to_slot(group_start, group_offset, CAPACITY);
+            if (index != _DC_SWISS_NO_INDEX && KEY_EQ(&self->slots[index].key, &key)) {
+                return NULL;
+            }
+        }
+
+        _dc_swiss_ctrl_group_bitmask const empty = _dc_swiss_group_match(group, DC_SWISS_VAL_EMPTY);
+        if (available == _DC_SWISS_NO_INDEX) {
+            _dc_swiss_ctrl_group_bitmask const vacant =
+                empty | _dc_swiss_group_match(group, DC_SWISS_VAL_DELETED);
+            if (vacant != 0) {
+                available = _dc_swiss_group_index_to_slot(
+                    group_start, _dc_swiss_ctrl_group_bitmask_lowest(vacant), CAPACITY);
+            }
+        }
+        if (empty != 0) {
+            break;
+        }
+    }
+
+    if (self->ctrl[available] == DC_SWISS_VAL_DELETED) {
+        self->tombstones--;
+    }
+    self->slots[available] = (SLOT){
+        .value = value,
+        .key = key,
+    };
+    _dc_swiss_ctrl_set_at(self->ctrl, CAPACITY, available, id);
+    self->count++;
+    return &self->slots[available].value;
+}
+
+DC_PUBLIC static VALUE* NS(SELF, insert)(SELF* self, KEY key, VALUE value) {
+    VALUE* placed = NS(SELF, try_insert)(self, key, value);
+    DC_ASSERT(placed, "Failed to insert item {key=%s, value=%s}", DC_DEBUG(KEY_DEBUG, &key),
+              DC_DEBUG(VALUE_DEBUG, &value));
+    return placed;
+}
+
+DC_PUBLIC static VALUE const* NS(SELF, try_read)(SELF const* self, KEY key) {
+    INVARIANT_CHECK(self);
+    size_t const index = PRIV(NS(SELF, find))(self, &key);
+    return index != _DC_SWISS_NO_INDEX ? &self->slots[index].value : NULL;
+}
+
+DC_PUBLIC static VALUE const* NS(SELF, read)(SELF const* self, KEY key) {
+    VALUE const* value = NS(SELF, try_read)(self, key);
+    DC_ASSERT(value, "Cannot read item {key=%s}", DC_DEBUG(KEY_DEBUG, &key));
+    return value;
+}
+
+DC_PUBLIC static VALUE* NS(SELF, try_write)(SELF* self, KEY key) {
+    return (VALUE*)NS(SELF, try_read)(self, key);
+}
+
+DC_PUBLIC static VALUE* NS(SELF, write)(SELF* self, KEY key) {
+    VALUE* value = NS(SELF, try_write)(self, key);
+    DC_ASSERT(value, "Cannot write item {key=%s}", DC_DEBUG(KEY_DEBUG, &key));
+    return value;
+}
+
+DC_PUBLIC static bool NS(SELF, try_remove)(SELF* self, KEY key, VALUE* destination) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(destination != NULL, "Passed NULL destination pointer");
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    size_t const index = PRIV(NS(SELF, find))(self, &key);
+    if (index == _DC_SWISS_NO_INDEX) {
+        return false;
+    }
+    KEY_DELETE(&self->slots[index].key);
+    *destination = self->slots[index].value;
+    _dc_swiss_ctrl_set_at(self->ctrl, CAPACITY, index, DC_SWISS_VAL_DELETED);
+    self->count--;
+    self->tombstones++;
+    return true;
+}
+
+DC_PUBLIC static VALUE NS(SELF, remove)(SELF* self, KEY key) {
+    VALUE value;
+    DC_ASSERT(NS(SELF, try_remove)(self, key, &value), "Failed to remove item {key=%s}",
+              DC_DEBUG(KEY_DEBUG, &key));
+    return value;
+}
+
+DC_PUBLIC static void NS(SELF, delete_entry)(SELF* self, KEY key) {
+    VALUE value = NS(SELF, remove)(self, key);
+    VALUE_DELETE(&value);
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->count;
+}
+
+static void PRIV(NS(SELF, delete_entries))(SELF* self) {
+    for (size_t index = 0; index < CAPACITY; index++) {
+        if (_dc_swiss_is_present(self->ctrl[index])) {
+            KEY_DELETE(&self->slots[index].key);
+            VALUE_DELETE(&self->slots[index].value);
+        }
+    }
+}
+
+/// Removes all entries, and their tombstones.
+DC_PUBLIC static void NS(SELF, clear)(SELF* self) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+    PRIV(NS(SELF, delete_entries))(self);
+    PRIV(NS(SELF, reset_ctrl))(self);
+    self->count = 0;
+    self->tombstones = 0;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = {
+        .count = self->count,
+        .tombstones = self->tombstones,
+        .derive_c_map_staticswiss = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+    memcpy(new_self.ctrl, self->ctrl, sizeof(self->ctrl));
+    for (size_t index = 0; index < CAPACITY; index++) {
+        if (_dc_swiss_is_present(self->ctrl[index])) {
+            new_self.slots[index].key = KEY_CLONE(&self->slots[index].key);
+            new_self.slots[index].value = VALUE_CLONE(&self->slots[index].value);
+        }
+    }
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    PRIV(NS(SELF, delete_entries))(self);
+}
+
+static size_t PRIV(NS(SELF, next_populated_index))(SELF const* self, size_t index) {
+    while (index < CAPACITY && !_dc_swiss_is_present(self->ctrl[index])) {
+        index++;
+    }
+    return index;
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+#define KV_PAIR_CONST NS(ITER_CONST, item)
+
+typedef struct {
+    SELF const* map;
+    size_t next_index;
+    mutation_version version;
+} ITER_CONST;
+
+typedef struct {
+    KEY const* key;
+    VALUE const* value;
+} KV_PAIR_CONST;
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(KV_PAIR_CONST const* item) {
+    return item->key == NULL && item->value == NULL;
+}
+
+DC_PUBLIC static KV_PAIR_CONST NS(ITER_CONST, next)(ITER_CONST* iter) {
+    mutation_version_check(&iter->version);
+    size_t const index = iter->next_index;
+    if (index >= CAPACITY) {
+        return (KV_PAIR_CONST){.key = NULL, .value = NULL};
+    }
+    iter->next_index = PRIV(NS(SELF, next_populated_index))(iter->map, index + 1);
+    return (KV_PAIR_CONST){
+        .key = &iter->map->slots[index].key,
+        .value = &iter->map->slots[index].value,
+    };
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index >= CAPACITY;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (ITER_CONST){
+        .map = self,
+        .next_index = PRIV(NS(SELF, next_populated_index))(self, 0),
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "capacity: %lu,\n", (size_t)CAPACITY);
+    dc_debug_fmt_print(fmt, stream, "tombstones: %lu,\n", self->tombstones);
+    dc_debug_fmt_print(fmt, stream, "count: %lu,\n", self->count);
+
+    dc_debug_fmt_print(fmt, stream, "entries: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    ITER_CONST iter = NS(SELF, get_iter_const)(self);
+    for (KV_PAIR_CONST item = NS(ITER_CONST, next)(&iter); !NS(ITER_CONST, empty_item)(&item);
+         item = NS(ITER_CONST, next)(&iter)) {
+        dc_debug_fmt_print(fmt, stream, "{key: ");
+        KEY_DEBUG(item.key, fmt, stream);
+        fprintf(stream, ", value: ");
+        VALUE_DEBUG(item.value, fmt, stream);
+        fprintf(stream, "},\n");
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef KV_PAIR_CONST
+#undef ITER_CONST
+
+#define ITER NS(SELF, iter)
+#define KV_PAIR NS(ITER, item)
+
+typedef struct {
+    SELF* map;
+    size_t next_index;
+    mutation_version version;
+} ITER;
+
+typedef struct {
+    KEY const* key;
+    VALUE* value;
+} KV_PAIR;
+
+DC_PUBLIC static bool NS(ITER, empty_item)(KV_PAIR const* item) {
+    return item->key == NULL && item->value == NULL;
+}
+
+DC_PUBLIC static KV_PAIR NS(ITER, next)(ITER* iter) {
+    mutation_version_check(&iter->version);
+    size_t const index = iter->next_index;
+    if (index >= CAPACITY) {
+        return (KV_PAIR){.key = NULL, .value = NULL};
+    }
+    iter->next_index = PRIV(NS(SELF, next_populated_index))(iter->map, index + 1);
+    return (KV_PAIR){
+        .key = &iter->map->slots[index].key,
+        .value = &iter->map->slots[index].value,
+    };
+}
+
+DC_PUBLIC static bool NS(ITER, empty)(ITER const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->next_index >= CAPACITY;
+}
+
+DC_PUBLIC static ITER NS(SELF, get_iter)(SELF* self) {
+    INVARIANT_CHECK(self);
+    return (ITER){
+        .map = self,
+        .next_index = PRIV(NS(SELF, next_populated_index))(self, 0),
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+#undef KV_PAIR
+#undef ITER
+
+#undef INVARIANT_CHECK
+#undef SLOT
+
+#undef VALUE_DEBUG
+#undef VALUE_CLONE
+#undef VALUE_DELETE
+#undef VALUE
+
+#undef KEY_DEBUG
+#undef KEY_CLONE
+#undef KEY_DELETE
+#undef KEY_EQ
+#undef KEY_HASH
+#undef KEY
+
+#undef CAPACITY
+
+DC_TRAIT_MAP(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/includes/undef.h>
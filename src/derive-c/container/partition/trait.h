@@ -0,0 +1,15 @@
+#pragma once
+
+#include <derive-c/core/prelude.h>
+
+/// A partition of the indices `[0, size)` into disjoint sets, each identified by one of its
+/// indices (its root).
+#define DC_TRAIT_PARTITION(SELF)                                                                   \
+    DC_REQUIRE_TYPE(SELF, index_t);                                                                \
+    DC_REQUIRE_METHOD(NS(SELF, index_t), SELF, find, (SELF*, NS(SELF, index_t)));                  \
+    DC_REQUIRE_METHOD(bool, SELF, unite, (SELF*, NS(SELF, index_t), NS(SELF, index_t)));           \
+    DC_REQUIRE_METHOD(size_t, SELF, size, (SELF const*));                                          \
+    DC_REQUIRE_METHOD(size_t, SELF, sets, (SELF const*));                                          \
+    DC_TRAIT_CLONEABLE(SELF);                                                                      \
+    DC_TRAIT_DELETABLE(SELF);                                                                      \
+    DC_TRAIT_DEBUGABLE(SELF)
@@ -0,0 +1,238 @@
+/// @brief A union-find (disjoint set forest) over the indices `[0, size)`.
+///
+/// Indices are plain integers of `INDEX_BITS`, for example the `index` of an arena's indices, so a
+/// partition of an arena's entries is a union-find of its capacity. Each index stores its parent
+/// (an `INDEX_BITS` integer) and its rank (a byte), in separate arrays.
+///  - `find` uses path halving, pointing each index visited at its grandparent.
+///  - `unite` uses union by rank, so trees have depth at most `log2(size)`.
+///  - `union_pairs` and `find_all` prefetch ahead for large forests, where every step is a cache
+///    miss.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined INDEX_BITS
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("The number of bits (8,16,32,64) to use for the union-find's indices")
+    #endif
+    #define INDEX_BITS 32
+#endif
+
+#if !defined GROWTH_POLICY
+    #define GROWTH_POLICY dc_growth_double
+#endif
+
+#include <derive-c/core/index/bits_to_type/def.h>
+
+typedef INDEX_TYPE NS(SELF, index_t);
+
+typedef struct {
+    NS(SELF, index_t) left;
+    NS(SELF, index_t) right;
+} NS(SELF, pair);
+
+typedef struct {
+    INDEX_TYPE* parents;
+    uint8_t* ranks;
+    size_t size;
+    size_t capacity;
+    size_t sets;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_union_find;
+} SELF;
+
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->parents);                                                                    \
+    DC_ASSUME((self)->ranks);                                                                      \
+    DC_ASSUME((self)->size <= (self)->capacity);                                                   \
+    DC_ASSUME((self)->sets <= (self)->size);
+
+/// A union-find of `size` indices, each in its own set.
+DC_PUBLIC static SELF NS(SELF, new)(size_t size, NS(ALLOC, ref) alloc_ref) {
+    DC_ASSERT(size <= (size_t)MAX_INDEX + 1,
+              "Too many indices for the index type {size=%lu, max_index=%lu}", size,
+              (size_t)MAX_INDEX);
+    size_t const capacity = size > 0 ? size : DC_GROWTH_INITIAL_CAPACITY;
+    INDEX_TYPE* parents =
+        (INDEX_TYPE*)NS(ALLOC, allocate_uninit)(alloc_ref, capacity * sizeof(INDEX_TYPE));
+    for (size_t index = 0; index < size; index++) {
+        parents[index] = (INDEX_TYPE)index;
+    }
+    return (SELF){
+        .parents = parents,
+        .ranks = (uint8_t*)NS(ALLOC, allocate_zeroed)(alloc_ref, capacity),
+        .size = size,
+        .capacity = capacity,
+        .sets = size,
+        .alloc_ref = alloc_ref,
+        .derive_c_union_find = dc_gdb_marker_new(),
+    };
+}
+
+/// Adds a new index, in its own set.
+DC_PUBLIC static INDEX_TYPE NS(SELF, add)(SELF* self) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(self->size <= MAX_INDEX, "Union-find is full {size=%lu, max_index=%lu}", self->size,
+              (size_t)MAX_INDEX);
+    if (self->size == self->capacity) {
+        size_t const capacity = GROWTH_POLICY(self->capacity, self->capacity + 1);
+        self->parents = (INDEX_TYPE*)NS(ALLOC, reallocate)(
+            self->alloc_ref, self->parents, self->capacity * sizeof(INDEX_TYPE),
+            capacity * sizeof(INDEX_TYPE));
+        self->ranks =
+            (uint8_t*)NS(ALLOC, reallocate)(self->alloc_ref, self->ranks, self->capacity, capacity);
+        self->capacity = capacity;
+    }
+
+    INDEX_TYPE const index = (INDEX_TYPE)self->size;
+    self->parents[index] = index;
+    self->ranks[index] = 0;
+    self->size++;
+    self->sets++;
+    return index;
+}
+
+/// The root of the set containing `index`, halving the path to it.
+DC_PUBLIC static INDEX_TYPE NS(SELF, find)(SELF* self, INDEX_TYPE index) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(index < self->size, "Index out of bounds {index=%lu, size=%lu}", (size_t)index,
+              self->size);
+    INDEX_TYPE* parents = self->parents;
+    while (parents[index] != index) {
+        INDEX_TYPE const grandparent = parents[parents[index]];
+        parents[index] = grandparent;
+        index = grandparent;
+    }
+    return index;
+}
+
+DC_PUBLIC static bool NS(SELF, same)(SELF* self, INDEX_TYPE left, INDEX_TYPE right) {
+    return NS(SELF, find)(self, left) == NS(SELF, find)(self, right);
+}
+
+static bool PRIV(NS(SELF, link))(SELF* self, INDEX_TYPE left, INDEX_TYPE right) {
+    if (left == right) {
+        return false;
+    }
+    if (self->ranks[left] < self->ranks[right]) {
+        INDEX_TYPE const swap = left;
+        left = right;
+        right = swap;
+    }
+    self->parents[right] = left;
+    if (self->ranks[left] == self->ranks[right]) {
+        self->ranks[left]++;
+    }
+    self->sets--;
+    return true;
+}
+
+/// Merges the sets containing `left` and `right`, returning `false` if they were already the same.
+DC_PUBLIC static bool NS(SELF, unite)(SELF* self, INDEX_TYPE left, INDEX_TYPE right) {
+    return PRIV(NS(SELF, link))(self, NS(SELF, find)(self, left), NS(SELF, find)(self, right));
+}
+
+// JUSTIFY: Batches of 16 pairs
+//  - For forests larger than the cache, each union starts with two cache misses. Prefetching the
+//    parents of a batch of pairs before uniting any overlaps them, as for the bloom filter.
+#define BATCH 16
+
+/// Unites each of the `pairs`, returning the number of merges (so the decrease in `sets`).
+DC_PUBLIC static size_t NS(SELF, union_pairs)(SELF* self, NS(SELF, pair) const* pairs,
+                                              size_t count) {
+    INVARIANT_CHECK(self);
+    size_t const sets = self->sets;
+    for (size_t start = 0; start < count; start += BATCH) {
+        size_t const batch = count - start < BATCH ? count - start : BATCH;
+        for (size_t i = 0; i < batch; i++) {
+            __builtin_prefetch(&self->parents[pairs[start + i].left], 1);
+            __builtin_prefetch(&self->parents[pairs[start + i].right], 1);
+        }
+        for (size_t i = 0; i < batch; i++) {
+            NS(SELF, unite)(self, pairs[start + i].left, pairs[start + i].right);
+        }
+    }
+    return sets - self->sets;
+}
+
+// JUSTIFY: Prefetching the parent of the index 16 ahead
+//  - The parents are read in order, so the hardware prefetches them, but their parents are
+//    scattered.
+
+/// Writes the root of every index to `roots` (of at least `size`), and points every index
+/// directly at its root.
+DC_PUBLIC static void NS(SELF, find_all)(SELF* self, INDEX_TYPE* roots) {
+    INVARIANT_CHECK(self);
+    for (size_t index = 0; index < self->size; index++) {
+        if (index + BATCH < self->size) {
+            __builtin_prefetch(&self->parents[self->parents[index + BATCH]], 1);
+        }
+        INDEX_TYPE const root = NS(SELF, find)(self, (INDEX_TYPE)index);
+        self->parents[index] = root;
+        roots[index] = root;
+    }
+}
+
+#undef BATCH
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+/// The number of disjoint sets.
+DC_PUBLIC static size_t NS(SELF, sets)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->sets;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = *self;
+    new_self.parents = (INDEX_TYPE*)NS(ALLOC, allocate_uninit)(
+        self->alloc_ref, self->capacity * sizeof(INDEX_TYPE));
+    new_self.ranks = (uint8_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref, self->capacity);
+    memcpy(new_self.parents, self->parents, self->size * sizeof(INDEX_TYPE));
+    memcpy(new_self.ranks, self->ranks, self->size);
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    NS(ALLOC, deallocate)(self->alloc_ref, self->parents, self->capacity * sizeof(INDEX_TYPE));
+    NS(ALLOC, deallocate)(self->alloc_ref, self->ranks, self->capacity);
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+    dc_debug_fmt_print(fmt, stream, "capacity: %lu,\n", self->capacity);
+    dc_debug_fmt_print(fmt, stream, "sets: %lu,\n", self->sets);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef INVARIANT_CHECK
+
+#include <derive-c/core/index/bits_to_type/undef.h>
+
+#undef GROWTH_POLICY
+#undef INDEX_BITS
+
+DC_TRAIT_PARTITION(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -289,6 +289,47 @@ DC_PUBLIC static ITEM* NS(SELF, try_write_from_back)(SELF* self, size_t index) {
     return (ITEM*)NS(SELF, try_read_from_back)(self, index);
 }
 
+typedef bool (*NS(SELF, predicate))(ITEM const* item, void* ctx);
+
+/// Keeps only the items for which `predicate` returns true, preserving their order from the front,
+/// and deleting the rest. Compacts towards the head in a single pass.
+/// Returns the number of items removed.
+DC_PUBLIC static size_t NS(SELF, retain)(SELF* self, NS(SELF, predicate) predicate, void* ctx) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(predicate);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (self->empty) {
+        return 0;
+    }
+
+    size_t kept = 0;
+    for (size_t index = 0; index < self->size; index++) {
+        size_t const from = dc_math_modulus_power_of_2_capacity(self->head + index, self->capacity);
+        if (predicate(&self->data[from], ctx)) {
+            if (kept != index) {
+                size_t const to =
+                    dc_math_modulus_power_of_2_capacity(self->head + kept, self->capacity);
+                self->data[to] = self->data[from];
+            }
+            kept++;
+        } else {
+            ITEM_DELETE(&self->data[from]);
+        }
+    }
+
+    size_t const removed = self->size - kept;
+    self->size = kept;
+    if (kept == 0) {
+        self->empty = true;
+        self->tail = self->head;
+    } else {
+        self->tail = dc_math_modulus_power_of_2_capacity(self->head + kept - 1, self->capacity);
+    }
+    PRIV(NS(SELF, set_inaccessible_memory_caps))(self, DC_MEMORY_TRACKER_CAP_NONE);
+    return removed;
+}
+
 #define ITER NS(SELF, iter)
 typedef ITEM* NS(ITER, item);
 
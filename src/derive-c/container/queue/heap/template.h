@@ -0,0 +1,573 @@
+/// @brief A d-ary heap based priority queue.
+///  - `ARITY` children per node (2, 4 or 8). Wider heaps are shallower, and the children compared
+///    during a sift-down are adjacent in memory.
+///  - `ITEM_ORD(a, b)` is a strict ordering, true when `a` should be popped before `b` (so the
+///    default `DC_MEM_LT` gives a min-heap).
+///  - With `INDEXED` defined, each pushed item is given a stable handle (an index into a table of
+///    heap positions) that can be used to read, update or remove the item in O(log n).
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+
+typedef struct {
+    int x;
+} item_t;
+    #define ITEM item_t
+
+    #define ITEM_ORD item_ord
+static bool ITEM_ORD(item_t const* self_1, item_t const* self_2) { return self_1->x < self_2->x; }
+    #define ITEM_DELETE item_delete
+static void ITEM_DELETE(item_t* /* self */) {}
+    #define ITEM_CLONE item_clone
+static item_t ITEM_CLONE(item_t const* self) { return *self; }
+    #define ITEM_DEBUG item_debug
+static void ITEM_DEBUG(ITEM const* /* self */, dc_debug_fmt /* fmt */, FILE* /* stream */) {}
+#endif
+
+#if !defined ITEM_ORD
+    #define ITEM_ORD DC_MEM_LT
+#endif
+
+#if !defined ITEM_DELETE
+    #define ITEM_DELETE DC_NO_DELETE
+#endif
+
+#if !defined ITEM_CLONE
+    #define ITEM_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined ITEM_DEBUG
+    #define ITEM_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+#if !defined ARITY
+    #define ARITY 4
+#endif
+
+DC_STATIC_ASSERT(ARITY == 2 || ARITY == 4 || ARITY == 8, "The heap ARITY must be one of 2, 4 or 8");
+
+typedef ITEM NS(SELF, item_t);
+typedef ALLOC NS(SELF, alloc_t);
+
+#if defined INDEXED
+    #define HANDLE NS(SELF, handle_t)
+typedef struct {
+    size_t index;
+} HANDLE;
+
+    #define ENTRY NS(NAME, entry)
+typedef struct {
+    ITEM item;
+    HANDLE handle;
+} ENTRY;
+
+DC_PUBLIC static void NS(ENTRY, delete)(ENTRY* entry) { ITEM_DELETE(&entry->item); }
+
+DC_PUBLIC static ENTRY NS(ENTRY, clone)(ENTRY const* entry) {
+    return (ENTRY){
+        .item = ITEM_CLONE(&entry->item),
+        .handle = entry->handle,
+    };
+}
+
+DC_PUBLIC static void NS(ENTRY, debug)(ENTRY const* entry, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, "{ handle: %lu, item: ", (size_t)entry->handle.index);
+    ITEM_DEBUG(&entry->item, fmt, stream);
+    fprintf(stream, " }");
+}
+
+    #define ENTRY_ITEM(entry) ((entry).item)
+#else
+    #define ENTRY ITEM
+    #define ENTRY_ITEM(entry) (entry)
+#endif
+
+#define ENTRY_VECTOR NS(NAME, entry_vector)
+
+#pragma push_macro("ALLOC")
+#pragma push_macro("ITEM")
+#pragma push_macro("ITEM_CLONE")
+#pragma push_macro("ITEM_DELETE")
+#pragma push_macro("ITEM_DEBUG")
+
+#if defined INDEXED
+    #undef ITEM                           // [DERIVE-C] for template
+    #undef ITEM_CLONE                     // [DERIVE-C] for template
+    #undef ITEM_DELETE                    // [DERIVE-C] for template
+    #undef ITEM_DEBUG                     // [DERIVE-C] for template
+    #define ITEM ENTRY                    // [DERIVE-C] for template
+    #define ITEM_CLONE NS(ENTRY, clone)   // [DERIVE-C] for template
+    #define ITEM_DELETE NS(ENTRY, delete) // [DERIVE-C] for template
+    #define ITEM_DEBUG NS(ENTRY, debug)   // [DERIVE-C] for template
+#endif
+
+#define INTERNAL_NAME ENTRY_VECTOR // [DERIVE-C] for template
+#include <derive-c/container/vector/dynamic/template.h>
+
+#pragma pop_macro("ALLOC")
+#pragma pop_macro("ITEM")
+#pragma pop_macro("ITEM_CLONE")
+#pragma pop_macro("ITEM_DELETE")
+#pragma pop_macro("ITEM_DEBUG")
+
+#if defined INDEXED
+    #define POSITIONS NS(NAME, positions)
+
+    #pragma push_macro("ALLOC")
+    #pragma push_macro("ITEM")
+    #pragma push_macro("ITEM_CLONE")
+    #pragma push_macro("ITEM_DELETE")
+    #pragma push_macro("ITEM_DEBUG")
+
+    #undef ITEM                     // [DERIVE-C] for template
+    #undef ITEM_CLONE               // [DERIVE-C] for template
+    #undef ITEM_DELETE              // [DERIVE-C] for template
+    #undef ITEM_DEBUG               // [DERIVE-C] for template
+    #define ITEM size_t             // [DERIVE-C] for template
+    #define INTERNAL_NAME POSITIONS // [DERIVE-C] for template
+    #include <derive-c/container/vector/dynamic/template.h>
+
+    #pragma pop_macro("ALLOC")
+    #pragma pop_macro("ITEM")
+    #pragma pop_macro("ITEM_CLONE")
+    #pragma pop_macro("ITEM_DELETE")
+    #pragma pop_macro("ITEM_DEBUG")
+#endif
+
+typedef struct {
+    ENTRY_VECTOR entries;
+#if defined INDEXED
+    // JUSTIFY: Handles index into a vector of positions, rather than an arena
+    //           - Arena templates nest a slot template, and templates only nest one level deep.
+    //           - Free handles are chained through their position slots.
+    POSITIONS positions;
+    size_t free_handles;
+#endif
+    dc_gdb_marker derive_c_heap;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+#if defined INDEXED
+    #define INVARIANT_CHECK(self)                                                                  \
+        DC_ASSUME(self);                                                                           \
+        DC_ASSUME(NS(ENTRY_VECTOR, size)(&(self)->entries) <=                                      \
+                  NS(POSITIONS, size)(&(self)->positions));
+#else
+    #define INVARIANT_CHECK(self) DC_ASSUME(self);
+#endif
+
+DC_PUBLIC static SELF NS(SELF, new_with_capacity)(size_t capacity, NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .entries = NS(ENTRY_VECTOR, new_with_capacity)(capacity, alloc_ref),
+#if defined INDEXED
+        .positions = NS(POSITIONS, new_with_capacity)(capacity, alloc_ref),
+        .free_handles = SIZE_MAX,
+#endif
+        .derive_c_heap = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return NS(SELF, new_with_capacity)(0, alloc_ref);
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (SELF){
+        .entries = NS(ENTRY_VECTOR, clone)(&self->entries),
+#if defined INDEXED
+        .positions = NS(POSITIONS, clone)(&self->positions),
+        .free_handles = self->free_handles,
+#endif
+        .derive_c_heap = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return NS(ENTRY_VECTOR, size)(&self->entries);
+}
+
+DC_PUBLIC static bool NS(SELF, empty)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return NS(ENTRY_VECTOR, size)(&self->entries) == 0;
+}
+
+DC_PUBLIC static void NS(SELF, reserve)(SELF* self, size_t capacity) {
+    INVARIANT_CHECK(self);
+    NS(ENTRY_VECTOR, reserve)(&self->entries, capacity);
+}
+
+/// Places the entry at the position, updating its handle's position if indexed.
+static DC_INLINE void PRIV(NS(SELF, place))(SELF* self, ENTRY* data, size_t position,
+                                            ENTRY entry) {
+#if defined INDEXED
+    NS(POSITIONS, data)(&self->positions)[entry.handle.index] = position;
+#else
+    (void)self;
+#endif
+    data[position] = entry;
+}
+
+// JUSTIFY: Sifting a hole rather than swapping
+//           - Each level costs one write rather than a three-way swap, and when indexed only
+//             the moved entries have their positions updated.
+static void PRIV(NS(SELF, sift_up))(SELF* self, size_t position) {
+    ENTRY* data = NS(ENTRY_VECTOR, data)(&self->entries);
+    ENTRY const entry = data[position];
+
+    while (position > 0) {
+        size_t const parent = (position - 1) / ARITY;
+        if (!ITEM_ORD(&ENTRY_ITEM(entry), &ENTRY_ITEM(data[parent]))) {
+            break;
+        }
+        PRIV(NS(SELF, place))(self, data, position, data[parent]);
+        position = parent;
+    }
+    PRIV(NS(SELF, place))(self, data, position, entry);
+}
+
+static void PRIV(NS(SELF, sift_down))(SELF* self, size_t position) {
+    ENTRY* data = NS(ENTRY_VECTOR, data)(&self->entries);
+    size_t const size = NS(ENTRY_VECTOR, size)(&self->entries);
+    ENTRY const entry = data[position];
+
+    for (;;) {
+        size_t const first_child = (position * ARITY) + 1;
+        if (first_child >= size) {
+            break;
+        }
+
+        size_t const children_end = first_child + ARITY < size ? first_child + ARITY : size;
+        size_t best = first_child;
+        for (size_t child = first_child + 1; child < children_end; child++) {
+            if (ITEM_ORD(&ENTRY_ITEM(data[child]), &ENTRY_ITEM(data[best]))) {
+                best = child;
+            }
+        }
+
+        if (!ITEM_ORD(&ENTRY_ITEM(data[best]), &ENTRY_ITEM(entry))) {
+            break;
+        }
+        PRIV(NS(SELF, place))(self, data, position, data[best]);
+        position = best;
+    }
+    PRIV(NS(SELF, place))(self, data, position, entry);
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, try_peek)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    ENTRY const* entry = NS(ENTRY_VECTOR, try_read)(&self->entries, 0);
+    if (DC_LIKELY(entry)) {
+        return &ENTRY_ITEM(*entry);
+    }
+    return NULL;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, peek)(SELF const* self) {
+    ITEM const* item = NS(SELF, try_peek)(self);
+    DC_ASSERT(item, "Cannot peek, heap is empty {size=%lu}", NS(SELF, size)(self));
+    return item;
+}
+
+#if defined INDEXED
+/// Gets the position slot of a handle, or NULL if the handle is not present.
+///  - A free handle's slot holds the next free handle, which can never point at an entry with
+///    the same handle.
+static size_t* PRIV(NS(SELF, try_position))(SELF const* self, HANDLE handle) {
+    size_t* position = NS(POSITIONS, try_write)((POSITIONS*)&self->positions, handle.index);
+    if (position == NULL) {
+        return NULL;
+    }
+    ENTRY const* entry = NS(ENTRY_VECTOR, try_read)(&self->entries, *position);
+    if (entry == NULL || entry->handle.index != handle.index) {
+        return NULL;
+    }
+    return position;
+}
+
+static HANDLE PRIV(NS(SELF, new_handle))(SELF* self, size_t position) {
+    if (self->free_handles != SIZE_MAX) {
+        HANDLE const handle = {.index = self->free_handles};
+        size_t* slot = NS(POSITIONS, write)(&self->positions, handle.index);
+        self->free_handles = *slot;
+        *slot = position;
+        return handle;
+    }
+
+    HANDLE const handle = {.index = NS(POSITIONS, size)(&self->positions)};
+    NS(POSITIONS, push)(&self->positions, position);
+    return handle;
+}
+
+static void PRIV(NS(SELF, free_handle))(SELF* self, HANDLE handle) {
+    *NS(POSITIONS, write)(&self->positions, handle.index) = self->free_handles;
+    self->free_handles = handle.index;
+}
+
+DC_PUBLIC static HANDLE NS(SELF, push)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    size_t const position = NS(ENTRY_VECTOR, size)(&self->entries);
+    HANDLE const handle = PRIV(NS(SELF, new_handle))(self, position);
+    NS(ENTRY_VECTOR, push)(&self->entries, (ENTRY){.item = item, .handle = handle});
+    PRIV(NS(SELF, sift_up))(self, position);
+    return handle;
+}
+#else
+DC_PUBLIC static void NS(SELF, push)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    NS(ENTRY_VECTOR, push)(&self->entries, item);
+    PRIV(NS(SELF, sift_up))(self, NS(ENTRY_VECTOR, size)(&self->entries) - 1);
+}
+#endif
+
+/// Removes the entry at a position, moving the last entry into its place.
+static ENTRY PRIV(NS(SELF, remove_at))(SELF* self, size_t position) {
+    ENTRY* data = NS(ENTRY_VECTOR, data)(&self->entries);
+    ENTRY const removed = data[position];
+    ENTRY const last = NS(ENTRY_VECTOR, pop)(&self->entries);
+
+    if (position < NS(ENTRY_VECTOR, size)(&self->entries)) {
+        PRIV(NS(SELF, place))(self, data, position, last);
+        if (ITEM_ORD(&ENTRY_ITEM(last), &ENTRY_ITEM(removed))) {
+            PRIV(NS(SELF, sift_up))(self, position);
+        } else {
+            PRIV(NS(SELF, sift_down))(self, position);
+        }
+    }
+
+#if defined INDEXED
+    PRIV(NS(SELF, free_handle))(self, removed.handle);
+#endif
+    return removed;
+}
+
+DC_PUBLIC static bool NS(SELF, try_pop)(SELF* self, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (DC_LIKELY(NS(ENTRY_VECTOR, size)(&self->entries) > 0)) {
+        *destination = ENTRY_ITEM(PRIV(NS(SELF, remove_at))(self, 0));
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static ITEM NS(SELF, pop)(SELF* self) {
+    ITEM item;
+    DC_ASSERT(NS(SELF, try_pop)(self, &item), "Cannot pop, heap is empty {size=%lu}",
+              NS(SELF, size)(self));
+    return item;
+}
+
+#if defined INDEXED
+DC_PUBLIC static ITEM const* NS(SELF, try_read)(SELF const* self, HANDLE handle) {
+    INVARIANT_CHECK(self);
+    size_t const* position = PRIV(NS(SELF, try_position))(self, handle);
+    if (position == NULL) {
+        return NULL;
+    }
+    return &NS(ENTRY_VECTOR, read)(&self->entries, *position)->item;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, read)(SELF const* self, HANDLE handle) {
+    ITEM const* item = NS(SELF, try_read)(self, handle);
+    DC_ASSERT(item, "Cannot read, handle not present {handle=%lu}", (size_t)handle.index);
+    return item;
+}
+
+DC_PUBLIC static bool NS(SELF, contains)(SELF const* self, HANDLE handle) {
+    return NS(SELF, try_read)(self, handle) != NULL;
+}
+
+/// Replaces the item for a handle, and restores the heap order in O(log n).
+DC_PUBLIC static void NS(SELF, update)(SELF* self, HANDLE handle, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    size_t const* position = PRIV(NS(SELF, try_position))(self, handle);
+    DC_ASSERT(position, "Cannot update, handle not present {handle=%lu, item=%s}",
+              (size_t)handle.index, DC_DEBUG(ITEM_DEBUG, &item));
+
+    size_t const at = *position;
+    ITEM* target = &NS(ENTRY_VECTOR, write)(&self->entries, at)->item;
+    ITEM old = *target;
+    *target = item;
+
+    if (ITEM_ORD(&item, &old)) {
+        PRIV(NS(SELF, sift_up))(self, at);
+    } else {
+        PRIV(NS(SELF, sift_down))(self, at);
+    }
+    ITEM_DELETE(&old);
+}
+
+/// Replaces the item for a handle with one that is popped no later than the current item.
+///  - Only needs to sift towards the root.
+DC_PUBLIC static void NS(SELF, decrease_key)(SELF* self, HANDLE handle, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    size_t const* position = PRIV(NS(SELF, try_position))(self, handle);
+    DC_ASSERT(position, "Cannot decrease key, handle not present {handle=%lu, item=%s}",
+              (size_t)handle.index, DC_DEBUG(ITEM_DEBUG, &item));
+
+    size_t const at = *position;
+    ITEM* target = &NS(ENTRY_VECTOR, write)(&self->entries, at)->item;
+    DC_ASSERT(!ITEM_ORD(target, &item),
+              "Cannot decrease key, new item is ordered after the current {handle=%lu, item=%s}",
+              (size_t)handle.index, DC_DEBUG(ITEM_DEBUG, &item));
+
+    ITEM old = *target;
+    *target = item;
+    PRIV(NS(SELF, sift_up))(self, at);
+    ITEM_DELETE(&old);
+}
+
+DC_PUBLIC static bool NS(SELF, try_remove)(SELF* self, HANDLE handle, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    size_t const* position = PRIV(NS(SELF, try_position))(self, handle);
+    if (position == NULL) {
+        return false;
+    }
+    *destination = PRIV(NS(SELF, remove_at))(self, *position).item;
+    return true;
+}
+
+DC_PUBLIC static ITEM NS(SELF, remove)(SELF* self, HANDLE handle) {
+    ITEM item;
+    DC_ASSERT(NS(SELF, try_remove)(self, handle, &item),
+              "Cannot remove, handle not present {handle=%lu}", (size_t)handle.index);
+    return item;
+}
+#else
+/// Builds a heap from the items of a vector in O(n), taking ownership of the vector.
+DC_PUBLIC static SELF NS(SELF, from_vector)(ENTRY_VECTOR items) {
+    SELF self = (SELF){
+        .entries = items,
+        .derive_c_heap = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+
+    size_t const size = NS(ENTRY_VECTOR, size)(&self.entries);
+    if (size > 1) {
+        // JUSTIFY: Floyd's heap construction
+        //           - Sifting down from the last parent is O(n), rather than O(n log n) pushes.
+        for (size_t position = ((size - 2) / ARITY) + 1; position > 0; position--) {
+            PRIV(NS(SELF, sift_down))(&self, position - 1);
+        }
+    }
+    return self;
+}
+#endif
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    NS(ENTRY_VECTOR, delete)(&self->entries);
+#if defined INDEXED
+    NS(POSITIONS, delete)(&self->positions);
+#endif
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef ITEM const* NS(ITER_CONST, item);
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(ITEM const* const* item) { return *item == NULL; }
+
+/// Iterates over items in heap (not priority) order.
+typedef struct {
+    ENTRY const* data;
+    size_t pos;
+    size_t size;
+    mutation_version version;
+} ITER_CONST;
+
+DC_PUBLIC static ITEM const* NS(ITER_CONST, next)(ITER_CONST* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    if (iter->pos < iter->size) {
+        ITEM const* item = &ENTRY_ITEM(iter->data[iter->pos]);
+        iter->pos++;
+        return item;
+    }
+    return NULL;
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos >= iter->size;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (ITER_CONST){
+        .data = self->entries.data,
+        .pos = 0,
+        .size = NS(ENTRY_VECTOR, size)(&self->entries),
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+#undef ITER_CONST
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "arity: %lu,\n", (size_t)ARITY);
+
+    dc_debug_fmt_print(fmt, stream, "entries: ");
+    NS(ENTRY_VECTOR, debug)(&self->entries, fmt, stream);
+    fprintf(stream, ",\n");
+
+#if defined INDEXED
+    dc_debug_fmt_print(fmt, stream, "positions: ");
+    NS(POSITIONS, debug)(&self->positions, fmt, stream);
+    fprintf(stream, ",\n");
+#endif
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef INVARIANT_CHECK
+#if defined INDEXED
+    #undef POSITIONS
+#endif
+#undef ENTRY_VECTOR
+#undef ENTRY_ITEM
+#undef ENTRY
+#if defined INDEXED
+    #undef HANDLE
+#endif
+#undef INDEXED // [DERIVE-C] for input arg
+#undef ARITY
+#undef ITEM_DEBUG
+#undef ITEM_CLONE
+#undef ITEM_DELETE
+#undef ITEM_ORD
+#undef ITEM
+
+DC_TRAIT_PRIORITY_QUEUE(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,629 @@
+/// @brief A hierarchical timing wheel, for large numbers of mostly-cancelled timeouts.
+///  - `LEVELS` wheels of `2^LEVEL_BITS` slots, each level covering `2^LEVEL_BITS` times the ticks
+///    of the level below. Timers are cascaded down a level as the wheel reaches their slot.
+///  - Scheduling and cancelling are O(1), with a stable handle per timer.
+///  - Advancing moves each due slot onto an expired list in one batch, which is then drained with
+///    `try_pop_expired`.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+
+typedef struct {
+    int x;
+} item_t;
+    #define ITEM item_t
+
+    #define ITEM_DELETE item_delete
+static void ITEM_DELETE(item_t* /* self */) {}
+    #define ITEM_CLONE item_clone
+static item_t ITEM_CLONE(item_t const* self) { return *self; }
+    #define ITEM_DEBUG item_debug
+static void ITEM_DEBUG(ITEM const* /* self */, dc_debug_fmt /* fmt */, FILE* /* stream */) {}
+#endif
+
+#if !defined ITEM_DELETE
+    #define ITEM_DELETE DC_NO_DELETE
+#endif
+
+#if !defined ITEM_CLONE
+    #define ITEM_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined ITEM_DEBUG
+    #define ITEM_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+#if !defined LEVEL_BITS
+    #define LEVEL_BITS 6
+#endif
+
+#if !defined LEVELS
+    #define LEVELS 4
+#endif
+
+DC_STATIC_ASSERT(LEVEL_BITS > 0 && LEVEL_BITS <= 16, "LEVEL_BITS must be in [1, 16]");
+DC_STATIC_ASSERT(LEVELS > 0 && LEVEL_BITS * LEVELS < 64, "LEVELS * LEVEL_BITS must be below 64");
+
+#define SLOTS ((uint32_t)1 << LEVEL_BITS)
+#define SLOT_MASK ((uint64_t)SLOTS - 1)
+#define LIST_EXPIRED ((uint32_t)(LEVELS * SLOTS))
+#define LIST_FREE ((uint32_t)(LIST_EXPIRED + 1))
+
+typedef ITEM NS(SELF, item_t);
+typedef ALLOC NS(SELF, alloc_t);
+
+DC_STATIC_CONSTANT uint64_t NS(SELF, max_delay) = ((uint64_t)1 << (LEVEL_BITS * LEVELS)) - 1;
+
+#define HANDLE NS(SELF, handle_t)
+typedef struct {
+    uint32_t index;
+    uint32_t generation;
+} HANDLE;
+
+DC_PUBLIC static bool NS(HANDLE, eq)(HANDLE const* handle_1, HANDLE const* handle_2) {
+    return handle_1->index == handle_2->index && handle_1->generation == handle_2->generation;
+}
+
+DC_PUBLIC static void NS(HANDLE, debug)(HANDLE const* handle, dc_debug_fmt fmt, FILE* stream) {
+    (void)fmt;
+    fprintf(stream, DC_EXPAND_STRING(HANDLE) " { index: %lu, generation: %lu }",
+            (size_t)handle->index, (size_t)handle->generation);
+}
+
+#define NODE NS(NAME, node)
+typedef struct {
+    ITEM item;
+    uint64_t expiry;
+    uint32_t next;
+    uint32_t prev;
+    // INVARIANT: The slot list (level * SLOTS + slot), `LIST_EXPIRED` or `LIST_FREE`.
+    uint32_t list;
+    uint32_t generation;
+} NODE;
+
+DC_PUBLIC static void NS(NODE, delete)(NODE* node) {
+    if (node->list != LIST_FREE) {
+        ITEM_DELETE(&node->item);
+    }
+}
+
+DC_PUBLIC static NODE NS(NODE, clone)(NODE const* node) {
+    NODE result = {
+        .expiry = node->expiry,
+        .next = node->next,
+        .prev = node->prev,
+        .list = node->list,
+        .generation = node->generation,
+    };
+    if (node->list != LIST_FREE) {
+        result.item = ITEM_CLONE(&node->item);
+    }
+    return result;
+}
+
+DC_PUBLIC static void NS(NODE, debug)(NODE const* node, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, "{ expiry: %lu, list: %lu, item: ", (size_t)node->expiry, (size_t)node->list);
+    if (node->list != LIST_FREE) {
+        ITEM_DEBUG(&node->item, fmt, stream);
+    }
+    fprintf(stream, " }");
+}
+
+#define NODE_VECTOR NS(NAME, node_vector)
+
+#pragma push_macro("ALLOC")
+#pragma push_macro("ITEM")
+#pragma push_macro("ITEM_CLONE")
+#pragma push_macro("ITEM_DELETE")
+#pragma push_macro("ITEM_DEBUG")
+
+#undef ITEM                          // [DERIVE-C] for template
+#undef ITEM_CLONE                    // [DERIVE-C] for template
+#undef ITEM_DELETE                   // [DERIVE-C] for template
+#undef ITEM_DEBUG                    // [DERIVE-C] for template
+#define ITEM NODE                    // [DERIVE-C] for template
+#define ITEM_CLONE NS(NODE, clone)   // [DERIVE-C] for template
+#define ITEM_DELETE NS(NODE, delete) // [DERIVE-C] for template
+#define ITEM_DEBUG NS(NODE, debug)   // [DERIVE-C] for template
+#define INTERNAL_NAME NODE_VECTOR    // [DERIVE-C] for template
+#include <derive-c/container/vector/dynamic/template.h>
+
+#pragma pop_macro("ALLOC")
+#pragma pop_macro("ITEM")
+#pragma pop_macro("ITEM_CLONE")
+#pragma pop_macro("ITEM_DELETE")
+#pragma pop_macro("ITEM_DEBUG")
+
+typedef struct {
+    // JUSTIFY: Timers in a vector of nodes, rather than an arena
+    //           - Arena templates nest a slot template, and templates only nest one level deep.
+    //           - Generations on each node let stale handles (e.g. cancelling a fired timer) be
+    //             detected, even after the node is reused.
+    NODE_VECTOR nodes;
+    uint32_t free_list;
+    uint32_t heads[LEVELS * SLOTS];
+    uint32_t expired_head;
+    uint32_t expired_tail;
+    size_t pending;
+    size_t expired;
+    uint64_t now;
+    dc_gdb_marker derive_c_timing_wheel;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->pending + (self)->expired <= NS(NODE_VECTOR, size)(&(self)->nodes));         \
+    DC_ASSUME(((self)->expired_head == UINT32_MAX) == ((self)->expired_tail == UINT32_MAX));
+
+DC_PUBLIC static SELF NS(SELF, new_with_capacity)(size_t capacity, NS(ALLOC, ref) alloc_ref) {
+    SELF self = {
+        .nodes = NS(NODE_VECTOR, new_with_capacity)(capacity, alloc_ref),
+        .free_list = UINT32_MAX,
+        .expired_head = UINT32_MAX,
+        .expired_tail = UINT32_MAX,
+        .pending = 0,
+        .expired = 0,
+        .now = 0,
+        .derive_c_timing_wheel = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+    for (uint32_t list = 0; list < LEVELS * SLOTS; list++) {
+        self.heads[list] = UINT32_MAX;
+    }
+    return self;
+}
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return NS(SELF, new_with_capacity)(0, alloc_ref);
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF clone = *self;
+    clone.nodes = NS(NODE_VECTOR, clone)(&self->nodes);
+    clone.derive_c_timing_wheel = dc_gdb_marker_new();
+    clone.iterator_invalidation_tracker = mutation_tracker_new();
+    return clone;
+}
+
+DC_PUBLIC static uint64_t NS(SELF, now)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->now;
+}
+
+/// The number of timers, both pending and expired (but not yet popped).
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->pending + self->expired;
+}
+
+DC_PUBLIC static size_t NS(SELF, pending)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->pending;
+}
+
+DC_PUBLIC static size_t NS(SELF, expired)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->expired;
+}
+
+static DC_INLINE void PRIV(NS(SELF, link))(SELF* self, NODE* nodes, uint32_t index, uint32_t list) {
+    NODE* node = &nodes[index];
+    node->list = list;
+    node->prev = UINT32_MAX;
+    node->next = self->heads[list];
+    if (node->next != UINT32_MAX) {
+        nodes[node->next].prev = index;
+    }
+    self->heads[list] = index;
+}
+
+static DC_INLINE void PRIV(NS(SELF, link_expired))(SELF* self, NODE* nodes, uint32_t index) {
+    NODE* node = &nodes[index];
+    node->list = LIST_EXPIRED;
+    node->next = UINT32_MAX;
+    node->prev = self->expired_tail;
+    if (self->expired_tail != UINT32_MAX) {
+        nodes[self->expired_tail].next = index;
+    } else {
+        self->expired_head = index;
+    }
+    self->expired_tail = index;
+}
+
+static DC_INLINE void PRIV(NS(SELF, unlink))(SELF* self, NODE* nodes, uint32_t index) {
+    NODE* node = &nodes[index];
+    bool const expired = node->list == LIST_EXPIRED;
+
+    if (node->prev != UINT32_MAX) {
+        nodes[node->prev].next = node->next;
+    } else if (expired) {
+        self->expired_head = node->next;
+    } else {
+        self->heads[node->list] = node->next;
+    }
+
+    if (node->next != UINT32_MAX) {
+        nodes[node->next].prev = node->prev;
+    } else if (expired) {
+        self->expired_tail = node->prev;
+    }
+}
+
+/// Links a node into the slot for its expiry, relative to the current tick.
+static DC_INLINE void PRIV(NS(SELF, place))(SELF* self, NODE* nodes, uint32_t index) {
+    uint64_t delta = nodes[index].expiry - self->now;
+    uint64_t expiry = nodes[index].expiry;
+
+    // JUSTIFY: Clamping timers beyond the wheel's range
+    //           - They sit in the furthest top level slot, and are re-placed when cascaded.
+    if (delta > NS(SELF, max_delay)) {
+        delta = NS(SELF, max_delay);
+        expiry = self->now + delta;
+    }
+
+    uint32_t level = 0;
+    while (level < LEVELS - 1 && delta >= ((uint64_t)1 << (LEVEL_BITS * (level + 1)))) {
+        level++;
+    }
+    uint32_t const slot = (uint32_t)((expiry >> (LEVEL_BITS * level)) & SLOT_MASK);
+    PRIV(NS(SELF, link))(self, nodes, index, (level * SLOTS) + slot);
+}
+
+static uint32_t PRIV(NS(SELF, allocate_node))(SELF* self, ITEM item, uint64_t expiry) {
+    if (self->free_list != UINT32_MAX) {
+        uint32_t const index = self->free_list;
+        NODE* node = NS(NODE_VECTOR, write)(&self->nodes, index);
+        self->free_list = node->next;
+        dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE,
+                              &node->item, sizeof(ITEM));
+        node->item = item;
+        node->expiry = expiry;
+        return index;
+    }
+
+    size_t const index = NS(NODE_VECTOR, size)(&self->nodes);
+    DC_ASSERT(index < UINT32_MAX, "Cannot schedule, timing wheel is full {size=%lu, item=%s}",
+              index, DC_DEBUG(ITEM_DEBUG, &item));
+    NS(NODE_VECTOR, push)(&self->nodes, (NODE){
+                                            .item = item,
+                                            .expiry = expiry,
+                                            .generation = 0,
+                                        });
+    return (uint32_t)index;
+}
+
+static void PRIV(NS(SELF, free_node))(SELF* self, NODE* node, uint32_t index) {
+    node->list = LIST_FREE;
+    node->generation++;
+    node->next = self->free_list;
+    self->free_list = index;
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE, &node->item,
+                          sizeof(ITEM));
+}
+
+/// Schedules an item to expire at an absolute tick. Ticks not after the current tick expire
+/// immediately.
+DC_PUBLIC static HANDLE NS(SELF, schedule_at)(SELF* self, uint64_t expiry, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    uint32_t const index = PRIV(NS(SELF, allocate_node))(self, item, expiry);
+    NODE* nodes = NS(NODE_VECTOR, data)(&self->nodes);
+
+    if (expiry <= self->now) {
+        PRIV(NS(SELF, link_expired))(self, nodes, index);
+        self->expired++;
+    } else {
+        PRIV(NS(SELF, place))(self, nodes, index);
+        self->pending++;
+    }
+    return (HANDLE){.index = index, .generation = nodes[index].generation};
+}
+
+/// Schedules an item to expire `delay` ticks from now.
+DC_PUBLIC static HANDLE NS(SELF, schedule)(SELF* self, uint64_t delay, ITEM item) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(delay <= UINT64_MAX - self->now,
+              "Cannot schedule, expiry overflows {now=%lu, delay=%lu, item=%s}", (size_t)self->now,
+              (size_t)delay, DC_DEBUG(ITEM_DEBUG, &item));
+    return NS(SELF, schedule_at)(self, self->now + delay, item);
+}
+
+static NODE* PRIV(NS(SELF, try_node))(SELF const* self, HANDLE handle) {
+    NODE* node = NS(NODE_VECTOR, try_write)((NODE_VECTOR*)&self->nodes, handle.index);
+    if (node == NULL || node->list == LIST_FREE || node->generation != handle.generation) {
+        return NULL;
+    }
+    return node;
+}
+
+DC_PUBLIC static bool NS(SELF, contains)(SELF const* self, HANDLE handle) {
+    INVARIANT_CHECK(self);
+    return PRIV(NS(SELF, try_node))(self, handle) != NULL;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, try_read)(SELF const* self, HANDLE handle) {
+    INVARIANT_CHECK(self);
+    NODE const* node = PRIV(NS(SELF, try_node))(self, handle);
+    if (node == NULL) {
+        return NULL;
+    }
+    return &node->item;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, read)(SELF const* self, HANDLE handle) {
+    ITEM const* item = NS(SELF, try_read)(self, handle);
+    DC_ASSERT(item, "Cannot read, timer not present {index=%lu, generation=%lu}",
+              (size_t)handle.index, (size_t)handle.generation);
+    return item;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, try_write)(SELF* self, HANDLE handle) {
+    INVARIANT_CHECK(self);
+    NODE* node = PRIV(NS(SELF, try_node))(self, handle);
+    if (node == NULL) {
+        return NULL;
+    }
+    return &node->item;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, write)(SELF* self, HANDLE handle) {
+    ITEM* item = NS(SELF, try_write)(self, handle);
+    DC_ASSERT(item, "Cannot write, timer not present {index=%lu, generation=%lu}",
+              (size_t)handle.index, (size_t)handle.generation);
+    return item;
+}
+
+/// Cancels a pending or expired (but not yet popped) timer. Returns false if the timer has already
+/// been popped or cancelled.
+DC_PUBLIC static bool NS(SELF, try_cancel)(SELF* self, HANDLE handle, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    NODE* node = PRIV(NS(SELF, try_node))(self, handle);
+    if (node == NULL) {
+        return false;
+    }
+
+    if (node->list == LIST_EXPIRED) {
+        self->expired--;
+    } else {
+        self->pending--;
+    }
+    PRIV(NS(SELF, unlink))(self, NS(NODE_VECTOR, data)(&self->nodes), handle.index);
+    *destination = node->item;
+    PRIV(NS(SELF, free_node))(self, node, handle.index);
+    return true;
+}
+
+DC_PUBLIC static ITEM NS(SELF, cancel)(SELF* self, HANDLE handle) {
+    ITEM item;
+    DC_ASSERT(NS(SELF, try_cancel)(self, handle, &item),
+              "Cannot cancel, timer not present {index=%lu, generation=%lu}", (size_t)handle.index,
+              (size_t)handle.generation);
+    return item;
+}
+
+/// Re-places every timer in a slot, each lands in a lower level (or is clamped again).
+static void PRIV(NS(SELF, cascade))(SELF* self, NODE* nodes, uint32_t list) {
+    uint32_t index = self->heads[list];
+    self->heads[list] = UINT32_MAX;
+    while (index != UINT32_MAX) {
+        uint32_t const next = nodes[index].next;
+        PRIV(NS(SELF, place))(self, nodes, index);
+        index = next;
+    }
+}
+
+/// Advances the wheel by a number of ticks, moving every timer that is due onto the expired list.
+/// Returns the number of timers that expired.
+DC_PUBLIC static size_t NS(SELF, advance)(SELF* self, uint64_t ticks) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(ticks <= UINT64_MAX - self->now,
+              "Cannot advance, tick overflows {now=%lu, ticks=%lu}", (size_t)self->now,
+              (size_t)ticks);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    NODE* nodes = NS(NODE_VECTOR, data)(&self->nodes);
+    size_t expired = 0;
+
+    for (uint64_t tick = 0; tick < ticks; tick++) {
+        // JUSTIFY: Skipping ahead when nothing is pending
+        //           - No slots need to be cascaded or expired.
+        if (self->pending == 0) {
+            self->now += ticks - tick;
+            break;
+        }
+
+        self->now++;
+
+        for (uint32_t level = LEVELS - 1; level > 0; level--) {
+            uint64_t const level_mask = ((uint64_t)1 << (LEVEL_BITS * level)) - 1;
+            if ((self->now & level_mask) == 0) {
+                uint32_t const slot = (uint32_t)((self->now >> (LEVEL_BITS * level)) & SLOT_MASK);
+                PRIV(NS(SELF, cascade))(self, nodes, (level * SLOTS) + slot);
+            }
+        }
+
+        uint32_t const list = (uint32_t)(self->now & SLOT_MASK);
+        uint32_t index = self->heads[list];
+        self->heads[list] = UINT32_MAX;
+        while (index != UINT32_MAX) {
+            uint32_t const next = nodes[index].next;
+            PRIV(NS(SELF, link_expired))(self, nodes, index);
+            self->pending--;
+            self->expired++;
+            expired++;
+            index = next;
+        }
+    }
+    return expired;
+}
+
+/// Pops the earliest expired timer.
+DC_PUBLIC static bool NS(SELF, try_pop_expired)(SELF* self, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    uint32_t const index = self->expired_head;
+    if (index == UINT32_MAX) {
+        return false;
+    }
+
+    NODE* nodes = NS(NODE_VECTOR, data)(&self->nodes);
+    PRIV(NS(SELF, unlink))(self, nodes, index);
+    self->expired--;
+    *destination = nodes[index].item;
+    PRIV(NS(SELF, free_node))(self, &nodes[index], index);
+    return true;
+}
+
+DC_PUBLIC static ITEM NS(SELF, pop_expired)(SELF* self) {
+    ITEM item;
+    DC_ASSERT(NS(SELF, try_pop_expired)(self, &item),
+              "Cannot pop expired, no timers have expired {pending=%lu}", self->pending);
+    return item;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    NODE* nodes = NS(NODE_VECTOR, data)(&self->nodes);
+    size_t const size = NS(NODE_VECTOR, size)(&self->nodes);
+    for (size_t index = 0; index < size; index++) {
+        if (nodes[index].list == LIST_FREE) {
+            // JUSTIFY: Returning freed items to write
+            //           - The vector's delete accesses the entire node.
+            dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE,
+                                  &nodes[index].item, sizeof(ITEM));
+        }
+    }
+    NS(NODE_VECTOR, delete)(&self->nodes);
+}
+
+#define TIMER_CONST NS(SELF, timer_const)
+typedef struct {
+    HANDLE handle;
+    uint64_t expiry;
+    ITEM const* item;
+} TIMER_CONST;
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef TIMER_CONST NS(ITER_CONST, item);
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(TIMER_CONST const* item) {
+    return item->item == NULL;
+}
+
+/// Iterates over all pending and expired timers, in no particular order.
+typedef struct {
+    NODE const* nodes;
+    size_t pos;
+    size_t size;
+    mutation_version version;
+} ITER_CONST;
+
+DC_PUBLIC static TIMER_CONST NS(ITER_CONST, next)(ITER_CONST* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    while (iter->pos < iter->size) {
+        NODE const* node = &iter->nodes[iter->pos];
+        uint32_t const index = (uint32_t)iter->pos;
+        iter->pos++;
+        if (node->list != LIST_FREE) {
+            return (TIMER_CONST){
+                .handle = {.index = index, .generation = node->generation},
+                .expiry = node->expiry,
+                .item = &node->item,
+            };
+        }
+    }
+    return (TIMER_CONST){
+        .handle = {.index = UINT32_MAX, .generation = 0},
+        .expiry = 0,
+        .item = NULL,
+    };
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    for (size_t pos = iter->pos; pos < iter->size; pos++) {
+        if (iter->nodes[pos].list != LIST_FREE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return (ITER_CONST){
+        .nodes = self->nodes.data,
+        .pos = 0,
+        .size = NS(NODE_VECTOR, size)(&self->nodes),
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "now: %lu,\n", (size_t)self->now);
+    dc_debug_fmt_print(fmt, stream, "levels: %lu,\n", (size_t)LEVELS);
+    dc_debug_fmt_print(fmt, stream, "slots_per_level: %lu,\n", (size_t)SLOTS);
+    dc_debug_fmt_print(fmt, stream, "pending: %lu,\n", self->pending);
+    dc_debug_fmt_print(fmt, stream, "expired: %lu,\n", self->expired);
+
+    dc_debug_fmt_print(fmt, stream, "timers: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+
+    ITER_CONST iter = NS(SELF, get_iter_const)(self);
+    for (TIMER_CONST timer = NS(ITER_CONST, next)(&iter); !NS(ITER_CONST, empty_item)(&timer);
+         timer = NS(ITER_CONST, next)(&iter)) {
+        dc_debug_fmt_print(fmt, stream, "{ handle: ");
+        NS(HANDLE, debug)(&timer.handle, fmt, stream);
+        fprintf(stream, ", expiry: %lu, item: ", (size_t)timer.expiry);
+        ITEM_DEBUG(timer.item, fmt, stream);
+        fprintf(stream, " },\n");
+    }
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef ITER_CONST
+#undef TIMER_CONST
+#undef INVARIANT_CHECK
+#undef NODE_VECTOR
+#undef NODE
+#undef HANDLE
+#undef LIST_FREE
+#undef LIST_EXPIRED
+#undef SLOT_MASK
+#undef SLOTS
+#undef LEVELS
+#undef LEVEL_BITS
+#undef ITEM_DEBUG
+#undef ITEM_CLONE
+#undef ITEM_DELETE
+#undef ITEM
+
+DC_TRAIT_TIMING_WHEEL(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
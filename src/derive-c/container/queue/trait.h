@@ -20,3 +20,30 @@
     DC_TRAIT_DELETABLE(SELF);                                                                      \
     DC_TRAIT_CLONEABLE(SELF);                                                                      \
     DC_TRAIT_DEBUGABLE(SELF)
+
+#define DC_TRAIT_PRIORITY_QUEUE(SELF)                                                              \
+    DC_REQUIRE_TYPE(SELF, item_t);                                                                 \
+    DC_REQUIRE_METHOD(size_t, SELF, size, (SELF const*));                                          \
+    DC_REQUIRE_METHOD(bool, SELF, empty, (SELF const*));                                           \
+    DC_REQUIRE_METHOD(NS(SELF, item_t) const*, SELF, try_peek, (SELF const*));                     \
+    DC_REQUIRE_METHOD(NS(SELF, item_t) const*, SELF, peek, (SELF const*));                         \
+    DC_REQUIRE_METHOD(bool, SELF, try_pop, (SELF*, NS(SELF, item_t)*));                            \
+    DC_REQUIRE_METHOD(NS(SELF, item_t), SELF, pop, (SELF*));                                       \
+    DC_TRAIT_CONST_ITERABLE(SELF);                                                                 \
+    DC_TRAIT_DELETABLE(SELF);                                                                      \
+    DC_TRAIT_CLONEABLE(SELF);                                                                      \
+    DC_TRAIT_DEBUGABLE(SELF)
+
+#define DC_TRAIT_TIMING_WHEEL(SELF)                                                                \
+    DC_REQUIRE_TYPE(SELF, item_t);                                                                 \
+    DC_REQUIRE_TYPE(SELF, handle_t);                                                               \
+    DC_REQUIRE_METHOD(size_t, SELF, size, (SELF const*));                                          \
+    DC_REQUIRE_METHOD(uint64_t, SELF, now, (SELF const*));                                         \
+    DC_REQUIRE_METHOD(NS(SELF, handle_t), SELF, schedule, (SELF*, uint64_t, NS(SELF, item_t)));    \
+    DC_REQUIRE_METHOD(bool, SELF, try_cancel, (SELF*, NS(SELF, handle_t), NS(SELF, item_t)*));     \
+    DC_REQUIRE_METHOD(size_t, SELF, advance, (SELF*, uint64_t));                                   \
+    DC_REQUIRE_METHOD(bool, SELF, try_pop_expired, (SELF*, NS(SELF, item_t)*));                    \
+    DC_TRAIT_CONST_ITERABLE(SELF);                                                                 \
+    DC_TRAIT_DELETABLE(SELF);                                                                      \
+    DC_TRAIT_CLONEABLE(SELF);                                                                      \
+    DC_TRAIT_DEBUGABLE(SELF)
@@ -0,0 +1,140 @@
+/// @brief A sparse set of integer items in `[0, universe)`, with O(1) `add`, `remove`, `contains`
+/// and `clear`, and iteration over exactly the items present.
+///
+/// A `map/sparse` of unit values, see it for the layout.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined INDEX_BITS
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("The number of bits (8,16,32,64) to use for the set's items")
+    #endif
+    #define INDEX_BITS 32
+#endif
+
+#define MAP PRIV(NS(NAME, inner_map))
+
+#pragma push_macro("ALLOC")
+#pragma push_macro("INDEX_BITS")
+
+// GROWTH_POLICY (if defined) is passed through to, and undefined by, the map.
+#define VALUE dc_unit               // [DERIVE-C] for template
+#define VALUE_DELETE dc_unit_delete // [DERIVE-C] for template
+#define VALUE_CLONE dc_unit_clone   // [DERIVE-C] for template
+#define VALUE_DEBUG dc_unit_debug   // [DERIVE-C] for template
+#define INTERNAL_NAME MAP           // [DERIVE-C] for template
+#include <derive-c/container/map/sparse/template.h>
+
+#pragma pop_macro("INDEX_BITS")
+#pragma pop_macro("ALLOC")
+
+typedef NS(MAP, key_t) NS(SELF, item_t);
+
+DC_STATIC_CONSTANT size_t NS(SELF, max_capacity) = NS(MAP, max_capacity);
+
+typedef struct {
+    MAP map;
+} SELF;
+
+/// A set for items in `[0, universe)`.
+DC_PUBLIC static SELF NS(SELF, new_with_universe)(size_t universe, NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .map = NS(MAP, new_with_universe)(universe, alloc_ref),
+    };
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    return (SELF){
+        .map = NS(MAP, clone)(&self->map),
+    };
+}
+
+DC_PUBLIC static bool NS(SELF, try_add)(SELF* self, NS(SELF, item_t) item) {
+    return NS(MAP, try_insert)(&self->map, item, dc_unit_new()) != NULL;
+}
+
+DC_PUBLIC static void NS(SELF, add)(SELF* self, NS(SELF, item_t) item) {
+    bool const inserted = NS(SELF, try_add)(self, item);
+    DC_ASSERT(inserted, "Failed to insert item {item=%lu}", (size_t)item);
+}
+
+DC_PUBLIC static bool NS(SELF, contains)(SELF const* self, NS(SELF, item_t) item) {
+    return NS(MAP, contains)(&self->map, item);
+}
+
+DC_PUBLIC static bool NS(SELF, try_remove)(SELF* self, NS(SELF, item_t) item) {
+    dc_unit dest;
+    return NS(MAP, try_remove)(&self->map, item, &dest);
+}
+
+DC_PUBLIC static void NS(SELF, remove)(SELF* self, NS(SELF, item_t) item) {
+    bool const removed = NS(SELF, try_remove)(self, item);
+    DC_ASSERT(removed, "Failed to remove item {item=%lu}", (size_t)item);
+}
+
+DC_PUBLIC static void NS(SELF, clear)(SELF* self) { NS(MAP, clear)(&self->map); }
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) { return NS(MAP, size)(&self->map); }
+
+DC_PUBLIC static size_t NS(SELF, universe)(SELF const* self) {
+    return NS(MAP, universe)(&self->map);
+}
+
+#define ITER_CONST NS(SELF, iter_const)
+
+typedef struct {
+    NS(MAP, iter_const) map_iter;
+} ITER_CONST;
+
+typedef NS(SELF, item_t) const* NS(ITER_CONST, item);
+
+DC_PUBLIC static bool NS(ITER_CONST, empty_item)(NS(SELF, item_t) const* const* item) {
+    return *item == NULL;
+}
+
+DC_PUBLIC static NS(SELF, item_t) const* NS(ITER_CONST, next)(ITER_CONST* iter) {
+    return NS(MAP, NS(iter_const, next))(&iter->map_iter).key;
+}
+
+DC_PUBLIC static bool NS(ITER_CONST, empty)(ITER_CONST const* iter) {
+    DC_ASSUME(iter);
+    return NS(MAP, NS(iter_const, empty))(&iter->map_iter);
+}
+
+DC_PUBLIC static ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    return (ITER_CONST){
+        .map_iter = NS(MAP, get_iter_const)(&self->map),
+    };
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+
+    dc_debug_fmt_print(fmt, stream, "map: ");
+    NS(MAP, debug)(&self->map, fmt, stream);
+    fprintf(stream, ",\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef ITER_CONST
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) { NS(MAP, delete)(&self->map); }
+
+#undef MAP
+
+#undef INDEX_BITS
+
+DC_TRAIT_SET(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,206 @@
+/// @brief A count-min sketch, estimating the number of times each item was added in fixed memory.
+///
+/// Each of `depth` rows of `width` counters counts items by one column of the row. An item's
+/// estimate is the minimum of its counters, never below its true count, and (with probability at
+/// least `1 - e^-depth`) at most `e / width` of the total count above it.
+///
+/// Adds use conservative update, only increasing the counters that are below the new estimate.
+/// This reduces the overestimate, but means counts cannot be subtracted.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+    #define ITEM count_min_item_t
+typedef size_t ITEM;
+#endif
+
+#if !defined ITEM_HASH
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM_HASH")
+    #endif
+
+    #define ITEM_HASH item_hash
+static size_t ITEM_HASH(ITEM const* item) { return *item; }
+#endif
+
+typedef ITEM NS(SELF, item_t);
+
+typedef struct {
+    uint64_t* counters;
+    size_t width;
+    size_t depth;
+    uint64_t total;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_sketch_count_min;
+} SELF;
+
+// INVARIANT: The counters are `depth` rows of `width`
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->counters);                                                                   \
+    DC_ASSUME((self)->width > 0 && (self)->width <= UINT32_MAX);                                   \
+    DC_ASSUME((self)->depth > 0 && (self)->depth <= DC_COUNT_MIN_MAX_DEPTH);
+
+DC_PUBLIC static SELF NS(SELF, new_with_dimensions)(size_t width, size_t depth,
+                                                     NS(ALLOC, ref) alloc_ref) {
+    DC_ASSERT(width > 0 && width <= UINT32_MAX,
+              "A count-min sketch needs between 1 and 2^32 - 1 columns {width=%lu}", width);
+    DC_ASSERT(depth > 0 && depth <= DC_COUNT_MIN_MAX_DEPTH,
+              "A count-min sketch needs between 1 and %d rows {depth=%lu}",
+              DC_COUNT_MIN_MAX_DEPTH, depth);
+    return (SELF){
+        .counters = (uint64_t*)NS(ALLOC, allocate_zeroed)(alloc_ref,
+                                                          width * depth * sizeof(uint64_t)),
+        .width = width,
+        .depth = depth,
+        .total = 0,
+        .alloc_ref = alloc_ref,
+        .derive_c_sketch_count_min = dc_gdb_marker_new(),
+    };
+}
+
+/// A sketch for which estimates are at most `epsilon` of the total count above the true count,
+/// with probability at least `1 - delta`.
+///  - The depth is capped at `DC_COUNT_MIN_MAX_DEPTH` rows, so a `delta` below e^-16 (about
+///    1.1e-7) gets a failure probability of e^-16, rather than the `delta` requested.
+DC_PUBLIC static SELF NS(SELF, new_for)(double epsilon, double delta, NS(ALLOC, ref) alloc_ref) {
+    DC_ASSERT(epsilon > 0.0 && epsilon < 1.0, "The error must be in (0, 1) {epsilon=%f}",
+              epsilon);
+    DC_ASSERT(delta > 0.0 && delta < 1.0, "The failure probability must be in (0, 1) {delta=%f}",
+              delta);
+
+    double const e = 2.718281828459045;
+    double const columns = e / epsilon;
+    size_t width = (size_t)columns;
+    if ((double)width < columns) {
+        width++;
+    }
+
+    size_t depth = 1;
+    for (double failure = 1.0 / e; failure > delta && depth < DC_COUNT_MIN_MAX_DEPTH;
+         failure /= e) {
+        depth++;
+    }
+    return NS(SELF, new_with_dimensions)(width, depth, alloc_ref);
+}
+
+/// Adds `count` occurrences of the `item`.
+DC_PUBLIC static void NS(SELF, add_count)(SELF* self, ITEM item, uint64_t count) {
+    INVARIANT_CHECK(self);
+    uint64_t const hash = dc_sketch_mix((uint64_t)ITEM_HASH(&item));
+    uint64_t* counters[DC_COUNT_MIN_MAX_DEPTH];
+
+    uint64_t estimate = UINT64_MAX;
+    for (size_t row = 0; row < self->depth; row++) {
+        counters[row] = &self->counters[(row * self->width) +
+                                        dc_count_min_column(hash, row, self->width)];
+        estimate = *counters[row] < estimate ? *counters[row] : estimate;
+    }
+
+    uint64_t const updated = estimate + count;
+    for (size_t row = 0; row < self->depth; row++) {
+        *counters[row] = *counters[row] < updated ? updated : *counters[row];
+    }
+    self->total += count;
+}
+
+DC_PUBLIC static void NS(SELF, add)(SELF* self, ITEM item) { NS(SELF, add_count)(self, item, 1); }
+
+/// The estimated number of times the `item` was added, never below the true number.
+DC_PUBLIC static uint64_t NS(SELF, estimate)(SELF const* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    uint64_t const hash = dc_sketch_mix((uint64_t)ITEM_HASH(&item));
+    uint64_t estimate = UINT64_MAX;
+    for (size_t row = 0; row < self->depth; row++) {
+        uint64_t const counter =
+            self->counters[(row * self->width) + dc_count_min_column(hash, row, self->width)];
+        estimate = counter < estimate ? counter : estimate;
+    }
+    return estimate;
+}
+
+// JUSTIFY: Merging by summing counters
+//  - Exact for sketches of only standard updates. Conservative updates make each counter at most
+//    its standard value, and at least the count of any item in its column, so the sum stays an
+//    upper bound on each item's count.
+
+/// Merges the `other` into `self`, so `self` estimates the counts of items added to either.
+DC_PUBLIC static void NS(SELF, merge)(SELF* self, SELF const* other) {
+    INVARIANT_CHECK(self);
+    INVARIANT_CHECK(other);
+    DC_ASSERT(self->width == other->width && self->depth == other->depth,
+              "Cannot merge count-min sketches of different dimensions {self=%lux%lu, "
+              "other=%lux%lu}",
+              self->width, self->depth, other->width, other->depth);
+    for (size_t i = 0; i < self->width * self->depth; i++) {
+        self->counters[i] += other->counters[i];
+    }
+    self->total += other->total;
+}
+
+/// The total count of all items added.
+DC_PUBLIC static uint64_t NS(SELF, total)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->total;
+}
+
+/// The most estimates exceed true counts by, with probability at least `1 - e^-depth`.
+DC_PUBLIC static double NS(SELF, error_bound)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return 2.718281828459045 / (double)self->width * (double)self->total;
+}
+
+DC_PUBLIC static size_t NS(SELF, capacity_bytes)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->width * self->depth * sizeof(uint64_t);
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    size_t const bytes = self->width * self->depth * sizeof(uint64_t);
+    SELF new_self = *self;
+    new_self.counters = (uint64_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref, bytes);
+    memcpy(new_self.counters, self->counters, bytes);
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    NS(ALLOC, deallocate)(self->alloc_ref, self->counters,
+                          self->width * self->depth * sizeof(uint64_t));
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "width: %lu,\n", self->width);
+    dc_debug_fmt_print(fmt, stream, "depth: %lu,\n", self->depth);
+    dc_debug_fmt_print(fmt, stream, "total: %lu,\n", (size_t)self->total);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef INVARIANT_CHECK
+
+#undef ITEM_HASH
+#undef ITEM
+
+DC_TRAIT_SKETCH(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <derive-c/container/sketch/utils.h>
+#include <derive-c/core/prelude.h>
+
+// JUSTIFY: At most 16 rows
+//  - A failure probability of e^-16 (about 1 in 9 million), beyond which extra rows only add
+//    memory and time, and so the column of each row fits in an array on the stack.
+#define DC_COUNT_MIN_MAX_DEPTH 16
+
+// JUSTIFY: Rows' columns from combining two halves of one hash (Kirsch-Mitzenmacher)
+//  - Rather than hashing the item once per row, as the rows only need pairwise independent
+//    columns.
+//  - The column is selected by multiplying and shifting, rather than a modulus, which is a slow
+//    division, or a power of 2 mask, which restricts widths.
+
+/// The column of the `row` for an item with the `hash`, in rows of `width` counters.
+DC_PUBLIC static size_t dc_count_min_column(uint64_t hash, size_t row, size_t width) {
+    uint32_t const low = (uint32_t)hash;
+    uint32_t const high = (uint32_t)(hash >> 32);
+    uint32_t const combined = low + ((uint32_t)row * (high | 1U));
+    return (size_t)(((uint64_t)combined * (uint64_t)width) >> 32);
+}
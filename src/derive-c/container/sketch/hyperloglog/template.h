@@ -0,0 +1,282 @@
+/// @brief A hyperloglog, estimating the number of distinct items added in fixed memory.
+///
+/// Items are hashed once (see `utils.h`), the high `PRECISION` bits selecting one of `2^PRECISION`
+/// registers, which keeps the maximum rank (leading zeros plus one) of the remaining bits. The
+/// standard error of the estimate is about `1.04 / sqrt(2^PRECISION)`.
+///
+/// Starts sparse, storing only the registers set (at a higher precision) in a hash table, until
+/// that table would use as much memory as the dense registers.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+    #define ITEM hyperloglog_item_t
+typedef size_t ITEM;
+#endif
+
+#if !defined ITEM_HASH
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM_HASH")
+    #endif
+
+    #define ITEM_HASH item_hash
+static size_t ITEM_HASH(ITEM const* item) { return *item; }
+#endif
+
+#if !defined PRECISION
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("The number of bits (4 to 18) of the hash selecting a register")
+    #endif
+    #define PRECISION 14
+#endif
+
+DC_STATIC_ASSERT(PRECISION >= DC_HLL_MIN_PRECISION && PRECISION <= DC_HLL_MAX_PRECISION,
+                 "The precision must be between 4 and 18");
+
+#define REGISTERS ((size_t)1 << PRECISION)
+
+// JUSTIFY: Converting to dense registers when the sparse table would exceed their memory
+//  - The table is kept at most half full, so with 4 byte entries, at `REGISTERS / 8` entries.
+#define SPARSE_MAX_CAPACITY (REGISTERS / 4)
+#define SPARSE_INITIAL_CAPACITY (SPARSE_MAX_CAPACITY < 16 ? SPARSE_MAX_CAPACITY : 16)
+
+typedef ITEM NS(SELF, item_t);
+
+typedef struct {
+    uint8_t* registers;
+    uint32_t* sparse;
+    size_t sparse_capacity;
+    size_t sparse_size;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_sketch_hyperloglog;
+} SELF;
+
+// INVARIANT: Exactly one of the sparse table and the dense registers is allocated
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME(((self)->registers == NULL) != ((self)->sparse == NULL));                            \
+    DC_ASSUME((self)->sparse == NULL ||                                                            \
+              ((self)->sparse_size * 2 <= (self)->sparse_capacity &&                               \
+               DC_MATH_IS_POWER_OF_2((self)->sparse_capacity)));
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .registers = NULL,
+        .sparse = (uint32_t*)NS(ALLOC, allocate_zeroed)(
+            alloc_ref, SPARSE_INITIAL_CAPACITY * sizeof(uint32_t)),
+        .sparse_capacity = SPARSE_INITIAL_CAPACITY,
+        .sparse_size = 0,
+        .alloc_ref = alloc_ref,
+        .derive_c_sketch_hyperloglog = dc_gdb_marker_new(),
+    };
+}
+
+static void PRIV(NS(SELF, dense_insert))(SELF* self, size_t index, uint8_t rank) {
+    if (self->registers[index] < rank) {
+        self->registers[index] = rank;
+    }
+}
+
+static void PRIV(NS(SELF, to_dense))(SELF* self) {
+    DC_ASSUME(self->sparse);
+    self->registers = (uint8_t*)NS(ALLOC, allocate_zeroed)(self->alloc_ref, REGISTERS);
+    for (size_t i = 0; i < self->sparse_capacity; i++) {
+        uint32_t const entry = self->sparse[i];
+        if (entry != 0) {
+            PRIV(NS(SELF, dense_insert))(self,
+                                         dc_hll_sparse_entry_dense_index(entry, PRECISION),
+                                         dc_hll_sparse_entry_dense_rank(entry, PRECISION));
+        }
+    }
+    NS(ALLOC, deallocate)(self->alloc_ref, self->sparse, self->sparse_capacity * sizeof(uint32_t));
+    self->sparse = NULL;
+    self->sparse_capacity = 0;
+    self->sparse_size = 0;
+}
+
+// JUSTIFY: Linear probing from the low bits of the entry's index
+//  - The index is the high bits of the mixed hash, so its low bits are uniform.
+static bool PRIV(NS(SELF, sparse_table_insert))(uint32_t* table, size_t capacity, uint32_t entry) {
+    size_t const mask = capacity - 1;
+    for (size_t slot = dc_hll_sparse_entry_index(entry) & mask;; slot = (slot + 1) & mask) {
+        uint32_t const existing = table[slot];
+        if (existing == 0) {
+            table[slot] = entry;
+            return true;
+        }
+        if (dc_hll_sparse_entry_index(existing) == dc_hll_sparse_entry_index(entry)) {
+            if (existing < entry) {
+                table[slot] = entry;
+            }
+            return false;
+        }
+    }
+}
+
+// JUSTIFY: Growing the sparse table in a separate function
+//  - Called for few adds, so the table insert of `add` stays small enough to inline.
+DC_NOINLINE static void PRIV(NS(SELF, sparse_grow))(SELF* self) {
+    size_t const capacity = self->sparse_capacity * 2;
+    if (capacity > SPARSE_MAX_CAPACITY) {
+        PRIV(NS(SELF, to_dense))(self);
+        return;
+    }
+    uint32_t* table =
+        (uint32_t*)NS(ALLOC, allocate_zeroed)(self->alloc_ref, capacity * sizeof(uint32_t));
+    for (size_t i = 0; i < self->sparse_capacity; i++) {
+        if (self->sparse[i] != 0) {
+            PRIV(NS(SELF, sparse_table_insert))(table, capacity, self->sparse[i]);
+        }
+    }
+    NS(ALLOC, deallocate)(self->alloc_ref, self->sparse, self->sparse_capacity * sizeof(uint32_t));
+    self->sparse = table;
+    self->sparse_capacity = capacity;
+}
+
+static void PRIV(NS(SELF, sparse_insert))(SELF* self, uint32_t entry) {
+    DC_ASSUME(self->sparse);
+    if (PRIV(NS(SELF, sparse_table_insert))(self->sparse, self->sparse_capacity, entry)) {
+        self->sparse_size++;
+        if (self->sparse_size * 2 > self->sparse_capacity) {
+            PRIV(NS(SELF, sparse_grow))(self);
+        }
+    }
+}
+
+DC_PUBLIC static void NS(SELF, add)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    uint64_t const hash = dc_sketch_mix((uint64_t)ITEM_HASH(&item));
+    if (DC_LIKELY(self->registers != NULL)) {
+        PRIV(NS(SELF, dense_insert))(self, dc_hll_index(hash, PRECISION),
+                                     dc_hll_rank(hash, PRECISION));
+    } else {
+        PRIV(NS(SELF, sparse_insert))(self, dc_hll_sparse_entry(hash));
+    }
+}
+
+/// Merges the `other` into `self`, so `self` estimates the distinct items added to either.
+DC_PUBLIC static void NS(SELF, merge)(SELF* self, SELF const* other) {
+    INVARIANT_CHECK(self);
+    INVARIANT_CHECK(other);
+
+    if (other->sparse != NULL) {
+        for (size_t i = 0; i < other->sparse_capacity; i++) {
+            uint32_t const entry = other->sparse[i];
+            if (entry == 0) {
+                continue;
+            }
+            if (self->registers != NULL) {
+                PRIV(NS(SELF, dense_insert))(self,
+                                             dc_hll_sparse_entry_dense_index(entry, PRECISION),
+                                             dc_hll_sparse_entry_dense_rank(entry, PRECISION));
+            } else {
+                PRIV(NS(SELF, sparse_insert))(self, entry);
+            }
+        }
+        return;
+    }
+
+    if (self->registers == NULL) {
+        PRIV(NS(SELF, to_dense))(self);
+    }
+    for (size_t i = 0; i < REGISTERS; i++) {
+        uint8_t const rank = other->registers[i];
+        self->registers[i] = self->registers[i] < rank ? rank : self->registers[i];
+    }
+}
+
+/// The estimated number of distinct items added.
+DC_PUBLIC static double NS(SELF, estimate)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    uint64_t histogram[DC_HLL_HISTOGRAM_SIZE] = {0};
+    if (self->registers != NULL) {
+        for (size_t i = 0; i < REGISTERS; i++) {
+            histogram[self->registers[i]]++;
+        }
+        return dc_hll_estimate(histogram, PRECISION);
+    }
+
+    histogram[0] = ((uint64_t)1 << DC_HLL_SPARSE_PRECISION) - self->sparse_size;
+    for (size_t i = 0; i < self->sparse_capacity; i++) {
+        if (self->sparse[i] != 0) {
+            histogram[dc_hll_sparse_entry_rank(self->sparse[i])]++;
+        }
+    }
+    return dc_hll_estimate(histogram, DC_HLL_SPARSE_PRECISION);
+}
+
+DC_PUBLIC static bool NS(SELF, is_sparse)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->sparse != NULL;
+}
+
+DC_PUBLIC static size_t NS(SELF, capacity_bytes)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->sparse != NULL ? self->sparse_capacity * sizeof(uint32_t) : REGISTERS;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = *self;
+    if (self->registers != NULL) {
+        new_self.registers = (uint8_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref, REGISTERS);
+        memcpy(new_self.registers, self->registers, REGISTERS);
+    } else {
+        size_t const bytes = self->sparse_capacity * sizeof(uint32_t);
+        new_self.sparse = (uint32_t*)NS(ALLOC, allocate_uninit)(self->alloc_ref, bytes);
+        memcpy(new_self.sparse, self->sparse, bytes);
+    }
+    return new_self;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    if (self->registers != NULL) {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->registers, REGISTERS);
+    } else {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->sparse,
+                              self->sparse_capacity * sizeof(uint32_t));
+    }
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "precision: %u,\n", (unsigned)PRECISION);
+    if (self->registers != NULL) {
+        dc_debug_fmt_print(fmt, stream, "dense: %lu registers,\n", REGISTERS);
+    } else {
+        dc_debug_fmt_print(fmt, stream, "sparse: %lu entries,\n", self->sparse_size);
+    }
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef INVARIANT_CHECK
+#undef SPARSE_INITIAL_CAPACITY
+#undef SPARSE_MAX_CAPACITY
+#undef REGISTERS
+
+#undef PRECISION
+#undef ITEM_HASH
+#undef ITEM
+
+DC_TRAIT_SKETCH(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
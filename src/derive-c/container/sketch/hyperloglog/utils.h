@@ -0,0 +1,133 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <derive-c/container/sketch/utils.h>
+#include <derive-c/core/prelude.h>
+
+#define DC_HLL_MIN_PRECISION 4
+#define DC_HLL_MAX_PRECISION 18
+
+// JUSTIFY: Sparse entries at a precision of 25
+//  - As for HyperLogLog++, while few registers are set, each set register is stored as an entry of
+//    its index at a higher precision than the dense registers, so small cardinalities are
+//    estimated near exactly.
+//  - An entry is the 25 bit index, and the 6 bit rank (at most 64 - 25 + 1), in a 32 bit word.
+//  - Zero is never a valid entry (the rank is at least 1), so marks an empty slot.
+#define DC_HLL_SPARSE_PRECISION 25
+#define DC_HLL_RANK_BITS 6
+
+// JUSTIFY: Histograms of ranks up to 64 - precision + 1
+//  - Ranks are the leading zeros (plus 1) of the hash bits after the register index, so at most
+//    61 for the minimum precision.
+#define DC_HLL_HISTOGRAM_SIZE (64 - DC_HLL_MIN_PRECISION + 2)
+
+/// The register of the `hash`, from its high `precision` bits.
+DC_PUBLIC static size_t dc_hll_index(uint64_t hash, unsigned precision) {
+    return (size_t)(hash >> (64 - precision));
+}
+
+/// The number of leading zeros plus one of the `hash`'s bits after the register index.
+DC_PUBLIC static uint8_t dc_hll_rank(uint64_t hash, unsigned precision) {
+    uint64_t const rest = (hash << precision) | ((uint64_t)1 << (precision - 1));
+    return (uint8_t)(__builtin_clzll(rest) + 1);
+}
+
+DC_PUBLIC static uint32_t dc_hll_sparse_entry(uint64_t hash) {
+    return ((uint32_t)dc_hll_index(hash, DC_HLL_SPARSE_PRECISION) << DC_HLL_RANK_BITS) |
+           dc_hll_rank(hash, DC_HLL_SPARSE_PRECISION);
+}
+
+DC_PUBLIC static uint32_t dc_hll_sparse_entry_index(uint32_t entry) {
+    return entry >> DC_HLL_RANK_BITS;
+}
+
+DC_PUBLIC static uint8_t dc_hll_sparse_entry_rank(uint32_t entry) {
+    return (uint8_t)(entry & ((1U << DC_HLL_RANK_BITS) - 1));
+}
+
+/// The register at `precision` of a sparse `entry`.
+DC_PUBLIC static size_t dc_hll_sparse_entry_dense_index(uint32_t entry, unsigned precision) {
+    return dc_hll_sparse_entry_index(entry) >> (DC_HLL_SPARSE_PRECISION - precision);
+}
+
+/// The rank at `precision` of a sparse `entry`, for which the index bits below `precision` are
+/// the first bits after the register index.
+DC_PUBLIC static uint8_t dc_hll_sparse_entry_dense_rank(uint32_t entry, unsigned precision) {
+    unsigned const width = DC_HLL_SPARSE_PRECISION - precision;
+    uint32_t const low = dc_hll_sparse_entry_index(entry) & ((1U << width) - 1);
+    if (low == 0) {
+        return (uint8_t)(width + dc_hll_sparse_entry_rank(entry));
+    }
+    return (uint8_t)(width - (32 - (unsigned)__builtin_clz(low)) + 1);
+}
+
+/// The square root of `value` in (0, 1], by newton's method from above.
+DC_PUBLIC static double dc_hll_sqrt(double value) {
+    DC_ASSUME(value > 0.0 && value <= 1.0);
+    double root = 1.0;
+    for (;;) {
+        double const next = 0.5 * (root + (value / root));
+        if (next >= root) {
+            return root;
+        }
+        root = next;
+    }
+}
+
+DC_PUBLIC static double dc_hll_sigma(double value) {
+    double result = value;
+    double weight = 1.0;
+    for (;;) {
+        value *= value;
+        double const next = result + (value * weight);
+        if (next <= result) {
+            return result;
+        }
+        result = next;
+        weight += weight;
+    }
+}
+
+DC_PUBLIC static double dc_hll_tau(double value) {
+    if (value <= 0.0 || value >= 1.0) {
+        return 0.0;
+    }
+    double result = 1.0 - value;
+    double weight = 1.0;
+    for (;;) {
+        value = dc_hll_sqrt(value);
+        weight *= 0.5;
+        double const next = result - ((1.0 - value) * (1.0 - value) * weight);
+        if (next >= result) {
+            return result / 3.0;
+        }
+        result = next;
+    }
+}
+
+// JUSTIFY: Ertl's improved estimator ("New cardinality estimation algorithms for HyperLogLog
+//          sketches", 2017)
+//  - Accurate from empty to saturated registers, without the linear counting threshold or the
+//    empirical bias tables of HyperLogLog++, and without `libm`.
+//  - Applies to the sparse entries as registers of the sparse precision, so both modes share it.
+
+/// The estimated cardinality, from the `histogram` of the ranks of `2^precision` registers.
+DC_PUBLIC static double dc_hll_estimate(uint64_t const* histogram, unsigned precision) {
+    double const registers = (double)((uint64_t)1 << precision);
+    unsigned const max_rank = 64 - precision + 1;
+    if ((double)histogram[0] >= registers) {
+        return 0.0;
+    }
+
+    double z = registers * dc_hll_tau(1.0 - ((double)histogram[max_rank] / registers));
+    for (unsigned rank = max_rank - 1; rank >= 1; rank--) {
+        z = 0.5 * (z + (double)histogram[rank]);
+    }
+    z += registers * dc_hll_sigma((double)histogram[0] / registers);
+
+    // 1 / (2 ln 2), the limit of the bias correction constant as the registers grow
+    double const alpha = 0.7213475204444817;
+    return alpha * registers * registers / z;
+}
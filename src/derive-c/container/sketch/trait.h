@@ -0,0 +1,13 @@
+#pragma once
+
+#include <derive-c/core/prelude.h>
+
+/// Fixed memory summaries of a stream of items, that can be merged to summarise the union of
+/// streams.
+#define DC_TRAIT_SKETCH(SELF)                                                                      \
+    DC_REQUIRE_TYPE(SELF, item_t);                                                                 \
+    DC_REQUIRE_METHOD(void, SELF, add, (SELF*, NS(SELF, item_t)));                                 \
+    DC_REQUIRE_METHOD(void, SELF, merge, (SELF*, SELF const*));                                    \
+    DC_TRAIT_CLONEABLE(SELF);                                                                      \
+    DC_TRAIT_DELETABLE(SELF);                                                                      \
+    DC_TRAIT_DEBUGABLE(SELF)
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <derive-c/core/prelude.h>
+
+// JUSTIFY: Mixing with MurmurHash3's 64 bit finalizer
+//  - Estimates depend on every bit of the hash being uniform (e.g. the leading zeros of a
+//    hyperloglog's hash), and hashes such as the identity hash are far from uniform.
+//  - Unlike the filters, an add is otherwise only a few instructions on data in cache, so a
+//    stronger mix is worth its cost.
+//  - Copied, as `murmur.h` cannot be included from C++.
+DC_PUBLIC static uint64_t dc_sketch_mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
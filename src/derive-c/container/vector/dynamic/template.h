@@ -36,6 +36,10 @@ static void ITEM_DEBUG(ITEM const* /* self */, dc_debug_fmt /* fmt */, FILE* /*
     #define ITEM_DEBUG DC_DEFAULT_DEBUG
 #endif
 
+#if !defined GROWTH_POLICY
+    #define GROWTH_POLICY dc_growth_double
+#endif
+
 typedef size_t NS(SELF, index_t);
 typedef ITEM NS(SELF, item_t);
 
@@ -138,6 +142,29 @@ DC_PUBLIC static void NS(SELF, reserve)(SELF* self, size_t new_capacity) {
     }
 }
 
+/// Reduces the capacity to the size, returning unused capacity to the allocator.
+DC_PUBLIC static void NS(SELF, shrink_to_fit)(SELF* self) {
+    INVARIANT_CHECK(self);
+    if (self->size == self->capacity) {
+        return;
+    }
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    // JUSTIFY: Return to write level before passing to allocator
+    //  - As for `delete`, the unused capacity is uninitialised, but still valid memory
+    size_t const old_size = self->capacity * sizeof(ITEM);
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE,
+                          &self->data[self->size], (self->capacity - self->size) * sizeof(ITEM));
+    if (self->size == 0) {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->data, old_size);
+        self->data = NULL;
+    } else {
+        self->data = (ITEM*)NS(ALLOC, reallocate)(self->alloc_ref, self->data, old_size,
+                                                  self->size * sizeof(ITEM));
+    }
+    self->capacity = self->size;
+}
+
 DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
     INVARIANT_CHECK(self);
     ITEM* data = (ITEM*)NS(ALLOC, allocate_uninit)(self->alloc_ref, self->capacity * sizeof(ITEM));
@@ -229,26 +256,25 @@ DC_PUBLIC static void NS(SELF, remove_at)(SELF* self, size_t at, size_t count) {
                           &self->data[self->size], count * sizeof(ITEM));
 }
 
+/// Grows the capacity to fit at least `required` items, by the `GROWTH_POLICY`, so that
+/// repeated bulk appends are amortised.
+static void PRIV(NS(SELF, grow_to_fit))(SELF* self, size_t required) {
+    if (required > self->capacity) {
+        size_t const new_capacity = GROWTH_POLICY(self->capacity, required);
+        DC_ASSERT(new_capacity >= required,
+                  "Growth policy did not fit the required capacity {capacity=%lu, required=%lu, "
+                  "new_capacity=%lu}",
+                  (size_t)self->capacity, (size_t)required, (size_t)new_capacity);
+        NS(SELF, reserve)(self, new_capacity);
+    }
+}
+
 DC_PUBLIC static ITEM* NS(SELF, try_push)(SELF* self, ITEM item) {
     INVARIANT_CHECK(self);
     mutation_tracker_mutate(&self->iterator_invalidation_tracker);
 
     if (self->size == self->capacity) {
-        size_t new_capacity;
-        if (self->data == NULL) {
-            DC_ASSUME(self->capacity == 0);
-            // JUSTIFY: Allocating capacity of 4
-            //           - Avoid repeat reallocations on growing a vector from
-            //             size sero (from new)
-            //           Otherwise an arbitrary choice (given we do not know the size of T)
-            new_capacity = 8;
-        } else {
-            // JUSTIFY: Growth factor of 2
-            //           - Simple arithmetic (for debugging)
-            //           - Same as used by GCC's std::vector implementation
-            new_capacity = self->capacity * 2;
-        }
-        NS(SELF, reserve)(self, new_capacity);
+        PRIV(NS(SELF, grow_to_fit))(self, self->size + 1);
     }
 
     dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE,
@@ -267,6 +293,119 @@ DC_PUBLIC static ITEM* NS(SELF, push)(SELF* self, ITEM item) {
     return entry;
 }
 
+/// Appends `count` items, copied from `items`, reserving once.
+///  - `items` may point into the vector itself (e.g. to duplicate its contents).
+/// Returns a pointer to the first appended item, or `NULL` if `count` is zero.
+DC_PUBLIC static ITEM* NS(SELF, extend)(SELF* self, ITEM const* items, size_t count) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(items || count == 0);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (count == 0) {
+        return NULL;
+    }
+
+    // JUSTIFY: Re-deriving `items` after growing
+    //  - If `items` is within the vector, growing reallocates it, so `items` would dangle.
+    //  - Compared as integers, as comparing pointers to different objects is undefined.
+    uintptr_t const data_begin = (uintptr_t)self->data;
+    uintptr_t const data_end = data_begin + (self->size * sizeof(ITEM));
+    bool const aliased = (uintptr_t)items >= data_begin && (uintptr_t)items < data_end;
+    size_t const aliased_offset = aliased ? (size_t)(items - self->data) : 0;
+
+    PRIV(NS(SELF, grow_to_fit))(self, self->size + count);
+    if (aliased) {
+        items = &self->data[aliased_offset];
+    }
+    ITEM* entries = &self->data[self->size];
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE, entries,
+                          count * sizeof(ITEM));
+    memcpy(entries, items, count * sizeof(ITEM));
+    self->size += count;
+    return entries;
+}
+
+/// Resizes the vector to `new_size` items, without initialising any new items.
+///  - When growing, returns a pointer to the first new item, which must be written (e.g. by
+///    `fread` or `recv`) before being read.
+///  - When shrinking, the removed items are deleted, and `NULL` is returned.
+DC_PUBLIC static ITEM* NS(SELF, resize_uninit)(SELF* self, size_t new_size) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (new_size <= self->size) {
+        for (size_t i = new_size; i < self->size; i++) {
+            ITEM_DELETE(&self->data[i]);
+        }
+        dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE,
+                              &self->data[new_size], (self->size - new_size) * sizeof(ITEM));
+        self->size = new_size;
+        return NULL;
+    }
+
+    PRIV(NS(SELF, grow_to_fit))(self, new_size);
+    ITEM* entries = &self->data[self->size];
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE, entries,
+                          (new_size - self->size) * sizeof(ITEM));
+    self->size = new_size;
+    return entries;
+}
+
+typedef ITEM (*NS(SELF, generator))(size_t index, void* ctx);
+
+/// Appends `count` items produced by `generator`, which is passed the index of each new item in
+/// the vector, and `ctx`. Reserves once.
+/// Returns a pointer to the first appended item, or `NULL` if `count` is zero.
+DC_PUBLIC static ITEM* NS(SELF, extend_with)(SELF* self, size_t count,
+                                             NS(SELF, generator) generator, void* ctx) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(generator);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (count == 0) {
+        return NULL;
+    }
+
+    PRIV(NS(SELF, grow_to_fit))(self, self->size + count);
+    ITEM* entries = &self->data[self->size];
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE, entries,
+                          count * sizeof(ITEM));
+    for (size_t i = 0; i < count; i++) {
+        entries[i] = generator(self->size + i, ctx);
+    }
+    self->size += count;
+    return entries;
+}
+
+typedef bool (*NS(SELF, predicate))(ITEM const* item, void* ctx);
+
+/// Keeps only the items for which `predicate` returns true, preserving their order, and deleting
+/// the rest. Compacts in a single pass.
+/// Returns the number of items removed.
+DC_PUBLIC static size_t NS(SELF, retain)(SELF* self, NS(SELF, predicate) predicate, void* ctx) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(predicate);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    size_t kept = 0;
+    for (size_t index = 0; index < self->size; index++) {
+        if (predicate(&self->data[index], ctx)) {
+            if (kept != index) {
+                self->data[kept] = self->data[index];
+            }
+            kept++;
+        } else {
+            ITEM_DELETE(&self->data[index]);
+        }
+    }
+
+    size_t const removed = self->size - kept;
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE,
+                          &self->data[kept], removed * sizeof(ITEM));
+    self->size = kept;
+    return removed;
+}
+
 DC_PUBLIC static bool NS(SELF, try_pop)(SELF* self, ITEM* destination) {
     INVARIANT_CHECK(self);
     mutation_tracker_mutate(&self->iterator_invalidation_tracker);
@@ -489,6 +628,7 @@ DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE*
 
 #undef ITER_CONST
 #undef INVARIANT_CHECK
+#undef GROWTH_POLICY
 #undef ITEM_DEBUG
 #undef ITEM_CLONE
 #undef ITEM_DELETE
@@ -0,0 +1,17 @@
+#pragma once
+
+// [DERIVE-C] stdlib includes
+#include <stdbool.h> // IWYU pragma: export
+#include <stddef.h>  // IWYU pragma: export
+#include <stdint.h>  // IWYU pragma: export
+#include <stdio.h>   // IWYU pragma: export
+#include <string.h>  // IWYU pragma: export
+
+// [DERIVE-C] lib includes
+#include <derive-c/core/debug/gdb_marker.h>       // IWYU pragma: export
+#include <derive-c/core/debug/mutation_tracker.h> // IWYU pragma: export
+#include <derive-c/core/prelude.h>                // IWYU pragma: export
+#include <derive-c/alloc/std.h>                   // IWYU pragma: export
+
+// [DERIVE-C] container includes
+#include "unpack.h" // IWYU pragma: export
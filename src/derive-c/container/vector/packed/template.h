@@ -0,0 +1,241 @@
+/// @brief A vector of unsigned integers, each stored in exactly `BITS` bits.
+///
+/// For small codes (e.g. dictionary ids) whose range is known at compile time:
+///  - `get` and `set` are O(1) for any index, including values crossing a word boundary.
+///  - `unpack` decodes a range of values into a `uint32_t` buffer, vectorised with AVX2 where
+///    supported (for `BITS <= DC_PACKED_GATHER_MAX_BITS`).
+///  - Values are not addressable, so there are no item pointers, and this is not a
+///    `DC_TRAIT_VECTOR`.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined BITS
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("The number of bits (1 to 32) used to store each value")
+    #endif
+    #define BITS 5
+#endif
+
+DC_STATIC_ASSERT(BITS >= 1 && BITS <= 32, "BITS must be between 1 and 32");
+
+typedef size_t NS(SELF, index_t);
+typedef uint32_t NS(SELF, value_t);
+
+DC_STATIC_CONSTANT uint32_t NS(SELF, max_value) = (uint32_t)((((uint64_t)1) << BITS) - 1);
+
+typedef struct {
+    size_t size;
+    size_t capacity;
+    uint64_t* words;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_vector_packed_marker;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->size <= (self)->capacity);                                                   \
+    DC_ASSUME(DC_WHEN(!((self)->words), (self)->capacity == 0));
+
+DC_STATIC_CONSTANT size_t NS(SELF, max_size) = SIZE_MAX / BITS;
+
+// JUSTIFY: An extra padding word
+//  - So that the 8 byte window read for the last value (see `unpack.h`) is always in bounds.
+static size_t PRIV(NS(SELF, words_for))(size_t capacity) {
+    return ((capacity * BITS + 63) / 64) + 1;
+}
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .size = 0,
+        .capacity = 0,
+        .words = NULL,
+        .alloc_ref = alloc_ref,
+        .derive_c_vector_packed_marker = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+// JUSTIFY: Zeroed storage, and no per item memory tracking
+//  - Values share bytes, and reads and writes use windows spanning neighbouring values, so all
+//    words (including unused capacity) are kept initialised and accessible.
+DC_PUBLIC static void NS(SELF, reserve)(SELF* self, size_t new_capacity) {
+    INVARIANT_CHECK(self);
+    if (new_capacity <= self->capacity) {
+        return;
+    }
+    DC_ASSERT(new_capacity <= NS(SELF, max_size), "Cannot reserve beyond max size {capacity=%lu}",
+              (size_t)new_capacity);
+
+    size_t const new_words = PRIV(NS(SELF, words_for))(new_capacity);
+    if (self->words == NULL) {
+        self->words =
+            (uint64_t*)NS(ALLOC, allocate_zeroed)(self->alloc_ref, new_words * sizeof(uint64_t));
+    } else {
+        size_t const old_words = PRIV(NS(SELF, words_for))(self->capacity);
+        self->words = (uint64_t*)NS(ALLOC, reallocate)(self->alloc_ref, self->words,
+                                                       old_words * sizeof(uint64_t),
+                                                       new_words * sizeof(uint64_t));
+        memset(&self->words[old_words], 0, (new_words - old_words) * sizeof(uint64_t));
+    }
+    self->capacity = new_capacity;
+}
+
+DC_PUBLIC static SELF NS(SELF, new_with_capacity)(size_t capacity, NS(ALLOC, ref) alloc_ref) {
+    SELF self = NS(SELF, new)(alloc_ref);
+    NS(SELF, reserve)(&self, capacity);
+    return self;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new_with_capacity)(self->capacity, self->alloc_ref);
+    if (self->words != NULL) {
+        memcpy(new_self.words, self->words,
+               PRIV(NS(SELF, words_for))(self->capacity) * sizeof(uint64_t));
+    }
+    new_self.size = self->size;
+    return new_self;
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+DC_PUBLIC static size_t NS(SELF, capacity)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->capacity;
+}
+
+/// The bytes allocated for the packed values (including unused capacity and padding).
+DC_PUBLIC static size_t NS(SELF, capacity_bytes)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    if (self->words == NULL) {
+        return 0;
+    }
+    return PRIV(NS(SELF, words_for))(self->capacity) * sizeof(uint64_t);
+}
+
+DC_PUBLIC static bool NS(SELF, try_get)(SELF const* self, size_t index, uint32_t* destination) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(destination);
+    if (DC_LIKELY(index < self->size)) {
+        *destination = dc_packed_get((uint8_t const*)self->words, BITS, index);
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static uint32_t NS(SELF, get)(SELF const* self, size_t index) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(index < self->size, "Cannot get, index out of bounds {index=%lu, size=%lu}",
+              (size_t)index, (size_t)self->size);
+    return dc_packed_get((uint8_t const*)self->words, BITS, index);
+}
+
+DC_PUBLIC static void NS(SELF, set)(SELF* self, size_t index, uint32_t value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(index < self->size, "Cannot set, index out of bounds {index=%lu, size=%lu}",
+              (size_t)index, (size_t)self->size);
+    DC_ASSERT(value <= NS(SELF, max_value), "Cannot set, value too wide {value=%u, bits=%u}",
+              (unsigned)value, (unsigned)BITS);
+    dc_packed_set((uint8_t*)self->words, BITS, index, value);
+}
+
+DC_PUBLIC static void NS(SELF, push)(SELF* self, uint32_t value) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(value <= NS(SELF, max_value), "Cannot push, value too wide {value=%u, bits=%u}",
+              (unsigned)value, (unsigned)BITS);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (self->size == self->capacity) {
+        // JUSTIFY: Initial capacity of 64 values, and growth factor of 2
+        //  - At least one word of values, then as for `vector/dynamic`.
+        NS(SELF, reserve)(self, self->capacity == 0 ? 64 : self->capacity * 2);
+    }
+    dc_packed_set((uint8_t*)self->words, BITS, self->size, value);
+    self->size++;
+}
+
+DC_PUBLIC static bool NS(SELF, try_pop)(SELF* self, uint32_t* destination) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(destination);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (DC_LIKELY(self->size > 0)) {
+        self->size--;
+        *destination = dc_packed_get((uint8_t const*)self->words, BITS, self->size);
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static uint32_t NS(SELF, pop)(SELF* self) {
+    uint32_t value;
+    DC_ASSERT(NS(SELF, try_pop)(self, &value), "Cannot pop, already empty {size=%lu}",
+              (size_t)self->size);
+    return value;
+}
+
+/// Decodes the `count` values from index `from` into `out`.
+DC_PUBLIC static void NS(SELF, unpack)(SELF const* self, size_t from, size_t count,
+                                       uint32_t* out) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(out || count == 0);
+    DC_ASSERT(from + count <= self->size,
+              "Cannot unpack, range out of bounds {from=%lu, count=%lu, size=%lu}", (size_t)from,
+              (size_t)count, (size_t)self->size);
+    if (count == 0) {
+        return;
+    }
+    dc_packed_unpack((uint8_t const*)self->words, BITS, from, count, out);
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    if (self->words != NULL) {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->words,
+                              PRIV(NS(SELF, words_for))(self->capacity) * sizeof(uint64_t));
+    }
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "bits: %u,\n", (unsigned)BITS);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+    dc_debug_fmt_print(fmt, stream, "capacity: %lu,\n", self->capacity);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "values: [");
+    for (size_t index = 0; index < self->size; index++) {
+        if (index > 0) {
+            fprintf(stream, ", ");
+        }
+        fprintf(stream, "%u", (unsigned)dc_packed_get((uint8_t const*)self->words, BITS, index));
+    }
+    fprintf(stream, "],\n");
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef INVARIANT_CHECK
+#undef BITS
+
+DC_TRAIT_DELETABLE(SELF);
+DC_TRAIT_CLONEABLE(SELF);
+DC_TRAIT_DEBUGABLE(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <derive-c/core/prelude.h>
+#include <derive-c/test/mock.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define DC_PACKED_X86
+    #include <immintrin.h>
+#endif
+
+// JUSTIFY: Little endian only
+//  - Values are read and written through unaligned 64 bit windows over the packed bytes, in which
+//    bit `n` of the stream is bit `n % 8` of byte `n / 8`.
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    #error "derive-c packed vectors require a little endian target"
+#endif
+
+/// Reading and writing `bits` wide unsigned values, packed back to back in a byte stream.
+///  - Value `index` occupies stream bits `[index * bits, (index + 1) * bits)`.
+///  - For `bits <= 32`, any value lies within the 8 bytes starting at its first byte, so each
+///    access is a single unaligned 64 bit load (and store), regardless of word boundaries.
+///  - The stream must have 8 readable bytes after the first byte of its last value.
+
+/// The largest value width for which a value is always within one 32 bit window (as the AVX2
+/// kernel gathers), given it starts at a bit offset of up to 7 in its first byte.
+#define DC_PACKED_GATHER_MAX_BITS 25
+
+DC_PUBLIC static DC_INLINE uint32_t dc_packed_get(uint8_t const* bytes, uint32_t bits,
+                                                  size_t index) {
+    size_t const bit = index * bits;
+    uint64_t window;
+    memcpy(&window, bytes + (bit >> 3), sizeof(window));
+    return (uint32_t)((window >> (bit & 7)) & (((uint64_t)1 << bits) - 1));
+}
+
+DC_PUBLIC static DC_INLINE void dc_packed_set(uint8_t* bytes, uint32_t bits, size_t index,
+                                              uint32_t value) {
+    size_t const bit = index * bits;
+    uint64_t const mask = (((uint64_t)1 << bits) - 1) << (bit & 7);
+    uint64_t window;
+    memcpy(&window, bytes + (bit >> 3), sizeof(window));
+    window = (window & ~mask) | (((uint64_t)value << (bit & 7)) & mask);
+    memcpy(bytes + (bit >> 3), &window, sizeof(window));
+}
+
+DC_PUBLIC static void dc_packed_unpack_scalar(uint8_t const* bytes, uint32_t bits, size_t from,
+                                              size_t count, uint32_t* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = dc_packed_get(bytes, bits, from + i);
+    }
+}
+
+typedef enum {
+    DC_PACKED_ISA_SCALAR,
+    DC_PACKED_ISA_AVX2,
+} dc_packed_isa;
+
+// JUSTIFY: Mockable
+//  - So tests can check the scalar and vectorised unpacking on a machine supporting both.
+DC_MOCKABLE(dc_packed_isa, dc_packed_isa_get, (void)) {
+#if defined DC_PACKED_X86
+    dc_cpu_features const features = dc_cpu_features_get();
+    if (features.AVX2.compiled_with || features.AVX2.runtime_supported) {
+        return DC_PACKED_ISA_AVX2;
+    }
+#endif
+    return DC_PACKED_ISA_SCALAR;
+}
+
+#if defined DC_PACKED_X86
+/// Unpacks 8 values per iteration: gathers the 32 bit window starting at each value's first
+/// byte, then shifts each lane by the value's offset within that byte, and masks.
+DC_PUBLIC __attribute__((target("avx2"))) static void
+dc_packed_unpack_avx2(uint8_t const* bytes, uint32_t bits, size_t from, size_t count,
+                      uint32_t* out) {
+    DC_ASSUME(bits <= DC_PACKED_GATHER_MAX_BITS);
+    __m256i const mask = _mm256_set1_epi32((int)(((uint32_t)1 << bits) - 1));
+    __m256i const lane_bits = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                 _mm256_set1_epi32((int)bits));
+    __m256i const seven = _mm256_set1_epi32(7);
+
+    size_t const vector_end = count - (count % 8);
+    for (size_t i = 0; i < vector_end; i += 8) {
+        size_t const first_bit = (from + i) * bits;
+        uint8_t const* base = bytes + (first_bit >> 3);
+        __m256i const lane_bit =
+            _mm256_add_epi32(lane_bits, _mm256_set1_epi32((int)(first_bit & 7)));
+        __m256i const windows =
+            _mm256_i32gather_epi32((int const*)base, _mm256_srli_epi32(lane_bit, 3), 1);
+        __m256i const values =
+            _mm256_and_si256(_mm256_srlv_epi32(windows, _mm256_and_si256(lane_bit, seven)), mask);
+        _mm256_storeu_si256((__m256i*)(out + i), values);
+    }
+    dc_packed_unpack_scalar(bytes, bits, from + vector_end, count - vector_end, out + vector_end);
+}
+#endif
+
+/// Unpacks `count` values from index `from` into `out`, with the AVX2 kernel where supported and
+/// `bits <= DC_PACKED_GATHER_MAX_BITS`.
+DC_PUBLIC static void dc_packed_unpack(uint8_t const* bytes, uint32_t bits, size_t from,
+                                       size_t count, uint32_t* out) {
+#if defined DC_PACKED_X86
+    if (bits <= DC_PACKED_GATHER_MAX_BITS && count >= 8 &&
+        dc_packed_isa_get() == DC_PACKED_ISA_AVX2) {
+        dc_packed_unpack_avx2(bytes, bits, from, count, out);
+        return;
+    }
+#endif
+    dc_packed_unpack_scalar(bytes, bits, from, count, out);
+}
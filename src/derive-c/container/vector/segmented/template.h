@@ -0,0 +1,524 @@
+/// @brief A vector of segments doubling in size, so that items are never moved on growth.
+///
+/// Segments are sized as the blocks of `arena/geometric`:
+///  - Segment determined by checking the most significant bit of the index, so indexing is O(1).
+///  - Pushing allocates a new segment when full, and never copies existing items, so pointers to
+///    items stay valid across `push` and `pop`.
+///  - `try_insert_at` and `remove_at` shift the items after the position (as for `vector/dynamic`),
+///    so pointers to those items then refer to other items.
+///  - Segments are kept allocated once used, until `delete`.
+///
+/// For example with:
+/// ```c
+/// INITIAL_SEGMENT_INDEX_BITS = 3
+/// ```
+///
+/// | Index | Items | Offset | Segment |
+/// |-------|-------|--------|---------|
+/// |     0 |     8 |      0 |       0 |
+/// |     7 |       |      7 |       0 |
+/// |     8 |     8 |      0 |       1 |
+/// |    15 |       |      7 |       1 |
+/// |    16 |    16 |      0 |       2 |
+/// |    31 |       |     15 |       2 |
+/// |    32 |    32 |      0 |       3 |
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+typedef struct {
+    int x;
+} item_t;
+    #define ITEM item_t
+    #define ITEM_DELETE item_delete
+static void ITEM_DELETE(item_t* /* self */) {}
+    #define ITEM_CLONE item_clone
+static item_t ITEM_CLONE(item_t const* self) { return *self; }
+    #define ITEM_DEBUG item_debug
+static void ITEM_DEBUG(ITEM const* /* self */, dc_debug_fmt /* fmt */, FILE* /* stream */) {}
+#endif
+
+#if !defined ITEM_DELETE
+    #define ITEM_DELETE DC_NO_DELETE
+#endif
+
+#if !defined ITEM_CLONE
+    #define ITEM_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined ITEM_DEBUG
+    #define ITEM_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+#if !defined INITIAL_SEGMENT_INDEX_BITS
+    #define INITIAL_SEGMENT_INDEX_BITS 4
+#endif
+
+DC_STATIC_ASSERT(INITIAL_SEGMENT_INDEX_BITS > 0,
+                 "INITIAL_SEGMENT_INDEX_BITS must be greater than zero");
+DC_STATIC_ASSERT(INITIAL_SEGMENT_INDEX_BITS < 32, "INITIAL_SEGMENT_INDEX_BITS must be below 32");
+
+#define SEGMENT_INDEX_BITS (sizeof(size_t) * 8)
+#define MAX_SEGMENTS DC_ARENA_GEO_MAX_NUM_BLOCKS(SEGMENT_INDEX_BITS, INITIAL_SEGMENT_INDEX_BITS)
+#define SEGMENT_SIZE(SEGMENT) DC_ARENA_GEO_BLOCK_TO_SIZE(SEGMENT, INITIAL_SEGMENT_INDEX_BITS)
+
+typedef size_t NS(SELF, index_t);
+typedef ITEM NS(SELF, item_t);
+
+typedef struct {
+    size_t size;
+    // JUSTIFY: Segment count is a uint8_t
+    //  - As for `arena/geometric`, there are at most 64 segments for a 64 bit index.
+    uint8_t segments_allocated;
+    ITEM* segments[MAX_SEGMENTS];
+    // JUSTIFY: Caching the next slot to push to
+    //  - So that `push` is a pointer bump within a segment, as for `vector/dynamic`.
+    //  - When `back == back_end`, the next slot is looked up again (or a new segment allocated).
+    ITEM* back;
+    ITEM* back_end;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_vector_segmented_marker;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+/// The number of items held by the first `segments` segments.
+static size_t PRIV(NS(SELF, segments_capacity))(uint8_t segments) {
+    if (segments == 0) {
+        return 0;
+    }
+    if (segments == MAX_SEGMENTS) {
+        return SIZE_MAX;
+    }
+    return DC_ARENA_GEO_BLOCK_OFFSET_TO_INDEX(segments, (size_t)0, INITIAL_SEGMENT_INDEX_BITS);
+}
+
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->segments_allocated <= MAX_SEGMENTS);                                         \
+    DC_ASSUME((self)->size <= PRIV(NS(SELF, segments_capacity))((self)->segments_allocated));      \
+    DC_ASSUME((self)->back <= (self)->back_end);
+
+DC_STATIC_CONSTANT size_t NS(SELF, max_size) = SIZE_MAX;
+
+// JUSTIFY: Branch free segment lookup
+//  - Equivalent to `DC_ARENA_GEO_INDEX_TO_BLOCK` and `DC_ARENA_GEO_INDEX_TO_OFFSET`, but without
+//    the branches for the first segment, as this is on the path of every read and write.
+//  - The segment is the bit width of `index >> INITIAL_SEGMENT_INDEX_BITS`, and the offset is the
+//    index with the segment's start bit cleared (none for the first segment).
+static DC_INLINE ITEM* PRIV(NS(SELF, slot))(SELF const* self, size_t index) {
+    size_t const upper = index >> INITIAL_SEGMENT_INDEX_BITS;
+    uint8_t const segment = (uint8_t)DC_MATH_MSB_INDEX((upper << 1) | 1U);
+    size_t const start = ((size_t)1 << (segment + INITIAL_SEGMENT_INDEX_BITS - 1)) &
+                         ~(((size_t)1 << INITIAL_SEGMENT_INDEX_BITS) - 1);
+    return &self->segments[segment][index ^ start];
+}
+
+/// Points `back` at the slot for the next push, if it is allocated.
+static void PRIV(NS(SELF, seek_back))(SELF* self) {
+    if (self->size == PRIV(NS(SELF, segments_capacity))(self->segments_allocated)) {
+        self->back = NULL;
+        self->back_end = NULL;
+        return;
+    }
+    uint8_t const segment = DC_ARENA_GEO_INDEX_TO_BLOCK(self->size, INITIAL_SEGMENT_INDEX_BITS);
+    self->back = PRIV(NS(SELF, slot))(self, self->size);
+    self->back_end = self->segments[segment] + SEGMENT_SIZE(segment);
+}
+
+/// Sets the capability of the items in `[from, to)`, which may span several segments.
+static void PRIV(NS(SELF, track))(SELF const* self, size_t from, size_t to,
+                                  dc_memory_tracker_capability cap) {
+    while (from < to) {
+        uint8_t const segment = DC_ARENA_GEO_INDEX_TO_BLOCK(from, INITIAL_SEGMENT_INDEX_BITS);
+        size_t const offset =
+            DC_ARENA_GEO_INDEX_TO_OFFSET(from, segment, INITIAL_SEGMENT_INDEX_BITS);
+        size_t span = SEGMENT_SIZE(segment) - offset;
+        if (span > to - from) {
+            span = to - from;
+        }
+        dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, cap,
+                              &self->segments[segment][offset], span * sizeof(ITEM));
+        from += span;
+    }
+}
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .size = 0,
+        .segments_allocated = 0,
+        .segments = {},
+        .back = NULL,
+        .back_end = NULL,
+        .alloc_ref = alloc_ref,
+        .derive_c_vector_segmented_marker = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+DC_PUBLIC static size_t NS(SELF, capacity)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return PRIV(NS(SELF, segments_capacity))(self->segments_allocated);
+}
+
+/// Allocates segments until there is room for at least `capacity` items. Existing items are not
+/// moved.
+DC_PUBLIC static void NS(SELF, reserve)(SELF* self, size_t capacity) {
+    INVARIANT_CHECK(self);
+    while (PRIV(NS(SELF, segments_capacity))(self->segments_allocated) < capacity) {
+        DC_ASSERT(self->segments_allocated < MAX_SEGMENTS,
+                  "Cannot reserve, out of segments {capacity=%lu}", (size_t)capacity);
+        size_t const segment_bytes = SEGMENT_SIZE(self->segments_allocated) * sizeof(ITEM);
+        ITEM* segment = (ITEM*)NS(ALLOC, allocate_uninit)(self->alloc_ref, segment_bytes);
+        dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE, segment,
+                              segment_bytes);
+        self->segments[self->segments_allocated] = segment;
+        self->segments_allocated++;
+    }
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new)(self->alloc_ref);
+    NS(SELF, reserve)(&new_self, self->size);
+
+    PRIV(NS(SELF, track))(&new_self, 0, self->size, DC_MEMORY_TRACKER_CAP_WRITE);
+    for (size_t index = 0; index < self->size; index++) {
+        *PRIV(NS(SELF, slot))(&new_self, index) = ITEM_CLONE(PRIV(NS(SELF, slot))(self, index));
+    }
+    new_self.size = self->size;
+    PRIV(NS(SELF, seek_back))(&new_self);
+    return new_self;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, try_read)(SELF const* self, size_t index) {
+    INVARIANT_CHECK(self);
+    if (DC_LIKELY(index < self->size)) {
+        return PRIV(NS(SELF, slot))(self, index);
+    }
+    return NULL;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, read)(SELF const* self, size_t index) {
+    ITEM const* item = NS(SELF, try_read)(self, index);
+    DC_ASSERT(item, "Cannot read, index out of bounds {index=%lu, size=%lu}", (size_t)index,
+              (size_t)self->size);
+    return item;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, try_write)(SELF* self, size_t index) {
+    INVARIANT_CHECK(self);
+    if (DC_LIKELY(index < self->size)) {
+        return PRIV(NS(SELF, slot))(self, index);
+    }
+    return NULL;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, write)(SELF* self, size_t index) {
+    ITEM* item = NS(SELF, try_write)(self, index);
+    DC_ASSERT(item, "Cannot write, index out of bounds {index=%lu, size=%lu}", (size_t)index,
+              (size_t)self->size);
+    return item;
+}
+
+/// Inserts `count` items at `at`, shifting the items after it back across segments.
+DC_PUBLIC static ITEM* NS(SELF, try_insert_at)(SELF* self, size_t at, ITEM const* items,
+                                               size_t count) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(items);
+    DC_ASSERT(at <= self->size, "Cannot insert at, index out of bounds {at=%lu, size=%lu}",
+              (size_t)at, (size_t)self->size);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (count == 0) {
+        return NULL;
+    }
+
+    NS(SELF, reserve)(self, self->size + count);
+    PRIV(NS(SELF, track))(self, self->size, self->size + count, DC_MEMORY_TRACKER_CAP_WRITE);
+    for (size_t index = self->size; index > at; index--) {
+        *PRIV(NS(SELF, slot))(self, index - 1 + count) = *PRIV(NS(SELF, slot))(self, index - 1);
+    }
+    for (size_t i = 0; i < count; i++) {
+        *PRIV(NS(SELF, slot))(self, at + i) = items[i];
+    }
+    self->size += count;
+    PRIV(NS(SELF, seek_back))(self);
+    return PRIV(NS(SELF, slot))(self, at);
+}
+
+/// Removes `count` items from `at`, shifting the items after them forward across segments.
+DC_PUBLIC static void NS(SELF, remove_at)(SELF* self, size_t at, size_t count) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(at + count <= self->size,
+              "Cannot remove at, index out of bounds {at=%lu, count=%lu, size=%lu}", (size_t)at,
+              (size_t)count, (size_t)self->size);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (count == 0) {
+        return;
+    }
+
+    for (size_t index = at; index < at + count; index++) {
+        ITEM_DELETE(PRIV(NS(SELF, slot))(self, index));
+    }
+    for (size_t index = at + count; index < self->size; index++) {
+        *PRIV(NS(SELF, slot))(self, index - count) = *PRIV(NS(SELF, slot))(self, index);
+    }
+    self->size -= count;
+    PRIV(NS(SELF, track))(self, self->size, self->size + count, DC_MEMORY_TRACKER_CAP_NONE);
+    PRIV(NS(SELF, seek_back))(self);
+}
+
+DC_PUBLIC static ITEM* NS(SELF, try_push)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (self->back == self->back_end) {
+        if (self->size == PRIV(NS(SELF, segments_capacity))(self->segments_allocated)) {
+            if (self->segments_allocated == MAX_SEGMENTS) {
+                return NULL;
+            }
+            NS(SELF, reserve)(self, self->size + 1);
+        }
+        PRIV(NS(SELF, seek_back))(self);
+    }
+
+    ITEM* entry = self->back;
+    self->back++;
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE, entry,
+                          sizeof(ITEM));
+    *entry = item;
+    self->size++;
+    return entry;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, push)(SELF* self, ITEM item) {
+    ITEM* entry = NS(SELF, try_push)(self, item);
+    DC_ASSERT(entry != NULL, "Cannot push, already at max size {size=%lu, item=%s}",
+              (size_t)self->size, DC_DEBUG(ITEM_DEBUG, &item));
+    return entry;
+}
+
+DC_PUBLIC static bool NS(SELF, try_pop)(SELF* self, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (DC_LIKELY(self->size > 0)) {
+        self->size--;
+        ITEM* entry = PRIV(NS(SELF, slot))(self, self->size);
+        *destination = *entry;
+        dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE, entry,
+                              sizeof(ITEM));
+        PRIV(NS(SELF, seek_back))(self);
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static ITEM NS(SELF, pop)(SELF* self) {
+    ITEM entry;
+    DC_ASSERT(NS(SELF, try_pop)(self, &entry), "Cannot pop, already empty {size=%lu}",
+              (size_t)self->size);
+    return entry;
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    for (size_t index = 0; index < self->size; index++) {
+        ITEM* entry = PRIV(NS(SELF, slot))(self, index);
+        ITEM_DELETE(entry);
+        // JUSTIFY: Setting items as inaccessible
+        //  - Incase a destructor of one item accesses the memory of another.
+        dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_NONE, entry,
+                              sizeof(ITEM));
+    }
+
+    for (uint8_t segment = 0; segment < self->segments_allocated; segment++) {
+        // JUSTIFY: Return to write level before passing to allocator
+        //  - Is uninitialised, but still valid memory
+        size_t const segment_bytes = SEGMENT_SIZE(segment) * sizeof(ITEM);
+        dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, DC_MEMORY_TRACKER_CAP_WRITE,
+                              self->segments[segment], segment_bytes);
+        NS(ALLOC, deallocate)(self->alloc_ref, self->segments[segment], segment_bytes);
+    }
+}
+
+#define ITER NS(SELF, iter)
+typedef ITEM* NS(ITER, item);
+
+DC_PUBLIC static DC_INLINE bool NS(ITER, empty_item)(ITEM* const* item) { return *item == NULL; }
+
+// JUSTIFY: Iterating by segment
+//  - Walks a pointer through each segment, rather than looking up the segment for every index.
+typedef struct {
+    ITEM* const* segments;
+    ITEM* cursor;
+    ITEM* segment_end;
+    uint8_t next_segment;
+    size_t pos;
+    size_t size;
+    mutation_version version;
+} ITER;
+
+DC_PUBLIC static DC_INLINE ITEM* NS(ITER, next)(ITER* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->pos < iter->size) {
+        if (iter->cursor == iter->segment_end) {
+            iter->cursor = iter->segments[iter->next_segment];
+            iter->segment_end = iter->cursor + SEGMENT_SIZE(iter->next_segment);
+            iter->next_segment++;
+        }
+        ITEM* item = iter->cursor;
+        iter->cursor++;
+        iter->pos++;
+        return item;
+    }
+    return NULL;
+}
+
+DC_PUBLIC static DC_INLINE size_t NS(ITER, position)(ITER const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos;
+}
+
+DC_PUBLIC static DC_INLINE bool NS(ITER, empty)(ITER const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos >= iter->size;
+}
+
+DC_PUBLIC static DC_INLINE ITER NS(SELF, get_iter)(SELF* self) {
+    DC_ASSUME(self);
+    return (ITER){
+        .segments = self->segments,
+        .cursor = NULL,
+        .segment_end = NULL,
+        .next_segment = 0,
+        .pos = 0,
+        .size = self->size,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+#undef ITER
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef ITEM const* NS(ITER_CONST, item);
+
+DC_PUBLIC static DC_INLINE bool NS(ITER_CONST, empty_item)(ITEM const* const* item) {
+    return *item == NULL;
+}
+
+typedef struct {
+    ITEM* const* segments;
+    ITEM const* cursor;
+    ITEM const* segment_end;
+    uint8_t next_segment;
+    size_t pos;
+    size_t size;
+    mutation_version version;
+} ITER_CONST;
+
+DC_PUBLIC static DC_INLINE ITEM const* NS(ITER_CONST, next)(ITER_CONST* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->pos < iter->size) {
+        if (iter->cursor == iter->segment_end) {
+            iter->cursor = iter->segments[iter->next_segment];
+            iter->segment_end = iter->cursor + SEGMENT_SIZE(iter->next_segment);
+            iter->next_segment++;
+        }
+        ITEM const* item = iter->cursor;
+        iter->cursor++;
+        iter->pos++;
+        return item;
+    }
+    return NULL;
+}
+
+DC_PUBLIC static DC_INLINE size_t NS(ITER_CONST, position)(ITER_CONST const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos;
+}
+
+DC_PUBLIC static DC_INLINE bool NS(ITER_CONST, empty)(ITER_CONST const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos >= iter->size;
+}
+
+DC_PUBLIC static DC_INLINE ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    DC_ASSUME(self);
+    return (ITER_CONST){
+        .segments = self->segments,
+        .cursor = NULL,
+        .segment_end = NULL,
+        .next_segment = 0,
+        .pos = 0,
+        .size = self->size,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+    dc_debug_fmt_print(fmt, stream, "capacity: %lu,\n",
+                       PRIV(NS(SELF, segments_capacity))(self->segments_allocated));
+    dc_debug_fmt_print(fmt, stream, "segments: %u,\n", (unsigned)self->segments_allocated);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "items: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+
+    ITER_CONST iter = NS(SELF, get_iter_const)(self);
+    ITEM const* item;
+    while ((item = NS(ITER_CONST, next)(&iter))) {
+        dc_debug_fmt_print_indents(fmt, stream);
+        ITEM_DEBUG(item, fmt, stream);
+        fprintf(stream, ",\n");
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef ITER_CONST
+#undef INVARIANT_CHECK
+#undef SEGMENT_SIZE
+#undef MAX_SEGMENTS
+#undef SEGMENT_INDEX_BITS
+#undef INITIAL_SEGMENT_INDEX_BITS
+#undef ITEM_DEBUG
+#undef ITEM_CLONE
+#undef ITEM_DELETE
+#undef ITEM
+
+DC_TRAIT_VECTOR(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
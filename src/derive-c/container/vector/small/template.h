@@ -0,0 +1,428 @@
+/// @brief A vector storing up to `INLINE_CAPACITY` elements in-place, spilling to the allocator
+/// when it grows beyond that.
+///  - Avoids allocating for the common case of short vectors.
+///  - As elements may be stored inside the vector object, moving the vector invalidates pointers
+///    to its elements (unlike `vector/dynamic`).
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+// JUSTIFY: No memory tracking
+//  - As with `vector/static`, while inline the elements are inside the vector object itself, and
+//    poisoning these makes memcopying the struct throw in asan.
+//  - Tracking only the spilled elements would mean branching on every access, for little benefit.
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+typedef struct {
+    int x;
+} item_t;
+    #define ITEM item_t
+    #define ITEM_DELETE item_delete
+static void ITEM_DELETE(item_t* /* self */) {}
+    #define ITEM_CLONE item_clone
+static item_t ITEM_CLONE(item_t const* self) { return *self; }
+    #define ITEM_DEBUG item_debug
+static void ITEM_DEBUG(ITEM const* /* self */, dc_debug_fmt /* fmt */, FILE* /* stream */) {}
+#endif
+
+#if !defined ITEM_DELETE
+    #define ITEM_DELETE DC_NO_DELETE
+#endif
+
+#if !defined ITEM_CLONE
+    #define ITEM_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined ITEM_DEBUG
+    #define ITEM_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+#if !defined INLINE_CAPACITY
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("The INLINE_CAPACITY must be defined")
+    #endif
+    #define INLINE_CAPACITY 8
+#endif
+DC_STATIC_ASSERT(INLINE_CAPACITY > 0, "INLINE_CAPACITY must be greater than 0");
+
+typedef size_t NS(SELF, index_t);
+typedef ITEM NS(SELF, item_t);
+
+typedef struct {
+    size_t size;
+    // INVARIANT: Is `INLINE_CAPACITY` exactly when the elements are inline.
+    size_t capacity;
+    NS(ALLOC, ref) alloc_ref;
+    union {
+        ITEM inline_items[INLINE_CAPACITY];
+        ITEM* heap_items;
+    } storage;
+    dc_gdb_marker derive_c_smallvec;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->size <= (self)->capacity);                                                   \
+    DC_ASSUME((self)->capacity >= INLINE_CAPACITY);
+
+DC_STATIC_CONSTANT size_t NS(SELF, max_size) = SIZE_MAX;
+DC_STATIC_CONSTANT size_t NS(SELF, inline_capacity) = INLINE_CAPACITY;
+
+static DC_INLINE bool PRIV(NS(SELF, spilled))(SELF const* self) {
+    return self->capacity > INLINE_CAPACITY;
+}
+
+static DC_INLINE ITEM* PRIV(NS(SELF, items))(SELF* self) {
+    return PRIV(NS(SELF, spilled))(self) ? self->storage.heap_items : self->storage.inline_items;
+}
+
+static DC_INLINE ITEM const* PRIV(NS(SELF, items_const))(SELF const* self) {
+    return PRIV(NS(SELF, spilled))(self) ? self->storage.heap_items : self->storage.inline_items;
+}
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    SELF self = {
+        .size = 0,
+        .capacity = INLINE_CAPACITY,
+        .alloc_ref = alloc_ref,
+        .derive_c_smallvec = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+    return self;
+}
+
+DC_PUBLIC static void NS(SELF, reserve)(SELF* self, size_t new_capacity) {
+    INVARIANT_CHECK(self);
+    if (new_capacity <= self->capacity) {
+        return;
+    }
+
+    if (PRIV(NS(SELF, spilled))(self)) {
+        self->storage.heap_items = (ITEM*)NS(ALLOC, reallocate)(
+            self->alloc_ref, self->storage.heap_items, self->capacity * sizeof(ITEM),
+            new_capacity * sizeof(ITEM));
+    } else {
+        ITEM* heap_items =
+            (ITEM*)NS(ALLOC, allocate_uninit)(self->alloc_ref, new_capacity * sizeof(ITEM));
+        memcpy(heap_items, self->storage.inline_items, self->size * sizeof(ITEM));
+        self->storage.heap_items = heap_items;
+    }
+    self->capacity = new_capacity;
+}
+
+DC_PUBLIC static SELF NS(SELF, new_with_capacity)(size_t capacity, NS(ALLOC, ref) alloc_ref) {
+    SELF self = NS(SELF, new)(alloc_ref);
+    NS(SELF, reserve)(&self, capacity);
+    return self;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new_with_capacity)(self->size, self->alloc_ref);
+    ITEM const* items = PRIV(NS(SELF, items_const))(self);
+    ITEM* new_items = PRIV(NS(SELF, items))(&new_self);
+    for (size_t index = 0; index < self->size; index++) {
+        new_items[index] = ITEM_CLONE(&items[index]);
+    }
+    new_self.size = self->size;
+    return new_self;
+}
+
+/// Whether the elements are currently stored inline, without an allocation.
+DC_PUBLIC static bool NS(SELF, is_inline)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return !PRIV(NS(SELF, spilled))(self);
+}
+
+DC_PUBLIC static size_t NS(SELF, capacity)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->capacity;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, try_read)(SELF const* self, size_t index) {
+    INVARIANT_CHECK(self);
+    if (DC_LIKELY(index < self->size)) {
+        return &PRIV(NS(SELF, items_const))(self)[index];
+    }
+    return NULL;
+}
+
+DC_PUBLIC static ITEM const* NS(SELF, read)(SELF const* self, size_t index) {
+    ITEM const* item = NS(SELF, try_read)(self, index);
+    DC_ASSERT(item, "Cannot read, index out of bounds {index=%lu, size=%lu}", (size_t)index,
+              (size_t)self->size);
+    return item;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, try_write)(SELF* self, size_t index) {
+    INVARIANT_CHECK(self);
+    if (DC_LIKELY(index < self->size)) {
+        return &PRIV(NS(SELF, items))(self)[index];
+    }
+    return NULL;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, write)(SELF* self, size_t index) {
+    ITEM* item = NS(SELF, try_write)(self, index);
+    DC_ASSERT(item, "Cannot write, index out of bounds {index=%lu, size=%lu}", (size_t)index,
+              (size_t)self->size);
+    return item;
+}
+
+static void PRIV(NS(SELF, grow_for))(SELF* self, size_t required) {
+    if (required > self->capacity) {
+        // JUSTIFY: Growth factor of 2
+        //           - As with `vector/dynamic`
+        size_t new_capacity = self->capacity * 2;
+        if (new_capacity < required) {
+            new_capacity = required;
+        }
+        NS(SELF, reserve)(self, new_capacity);
+    }
+}
+
+DC_PUBLIC static ITEM* NS(SELF, try_insert_at)(SELF* self, size_t at, ITEM const* items,
+                                               size_t count) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(items);
+    DC_ASSERT(at <= self->size, "Cannot insert at, index out of bounds {at=%lu, size=%lu}",
+              (size_t)at, (size_t)self->size);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (count == 0) {
+        return NULL;
+    }
+
+    PRIV(NS(SELF, grow_for))(self, self->size + count);
+    ITEM* data = PRIV(NS(SELF, items))(self);
+    memmove(&data[at + count], &data[at], (self->size - at) * sizeof(ITEM));
+    memcpy(&data[at], items, count * sizeof(ITEM));
+    self->size += count;
+    return &data[at];
+}
+
+DC_PUBLIC static void NS(SELF, remove_at)(SELF* self, size_t at, size_t count) {
+    INVARIANT_CHECK(self);
+    DC_ASSERT(at + count <= self->size,
+              "Cannot remove at, index out of bounds {at=%lu, count=%lu, size=%lu}", (size_t)at,
+              (size_t)count, (size_t)self->size);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (count == 0) {
+        return;
+    }
+
+    ITEM* data = PRIV(NS(SELF, items))(self);
+    for (size_t i = at; i < at + count; i++) {
+        ITEM_DELETE(&data[i]);
+    }
+
+    memmove(&data[at], &data[at + count], (self->size - (at + count)) * sizeof(ITEM));
+    self->size -= count;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, try_push)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (self->size == self->capacity) {
+        PRIV(NS(SELF, grow_for))(self, self->size + 1);
+    }
+
+    ITEM* entry = &PRIV(NS(SELF, items))(self)[self->size];
+    *entry = item;
+    self->size++;
+    return entry;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, push)(SELF* self, ITEM item) {
+    ITEM* entry = NS(SELF, try_push)(self, item);
+    DC_ASSERT(entry != NULL, "Cannot push, already at max capacity {capacity=%lu, item=%s}",
+              (size_t)self->capacity, DC_DEBUG(ITEM_DEBUG, &item));
+    return entry;
+}
+
+DC_PUBLIC static bool NS(SELF, try_pop)(SELF* self, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (DC_LIKELY(self->size > 0)) {
+        self->size--;
+        *destination = PRIV(NS(SELF, items))(self)[self->size];
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static ITEM NS(SELF, pop)(SELF* self) {
+    ITEM entry;
+    DC_ASSERT(NS(SELF, try_pop)(self, &entry), "Cannot pop, already empty {size=%lu}",
+              (size_t)self->size);
+    return entry;
+}
+
+DC_PUBLIC static ITEM* NS(SELF, data)(SELF* self) {
+    INVARIANT_CHECK(self);
+    return PRIV(NS(SELF, items))(self);
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    ITEM* data = PRIV(NS(SELF, items))(self);
+    for (size_t i = 0; i < self->size; i++) {
+        ITEM_DELETE(&data[i]);
+    }
+    if (PRIV(NS(SELF, spilled))(self)) {
+        NS(ALLOC, deallocate)(self->alloc_ref, self->storage.heap_items,
+                              self->capacity * sizeof(ITEM));
+    }
+}
+
+#define ITER NS(SELF, iter)
+typedef ITEM* NS(ITER, item);
+
+DC_PUBLIC static DC_INLINE bool NS(ITER, empty_item)(ITEM* const* item) { return *item == NULL; }
+
+typedef struct {
+    ITEM* data;
+    size_t pos;
+    size_t size;
+    mutation_version version;
+} ITER;
+
+DC_PUBLIC static DC_INLINE ITEM* NS(ITER, next)(ITER* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+
+    if (iter->pos < iter->size) {
+        ITEM* item = &iter->data[iter->pos];
+        iter->pos++;
+        return item;
+    }
+    return NULL;
+}
+
+DC_PUBLIC static DC_INLINE size_t NS(ITER, position)(ITER const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos;
+}
+
+DC_PUBLIC static DC_INLINE bool NS(ITER, empty)(ITER const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos >= iter->size;
+}
+
+DC_PUBLIC static DC_INLINE ITER NS(SELF, get_iter)(SELF* self) {
+    DC_ASSUME(self);
+    return (ITER){
+        .data = PRIV(NS(SELF, items))(self),
+        .pos = 0,
+        .size = self->size,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+#undef ITER
+
+#define ITER_CONST NS(SELF, iter_const)
+typedef ITEM const* NS(ITER_CONST, item);
+
+DC_PUBLIC static DC_INLINE bool NS(ITER_CONST, empty_item)(ITEM const* const* item) {
+    return *item == NULL;
+}
+
+typedef struct {
+    ITEM const* data;
+    size_t pos;
+    size_t size;
+    mutation_version version;
+} ITER_CONST;
+
+DC_PUBLIC static DC_INLINE ITEM const* NS(ITER_CONST, next)(ITER_CONST* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    if (iter->pos < iter->size) {
+        ITEM const* item = &iter->data[iter->pos];
+        iter->pos++;
+        return item;
+    }
+    return NULL;
+}
+
+DC_PUBLIC static DC_INLINE size_t NS(ITER_CONST, position)(ITER_CONST const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos;
+}
+
+DC_PUBLIC static DC_INLINE bool NS(ITER_CONST, empty)(ITER_CONST const* DC_RESTRICT iter) {
+    DC_ASSUME(iter);
+    mutation_version_check(&iter->version);
+    return iter->pos >= iter->size;
+}
+
+DC_PUBLIC static DC_INLINE ITER_CONST NS(SELF, get_iter_const)(SELF const* self) {
+    DC_ASSUME(self);
+    return (ITER_CONST){
+        .data = PRIV(NS(SELF, items_const))(self),
+        .pos = 0,
+        .size = self->size,
+        .version = mutation_tracker_get(&self->iterator_invalidation_tracker),
+    };
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+    dc_debug_fmt_print(fmt, stream, "capacity: %lu,\n", self->capacity);
+    dc_debug_fmt_print(fmt, stream, "inline_capacity: %lu,\n", (size_t)INLINE_CAPACITY);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "items: @%p [\n", (void*)PRIV(NS(SELF, items_const))(self));
+    fmt = dc_debug_fmt_scope_begin(fmt);
+
+    ITER_CONST iter = NS(SELF, get_iter_const)(self);
+    ITEM const* item;
+    while ((item = NS(ITER_CONST, next)(&iter))) {
+        dc_debug_fmt_print_indents(fmt, stream);
+        ITEM_DEBUG(item, fmt, stream);
+        fprintf(stream, ",\n");
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef ITER_CONST
+#undef INVARIANT_CHECK
+#undef INLINE_CAPACITY
+#undef ITEM_DEBUG
+#undef ITEM_CLONE
+#undef ITEM_DELETE
+#undef ITEM
+
+DC_TRAIT_VECTOR(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
@@ -0,0 +1,333 @@
+/// @brief A structure of arrays vector, storing each field of the items in its own array.
+///
+/// The fields are taken from the item's reflection (as used by `DC_DERIVE_STRUCT`):
+/// ```c
+/// #define Trade_REFLECT(F)
+///     F(uint64_t, id)
+///     F(double, price)
+///
+/// DC_DERIVE_STRUCT(Trade)
+///
+/// #define ITEM Trade
+/// #define NAME trades
+/// #include <derive-c/container/vector/soa/template.h>
+/// ```
+///  - `push`, `read` and `write` take and return whole items, scattered across and gathered from
+///    the columns.
+///  - Each field's column is exposed as a contiguous array of `size` items, e.g.
+///    `trades_column_price(&trades)`, so scans over one field only touch that field's memory.
+///  - As items are not stored whole, there is no pointer to an item, and so this is not a
+///    `DC_TRAIT_VECTOR`.
+
+#include <derive-c/core/includes/def.h>
+#if !defined(SKIP_INCLUDES)
+    #include "includes.h"
+#endif
+
+#include <derive-c/core/alloc/def.h>
+#include <derive-c/core/self/def.h>
+
+#if !defined ITEM
+    #if !defined DC_PLACEHOLDERS
+TEMPLATE_ERROR("No ITEM")
+    #endif
+    // JUSTIFY: Marking the placeholder
+    //  - So only the placeholder's `item_t_REFLECT` is undefined, not that of a user's `item_t`.
+    #define _DC_VECTOR_SOA_PLACEHOLDER_ITEM
+    #define item_t_REFLECT(F)                                                                      \
+        F(int, x)                                                                                  \
+        F(double, y)
+DC_DERIVE_STRUCT(item_t)
+    #define ITEM item_t
+    #define ITEM_DELETE item_delete
+static void ITEM_DELETE(item_t* /* self */) {}
+    #define ITEM_CLONE item_clone
+static item_t ITEM_CLONE(item_t const* self) { return *self; }
+    #define ITEM_DEBUG item_debug
+static void ITEM_DEBUG(ITEM const* /* self */, dc_debug_fmt /* fmt */, FILE* /* stream */) {}
+#endif
+
+#if !defined ITEM_REFLECT
+    #define ITEM_REFLECT NS(ITEM, REFLECT)
+#endif
+
+#if !defined ITEM_DELETE
+    #define ITEM_DELETE DC_NO_DELETE
+#endif
+
+#if !defined ITEM_CLONE
+    #define ITEM_CLONE DC_COPY_CLONE
+#endif
+
+#if !defined ITEM_DEBUG
+    #define ITEM_DEBUG DC_DEFAULT_DEBUG
+#endif
+
+typedef size_t NS(SELF, index_t);
+typedef ITEM NS(SELF, item_t);
+
+#define COLUMNS NS(SELF, columns)
+
+#define COLUMN_FIELD(MEMBER_TYPE, MEMBER_NAME) MEMBER_TYPE* MEMBER_NAME;
+typedef struct {
+    ITEM_REFLECT(COLUMN_FIELD)
+} COLUMNS;
+#undef COLUMN_FIELD
+
+typedef struct {
+    size_t size;
+    size_t capacity;
+    COLUMNS columns;
+    NS(ALLOC, ref) alloc_ref;
+    dc_gdb_marker derive_c_vector_soa_marker;
+    mutation_tracker iterator_invalidation_tracker;
+} SELF;
+
+#define INVARIANT_CHECK(self)                                                                      \
+    DC_ASSUME(self);                                                                               \
+    DC_ASSUME((self)->size <= (self)->capacity);
+
+DC_STATIC_CONSTANT size_t NS(SELF, max_size) = SIZE_MAX;
+
+/// Sets the capability of items `[from, to)` in every column.
+static void PRIV(NS(SELF, track))(SELF const* self, size_t from, size_t to,
+                                  dc_memory_tracker_capability cap) {
+#define COLUMN_TRACK(MEMBER_TYPE, MEMBER_NAME)                                                     \
+    dc_memory_tracker_set(DC_MEMORY_TRACKER_LVL_CONTAINER, cap, &self->columns.MEMBER_NAME[from],  \
+                          (to - from) * sizeof(MEMBER_TYPE));
+    ITEM_REFLECT(COLUMN_TRACK)
+#undef COLUMN_TRACK
+}
+
+static ITEM PRIV(NS(SELF, gather))(SELF const* self, size_t index) {
+#define COLUMN_GATHER(MEMBER_TYPE, MEMBER_NAME) .MEMBER_NAME = self->columns.MEMBER_NAME[index],
+    return (ITEM){ITEM_REFLECT(COLUMN_GATHER)};
+#undef COLUMN_GATHER
+}
+
+static void PRIV(NS(SELF, scatter))(SELF* self, size_t index, ITEM const* item) {
+#define COLUMN_SCATTER(MEMBER_TYPE, MEMBER_NAME)                                                   \
+    self->columns.MEMBER_NAME[index] = item->MEMBER_NAME;
+    ITEM_REFLECT(COLUMN_SCATTER)
+#undef COLUMN_SCATTER
+}
+
+DC_PUBLIC static SELF NS(SELF, new)(NS(ALLOC, ref) alloc_ref) {
+    return (SELF){
+        .size = 0,
+        .capacity = 0,
+        .columns = {},
+        .alloc_ref = alloc_ref,
+        .derive_c_vector_soa_marker = dc_gdb_marker_new(),
+        .iterator_invalidation_tracker = mutation_tracker_new(),
+    };
+}
+
+DC_PUBLIC static void NS(SELF, reserve)(SELF* self, size_t new_capacity) {
+    INVARIANT_CHECK(self);
+    if (new_capacity <= self->capacity) {
+        return;
+    }
+
+    if (self->capacity == 0) {
+#define COLUMN_ALLOCATE(MEMBER_TYPE, MEMBER_NAME)                                                  \
+    self->columns.MEMBER_NAME = (MEMBER_TYPE*)NS(ALLOC, allocate_uninit)(                          \
+        self->alloc_ref, new_capacity * sizeof(MEMBER_TYPE));
+        ITEM_REFLECT(COLUMN_ALLOCATE)
+#undef COLUMN_ALLOCATE
+    } else {
+        PRIV(NS(SELF, track))(self, self->size, self->capacity, DC_MEMORY_TRACKER_CAP_WRITE);
+#define COLUMN_REALLOCATE(MEMBER_TYPE, MEMBER_NAME)                                                \
+    self->columns.MEMBER_NAME = (MEMBER_TYPE*)NS(ALLOC, reallocate)(                               \
+        self->alloc_ref, self->columns.MEMBER_NAME, self->capacity * sizeof(MEMBER_TYPE),          \
+        new_capacity * sizeof(MEMBER_TYPE));
+        ITEM_REFLECT(COLUMN_REALLOCATE)
+#undef COLUMN_REALLOCATE
+    }
+
+    self->capacity = new_capacity;
+    PRIV(NS(SELF, track))(self, self->size, self->capacity, DC_MEMORY_TRACKER_CAP_NONE);
+}
+
+DC_PUBLIC static SELF NS(SELF, new_with_capacity)(size_t capacity, NS(ALLOC, ref) alloc_ref) {
+    SELF self = NS(SELF, new)(alloc_ref);
+    NS(SELF, reserve)(&self, capacity);
+    return self;
+}
+
+DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    SELF new_self = NS(SELF, new_with_capacity)(self->capacity, self->alloc_ref);
+    PRIV(NS(SELF, track))(&new_self, 0, self->size, DC_MEMORY_TRACKER_CAP_WRITE);
+    for (size_t index = 0; index < self->size; index++) {
+        ITEM const item = PRIV(NS(SELF, gather))(self, index);
+        ITEM const cloned = ITEM_CLONE(&item);
+        PRIV(NS(SELF, scatter))(&new_self, index, &cloned);
+    }
+    new_self.size = self->size;
+    return new_self;
+}
+
+DC_PUBLIC static size_t NS(SELF, size)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->size;
+}
+
+DC_PUBLIC static size_t NS(SELF, capacity)(SELF const* self) {
+    INVARIANT_CHECK(self);
+    return self->capacity;
+}
+
+/// Gathers the item at `index` from each column.
+DC_PUBLIC static bool NS(SELF, try_read)(SELF const* self, size_t index, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(destination);
+    if (DC_LIKELY(index < self->size)) {
+        *destination = PRIV(NS(SELF, gather))(self, index);
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static ITEM NS(SELF, read)(SELF const* self, size_t index) {
+    ITEM item;
+    DC_ASSERT(NS(SELF, try_read)(self, index, &item),
+              "Cannot read, index out of bounds {index=%lu, size=%lu}", (size_t)index,
+              (size_t)self->size);
+    return item;
+}
+
+/// Replaces the item at `index`, deleting the previous item.
+DC_PUBLIC static bool NS(SELF, try_write)(SELF* self, size_t index, ITEM item) {
+    INVARIANT_CHECK(self);
+    if (DC_LIKELY(index < self->size)) {
+        ITEM previous = PRIV(NS(SELF, gather))(self, index);
+        ITEM_DELETE(&previous);
+        PRIV(NS(SELF, scatter))(self, index, &item);
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static void NS(SELF, write)(SELF* self, size_t index, ITEM item) {
+    DC_ASSERT(NS(SELF, try_write)(self, index, item),
+              "Cannot write, index out of bounds {index=%lu, size=%lu}", (size_t)index,
+              (size_t)self->size);
+}
+
+/// Appends the item, scattering its fields to the end of each column. Returns its index.
+DC_PUBLIC static size_t NS(SELF, push)(SELF* self, ITEM item) {
+    INVARIANT_CHECK(self);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (self->size == self->capacity) {
+        // JUSTIFY: Initial capacity of 8 and growth factor of 2
+        //  - As for `vector/dynamic`.
+        NS(SELF, reserve)(self, self->capacity == 0 ? 8 : self->capacity * 2);
+    }
+
+    size_t const index = self->size;
+    PRIV(NS(SELF, track))(self, index, index + 1, DC_MEMORY_TRACKER_CAP_WRITE);
+    PRIV(NS(SELF, scatter))(self, index, &item);
+    self->size++;
+    return index;
+}
+
+DC_PUBLIC static bool NS(SELF, try_pop)(SELF* self, ITEM* destination) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(destination);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    if (DC_LIKELY(self->size > 0)) {
+        self->size--;
+        *destination = PRIV(NS(SELF, gather))(self, self->size);
+        PRIV(NS(SELF, track))(self, self->size, self->size + 1, DC_MEMORY_TRACKER_CAP_NONE);
+        return true;
+    }
+    return false;
+}
+
+DC_PUBLIC static ITEM NS(SELF, pop)(SELF* self) {
+    ITEM item;
+    DC_ASSERT(NS(SELF, try_pop)(self, &item), "Cannot pop, already empty {size=%lu}",
+              (size_t)self->size);
+    return item;
+}
+
+/// For each field, `column_<field>` and `column_const_<field>` return its column of `size` items.
+///  - Invalidated by any operation that grows the vector.
+#define COLUMN_ACCESSORS(MEMBER_TYPE, MEMBER_NAME)                                                 \
+    DC_PUBLIC static MEMBER_TYPE* NS(NS(SELF, column), MEMBER_NAME)(SELF* self) {                  \
+        INVARIANT_CHECK(self);                                                                     \
+        return self->columns.MEMBER_NAME;                                                          \
+    }                                                                                              \
+    DC_PUBLIC static MEMBER_TYPE const* NS(NS(SELF, column_const),                                 \
+                                           MEMBER_NAME)(SELF const* self) {                        \
+        INVARIANT_CHECK(self);                                                                     \
+        return self->columns.MEMBER_NAME;                                                          \
+    }
+ITEM_REFLECT(COLUMN_ACCESSORS)
+#undef COLUMN_ACCESSORS
+
+DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
+    INVARIANT_CHECK(self);
+    for (size_t index = 0; index < self->size; index++) {
+        ITEM item = PRIV(NS(SELF, gather))(self, index);
+        ITEM_DELETE(&item);
+    }
+
+    if (self->capacity > 0) {
+        // JUSTIFY: Return to write level before passing to allocator
+        //  - Is uninitialised, but still valid memory
+        PRIV(NS(SELF, track))(self, 0, self->capacity, DC_MEMORY_TRACKER_CAP_WRITE);
+#define COLUMN_DEALLOCATE(MEMBER_TYPE, MEMBER_NAME)                                                \
+    NS(ALLOC, deallocate)(self->alloc_ref, self->columns.MEMBER_NAME,                              \
+                          self->capacity * sizeof(MEMBER_TYPE));
+        ITEM_REFLECT(COLUMN_DEALLOCATE)
+#undef COLUMN_DEALLOCATE
+    }
+}
+
+DC_PUBLIC static void NS(SELF, debug)(SELF const* self, dc_debug_fmt fmt, FILE* stream) {
+    fprintf(stream, DC_EXPAND_STRING(SELF) "@%p {\n", (void*)self);
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    dc_debug_fmt_print(fmt, stream, "size: %lu,\n", self->size);
+    dc_debug_fmt_print(fmt, stream, "capacity: %lu,\n", self->capacity);
+
+    dc_debug_fmt_print(fmt, stream, "alloc: ");
+    NS(ALLOC, debug)(NS(NS(ALLOC, ref), deref)(self->alloc_ref), fmt, stream);
+    fprintf(stream, ",\n");
+
+    dc_debug_fmt_print(fmt, stream, "items: [\n");
+    fmt = dc_debug_fmt_scope_begin(fmt);
+    for (size_t index = 0; index < self->size; index++) {
+        ITEM const item = PRIV(NS(SELF, gather))(self, index);
+        dc_debug_fmt_print_indents(fmt, stream);
+        ITEM_DEBUG(&item, fmt, stream);
+        fprintf(stream, ",\n");
+    }
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "],\n");
+    fmt = dc_debug_fmt_scope_end(fmt);
+    dc_debug_fmt_print(fmt, stream, "}");
+}
+
+#undef INVARIANT_CHECK
+#undef COLUMNS
+#undef ITEM_REFLECT
+#undef ITEM_DEBUG
+#undef ITEM_CLONE
+#undef ITEM_DELETE
+#undef ITEM
+#if defined _DC_VECTOR_SOA_PLACEHOLDER_ITEM
+    #undef item_t_REFLECT
+    #undef _DC_VECTOR_SOA_PLACEHOLDER_ITEM
+#endif
+
+DC_TRAIT_DELETABLE(SELF);
+DC_TRAIT_CLONEABLE(SELF);
+DC_TRAIT_DEBUGABLE(SELF);
+
+#include <derive-c/core/self/undef.h>
+#include <derive-c/core/alloc/undef.h>
+#include <derive-c/core/includes/undef.h>
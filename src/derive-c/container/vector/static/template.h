@@ -178,6 +178,34 @@ DC_PUBLIC static void NS(SELF, remove_at)(SELF* self, INDEX_TYPE at, INDEX_TYPE
     self->size -= count;
 }
 
+typedef bool (*NS(SELF, predicate))(ITEM const* item, void* ctx);
+
+/// Keeps only the items for which `predicate` returns true, preserving their order, and deleting
+/// the rest. Compacts in a single pass.
+/// Returns the number of items removed.
+DC_PUBLIC static INDEX_TYPE NS(SELF, retain)(SELF* self, NS(SELF, predicate) predicate,
+                                             void* ctx) {
+    INVARIANT_CHECK(self);
+    DC_ASSUME(predicate);
+    mutation_tracker_mutate(&self->iterator_invalidation_tracker);
+
+    INDEX_TYPE kept = 0;
+    for (INDEX_TYPE index = 0; index < self->size; index++) {
+        if (predicate(&self->data[index], ctx)) {
+            if (kept != index) {
+                self->data[kept] = self->data[index];
+            }
+            kept++;
+        } else {
+            ITEM_DELETE(&self->data[index]);
+        }
+    }
+
+    INDEX_TYPE const removed = (INDEX_TYPE)(self->size - kept);
+    self->size = kept;
+    return removed;
+}
+
 DC_PUBLIC static ITEM* NS(SELF, push)(SELF* self, ITEM item) {
     ITEM* slot = NS(SELF, try_push)(self, item);
     DC_ASSERT(slot, "Cannot push, already at max capacity {capacity=%d, item=%s}", CAPACITY,
@@ -203,6 +231,11 @@ DC_PUBLIC static ITEM NS(SELF, pop)(SELF* self) {
     return entry;
 }
 
+DC_PUBLIC static ITEM* NS(SELF, data)(SELF* self) {
+    INVARIANT_CHECK(self);
+    return self->data;
+}
+
 DC_PUBLIC static INDEX_TYPE NS(SELF, size)(SELF const* self) {
     INVARIANT_CHECK(self);
     return self->size;
@@ -0,0 +1,69 @@
+/// @brief Growth policies for containers with a single contiguous buffer.
+///
+/// A growth policy is called as `policy(capacity, required)` when a buffer of `capacity` items
+/// must grow to fit at least `required` items (`required > capacity`). It returns the new
+/// capacity, which is at least `required`.
+///  - Containers take their policy as the `GROWTH_POLICY` template parameter (a function, or a
+///    function-like macro), defaulting to `dc_growth_double`.
+///  - Capacities saturate at `SIZE_MAX`, the container checks its own maximum.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <derive-c/core/attributes.h>
+#include <derive-c/core/compiler.h>
+#include <derive-c/core/namespace.h>
+
+// JUSTIFY: Initial capacity of 8
+//  - Avoids repeat reallocations on growing a container from empty.
+//  - Otherwise an arbitrary choice (given we do not know the size of the item)
+#define DC_GROWTH_INITIAL_CAPACITY 8
+
+DC_PUBLIC static DC_INLINE DC_CONST size_t _dc_growth_fit(size_t new_capacity, size_t required) {
+    if (new_capacity == 0) {
+        new_capacity = DC_GROWTH_INITIAL_CAPACITY;
+    }
+    return new_capacity < required ? required : new_capacity;
+}
+
+DC_PUBLIC static DC_INLINE DC_CONST size_t _dc_growth_add(size_t capacity, size_t increase) {
+    return capacity > SIZE_MAX - increase ? SIZE_MAX : capacity + increase;
+}
+
+/// Doubles the capacity.
+///  - The fewest reallocations, and the amortised cost of a push is lowest.
+///  - Up to half of the buffer is unused, and a freed buffer can never be reused by the next
+///    growth (it is always smaller than the sum of those before it).
+DC_PUBLIC static DC_INLINE DC_CONST size_t dc_growth_double(size_t capacity, size_t required) {
+    return _dc_growth_fit(_dc_growth_add(capacity, capacity), required);
+}
+
+/// Grows the capacity by half.
+///  - At most a third of the buffer is unused, at the cost of more reallocations.
+///  - After a few growths, the sum of freed buffers exceeds the next request, so an allocator
+///    can reuse them.
+DC_PUBLIC static DC_INLINE DC_CONST size_t dc_growth_one_and_half(size_t capacity,
+                                                                  size_t required) {
+    return _dc_growth_fit(_dc_growth_add(capacity, capacity / 2), required);
+}
+
+/// Doubles the capacity until it reaches `limit`, then grows by `limit` items at a time.
+///  - For containers which may become large, bounding the unused capacity to `limit` items.
+///  - Pushes past `limit` are amortised over `limit` items, rather than over the size.
+DC_PUBLIC static DC_INLINE DC_CONST size_t dc_growth_double_then_linear(size_t capacity,
+                                                                        size_t required,
+                                                                        size_t limit) {
+    if (capacity < limit) {
+        size_t const doubled = _dc_growth_add(capacity, capacity);
+        return _dc_growth_fit(doubled < limit ? doubled : limit, required);
+    }
+    return _dc_growth_fit(_dc_growth_add(capacity, limit), required);
+}
+
+/// Defines a growth policy `NAME`, which doubles the capacity until `LIMIT` items, then grows
+/// linearly by `LIMIT` items.
+#define DC_GROWTH_DOUBLE_THEN_LINEAR(NAME, LIMIT)                                                  \
+    static size_t NAME(size_t capacity, size_t required) {                                         \
+        return dc_growth_double_then_linear(capacity, required, LIMIT);                            \
+    }
@@ -10,6 +10,11 @@ DC_PUBLIC static bool NS(INDEX, eq)(INDEX const* idx_1, INDEX const* idx_2) {
     return idx_1->index == idx_2->index;
 }
 
+/// The index of no entry, for example the niche of an option of indices.
+DC_PUBLIC static INDEX NS(INDEX, none)() { return (INDEX){.index = INDEX_NONE}; }
+
+DC_PUBLIC static bool NS(INDEX, is_none)(INDEX const* idx) { return idx->index == INDEX_NONE; }
+
 DC_PUBLIC static void NS(INDEX, debug)(INDEX const* idx, dc_debug_fmt fmt, FILE* stream) {
     (void)fmt;
     fprintf(stream, DC_EXPAND_STRING(INDEX) " { %lu }", (size_t)idx->index);
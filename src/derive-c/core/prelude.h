@@ -5,6 +5,7 @@
 // Helpful
 #include <derive-c/core/attributes.h>   // IWYU pragma: export
 #include <derive-c/core/derive.h>       // IWYU pragma: export
+#include <derive-c/core/growth.h>       // IWYU pragma: export
 #include <derive-c/core/math.h>         // IWYU pragma: export
 #include <derive-c/core/namespace.h>    // IWYU pragma: export
 #include <derive-c/core/placeholder.h>  // IWYU pragma: export
@@ -18,17 +18,33 @@
     DC_ASSUME(!NS(SELF, lt)(&a, &a));                                                              \
     DC_ASSUME(!NS(SELF, gt)(&a, &a))
 
+#define DC_MEM_LT(SELF_1, SELF_2) (*(SELF_1) < *(SELF_2))
+#define DC_MEM_GT(SELF_1, SELF_2) (*(SELF_1) > *(SELF_2))
+
+/// Derived orderings are lexicographic over the members, in declaration order.
 #define _DC_DERIVE_ORD_MEMBER_GT(MEMBER_TYPE, MEMBER_NAME)                                         \
-    || NS(MEMBER_TYPE, gt)(&self_1->MEMBER_NAME, &self_2->MEMBER_NAME)
+    if (NS(MEMBER_TYPE, gt)(&self_1->MEMBER_NAME, &self_2->MEMBER_NAME)) {                         \
+        return true;                                                                               \
+    }                                                                                              \
+    if (NS(MEMBER_TYPE, gt)(&self_2->MEMBER_NAME, &self_1->MEMBER_NAME)) {                         \
+        return false;                                                                              \
+    }
 #define _DC_DERIVE_ORD_MEMBER_LT(MEMBER_TYPE, MEMBER_NAME)                                         \
-    || NS(MEMBER_TYPE, lt)(&self_1->MEMBER_NAME, &self_2->MEMBER_NAME)
+    if (NS(MEMBER_TYPE, lt)(&self_1->MEMBER_NAME, &self_2->MEMBER_NAME)) {                         \
+        return true;                                                                               \
+    }                                                                                              \
+    if (NS(MEMBER_TYPE, lt)(&self_2->MEMBER_NAME, &self_1->MEMBER_NAME)) {                         \
+        return false;                                                                              \
+    }
 
 #define DC_DERIVE_ORD(TYPE)                                                                        \
     DC_PUBLIC static bool NS(TYPE, gt)(TYPE const* self_1, TYPE const* self_2) {                   \
-        return false NS(TYPE, REFLECT)(_DC_DERIVE_ORD_MEMBER_GT);                                  \
+        NS(TYPE, REFLECT)(_DC_DERIVE_ORD_MEMBER_GT)                                                \
+        return false;                                                                              \
     }                                                                                              \
     DC_PUBLIC static bool NS(TYPE, lt)(TYPE const* self_1, TYPE const* self_2) {                   \
-        return false NS(TYPE, REFLECT)(_DC_DERIVE_ORD_MEMBER_LT);                                  \
+        NS(TYPE, REFLECT)(_DC_DERIVE_ORD_MEMBER_LT)                                                \
+        return false;                                                                              \
     }
 
 #define _DC_DERIVE_STD_ORD(TYPE, ...)                                                              \
@@ -1,5 +1,10 @@
 /// @brief A simple optional type, using the (already) optional pointer type
 // for access
+///
+/// By default a `present` flag is stored beside the item. Defining `ITEM_NICHE` (a value of `ITEM`
+/// that is never present, such as `NULL`, or an arena's `none` index) stores the empty option as
+/// that value instead, so the option is the same size as the item.
+///  - `ITEM_IS_NICHE(item_ptr)` defaults to comparing with `==`, so must be defined for structs.
 
 #include <derive-c/core/includes/def.h>
 #if !defined(SKIP_INCLUDES)
@@ -38,6 +43,28 @@ static void ITEM_DEBUG(ITEM const* /* self */, dc_debug_fmt /* fmt */, FILE* /*
     #define ITEM_DEBUG DC_DEFAULT_DEBUG
 #endif
 
+#if defined ITEM_NICHE
+    #if !defined ITEM_IS_NICHE
+        #define ITEM_IS_NICHE(item_ptr) (*(item_ptr) == ITEM_NICHE)
+    #endif
+
+typedef struct {
+    ITEM item;
+    dc_gdb_marker derive_c_option;
+} SELF;
+
+DC_STATIC_ASSERT(sizeof(SELF) == sizeof(ITEM),
+                 DC_EXPAND_STRING(SELF) " with a niche must be the size of its item");
+
+    #define PRESENT(self) (!ITEM_IS_NICHE(&(self)->item))
+
+DC_PUBLIC static SELF NS(SELF, from)(ITEM value) {
+    DC_ASSERT(!ITEM_IS_NICHE(&value), "Cannot create a present option from the niche value");
+    return (SELF){.item = value};
+}
+
+DC_PUBLIC static SELF NS(SELF, empty)() { return (SELF){.item = ITEM_NICHE}; }
+#else
 typedef struct {
     union {
         ITEM item;
@@ -46,13 +73,16 @@ typedef struct {
     dc_gdb_marker derive_c_option;
 } SELF;
 
+    #define PRESENT(self) ((self)->present)
+
 DC_PUBLIC static SELF NS(SELF, from)(ITEM value) { return (SELF){.item = value, .present = true}; }
 
 DC_PUBLIC static SELF NS(SELF, empty)() { return (SELF){.present = false}; }
+#endif
 
 DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
     DC_ASSUME(self);
-    if (self->present) {
+    if (PRESENT(self)) {
         return NS(SELF, from)(ITEM_CLONE(&self->item));
     }
     return NS(SELF, empty)();
@@ -60,7 +90,7 @@ DC_PUBLIC static SELF NS(SELF, clone)(SELF const* self) {
 
 DC_PUBLIC static ITEM* NS(SELF, get)(SELF* self) {
     DC_ASSUME(self);
-    if (self->present) {
+    if (PRESENT(self)) {
         return &self->item;
     }
     return NULL;
@@ -68,7 +98,7 @@ DC_PUBLIC static ITEM* NS(SELF, get)(SELF* self) {
 
 DC_PUBLIC static ITEM const* NS(SELF, get_const)(SELF const* self) {
     DC_ASSUME(self);
-    if (self->present) {
+    if (PRESENT(self)) {
         return &self->item;
     }
     return NULL;
@@ -76,7 +106,7 @@ DC_PUBLIC static ITEM const* NS(SELF, get_const)(SELF const* self) {
 
 DC_PUBLIC static ITEM const* NS(SELF, get_const_or)(SELF const* self, ITEM const* default_value) {
     DC_ASSUME(self);
-    if (self->present) {
+    if (PRESENT(self)) {
         return &self->item;
     }
     return default_value;
@@ -84,7 +114,7 @@ DC_PUBLIC static ITEM const* NS(SELF, get_const_or)(SELF const* self, ITEM const
 
 DC_PUBLIC static ITEM NS(SELF, get_value_or)(SELF const* self, ITEM const default_value) {
     DC_ASSUME(self);
-    if (self->present) {
+    if (PRESENT(self)) {
         return self->item;
     }
     return default_value;
@@ -92,12 +122,12 @@ DC_PUBLIC static ITEM NS(SELF, get_value_or)(SELF const* self, ITEM const defaul
 
 DC_PUBLIC static bool NS(SELF, is_present)(SELF const* self) {
     DC_ASSUME(self);
-    return self->present;
+    return PRESENT(self);
 }
 
 DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
     DC_ASSUME(self);
-    if (self->present) {
+    if (PRESENT(self)) {
         ITEM_DELETE(&self->item);
     }
 }
@@ -105,19 +135,18 @@ DC_PUBLIC static void NS(SELF, delete)(SELF* self) {
 DC_PUBLIC static bool NS(SELF, replace)(SELF* self, ITEM value) {
     DC_ASSUME(self);
     bool was_present;
-    if (self->present) {
+    if (PRESENT(self)) {
         ITEM_DELETE(&self->item);
         was_present = true;
     } else {
         was_present = false;
     }
-    self->item = value;
-    self->present = true;
+    *self = NS(SELF, from)(value);
     return was_present;
 }
 
 DC_PUBLIC static void NS(SELF, debug)(SELF* self, dc_debug_fmt fmt, FILE* stream) {
-    if (self->present) {
+    if (PRESENT(self)) {
         fprintf(stream, DC_EXPAND_STRING(SELF) "@%p { ", (void*)self);
         fmt = dc_debug_fmt_scope_begin(fmt);
         ITEM_DEBUG(&self->item, fmt, stream);
@@ -127,6 +156,12 @@ DC_PUBLIC static void NS(SELF, debug)(SELF* self, dc_debug_fmt fmt, FILE* stream
     }
 }
 
+#undef PRESENT
+
+#if defined ITEM_NICHE
+    #undef ITEM_IS_NICHE
+    #undef ITEM_NICHE // [DERIVE-C] for input arg
+#endif
 #undef ITEM_DEBUG
 #undef ITEM_EQ
 #undef ITEM_CLONE
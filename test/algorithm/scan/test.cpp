@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define ITEM uint8_t
+#define NAME u8_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM int8_t
+#define NAME i8_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM uint16_t
+#define NAME u16_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM int16_t
+#define NAME i16_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM uint32_t
+#define NAME u32_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM int32_t
+#define NAME i32_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM uint64_t
+#define NAME u64_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM int64_t
+#define NAME i64_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM float
+#define NAME f32_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM double
+#define NAME f64_scan
+#include <derive-c/algorithm/scan/template.h>
+
+static bool same_parity(uint32_t const* self_1, uint32_t const* self_2) {
+    return (*self_1 % 2) == (*self_2 % 2);
+}
+
+#define ITEM uint32_t
+#define ITEM_EQ same_parity
+#define ITEM_ORD DC_MEM_GT
+#define NAME u32_parity_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define Pair_REFLECT(F)                                                                            \
+    F(uint32_t, key)                                                                               \
+    F(uint32_t, value)
+
+DC_DERIVE_STRUCT(Pair)
+DC_DERIVE_EQ(Pair)
+DC_DERIVE_ORD(Pair)
+
+#define ITEM Pair
+#define ITEM_EQ Pair_eq
+#define ITEM_ORD Pair_lt
+#define NAME pair_scan
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM uint32_t
+#define NAME u32_vec
+#include <derive-c/container/vector/dynamic/template.h>
+
+namespace {
+dc_scan_isa scalar_isa() { return DC_SCAN_ISA_SCALAR; }
+dc_scan_isa sse2_isa() { return DC_SCAN_ISA_SSE2; }
+dc_scan_isa avx2_isa() { return DC_SCAN_ISA_AVX2; }
+
+/// Runs a check with each of the kernels selected in turn.
+template <typename F> void for_each_isa(F check) {
+    for (auto* isa : {scalar_isa, sse2_isa, avx2_isa}) {
+        if (isa == avx2_isa && !__builtin_cpu_supports("avx2")) {
+            continue;
+        }
+        DC_MOCKABLE_SET(dc_scan_isa_get)(isa);
+        check();
+    }
+    DC_MOCKABLE_SET(dc_scan_isa_get)(DC_MOCKABLE_REAL(dc_scan_isa_get));
+}
+
+template <typename T> std::vector<T> random_values(size_t count, T min, T max, uint32_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> values(count);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> dist(min, max);
+        for (T& value : values) {
+            value = dist(rng);
+        }
+    } else {
+        std::uniform_int_distribution<int64_t> dist(static_cast<int64_t>(min),
+                                                    static_cast<int64_t>(max));
+        for (T& value : values) {
+            value = static_cast<T>(dist(rng));
+        }
+    }
+    return values;
+}
+
+template <typename T, typename Scan> void check_against_std(T min, T max) {
+    // Sizes either side of the vector widths, to cover the scalar tails.
+    for (size_t count : {0, 1, 3, 15, 16, 17, 31, 32, 33, 100, 1000}) {
+        std::vector<T> const values =
+            random_values<T>(count, min, max, static_cast<uint32_t>(count));
+        T const* items = values.data();
+
+        for (T needle : {min, max, static_cast<T>((min / 2) + (max / 2))}) {
+            size_t const expected_find = static_cast<size_t>(
+                std::find(values.begin(), values.end(), needle) - values.begin());
+            size_t const expected_count =
+                static_cast<size_t>(std::count(values.begin(), values.end(), needle));
+            EXPECT_EQ(Scan::find(items, count, needle), expected_find);
+            EXPECT_EQ(Scan::count(items, count, needle), expected_count);
+            EXPECT_EQ(Scan::contains(items, count, needle), expected_find != count);
+        }
+
+        EXPECT_EQ(Scan::min(items, count),
+                  static_cast<size_t>(std::min_element(values.begin(), values.end()) -
+                                      values.begin()));
+        EXPECT_EQ(Scan::max(items, count),
+                  static_cast<size_t>(std::max_element(values.begin(), values.end()) -
+                                      values.begin()));
+    }
+}
+
+#define SCAN_CASE(NAME)                                                                            \
+    struct NAME##_case {                                                                           \
+        static constexpr auto find = NAME##_find;                                                  \
+        static constexpr auto count = NAME##_count;                                                \
+        static constexpr auto contains = NAME##_contains;                                          \
+        static constexpr auto min = NAME##_min;                                                    \
+        static constexpr auto max = NAME##_max;                                                    \
+    };
+
+SCAN_CASE(u8_scan)
+SCAN_CASE(i8_scan)
+SCAN_CASE(u16_scan)
+SCAN_CASE(i16_scan)
+SCAN_CASE(u32_scan)
+SCAN_CASE(i32_scan)
+SCAN_CASE(u64_scan)
+SCAN_CASE(i64_scan)
+SCAN_CASE(f32_scan)
+SCAN_CASE(f64_scan)
+
+#undef SCAN_CASE
+} // namespace
+
+TEST(ScanTests, Unsigned) {
+    for_each_isa([] {
+        check_against_std<uint8_t, u8_scan_case>(0, UINT8_MAX);
+        check_against_std<uint16_t, u16_scan_case>(0, UINT16_MAX);
+        check_against_std<uint32_t, u32_scan_case>(0, UINT32_MAX);
+        check_against_std<uint64_t, u64_scan_case>(0, INT64_MAX);
+        check_against_std<uint32_t, u32_scan_case>(0, 7);
+    });
+}
+
+TEST(ScanTests, Signed) {
+    for_each_isa([] {
+        check_against_std<int8_t, i8_scan_case>(INT8_MIN, INT8_MAX);
+        check_against_std<int16_t, i16_scan_case>(INT16_MIN, INT16_MAX);
+        check_against_std<int32_t, i32_scan_case>(INT32_MIN, INT32_MAX);
+        check_against_std<int64_t, i64_scan_case>(INT64_MIN, INT64_MAX);
+        check_against_std<int32_t, i32_scan_case>(-3, 3);
+    });
+}
+
+TEST(ScanTests, Floats) {
+    for_each_isa([] {
+        check_against_std<float, f32_scan_case>(-1000.0F, 1000.0F);
+        check_against_std<double, f64_scan_case>(-1e9, 1e9);
+    });
+}
+
+TEST(ScanTests, FloatEdgeCases) {
+    for_each_isa([] {
+        double const nan = std::numeric_limits<double>::quiet_NaN();
+        std::vector<double> values(40, 1.0);
+        values[3] = nan;
+        values[20] = -5.0;
+        values[30] = 7.0;
+        values[35] = -0.0;
+
+        // NaN is never found, nor selected unless it is the first item
+        EXPECT_EQ(f64_scan_find(values.data(), values.size(), nan), values.size());
+        EXPECT_EQ(f64_scan_min(values.data(), values.size()), 20);
+        EXPECT_EQ(f64_scan_max(values.data(), values.size()), 30);
+        EXPECT_EQ(f64_scan_find(values.data(), values.size(), 0.0), 35);
+
+        values[0] = nan;
+        EXPECT_EQ(f64_scan_min(values.data(), values.size()), 0);
+        EXPECT_EQ(f64_scan_max(values.data(), values.size()), 0);
+    });
+}
+
+TEST(ScanTests, FirstOfEqualBest) {
+    for_each_isa([] {
+        std::vector<int16_t> values(100, 5);
+        values[40] = -2;
+        values[70] = -2;
+        values[50] = 9;
+        values[90] = 9;
+        EXPECT_EQ(i16_scan_min(values.data(), values.size()), 40);
+        EXPECT_EQ(i16_scan_max(values.data(), values.size()), 50);
+    });
+}
+
+TEST(ScanTests, CustomEqAndOrd) {
+    std::vector<uint32_t> values = {2, 4, 6, 9, 10, 3, 1};
+    EXPECT_EQ(u32_parity_scan_find(values.data(), values.size(), 101), 3);
+    EXPECT_EQ(u32_parity_scan_count(values.data(), values.size(), 0), 4);
+    EXPECT_EQ(u32_parity_scan_min(values.data(), values.size()), 4); // largest, by DC_MEM_GT
+    EXPECT_EQ(u32_parity_scan_max(values.data(), values.size()), 6); // smallest, by DC_MEM_GT
+}
+
+TEST(ScanTests, DerivedStruct) {
+    std::vector<Pair> values = {{3, 1}, {1, 9}, {3, 0}, {1, 2}, {3, 1}};
+    EXPECT_EQ(pair_scan_find(values.data(), values.size(), Pair{3, 1}), 0);
+    EXPECT_EQ(pair_scan_count(values.data(), values.size(), Pair{3, 1}), 2);
+    EXPECT_FALSE(pair_scan_contains(values.data(), values.size(), Pair{2, 2}));
+    EXPECT_EQ(pair_scan_min(values.data(), values.size()), 3);
+    EXPECT_EQ(pair_scan_max(values.data(), values.size()), 0);
+}
+
+TEST(ScanTests, DynamicVector) {
+    DC_SCOPED(u32_vec) vec = u32_vec_new(stdalloc_get_ref());
+    for (uint32_t i = 0; i < 1000; i++) {
+        u32_vec_push(&vec, i * 3);
+    }
+
+    EXPECT_EQ(u32_scan_find(u32_vec_data(&vec), u32_vec_size(&vec), 300), 100);
+    EXPECT_FALSE(u32_scan_contains(u32_vec_data(&vec), u32_vec_size(&vec), 301));
+    EXPECT_EQ(u32_scan_max(u32_vec_data(&vec), u32_vec_size(&vec)), 999);
+}
@@ -0,0 +1,37 @@
+#include <stdint.h>
+
+#define ITEM uint8_t
+#define NAME expand_1
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM int64_t
+#define NAME expand_2
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM double
+#define NAME expand_5
+#include <derive-c/algorithm/scan/template.h>
+
+#define ITEM char*
+#define NAME expand_3
+#include <derive-c/algorithm/scan/template.h>
+
+typedef struct {
+    uint32_t x;
+} expand_4_item;
+
+static bool expand_4_item_eq(expand_4_item const* self_1, expand_4_item const* self_2) {
+    return self_1->x == self_2->x;
+}
+
+static bool expand_4_item_lt(expand_4_item const* self_1, expand_4_item const* self_2) {
+    return self_1->x < self_2->x;
+}
+
+#define ITEM expand_4_item
+#define ITEM_EQ expand_4_item_eq
+#define ITEM_ORD expand_4_item_lt
+#define NAME expand_4
+#include <derive-c/algorithm/scan/template.h>
+
+int main() {}
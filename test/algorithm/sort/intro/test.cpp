@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define ITEM uint32_t
+#define NAME u32_sort
+#include <derive-c/algorithm/sort/intro/template.h>
+
+#define ITEM int64_t
+#define ITEM_ORD DC_MEM_GT
+#define NAME i64_descending_sort
+#include <derive-c/algorithm/sort/intro/template.h>
+
+#define Point_REFLECT(F)                                                                           \
+    F(uint32_t, x)                                                                                 \
+    F(uint32_t, y)
+
+DC_DERIVE_STRUCT(Point)
+DC_DERIVE_ORD(Point)
+
+#define ITEM Point
+#define ITEM_ORD Point_lt
+#define NAME point_sort
+#include <derive-c/algorithm/sort/intro/template.h>
+
+// JUSTIFY: An inconsistent ordering
+//  - Used to check the sort never scans out of bounds for an ordering that is not strict weak.
+static bool always_lt(uint32_t const* /* self_1 */, uint32_t const* /* self_2 */) { return true; }
+
+#define ITEM uint32_t
+#define ITEM_ORD always_lt
+#define NAME always_lt_sort
+#include <derive-c/algorithm/sort/intro/template.h>
+
+#define ITEM uint32_t
+#define NAME u32_vec
+#include <derive-c/container/vector/dynamic/template.h>
+
+#define ITEM uint32_t
+#define CAPACITY 200
+#define NAME u32_static_vec
+#include <derive-c/container/vector/static/template.h>
+
+namespace {
+std::vector<uint32_t> random_values(size_t count, uint32_t max_value, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> dist(0, max_value);
+    std::vector<uint32_t> values(count);
+    for (uint32_t& value : values) {
+        value = dist(rng);
+    }
+    return values;
+}
+
+void expect_sorts(std::vector<uint32_t> values) {
+    std::vector<uint32_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+    u32_sort_sort(values.data(), values.size());
+    EXPECT_TRUE(u32_sort_is_sorted(values.data(), values.size()));
+    EXPECT_EQ(values, expected);
+}
+} // namespace
+
+TEST(IntroSortTests, Empty) {
+    u32_sort_sort(nullptr, 0);
+    EXPECT_TRUE(u32_sort_is_sorted(nullptr, 0));
+}
+
+TEST(IntroSortTests, RandomSizes) {
+    for (size_t count : {1, 2, 3, 10, 24, 25, 100, 129, 1000, 100000}) {
+        expect_sorts(random_values(count, UINT32_MAX, static_cast<uint32_t>(count)));
+    }
+}
+
+TEST(IntroSortTests, FewDistinct) {
+    expect_sorts(random_values(50000, 3, 1));
+    expect_sorts(std::vector<uint32_t>(10000, 7));
+}
+
+TEST(IntroSortTests, Patterns) {
+    std::vector<uint32_t> ascending(20000);
+    for (size_t i = 0; i < ascending.size(); i++) {
+        ascending[i] = static_cast<uint32_t>(i);
+    }
+    expect_sorts(ascending);
+
+    std::vector<uint32_t> descending(ascending.rbegin(), ascending.rend());
+    expect_sorts(descending);
+
+    std::vector<uint32_t> nearly_sorted = ascending;
+    std::swap(nearly_sorted[10], nearly_sorted[15000]);
+    std::swap(nearly_sorted[500], nearly_sorted[501]);
+    expect_sorts(nearly_sorted);
+
+    std::vector<uint32_t> organ_pipe(20000);
+    for (size_t i = 0; i < organ_pipe.size(); i++) {
+        organ_pipe[i] = static_cast<uint32_t>(i < 10000 ? i : 20000 - i);
+    }
+    expect_sorts(organ_pipe);
+
+    std::vector<uint32_t> sawtooth(20000);
+    for (size_t i = 0; i < sawtooth.size(); i++) {
+        sawtooth[i] = static_cast<uint32_t>(i % 64);
+    }
+    expect_sorts(sawtooth);
+}
+
+TEST(IntroSortTests, CustomOrd) {
+    std::vector<int64_t> values = {3, -1, 4, -1, 5, -9, 2, 6, 5, 3, 5, -8, 9, 7, 9, 3, 2, 3, 8,
+                                   4, -6, 2, 6, 4, 3, 3, 8, 3, 2, 7, 9, 5, 0, 2, 8, 8, 4, 1, 9};
+    std::vector<int64_t> expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+    i64_descending_sort_sort(values.data(), values.size());
+    EXPECT_EQ(values, expected);
+}
+
+TEST(IntroSortTests, DerivedOrd) {
+    std::vector<uint32_t> xs = random_values(5000, 20, 2);
+    std::vector<uint32_t> ys = random_values(5000, 1000, 3);
+    std::vector<Point> points;
+    for (size_t i = 0; i < xs.size(); i++) {
+        points.push_back(Point{.x = xs[i], .y = ys[i]});
+    }
+
+    point_sort_sort(points.data(), points.size());
+    EXPECT_TRUE(point_sort_is_sorted(points.data(), points.size()));
+    for (size_t i = 1; i < points.size(); i++) {
+        EXPECT_LE(points[i - 1].x, points[i].x);
+        if (points[i - 1].x == points[i].x) {
+            EXPECT_LE(points[i - 1].y, points[i].y);
+        }
+    }
+}
+
+TEST(IntroSortTests, InconsistentOrdStaysInBounds) {
+    std::vector<uint32_t> values = random_values(10000, 100, 4);
+    std::vector<uint32_t> expected = values;
+    always_lt_sort_sort(values.data(), values.size());
+
+    // The items are only permuted
+    std::sort(values.begin(), values.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(values, expected);
+}
+
+TEST(IntroSortTests, DynamicVector) {
+    DC_SCOPED(u32_vec) vec = u32_vec_new(stdalloc_get_ref());
+    for (uint32_t value : random_values(3000, 1000, 5)) {
+        u32_vec_push(&vec, value);
+    }
+
+    u32_sort_sort(u32_vec_data(&vec), u32_vec_size(&vec));
+    EXPECT_TRUE(u32_sort_is_sorted(u32_vec_data(&vec), u32_vec_size(&vec)));
+}
+
+TEST(IntroSortTests, StaticVector) {
+    DC_SCOPED(u32_static_vec) vec = u32_static_vec_new();
+    for (uint32_t value : random_values(200, 1000, 6)) {
+        u32_static_vec_push(&vec, value);
+    }
+
+    u32_sort_sort(u32_static_vec_data(&vec), u32_static_vec_size(&vec));
+    EXPECT_TRUE(u32_sort_is_sorted(u32_static_vec_data(&vec), u32_static_vec_size(&vec)));
+}
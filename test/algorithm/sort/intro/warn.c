@@ -0,0 +1,17 @@
+#include <stdint.h>
+
+#define ITEM uint8_t
+#define NAME expand_1
+#include <derive-c/algorithm/sort/intro/template.h>
+
+#define ITEM double
+#define ITEM_ORD DC_MEM_GT
+#define NAME expand_2
+#include <derive-c/algorithm/sort/intro/template.h>
+
+#define ITEM char*
+#define ITEM_ORD(a, b) (*(a) < *(b))
+#define NAME expand_3
+#include <derive-c/algorithm/sort/intro/template.h>
+
+int main() {}
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define ITEM uint32_t
+#define NAME u32_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM uint64_t
+#define NAME u64_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM uint8_t
+#define NAME u8_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM int32_t
+#define KEY uint32_t
+#define ITEM_KEY(item) int32_t_radix_key(*(item))
+#define NAME i32_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM int16_t
+#define KEY uint16_t
+#define ITEM_KEY(item) int16_t_radix_key(*(item))
+#define NAME i16_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM double
+#define KEY uint64_t
+#define ITEM_KEY(item) double_radix_key(*(item))
+#define NAME f64_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM float
+#define KEY uint32_t
+#define ITEM_KEY(item) float_radix_key(*(item))
+#define NAME f32_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+struct Record {
+    int32_t key;
+    uint32_t sequence;
+};
+
+#define ITEM Record
+#define KEY uint32_t
+#define ITEM_KEY(item) int32_t_radix_key((item)->key)
+#define NAME record_radix
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM uint32_t
+#define NAME u32_vec
+#include <derive-c/container/vector/dynamic/template.h>
+
+#define ITEM uint32_t
+#define CAPACITY 200
+#define NAME u32_static_vec
+#include <derive-c/container/vector/static/template.h>
+
+namespace {
+template <typename T> std::vector<T> random_values(size_t count, T min, T max, uint32_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<T> values(count);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> dist(min, max);
+        for (T& value : values) {
+            value = dist(rng);
+        }
+    } else {
+        std::uniform_int_distribution<int64_t> dist(min, max);
+        for (T& value : values) {
+            value = static_cast<T>(dist(rng));
+        }
+    }
+    return values;
+}
+} // namespace
+
+TEST(RadixSortTests, Empty) {
+    u32_radix_sort(nullptr, 0, stdalloc_get_ref());
+    EXPECT_TRUE(u32_radix_is_sorted(nullptr, 0));
+}
+
+TEST(RadixSortTests, Unsigned) {
+    for (size_t count : {1, 2, 31, 32, 33, 1000, 100000}) {
+        std::vector<uint32_t> values =
+            random_values<uint32_t>(count, 0, UINT32_MAX, static_cast<uint32_t>(count));
+        std::vector<uint32_t> expected = values;
+        std::sort(expected.begin(), expected.end());
+        u32_radix_sort(values.data(), values.size(), stdalloc_get_ref());
+        EXPECT_EQ(values, expected);
+    }
+
+    std::vector<uint64_t> wide = random_values<uint64_t>(50000, 0, INT64_MAX, 1);
+    wide.push_back(UINT64_MAX);
+    std::vector<uint64_t> wide_expected = wide;
+    std::sort(wide_expected.begin(), wide_expected.end());
+    u64_radix_sort(wide.data(), wide.size(), stdalloc_get_ref());
+    EXPECT_EQ(wide, wide_expected);
+
+    std::vector<uint8_t> narrow = random_values<uint8_t>(5000, 0, UINT8_MAX, 2);
+    std::vector<uint8_t> narrow_expected = narrow;
+    std::sort(narrow_expected.begin(), narrow_expected.end());
+    u8_radix_sort(narrow.data(), narrow.size(), stdalloc_get_ref());
+    EXPECT_EQ(narrow, narrow_expected);
+}
+
+TEST(RadixSortTests, SkipsConstantDigits) {
+    // Only the lowest byte varies, the remaining passes are skipped.
+    std::vector<uint32_t> values = random_values<uint32_t>(10000, 0x12345600, 0x123456FF, 3);
+    std::vector<uint32_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+    u32_radix_sort(values.data(), values.size(), stdalloc_get_ref());
+    EXPECT_EQ(values, expected);
+}
+
+TEST(RadixSortTests, Signed) {
+    std::vector<int32_t> values = random_values<int32_t>(50000, INT32_MIN, INT32_MAX, 4);
+    values.push_back(0);
+    values.push_back(-1);
+    std::vector<int32_t> expected = values;
+    std::sort(expected.begin(), expected.end());
+    i32_radix_sort(values.data(), values.size(), stdalloc_get_ref());
+    EXPECT_EQ(values, expected);
+
+    std::vector<int16_t> narrow = random_values<int16_t>(5000, INT16_MIN, INT16_MAX, 5);
+    std::vector<int16_t> narrow_expected = narrow;
+    std::sort(narrow_expected.begin(), narrow_expected.end());
+    i16_radix_sort(narrow.data(), narrow.size(), stdalloc_get_ref());
+    EXPECT_EQ(narrow, narrow_expected);
+}
+
+TEST(RadixSortTests, Floats) {
+    std::vector<double> values = random_values<double>(50000, -1e9, 1e9, 6);
+    values.push_back(0.0);
+    values.push_back(-std::numeric_limits<double>::infinity());
+    values.push_back(std::numeric_limits<double>::infinity());
+    values.push_back(std::numeric_limits<double>::denorm_min());
+    values.push_back(-std::numeric_limits<double>::denorm_min());
+    std::vector<double> expected = values;
+    std::sort(expected.begin(), expected.end());
+    f64_radix_sort(values.data(), values.size(), stdalloc_get_ref());
+    EXPECT_EQ(values, expected);
+
+    std::vector<float> narrow = random_values<float>(5000, -1.0F, 1.0F, 7);
+    std::vector<float> narrow_expected = narrow;
+    std::sort(narrow_expected.begin(), narrow_expected.end());
+    f32_radix_sort(narrow.data(), narrow.size(), stdalloc_get_ref());
+    EXPECT_EQ(narrow, narrow_expected);
+}
+
+TEST(RadixSortTests, NegativeZeroFirst) {
+    std::vector<double> values(40, 0.0);
+    values[20] = -0.0;
+    f64_radix_sort(values.data(), values.size(), stdalloc_get_ref());
+    EXPECT_TRUE(std::signbit(values[0]));
+    EXPECT_FALSE(std::signbit(values[1]));
+}
+
+TEST(RadixSortTests, Stable) {
+    std::vector<int32_t> keys = random_values<int32_t>(20000, -50, 50, 8);
+    std::vector<Record> records;
+    for (size_t i = 0; i < keys.size(); i++) {
+        records.push_back(Record{.key = keys[i], .sequence = static_cast<uint32_t>(i)});
+    }
+    std::vector<Record> expected = records;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](Record const& a, Record const& b) { return a.key < b.key; });
+
+    std::vector<Record> scratch(records.size());
+    record_radix_sort_with_scratch(records.data(), scratch.data(), records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        EXPECT_EQ(records[i].key, expected[i].key);
+        EXPECT_EQ(records[i].sequence, expected[i].sequence);
+    }
+}
+
+TEST(RadixSortTests, DynamicVector) {
+    DC_SCOPED(u32_vec) vec = u32_vec_new(stdalloc_get_ref());
+    for (uint32_t value : random_values<uint32_t>(3000, 0, UINT32_MAX, 9)) {
+        u32_vec_push(&vec, value);
+    }
+
+    u32_radix_sort(u32_vec_data(&vec), u32_vec_size(&vec), stdalloc_get_ref());
+    EXPECT_TRUE(u32_radix_is_sorted(u32_vec_data(&vec), u32_vec_size(&vec)));
+}
+
+TEST(RadixSortTests, StaticVector) {
+    DC_SCOPED(u32_static_vec) vec = u32_static_vec_new();
+    for (uint32_t value : random_values<uint32_t>(200, 0, UINT32_MAX, 10)) {
+        u32_static_vec_push(&vec, value);
+    }
+
+    u32_radix_sort(u32_static_vec_data(&vec), u32_static_vec_size(&vec), stdalloc_get_ref());
+    EXPECT_TRUE(u32_radix_is_sorted(u32_static_vec_data(&vec), u32_static_vec_size(&vec)));
+}
@@ -0,0 +1,24 @@
+#include <stdint.h>
+
+#define ITEM uint8_t
+#define NAME expand_1
+#include <derive-c/algorithm/sort/radix/template.h>
+
+#define ITEM int64_t
+#define KEY uint64_t
+#define ITEM_KEY(item) int64_t_radix_key(*(item))
+#define NAME expand_2
+#include <derive-c/algorithm/sort/radix/template.h>
+
+typedef struct {
+    float weight;
+    char const* name;
+} expand_3_item;
+
+#define ITEM expand_3_item
+#define KEY uint32_t
+#define ITEM_KEY(item) float_radix_key((item)->weight)
+#define NAME expand_3
+#include <derive-c/algorithm/sort/radix/template.h>
+
+int main() {}
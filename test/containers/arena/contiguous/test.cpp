@@ -1,6 +1,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <derive-cpp/fmt/remove_ptrs.hpp>
 
 #include <derive-c/alloc/std.h>
@@ -25,6 +28,29 @@ TEST(ArenaTests, Full) {
     int_arena_delete(&sut);
 }
 
+#define NAME one_and_half_arena
+#define VALUE size_t
+#define INDEX_BITS 8
+#define GROWTH_POLICY dc_growth_one_and_half
+#include <derive-c/container/arena/contiguous/template.h>
+
+TEST(ArenaTests, FullWithGrowthPolicy) {
+    DC_SCOPED(one_and_half_arena)
+    sut = one_and_half_arena_new_with_capacity_for(1, stdalloc_get_ref());
+
+    for (size_t i = 0; i < one_and_half_arena_max_entries; ++i) {
+        one_and_half_arena_insert(&sut, i);
+        ASSERT_LE(sut.capacity, 256);
+    }
+    // Growth by half is not a power of 2, so is capped at the index capacity.
+    ASSERT_EQ(sut.capacity, 256);
+    ASSERT_TRUE(one_and_half_arena_full(&sut));
+    for (size_t i = 0; i < one_and_half_arena_max_entries; ++i) {
+        ASSERT_EQ(*one_and_half_arena_read(&sut, (one_and_half_arena_index_t){.index = (uint8_t)i}),
+                  i);
+    }
+}
+
 TEST(ArenaTests, Empty) {
     int_arena sut = int_arena_new_with_capacity_for(1, stdalloc_get_ref());
     int_arena_delete(&sut);
@@ -110,3 +136,54 @@ TEST(ArenaTests, Debug) {
             derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
     }
 }
+
+TEST(ArenaTests, SparseIteration) {
+    DC_SCOPED(int_arena) arena = int_arena_new_with_capacity_for(1, stdalloc_get_ref());
+
+    // Keep every 67th entry, so most words of the occupancy bitmap are empty
+    std::vector<size_t> expected;
+    std::vector<int_arena_index_t> removed;
+    for (size_t value = 0; value < 200; value++) {
+        int_arena_index_t const index = int_arena_insert(&arena, value);
+        if (value % 67 == 66) {
+            expected.push_back(index.index);
+        } else {
+            removed.push_back(index);
+        }
+    }
+    for (int_arena_index_t const index : removed) {
+        int_arena_remove(&arena, index);
+    }
+
+    std::vector<size_t> iterated;
+    int_arena_iter iter = int_arena_get_iter(&arena);
+    EXPECT_FALSE(int_arena_iter_empty(&iter));
+    for (int_arena_iter_item item = int_arena_iter_next(&iter); !int_arena_iter_empty_item(&item);
+         item = int_arena_iter_next(&iter)) {
+        EXPECT_EQ(*item.value % 67, 66);
+        iterated.push_back(item.index.index);
+    }
+    EXPECT_TRUE(int_arena_iter_empty(&iter));
+    EXPECT_EQ(iterated, expected);
+
+    DC_SCOPED(int_arena) clone = int_arena_clone(&arena);
+    iterated.clear();
+    int_arena_iter_const iter_const = int_arena_get_iter_const(&clone);
+    for (int_arena_iter_const_item item = int_arena_iter_const_next(&iter_const);
+         !int_arena_iter_const_empty_item(&item); item = int_arena_iter_const_next(&iter_const)) {
+        iterated.push_back(item.index.index);
+    }
+    EXPECT_EQ(iterated, expected);
+
+    // Reused slots are iterated again
+    int_arena_index_t const reused = int_arena_insert(&arena, 0);
+    iterated.clear();
+    int_arena_iter refilled = int_arena_get_iter(&arena);
+    for (int_arena_iter_item item = int_arena_iter_next(&refilled);
+         !int_arena_iter_empty_item(&item); item = int_arena_iter_next(&refilled)) {
+        iterated.push_back(item.index.index);
+    }
+    expected.push_back(reused.index);
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(iterated, expected);
+}
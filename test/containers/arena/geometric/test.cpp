@@ -1,6 +1,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <derive-cpp/fmt/remove_ptrs.hpp>
 
 #include <derive-c/container/arena/geometric/utils.h>
@@ -196,3 +199,54 @@ TEST(GeometricArena, Debug) {
             derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
     }
 }
+
+TEST(GeometricArena, SparseIteration) {
+    DC_SCOPED(int_arena) arena = int_arena_new(stdalloc_get_ref());
+
+    // Keep every 67th entry, so most words of the occupancy bitmap are empty
+    std::vector<size_t> expected;
+    std::vector<int_arena_index_t> removed;
+    for (int32_t value = 0; value < 200; value++) {
+        int_arena_index_t const index = int_arena_insert(&arena, value);
+        if (value % 67 == 66) {
+            expected.push_back(index.index);
+        } else {
+            removed.push_back(index);
+        }
+    }
+    for (int_arena_index_t const index : removed) {
+        int_arena_remove(&arena, index);
+    }
+
+    std::vector<size_t> iterated;
+    int_arena_iter iter = int_arena_get_iter(&arena);
+    EXPECT_FALSE(int_arena_iter_empty(&iter));
+    for (int_arena_iter_item item = int_arena_iter_next(&iter); !int_arena_iter_empty_item(&item);
+         item = int_arena_iter_next(&iter)) {
+        EXPECT_EQ(*item.value % 67, 66);
+        iterated.push_back(item.index.index);
+    }
+    EXPECT_TRUE(int_arena_iter_empty(&iter));
+    EXPECT_EQ(iterated, expected);
+
+    DC_SCOPED(int_arena) clone = int_arena_clone(&arena);
+    iterated.clear();
+    int_arena_iter_const iter_const = int_arena_get_iter_const(&clone);
+    for (int_arena_iter_const_item item = int_arena_iter_const_next(&iter_const);
+         !int_arena_iter_const_empty_item(&item); item = int_arena_iter_const_next(&iter_const)) {
+        iterated.push_back(item.index.index);
+    }
+    EXPECT_EQ(iterated, expected);
+
+    // Reused slots are iterated again
+    int_arena_index_t const reused = int_arena_insert(&arena, 0);
+    iterated.clear();
+    int_arena_iter refilled = int_arena_get_iter(&arena);
+    for (int_arena_iter_item item = int_arena_iter_next(&refilled);
+         !int_arena_iter_empty_item(&item); item = int_arena_iter_next(&refilled)) {
+        iterated.push_back(item.index.index);
+    }
+    expected.push_back(reused.index);
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(iterated, expected);
+}
@@ -0,0 +1,129 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/for.h>
+#include <derive-c/utils/debug/string.h>
+
+#define EXCLUSIVE_END_INDEX 200
+#define NAME sut
+#include <derive-c/container/bitset/atomic/template.h>
+
+TEST(BitsetAtomic, SetGetAndIterate) {
+    DC_SCOPED(sut) bitset = sut_new();
+    EXPECT_EQ(sut_size(&bitset), 0);
+
+    std::vector<size_t> const expected = {0, 63, 64, 130, 199};
+    for (size_t index : expected) {
+        sut_set(&bitset, (sut_index_t)index, true);
+    }
+    EXPECT_FALSE(sut_try_set(&bitset, 200, true));
+    EXPECT_TRUE(sut_get(&bitset, 63));
+    EXPECT_FALSE(sut_get(&bitset, 62));
+    EXPECT_EQ(sut_size(&bitset), expected.size());
+
+    std::vector<size_t> actual;
+    DC_FOR_CONST(sut, &bitset, iter, index) { actual.push_back(index); }
+    EXPECT_EQ(actual, expected);
+
+    DC_SCOPED(sut) cloned = sut_clone(&bitset);
+    sut_set(&bitset, 0, false);
+    EXPECT_TRUE(sut_get(&cloned, 0));
+    EXPECT_EQ(sut_size(&bitset), expected.size() - 1);
+}
+
+TEST(BitsetAtomic, TestAndSetAndClear) {
+    DC_SCOPED(sut) bitset = sut_new();
+    EXPECT_FALSE(sut_test_and_set(&bitset, 70));
+    EXPECT_TRUE(sut_test_and_set(&bitset, 70));
+    EXPECT_TRUE(sut_test_and_clear(&bitset, 70));
+    EXPECT_FALSE(sut_test_and_clear(&bitset, 70));
+    EXPECT_EQ(sut_size(&bitset), 0);
+}
+
+TEST(BitsetAtomic, ClaimFirstClear) {
+    DC_SCOPED(sut) bitset = sut_new();
+    EXPECT_EQ(sut_claim_first_clear(&bitset, 0), 0);
+    EXPECT_EQ(sut_claim_first_clear(&bitset, 0), 1);
+
+    // Starts from the hint's word, and wraps around to the first word.
+    EXPECT_EQ(sut_claim_first_clear(&bitset, 150), 128);
+    for (size_t index = 129; index < 200; index++) {
+        sut_set(&bitset, (sut_index_t)index, true);
+    }
+    EXPECT_EQ(sut_claim_first_clear(&bitset, 199), 2);
+    EXPECT_EQ(sut_claim_first_clear(&bitset, 450), 3);
+
+    // Never claims the bits past the end of the last word.
+    while (sut_claim_first_clear(&bitset, 0) != sut_exclusive_end_index) {
+    }
+    EXPECT_EQ(sut_size(&bitset), 200);
+    EXPECT_EQ(sut_claim_first_clear(&bitset, 199), sut_exclusive_end_index);
+
+    EXPECT_TRUE(sut_test_and_clear(&bitset, 77));
+    EXPECT_EQ(sut_claim_first_clear(&bitset, 199), 77);
+}
+
+TEST(BitsetAtomic, Debug) {
+    DC_SCOPED(sut) bitset = sut_new();
+    sut_set(&bitset, 3, true);
+    sut_set(&bitset, 150, true);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&bitset, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  indices: [\n"
+        "    3,\n"
+        "    150,\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
+
+TEST(BitsetAtomic, ConcurrentClaimAndRelease) {
+    static constexpr size_t threads = 4;
+    static constexpr size_t rounds = 2000;
+    static constexpr size_t held = 40;
+
+    DC_SCOPED(sut) bitset = sut_new();
+    std::vector<std::atomic<size_t>> owners(sut_exclusive_end_index);
+    std::atomic<bool> duplicate_claim = false;
+
+    std::vector<std::thread> workers;
+    for (size_t thread = 0; thread < threads; thread++) {
+        workers.emplace_back([&, thread] {
+            size_t const hint = thread * (sut_exclusive_end_index / threads);
+            std::vector<size_t> claimed;
+            for (size_t round = 0; round < rounds; round++) {
+                for (size_t i = 0; i < held; i++) {
+                    size_t const index = sut_claim_first_clear(&bitset, hint);
+                    ASSERT_NE(index, sut_exclusive_end_index);
+                    if (owners[index].fetch_add(1) != 0) {
+                        duplicate_claim = true;
+                    }
+                    claimed.push_back(index);
+                }
+                for (size_t index : claimed) {
+                    owners[index].fetch_sub(1);
+                    ASSERT_TRUE(sut_test_and_clear(&bitset, (sut_index_t)index));
+                }
+                claimed.clear();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_FALSE(duplicate_claim);
+    EXPECT_EQ(sut_size(&bitset), 0);
+}
@@ -0,0 +1,13 @@
+#define EXCLUSIVE_END_INDEX 1
+#define NAME expand_1
+#include <derive-c/container/bitset/atomic/template.h>
+
+#define EXCLUSIVE_END_INDEX 200
+#define NAME expand_2
+#include <derive-c/container/bitset/atomic/template.h>
+
+#define EXCLUSIVE_END_INDEX 4294967295 /* 2**32 - 1 */
+#define NAME expand_3
+#include <derive-c/container/bitset/atomic/template.h>
+
+int main() {}
@@ -4,7 +4,9 @@
 #include <rapidcheck.h>
 #include <rapidcheck/gtest.h>
 #include <rapidcheck/state.h>
+#include <set>
 #include <unordered_set>
+#include <vector>
 
 using SutModel = std::unordered_set<size_t>;
 
@@ -61,6 +63,17 @@ template <typename SutNS> struct Command : rc::state::Command<SutModel, SutWrapp
         RC_ASSERT(SutNS::Sut_iter_const_empty_item(&item_const));
     }
 
+    void CheckFind(const Model& m, const Wrapper& w) const {
+        std::set<size_t> const sorted(m.begin(), m.end());
+        std::vector<size_t> found;
+        for (size_t index = SutNS::Sut_find_first_set(w.getConst());
+             index != SutNS::Sut_exclusive_end_index;
+             index = SutNS::Sut_find_next_set(w.getConst(), index + 1)) {
+            found.push_back(index);
+        }
+        RC_ASSERT(found == std::vector<size_t>(sorted.begin(), sorted.end()));
+    }
+
     void CheckFailedAccess(const Model& m, const Wrapper& w) const {
         const auto it = std::max_element(m.begin(), m.end());
         if (it != m.end()) {
@@ -82,6 +95,7 @@ template <typename SutNS> struct Command : rc::state::Command<SutModel, SutWrapp
         Model next = this->nextState(m);
         CheckValues(next, w);
         CheckIterators(next, w);
+        CheckFind(next, w);
         CheckFailedAccess(next, w);
         AdditionalChecks(next, w);
     }
@@ -0,0 +1,285 @@
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+#include <derive-c/utils/for.h>
+
+#define NAME sut
+#include <derive-c/container/bitset/dynamic/template.h>
+
+namespace {
+std::vector<size_t> iterated(sut const* bitset) {
+    std::vector<size_t> indices;
+    DC_FOR_CONST(sut, bitset, iter, index) { indices.push_back(index); }
+    return indices;
+}
+
+std::vector<size_t> found(sut const* bitset) {
+    std::vector<size_t> indices;
+    for (size_t index = sut_find_first_set(bitset); index < sut_exclusive_end_index(bitset);
+         index = sut_find_next_set(bitset, index + 1)) {
+        indices.push_back(index);
+    }
+    return indices;
+}
+
+sut random_bitset(std::mt19937& rng, size_t end, uint32_t per_mille) {
+    sut bitset = sut_new_with_end(end, stdalloc_get_ref());
+    for (size_t index = 0; index < end; index++) {
+        sut_set(&bitset, index, rng() % 1000 < per_mille);
+    }
+    return bitset;
+}
+
+std::vector<size_t> indices_of(std::vector<bool> const& keep) {
+    std::vector<size_t> indices;
+    for (size_t index = 0; index < keep.size(); index++) {
+        if (keep[index]) {
+            indices.push_back(index);
+        }
+    }
+    return indices;
+}
+
+dc_bitset_isa scalar_isa() { return DC_BITSET_ISA_SCALAR; }
+dc_bitset_isa avx2_isa() { return DC_BITSET_ISA_AVX2; }
+
+/// Runs a check with each of the bulk operation kernels selected in turn.
+template <typename F> void for_each_isa(F check) {
+    for (auto* isa : {scalar_isa, avx2_isa}) {
+        if (isa == avx2_isa && !__builtin_cpu_supports("avx2")) {
+            continue;
+        }
+        DC_MOCKABLE_SET(dc_bitset_isa_get)(isa);
+        check();
+    }
+    DC_MOCKABLE_SET(dc_bitset_isa_get)(DC_MOCKABLE_REAL(dc_bitset_isa_get));
+}
+} // namespace
+
+TEST(BitsetDynamic, Empty) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+    ASSERT_EQ(sut_exclusive_end_index(&bitset), 0);
+    ASSERT_EQ(sut_size(&bitset), 0);
+    ASSERT_FALSE(sut_try_set(&bitset, 0, true));
+    ASSERT_EQ(sut_find_first_set(&bitset), 0);
+    ASSERT_TRUE(iterated(&bitset).empty());
+
+    DC_SCOPED(sut) cloned = sut_clone(&bitset);
+    ASSERT_EQ(sut_exclusive_end_index(&cloned), 0);
+}
+
+TEST(BitsetDynamic, SetAndGet) {
+    DC_SCOPED(sut) bitset = sut_new_with_end(130, stdalloc_get_ref());
+    for (size_t i = 0; i < 130; i++) {
+        ASSERT_FALSE(sut_get(&bitset, i));
+    }
+    ASSERT_FALSE(sut_try_set(&bitset, 130, true));
+
+    std::vector<size_t> const expected = {0, 63, 64, 127, 128, 129};
+    for (size_t index : expected) {
+        sut_set(&bitset, index, true);
+    }
+    ASSERT_EQ(sut_size(&bitset), expected.size());
+    ASSERT_EQ(iterated(&bitset), expected);
+    ASSERT_EQ(found(&bitset), expected);
+
+    std::vector<size_t> iterated_mut;
+    DC_FOR(sut, &bitset, iter, index) { iterated_mut.push_back(index); }
+    ASSERT_EQ(iterated_mut, expected);
+
+    sut_set(&bitset, 64, false);
+    ASSERT_FALSE(sut_get(&bitset, 64));
+    ASSERT_EQ(sut_find_next_set(&bitset, 64), 127);
+}
+
+TEST(BitsetDynamic, SetRange) {
+    DC_SCOPED(sut) bitset = sut_new_with_end(300, stdalloc_get_ref());
+
+    // Within a word, across one boundary, and across whole words
+    sut_set_range(&bitset, 3, 9, true);
+    sut_set_range(&bitset, 60, 70, true);
+    sut_set_range(&bitset, 100, 300, true);
+    ASSERT_EQ(sut_size(&bitset), 6 + 10 + 200);
+
+    sut_set_range(&bitset, 101, 299, false);
+    sut_set_range(&bitset, 5, 5, false);
+
+    std::vector<size_t> expected = {3, 4, 5, 6, 7, 8};
+    for (size_t i = 60; i < 70; i++) {
+        expected.push_back(i);
+    }
+    expected.push_back(100);
+    expected.push_back(299);
+    ASSERT_EQ(iterated(&bitset), expected);
+    ASSERT_EQ(found(&bitset), expected);
+}
+
+TEST(BitsetDynamic, Resize) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 1000; i++) {
+        sut_resize(&bitset, i + 1);
+        sut_set(&bitset, i, i % 3 == 0);
+    }
+    ASSERT_EQ(sut_size(&bitset), 334);
+
+    // Shrinking discards indices past the end, and growing again does not restore them
+    sut_resize(&bitset, 100);
+    ASSERT_EQ(sut_size(&bitset), 34);
+    ASSERT_EQ(sut_find_next_set(&bitset, 100), 100);
+    sut_resize(&bitset, 1000);
+    ASSERT_EQ(sut_size(&bitset), 34);
+    ASSERT_EQ(sut_find_next_set(&bitset, 100), 1000);
+}
+
+TEST(BitsetDynamic, MatchesModel) {
+    std::mt19937 rng(42);
+    for (size_t round = 0; round < 50; round++) {
+        size_t end = rng() % 700;
+        DC_SCOPED(sut) bitset = sut_new_with_end(end, stdalloc_get_ref());
+        std::set<size_t> model;
+
+        for (size_t step = 0; step < 200; step++) {
+            switch (rng() % 4) {
+            case 0: {
+                if (end > 0) {
+                    size_t const index = rng() % end;
+                    bool const value = rng() % 2 == 0;
+                    sut_set(&bitset, index, value);
+                    value ? (void)model.insert(index) : (void)model.erase(index);
+                }
+                break;
+            }
+            case 1: {
+                size_t from = end > 0 ? rng() % end : 0;
+                size_t to = end > 0 ? rng() % (end + 1) : 0;
+                if (from > to) {
+                    std::swap(from, to);
+                }
+                bool const value = rng() % 2 == 0;
+                sut_set_range(&bitset, from, to, value);
+                for (size_t i = from; i < to; i++) {
+                    value ? (void)model.insert(i) : (void)model.erase(i);
+                }
+                break;
+            }
+            case 2: {
+                end = rng() % 700;
+                sut_resize(&bitset, end);
+                model.erase(model.lower_bound(end), model.end());
+                break;
+            }
+            default: {
+                DC_SCOPED(sut) cloned = sut_clone(&bitset);
+                ASSERT_EQ(iterated(&cloned), iterated(&bitset));
+                break;
+            }
+            }
+
+            std::vector<size_t> const expected(model.begin(), model.end());
+            ASSERT_EQ(sut_size(&bitset), model.size());
+            ASSERT_EQ(iterated(&bitset), expected);
+            ASSERT_EQ(found(&bitset), expected);
+        }
+    }
+}
+
+TEST(BitsetDynamic, Debug) {
+    DC_SCOPED(sut) bitset = sut_new_with_end(16, stdalloc_get_ref());
+    sut_set(&bitset, 0, true);
+    sut_set(&bitset, 9, true);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&bitset, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  exclusive_end_index: 16,\n"
+        "  words_capacity: 1,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  blocks: [\n"
+        "    { byte: 0, offset: 0, index: 0},\n"
+        "    { byte: 1, offset: 1, index: 9},\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
+
+TEST(BitsetDynamic, BulkOps) {
+    std::mt19937 rng(7);
+    // Sizes either side of a word, and of the 4 word AVX2 vectors
+    for (size_t end : {0, 1, 63, 64, 65, 255, 256, 257, 320, 1000}) {
+        for (uint32_t per_mille : {0, 10, 500, 1000}) {
+            DC_SCOPED(sut) left = random_bitset(rng, end, per_mille);
+            DC_SCOPED(sut) right = random_bitset(rng, end, 500);
+            DC_SCOPED(sut) out = sut_new_with_end(end, stdalloc_get_ref());
+
+            std::vector<bool> l(end);
+            std::vector<bool> r(end);
+            for (size_t index = 0; index < end; index++) {
+                l[index] = sut_get(&left, index);
+                r[index] = sut_get(&right, index);
+            }
+            std::vector<bool> both(end);
+            std::vector<bool> either(end);
+            std::vector<bool> one(end);
+            std::vector<bool> only_left(end);
+            std::vector<bool> only_right(end);
+            size_t both_count = 0;
+            for (size_t index = 0; index < end; index++) {
+                both[index] = l[index] && r[index];
+                either[index] = l[index] || r[index];
+                one[index] = l[index] != r[index];
+                only_left[index] = l[index] && !r[index];
+                only_right[index] = r[index] && !l[index];
+                both_count += both[index] ? 1 : 0;
+            }
+
+            for_each_isa([&] {
+                sut_and(&left, &right, &out);
+                ASSERT_EQ(iterated(&out), indices_of(both));
+                sut_or(&left, &right, &out);
+                ASSERT_EQ(iterated(&out), indices_of(either));
+                sut_xor(&left, &right, &out);
+                ASSERT_EQ(iterated(&out), indices_of(one));
+                sut_andnot(&left, &right, &out);
+                ASSERT_EQ(iterated(&out), indices_of(only_left));
+
+                ASSERT_EQ(sut_count_and(&left, &right), both_count);
+                ASSERT_EQ(sut_any_and(&left, &right), both_count > 0);
+
+                DC_SCOPED(sut) in_place = sut_clone(&left);
+                sut_and_assign(&in_place, &right);
+                ASSERT_EQ(iterated(&in_place), indices_of(both));
+                sut_or_assign(&in_place, &left);
+                ASSERT_EQ(iterated(&in_place), indices_of(l));
+                sut_xor_assign(&in_place, &right);
+                ASSERT_EQ(iterated(&in_place), indices_of(one));
+                sut_andnot_assign(&in_place, &left);
+                ASSERT_EQ(iterated(&in_place), indices_of(only_right));
+            });
+        }
+    }
+}
+
+TEST(BitsetDynamic, AnyAndLastWord) {
+    // Only the tail word after the AVX2 vectors intersects
+    DC_SCOPED(sut) left = sut_new_with_end(330, stdalloc_get_ref());
+    DC_SCOPED(sut) right = sut_new_with_end(330, stdalloc_get_ref());
+    sut_set(&left, 329, true);
+    sut_set(&right, 328, true);
+    for_each_isa([&] { ASSERT_FALSE(sut_any_and(&left, &right)); });
+    sut_set(&right, 329, true);
+    for_each_isa([&] {
+        ASSERT_TRUE(sut_any_and(&left, &right));
+        ASSERT_EQ(sut_count_and(&left, &right), 1);
+    });
+}
@@ -0,0 +1,162 @@
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+#include <derive-c/utils/for.h>
+
+#define NAME sut
+#include <derive-c/container/bitset/hierarchical/template.h>
+
+namespace {
+std::vector<size_t> iterated(sut const* bitset) {
+    std::vector<size_t> indices;
+    DC_FOR_CONST(sut, bitset, iter, index) { indices.push_back(index); }
+    return indices;
+}
+
+std::vector<size_t> found(sut const* bitset) {
+    std::vector<size_t> indices;
+    for (size_t index = sut_find_first_set(bitset); index < sut_exclusive_end_index(bitset);
+         index = sut_find_next_set(bitset, index + 1)) {
+        indices.push_back(index);
+    }
+    return indices;
+}
+} // namespace
+
+TEST(BitsetHierarchical, Empty) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+    ASSERT_EQ(sut_exclusive_end_index(&bitset), 0);
+    ASSERT_EQ(sut_levels(&bitset), 0);
+    ASSERT_EQ(sut_size(&bitset), 0);
+    ASSERT_FALSE(sut_try_set(&bitset, 0, true));
+    ASSERT_EQ(sut_find_first_set(&bitset), 0);
+    ASSERT_TRUE(iterated(&bitset).empty());
+    sut_clear_all(&bitset);
+
+    DC_SCOPED(sut) cloned = sut_clone(&bitset);
+    ASSERT_EQ(sut_exclusive_end_index(&cloned), 0);
+}
+
+TEST(BitsetHierarchical, Levels) {
+    for (auto [end, levels] : std::vector<std::pair<size_t, uint8_t>>{
+             {1, 1}, {64, 1}, {65, 2}, {4096, 2}, {4097, 3}, {262144, 3}, {262145, 4}}) {
+        DC_SCOPED(sut) bitset = sut_new_with_end(end, stdalloc_get_ref());
+        ASSERT_EQ(sut_levels(&bitset), levels) << "end " << end;
+    }
+}
+
+TEST(BitsetHierarchical, FindAcrossLevels) {
+    // 4 levels, with indices separated by long runs of empty words
+    size_t const end = 262145;
+    DC_SCOPED(sut) bitset = sut_new_with_end(end, stdalloc_get_ref());
+    std::vector<size_t> const expected = {0, 63, 64, 4095, 4096, 100000, 262143, 262144};
+    for (size_t index : expected) {
+        sut_set(&bitset, index, true);
+    }
+    ASSERT_EQ(sut_size(&bitset), expected.size());
+    ASSERT_EQ(found(&bitset), expected);
+    ASSERT_EQ(iterated(&bitset), expected);
+
+    std::vector<size_t> iterated_mut;
+    DC_FOR(sut, &bitset, iter, index) { iterated_mut.push_back(index); }
+    ASSERT_EQ(iterated_mut, expected);
+
+    ASSERT_EQ(sut_find_next_set(&bitset, 4097), 100000);
+    ASSERT_EQ(sut_find_next_set(&bitset, 100001), 262143);
+    ASSERT_EQ(sut_find_next_set(&bitset, end), end);
+
+    // Clearing the only index below a summary bit clears the summaries above
+    sut_set(&bitset, 100000, false);
+    ASSERT_FALSE(sut_get(&bitset, 100000));
+    ASSERT_EQ(sut_find_next_set(&bitset, 4097), 262143);
+    sut_set(&bitset, 262144, false);
+    sut_set(&bitset, 262143, false);
+    ASSERT_EQ(sut_find_next_set(&bitset, 4097), end);
+
+    // Setting and clearing an already set or unset index does not change the size
+    sut_set(&bitset, 0, true);
+    sut_set(&bitset, 1, false);
+    ASSERT_EQ(sut_size(&bitset), expected.size() - 3);
+
+    sut_clear_all(&bitset);
+    ASSERT_EQ(sut_size(&bitset), 0);
+    ASSERT_EQ(sut_find_first_set(&bitset), end);
+    ASSERT_TRUE(iterated(&bitset).empty());
+}
+
+TEST(BitsetHierarchical, MatchesModel) {
+    std::mt19937 rng(42);
+    for (size_t round = 0; round < 30; round++) {
+        size_t const end = rng() % 20000;
+        DC_SCOPED(sut) bitset = sut_new_with_end(end, stdalloc_get_ref());
+        std::set<size_t> model;
+
+        for (size_t step = 0; step < 300; step++) {
+            switch (rng() % 8) {
+            case 0: {
+                sut_clear_all(&bitset);
+                model.clear();
+                break;
+            }
+            case 1: {
+                DC_SCOPED(sut) cloned = sut_clone(&bitset);
+                ASSERT_EQ(iterated(&cloned), iterated(&bitset));
+                ASSERT_EQ(sut_size(&cloned), sut_size(&bitset));
+                break;
+            }
+            default: {
+                if (end > 0) {
+                    // Clustered indices, so some words fill and empty
+                    size_t const cluster = end < 200 ? end : 200;
+                    size_t const index = (rng() % 2 == 0) ? rng() % end : rng() % cluster;
+                    bool const value = rng() % 3 != 0;
+                    sut_set(&bitset, index, value);
+                    value ? (void)model.insert(index) : (void)model.erase(index);
+                }
+                break;
+            }
+            }
+
+            std::vector<size_t> const expected(model.begin(), model.end());
+            ASSERT_EQ(sut_size(&bitset), model.size());
+            ASSERT_EQ(iterated(&bitset), expected);
+            ASSERT_EQ(found(&bitset), expected);
+            if (end > 0) {
+                size_t const from = rng() % end;
+                auto const next = model.lower_bound(from);
+                ASSERT_EQ(sut_find_next_set(&bitset, from), next == model.end() ? end : *next);
+            }
+        }
+    }
+}
+
+TEST(BitsetHierarchical, Debug) {
+    DC_SCOPED(sut) bitset = sut_new_with_end(100, stdalloc_get_ref());
+    sut_set(&bitset, 0, true);
+    sut_set(&bitset, 70, true);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&bitset, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  exclusive_end_index: 100,\n"
+        "  levels: 2,\n"
+        "  size: 2,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  blocks: [\n"
+        "    { byte: 0, offset: 0, index: 0},\n"
+        "    { byte: 8, offset: 6, index: 70},\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
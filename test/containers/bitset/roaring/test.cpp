@@ -0,0 +1,326 @@
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+#include <derive-c/utils/for.h>
+
+#define NAME sut
+#include <derive-c/container/bitset/roaring/template.h>
+
+namespace {
+std::vector<uint32_t> iterated(sut const* bitset) {
+    std::vector<uint32_t> indices;
+    DC_FOR_CONST(sut, bitset, iter, index) { indices.push_back(static_cast<uint32_t>(index)); }
+    return indices;
+}
+
+std::string debug(sut const* bitset) {
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(bitset, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    return derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb));
+}
+
+size_t count_kind(sut const* bitset, std::string const& kind) {
+    std::string const text = debug(bitset);
+    std::string const needle = "kind: " + kind + ",";
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+void set_all(sut* bitset, std::set<uint32_t> const& indices) {
+    for (uint32_t index : indices) {
+        sut_set(bitset, index, true);
+    }
+}
+
+std::vector<uint32_t> as_vector(std::set<uint32_t> const& indices) {
+    return {indices.begin(), indices.end()};
+}
+
+enum class Kind { Array, Bitmap, Runs };
+
+// Indices of a single chunk (key 7) that are stored as the given kind.
+std::set<uint32_t> indices_for(Kind kind, std::mt19937& rng) {
+    uint32_t const base = 7 << 16;
+    std::set<uint32_t> indices;
+    switch (kind) {
+    case Kind::Array:
+        for (size_t i = 0; i < 1000; i++) {
+            indices.insert(base + (rng() % 65536));
+        }
+        break;
+    case Kind::Bitmap:
+        for (size_t i = 0; i < 30000; i++) {
+            indices.insert(base + (rng() % 65536));
+        }
+        break;
+    case Kind::Runs:
+        for (size_t run = 0; run < 20; run++) {
+            uint32_t const start = rng() % 60000;
+            uint32_t const length = 1 + (rng() % 3000);
+            for (uint32_t i = start; i < start + length; i++) {
+                indices.insert(base + i);
+            }
+        }
+        break;
+    }
+    return indices;
+}
+} // namespace
+
+TEST(BitsetRoaring, Empty) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+    ASSERT_EQ(sut_size(&bitset), 0);
+    ASSERT_EQ(sut_capacity_bytes(&bitset), 0);
+    ASSERT_FALSE(sut_get(&bitset, 0));
+    ASSERT_FALSE(sut_get(&bitset, UINT32_MAX));
+    ASSERT_TRUE(sut_try_set(&bitset, 3, false));
+    ASSERT_TRUE(iterated(&bitset).empty());
+    sut_run_optimize(&bitset);
+
+    DC_SCOPED(sut) cloned = sut_clone(&bitset);
+    ASSERT_EQ(sut_size(&cloned), 0);
+    sut_and_assign(&bitset, &cloned);
+    sut_or_assign(&bitset, &cloned);
+    ASSERT_EQ(sut_size(&bitset), 0);
+    ASSERT_EQ(sut_count_and(&bitset, &cloned), 0);
+    ASSERT_FALSE(sut_any_and(&bitset, &cloned));
+}
+
+TEST(BitsetRoaring, ExtremeIndices) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+    std::vector<uint32_t> const expected = {0, 65535, 65536, UINT32_MAX - 1, UINT32_MAX};
+    for (uint32_t index : expected) {
+        sut_set(&bitset, index, true);
+    }
+    ASSERT_EQ(iterated(&bitset), expected);
+    ASSERT_TRUE(sut_get(&bitset, UINT32_MAX));
+    ASSERT_FALSE(sut_get(&bitset, UINT32_MAX - 2));
+
+    sut_run_optimize(&bitset);
+    ASSERT_EQ(iterated(&bitset), expected);
+    sut_set(&bitset, UINT32_MAX, false);
+    sut_set(&bitset, 0, false);
+    ASSERT_EQ(iterated(&bitset), (std::vector<uint32_t>{65535, 65536, UINT32_MAX - 1}));
+}
+
+TEST(BitsetRoaring, ChunkKinds) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+
+    // An array up to 4096 indices, then a bitmap
+    for (uint32_t index = 0; index < 2 * 4096; index += 2) {
+        sut_set(&bitset, index, true);
+    }
+    ASSERT_EQ(count_kind(&bitset, "array"), 1);
+    sut_set(&bitset, 1, true);
+    ASSERT_EQ(count_kind(&bitset, "bitmap"), 1);
+    ASSERT_EQ(sut_size(&bitset), 4097);
+
+    // Back to an array only once well below 4096 indices
+    for (uint32_t index = 0; index < 4096; index += 2) {
+        sut_set(&bitset, index, false);
+    }
+    ASSERT_EQ(count_kind(&bitset, "bitmap"), 1);
+    for (uint32_t index = 4096; index < 2 * 4096; index += 2) {
+        sut_set(&bitset, index, false);
+    }
+    ASSERT_EQ(count_kind(&bitset, "array"), 1);
+    ASSERT_EQ(iterated(&bitset), std::vector<uint32_t>{1});
+
+    // A range is stored as a single run, once optimised
+    for (uint32_t index = 10; index < 60000; index++) {
+        sut_set(&bitset, index, true);
+    }
+    size_t const bitmap_bytes = sut_capacity_bytes(&bitset);
+    sut_run_optimize(&bitset);
+    ASSERT_EQ(count_kind(&bitset, "runs"), 1);
+    ASSERT_LT(sut_capacity_bytes(&bitset), bitmap_bytes / 16);
+    ASSERT_EQ(sut_size(&bitset), 59991);
+
+    // Splitting the runs until an array is smaller
+    for (uint32_t index = 11; index < 60000; index += 2) {
+        sut_set(&bitset, index, false);
+    }
+    ASSERT_EQ(count_kind(&bitset, "runs"), 0);
+    ASSERT_EQ(sut_size(&bitset), 59991 - 29995);
+    ASSERT_TRUE(sut_get(&bitset, 59998));
+    ASSERT_FALSE(sut_get(&bitset, 59999));
+
+    // Removing every index removes the chunk
+    for (uint32_t index = 0; index < 60000; index++) {
+        sut_set(&bitset, index, false);
+    }
+    ASSERT_EQ(sut_size(&bitset), 0);
+    ASSERT_EQ(count_kind(&bitset, "array") + count_kind(&bitset, "bitmap"), 0);
+}
+
+TEST(BitsetRoaring, RunsMutation) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+    std::set<uint32_t> model;
+    for (uint32_t index = 100; index < 200; index++) {
+        model.insert(index);
+    }
+    for (uint32_t index = 300; index < 400; index++) {
+        model.insert(index);
+    }
+    set_all(&bitset, model);
+    sut_run_optimize(&bitset);
+    ASSERT_EQ(count_kind(&bitset, "runs"), 1);
+
+    // Extending, joining, shrinking and splitting runs
+    for (auto [index, value] : std::vector<std::pair<uint32_t, bool>>{{99, true},
+                                                                      {200, true},
+                                                                      {150, false},
+                                                                      {100, false},
+                                                                      {399, false},
+                                                                      {250, true},
+                                                                      {150, true}}) {
+        sut_set(&bitset, index, value);
+        value ? (void)model.insert(index) : (void)model.erase(index);
+        ASSERT_EQ(iterated(&bitset), as_vector(model));
+        ASSERT_EQ(sut_size(&bitset), model.size());
+    }
+    ASSERT_EQ(count_kind(&bitset, "runs"), 1);
+
+    for (uint32_t index = 201; index < 300; index++) {
+        sut_set(&bitset, index, true);
+        model.insert(index);
+    }
+    ASSERT_EQ(iterated(&bitset), as_vector(model));
+    ASSERT_EQ(count_kind(&bitset, "runs"), 1);
+}
+
+TEST(BitsetRoaring, BulkOpsAcrossKinds) {
+    std::mt19937 rng(7);
+    for (Kind left_kind : {Kind::Array, Kind::Bitmap, Kind::Runs}) {
+        for (Kind right_kind : {Kind::Array, Kind::Bitmap, Kind::Runs}) {
+            std::set<uint32_t> const left_model = indices_for(left_kind, rng);
+            std::set<uint32_t> const right_model = indices_for(right_kind, rng);
+
+            DC_SCOPED(sut) left = sut_new(stdalloc_get_ref());
+            DC_SCOPED(sut) right = sut_new(stdalloc_get_ref());
+            set_all(&left, left_model);
+            set_all(&right, right_model);
+            if (left_kind == Kind::Runs) {
+                sut_run_optimize(&left);
+            }
+            if (right_kind == Kind::Runs) {
+                sut_run_optimize(&right);
+            }
+
+            std::set<uint32_t> intersection;
+            std::set_intersection(left_model.begin(), left_model.end(), right_model.begin(),
+                                  right_model.end(),
+                                  std::inserter(intersection, intersection.end()));
+            std::set<uint32_t> united;
+            std::set_union(left_model.begin(), left_model.end(), right_model.begin(),
+                           right_model.end(), std::inserter(united, united.end()));
+
+            DC_SCOPED(sut) out = sut_new(stdalloc_get_ref());
+            sut_set(&out, 1, true);
+            sut_and(&left, &right, &out);
+            ASSERT_EQ(iterated(&out), as_vector(intersection));
+            ASSERT_EQ(sut_size(&out), intersection.size());
+            ASSERT_EQ(sut_count_and(&left, &right), intersection.size());
+            ASSERT_EQ(sut_any_and(&left, &right), !intersection.empty());
+
+            sut_or(&left, &right, &out);
+            ASSERT_EQ(iterated(&out), as_vector(united));
+            ASSERT_EQ(sut_size(&out), united.size());
+        }
+    }
+}
+
+TEST(BitsetRoaring, MatchesModel) {
+    std::mt19937 rng(42);
+    for (size_t round = 0; round < 8; round++) {
+        DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+        DC_SCOPED(sut) other = sut_new(stdalloc_get_ref());
+        std::set<uint32_t> model;
+        std::set<uint32_t> other_model;
+
+        for (size_t step = 0; step < 300; step++) {
+            // A few chunks, with ranges so chunks are arrays, bitmaps and runs
+            uint32_t const key = rng() % 4;
+            uint32_t const start = rng() % 65536;
+            uint32_t const length = rng() % 3 == 0 ? 1 + (rng() % 1500) : 1;
+            bool const value = rng() % 3 != 0;
+            bool const to_other = rng() % 4 == 0;
+            sut* target = to_other ? &other : &bitset;
+            std::set<uint32_t>& target_model = to_other ? other_model : model;
+            for (uint32_t low = start; low < start + length && low < 65536; low++) {
+                uint32_t const index = (key << 16) | low;
+                sut_set(target, index, value);
+                value ? (void)target_model.insert(index) : (void)target_model.erase(index);
+            }
+
+            switch (rng() % 10) {
+            case 0:
+                sut_run_optimize(&bitset);
+                break;
+            case 1: {
+                sut_and_assign(&bitset, &other);
+                std::set<uint32_t> result;
+                std::set_intersection(model.begin(), model.end(), other_model.begin(),
+                                      other_model.end(), std::inserter(result, result.end()));
+                model = result;
+                break;
+            }
+            case 2: {
+                sut_or_assign(&bitset, &other);
+                model.insert(other_model.begin(), other_model.end());
+                break;
+            }
+            case 3: {
+                DC_SCOPED(sut) cloned = sut_clone(&bitset);
+                ASSERT_EQ(iterated(&cloned), iterated(&bitset));
+                break;
+            }
+            default:
+                break;
+            }
+
+            ASSERT_EQ(sut_size(&bitset), model.size());
+            if (step % 10 == 0) {
+                ASSERT_EQ(iterated(&bitset), as_vector(model));
+            }
+            uint32_t const probe = ((rng() % 4) << 16) | (rng() % 65536);
+            ASSERT_EQ(sut_get(&bitset, probe), model.contains(probe));
+        }
+    }
+}
+
+TEST(BitsetRoaring, Debug) {
+    DC_SCOPED(sut) bitset = sut_new(stdalloc_get_ref());
+    sut_set(&bitset, 3, true);
+    sut_set(&bitset, 70000, true);
+    sut_set(&bitset, 70001, true);
+    sut_set(&bitset, 70002, true);
+    sut_run_optimize(&bitset);
+
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  size: 4,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  chunks: [\n"
+        "    { key: 0, kind: array, cardinality: 1 },\n"
+        "    { key: 1, kind: runs, cardinality: 3 },\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        debug(&bitset));
+}
@@ -0,0 +1,6 @@
+#include <derive-c/alloc/std.h>
+
+#define NAME expand_1
+#include <derive-c/container/bitset/roaring/template.h>
+
+int main() {}
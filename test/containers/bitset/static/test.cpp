@@ -1,3 +1,4 @@
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -49,6 +50,20 @@ TEST(BitsetStaticUtils, IndexToBytesAndOffset) {
     EXPECT_EQ(7, DC_BITSET_STATIC_INDEX_TO_OFFSET((uint8_t)23));
 }
 
+TEST(BitsetStaticUtils, Words) {
+    EXPECT_EQ(1, DC_BITSET_STATIC_CAPACITY_TO_WORDS((uint8_t)1));
+    EXPECT_EQ(1, DC_BITSET_STATIC_CAPACITY_TO_WORDS((uint8_t)64));
+    EXPECT_EQ(2, DC_BITSET_STATIC_CAPACITY_TO_WORDS((uint8_t)65));
+
+    EXPECT_EQ(0, DC_BITSET_STATIC_INDEX_TO_WORDS((uint8_t)63));
+    EXPECT_EQ(63, DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET((uint8_t)63));
+    EXPECT_EQ(1, DC_BITSET_STATIC_INDEX_TO_WORDS((uint8_t)64));
+    EXPECT_EQ(0, DC_BITSET_STATIC_INDEX_TO_WORD_OFFSET((uint8_t)64));
+
+    EXPECT_EQ(0x1ULL, DC_BITSET_STATIC_WORD_OFFSET_TO_MASK((uint8_t)0));
+    EXPECT_EQ(0x8000000000000000ULL, DC_BITSET_STATIC_WORD_OFFSET_TO_MASK((uint8_t)63));
+}
+
 #define EXCLUSIVE_END_INDEX 16
 #define NAME sut
 #include <derive-c/container/bitset/static/template.h>
@@ -109,3 +124,86 @@ TEST(BitsetStatic, Debug) {
             derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
     }
 }
+
+#define EXCLUSIVE_END_INDEX 200
+#define NAME words_sut
+#include <derive-c/container/bitset/static/template.h>
+
+TEST(BitsetStatic, FindAndIterate) {
+    DC_SCOPED(words_sut) bitset = words_sut_new();
+    ASSERT_EQ(words_sut_find_first_set(&bitset), words_sut_exclusive_end_index);
+    ASSERT_EQ(words_sut_size(&bitset), 0);
+    {
+        words_sut_iter_const iter = words_sut_get_iter_const(&bitset);
+        ASSERT_TRUE(words_sut_iter_const_empty(&iter));
+    }
+
+    // Indices at either side of word boundaries, and the last index
+    std::vector<size_t> const expected = {0, 1, 63, 64, 127, 130, 191, 192, 199};
+    for (size_t index : expected) {
+        words_sut_set(&bitset, static_cast<words_sut_index_t>(index), true);
+    }
+    ASSERT_EQ(words_sut_size(&bitset), expected.size());
+
+    std::vector<size_t> found;
+    for (size_t index = words_sut_find_first_set(&bitset);
+         index != words_sut_exclusive_end_index;
+         index = words_sut_find_next_set(&bitset, index + 1)) {
+        found.push_back(index);
+    }
+    ASSERT_EQ(found, expected);
+
+    ASSERT_EQ(words_sut_find_next_set(&bitset, 2), 63);
+    ASSERT_EQ(words_sut_find_next_set(&bitset, 65), 127);
+    ASSERT_EQ(words_sut_find_next_set(&bitset, 200), words_sut_exclusive_end_index);
+
+    std::vector<size_t> iterated;
+    DC_FOR_CONST(words_sut, &bitset, iter, index) { iterated.push_back(index); }
+    ASSERT_EQ(iterated, expected);
+
+    std::vector<size_t> iterated_mut;
+    DC_FOR(words_sut, &bitset, iter_mut, index) { iterated_mut.push_back(index); }
+    ASSERT_EQ(iterated_mut, expected);
+
+    words_sut_set(&bitset, 199, false);
+    ASSERT_EQ(words_sut_find_next_set(&bitset, 193), words_sut_exclusive_end_index);
+    ASSERT_EQ(words_sut_size(&bitset), expected.size() - 1);
+}
+
+TEST(BitsetStatic, BulkOps) {
+    DC_SCOPED(words_sut) left = words_sut_new();
+    DC_SCOPED(words_sut) right = words_sut_new();
+    DC_SCOPED(words_sut) out = words_sut_new();
+    for (words_sut_index_t index : {0, 5, 64, 130, 199}) {
+        words_sut_set(&left, index, true);
+    }
+    for (words_sut_index_t index : {5, 63, 130, 198}) {
+        words_sut_set(&right, index, true);
+    }
+
+    auto indices = [](words_sut const* bitset) {
+        std::vector<size_t> found;
+        DC_FOR_CONST(words_sut, bitset, iter, index) { found.push_back(index); }
+        return found;
+    };
+
+    words_sut_and(&left, &right, &out);
+    ASSERT_EQ(indices(&out), (std::vector<size_t>{5, 130}));
+    words_sut_or(&left, &right, &out);
+    ASSERT_EQ(indices(&out), (std::vector<size_t>{0, 5, 63, 64, 130, 198, 199}));
+    words_sut_xor(&left, &right, &out);
+    ASSERT_EQ(indices(&out), (std::vector<size_t>{0, 63, 64, 198, 199}));
+    words_sut_andnot(&left, &right, &out);
+    ASSERT_EQ(indices(&out), (std::vector<size_t>{0, 64, 199}));
+
+    ASSERT_EQ(words_sut_count_and(&left, &right), 2);
+    ASSERT_TRUE(words_sut_any_and(&left, &right));
+    ASSERT_FALSE(words_sut_any_and(&right, &out));
+
+    words_sut_andnot_assign(&left, &out);
+    ASSERT_EQ(indices(&left), (std::vector<size_t>{5, 130}));
+    words_sut_or_assign(&left, &out);
+    words_sut_xor_assign(&left, &right);
+    words_sut_and_assign(&left, &out);
+    ASSERT_EQ(indices(&left), (std::vector<size_t>{0, 64, 199}));
+}
@@ -0,0 +1,243 @@
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define NAME sut
+#include <derive-c/container/filter/bloom/template.h>
+
+namespace {
+std::vector<uint64_t> distinct_items(size_t count, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<uint64_t> items(count);
+    for (uint64_t& item : items) {
+        item = gen();
+    }
+    return items;
+}
+
+dc_bloom_isa scalar_isa() { return DC_BLOOM_ISA_SCALAR; }
+dc_bloom_isa avx2_isa() { return DC_BLOOM_ISA_AVX2; }
+
+/// Runs a check with each of the block kernels selected in turn.
+template <typename F> void for_each_isa(F check) {
+    for (auto* isa : {scalar_isa, avx2_isa}) {
+        if (isa == avx2_isa && !__builtin_cpu_supports("avx2")) {
+            continue;
+        }
+        DC_MOCKABLE_SET(dc_bloom_isa_get)(isa);
+        check(isa());
+    }
+    DC_MOCKABLE_SET(dc_bloom_isa_get)(DC_MOCKABLE_REAL(dc_bloom_isa_get));
+}
+} // namespace
+
+TEST(FilterBloom, ExpectedFalsePositiveRate) {
+    EXPECT_EQ(sut_expected_false_positive_rate(1, 0), 0.0);
+    EXPECT_EQ(sut_expected_false_positive_rate(1000, 0), 0.0);
+
+    // Increases with the items, and decreases with the blocks.
+    double previous = 0.0;
+    for (size_t items = 1000; items <= 64000; items *= 2) {
+        double const rate = sut_expected_false_positive_rate(1000, items);
+        EXPECT_GT(rate, previous);
+        previous = rate;
+    }
+    EXPECT_GT(sut_expected_false_positive_rate(1000, 10000),
+              sut_expected_false_positive_rate(2000, 10000));
+
+    // Saturated filters match every query.
+    EXPECT_NEAR(sut_expected_false_positive_rate(1, 10000), 1.0, 1e-9);
+    EXPECT_EQ(sut_expected_false_positive_rate(10, 1000000), 1.0);
+}
+
+TEST(FilterBloom, NewForFewestBlocks) {
+    for (double const target : {0.1, 0.01, 0.001}) {
+        DC_SCOPED(sut) filter = sut_new_for(100000, target, stdalloc_get_ref());
+        EXPECT_LE(sut_expected_false_positive_rate(filter.blocks_count, 100000), target);
+        EXPECT_GT(sut_expected_false_positive_rate(filter.blocks_count - 1, 100000), target);
+    }
+
+    DC_SCOPED(sut) empty = sut_new_for(0, 0.01, stdalloc_get_ref());
+    EXPECT_EQ(empty.blocks_count, 1);
+}
+
+TEST(FilterBloom, NoFalseNegatives) {
+    std::vector<uint64_t> const items = distinct_items(20000, 1);
+    DC_SCOPED(sut) filter = sut_new_for(items.size(), 0.01, stdalloc_get_ref());
+
+    for (uint64_t item : items) {
+        sut_add(&filter, item);
+    }
+    EXPECT_EQ(sut_size(&filter), items.size());
+
+    for (uint64_t item : items) {
+        ASSERT_TRUE(sut_contains(&filter, item));
+    }
+
+    std::unique_ptr<bool[]> found = std::make_unique<bool[]>(items.size());
+    EXPECT_EQ(sut_contains_many(&filter, items.data(), items.size(), found.get()), items.size());
+}
+
+namespace {
+double observed_false_positive_rate(sut const* filter, std::vector<uint64_t> const& queries) {
+    size_t false_positives = 0;
+    for (uint64_t query : queries) {
+        false_positives += sut_contains(filter, query) ? 1 : 0;
+    }
+    return static_cast<double>(false_positives) / static_cast<double>(queries.size());
+}
+} // namespace
+
+TEST(FilterBloom, FalsePositiveRateMatchesExpected) {
+    for (double const target : {0.05, 0.01, 0.001}) {
+        std::vector<uint64_t> const items = distinct_items(50000, 4);
+        DC_SCOPED(sut) filter = sut_new_for(items.size(), target, stdalloc_get_ref());
+        sut_add_many(&filter, items.data(), items.size());
+
+        double const expected = sut_false_positive_rate(&filter);
+        double const observed = observed_false_positive_rate(&filter, distinct_items(1000000, 5));
+        EXPECT_LE(expected, target);
+        EXPECT_GT(observed, expected * 0.8) << "target " << target;
+        EXPECT_LT(observed, expected * 1.2) << "target " << target;
+    }
+}
+
+// Small integers, for which the identity hash's high bits are zero, and the low bits correlated.
+// The blocks are then filled more evenly than for random items, so only bounded above.
+TEST(FilterBloom, FalsePositiveRateSequentialItems) {
+    for (double const target : {0.05, 0.01, 0.001}) {
+        size_t const count = 50000;
+        DC_SCOPED(sut) filter = sut_new_for(count, target, stdalloc_get_ref());
+        for (uint64_t item = 0; item < count; item++) {
+            sut_add(&filter, item);
+        }
+
+        std::vector<uint64_t> queries(1000000);
+        for (size_t i = 0; i < queries.size(); i++) {
+            queries[i] = count + i;
+        }
+        double const observed = observed_false_positive_rate(&filter, queries);
+        EXPECT_LT(observed, sut_false_positive_rate(&filter) * 1.2) << "target " << target;
+    }
+}
+
+TEST(FilterBloom, BulkMatchesSingle) {
+    std::vector<uint64_t> const items = distinct_items(1001, 2);
+    std::vector<uint64_t> const queries = distinct_items(5003, 3);
+
+    DC_SCOPED(sut) single = sut_new_with_blocks(16, stdalloc_get_ref());
+    DC_SCOPED(sut) bulk = sut_new_with_blocks(16, stdalloc_get_ref());
+    for (uint64_t item : items) {
+        sut_add(&single, item);
+    }
+    sut_add_many(&bulk, items.data(), items.size());
+    EXPECT_EQ(sut_size(&bulk), items.size());
+    EXPECT_EQ(std::memcmp(single.blocks, bulk.blocks, 16 * sizeof(dc_bloom_block)), 0);
+
+    std::unique_ptr<bool[]> found = std::make_unique<bool[]>(queries.size());
+    size_t const count = sut_contains_many(&bulk, queries.data(), queries.size(), found.get());
+    size_t expected_count = 0;
+    for (size_t i = 0; i < queries.size(); i++) {
+        bool const expected = sut_contains(&single, queries[i]);
+        EXPECT_EQ(found[i], expected);
+        expected_count += expected ? 1 : 0;
+    }
+    EXPECT_EQ(count, expected_count);
+    EXPECT_GT(count, 0);
+}
+
+TEST(FilterBloom, KernelsMatchScalar) {
+    std::mt19937 gen(4);
+    for (size_t trial = 0; trial < 64; trial++) {
+        std::vector<uint32_t> hashes(trial % 16);
+        for (uint32_t& hash : hashes) {
+            hash = gen();
+        }
+
+        alignas(sizeof(dc_bloom_block)) dc_bloom_block expected = {};
+        for (uint32_t hash : hashes) {
+            dc_bloom_block_add(&expected, hash, DC_BLOOM_ISA_SCALAR);
+        }
+
+        for_each_isa([&](dc_bloom_isa isa) {
+            alignas(sizeof(dc_bloom_block)) dc_bloom_block block = {};
+            for (uint32_t hash : hashes) {
+                dc_bloom_block_add(&block, hash, isa);
+                EXPECT_TRUE(dc_bloom_block_contains(&block, hash, isa));
+            }
+            EXPECT_EQ(std::memcmp(&block, &expected, sizeof(dc_bloom_block)), 0);
+
+            for (size_t query = 0; query < 64; query++) {
+                uint32_t const hash = gen();
+                EXPECT_EQ(dc_bloom_block_contains(&block, hash, isa),
+                          dc_bloom_block_contains(&expected, hash, DC_BLOOM_ISA_SCALAR));
+            }
+        });
+    }
+}
+
+TEST(FilterBloom, FilterMatchesAcrossIsas) {
+    std::vector<uint64_t> const items = distinct_items(1001, 5);
+    std::vector<uint64_t> const queries = distinct_items(5003, 6);
+
+    DC_SCOPED(sut) expected = sut_new_with_blocks(16, stdalloc_get_ref());
+    DC_MOCKABLE_SET(dc_bloom_isa_get)(scalar_isa);
+    sut_add_many(&expected, items.data(), items.size());
+    std::unique_ptr<bool[]> expected_found = std::make_unique<bool[]>(queries.size());
+    size_t const expected_count =
+        sut_contains_many(&expected, queries.data(), queries.size(), expected_found.get());
+
+    for_each_isa([&](dc_bloom_isa /* isa */) {
+        DC_SCOPED(sut) single = sut_new_with_blocks(16, stdalloc_get_ref());
+        DC_SCOPED(sut) bulk = sut_new_with_blocks(16, stdalloc_get_ref());
+        for (uint64_t item : items) {
+            sut_add(&single, item);
+        }
+        sut_add_many(&bulk, items.data(), items.size());
+        EXPECT_EQ(std::memcmp(single.blocks, expected.blocks, 16 * sizeof(dc_bloom_block)), 0);
+        EXPECT_EQ(std::memcmp(bulk.blocks, expected.blocks, 16 * sizeof(dc_bloom_block)), 0);
+
+        std::unique_ptr<bool[]> found = std::make_unique<bool[]>(queries.size());
+        EXPECT_EQ(sut_contains_many(&bulk, queries.data(), queries.size(), found.get()),
+                  expected_count);
+        for (size_t i = 0; i < queries.size(); i++) {
+            EXPECT_EQ(found[i], expected_found[i]);
+            EXPECT_EQ(sut_contains(&single, queries[i]), expected_found[i]);
+        }
+    });
+}
+
+TEST(FilterBloom, CloneAndDebug) {
+    DC_SCOPED(sut) filter = sut_new_with_blocks(3, stdalloc_get_ref());
+    sut_add(&filter, 42);
+    EXPECT_EQ(sut_capacity_bytes(&filter), 3 * 64);
+
+    DC_SCOPED(sut) cloned = sut_clone(&filter);
+    sut_add(&filter, 43);
+    EXPECT_TRUE(sut_contains(&cloned, 42));
+    EXPECT_EQ(sut_size(&cloned), 1);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&cloned, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  blocks: 3,\n"
+        "  size: 1,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
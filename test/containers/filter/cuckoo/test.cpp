@@ -0,0 +1,246 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define FINGERPRINT_BITS 12
+#define NAME sut
+#include <derive-c/container/filter/cuckoo/template.h>
+
+namespace {
+std::vector<uint64_t> distinct_items(size_t count, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<uint64_t> items(count);
+    for (uint64_t& item : items) {
+        item = gen();
+    }
+    return items;
+}
+
+struct Bits8 {
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define FINGERPRINT_BITS 8
+#define NAME Self
+#include <derive-c/container/filter/cuckoo/template.h>
+};
+
+struct Bits12 {
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define FINGERPRINT_BITS 12
+#define NAME Self
+#include <derive-c/container/filter/cuckoo/template.h>
+};
+
+struct Bits16 {
+#define EXPAND_IN_STRUCT
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define FINGERPRINT_BITS 16
+#define NAME Self
+#include <derive-c/container/filter/cuckoo/template.h>
+};
+} // namespace
+
+TEST(FilterCuckoo, BucketSlots) {
+    for (unsigned const bits : {8U, 12U, 16U}) {
+        uint64_t bucket = 0;
+        EXPECT_EQ(dc_cuckoo_first_slot(dc_cuckoo_zero_slots(bucket, bits), bits), 0);
+
+        bucket = dc_cuckoo_bucket_set(bucket, 0, 1, bits);
+        bucket = dc_cuckoo_bucket_set(bucket, 2, (1U << bits) - 1, bits);
+        EXPECT_EQ(dc_cuckoo_bucket_get(bucket, 0, bits), 1);
+        EXPECT_EQ(dc_cuckoo_bucket_get(bucket, 1, bits), 0);
+        EXPECT_EQ(dc_cuckoo_bucket_get(bucket, 2, bits), (1U << bits) - 1);
+        EXPECT_EQ(dc_cuckoo_first_slot(dc_cuckoo_zero_slots(bucket, bits), bits), 1);
+
+        EXPECT_TRUE(dc_cuckoo_bucket_contains(bucket, (1U << bits) - 1, bits));
+        EXPECT_FALSE(dc_cuckoo_bucket_contains(bucket, 2, bits));
+
+        bucket = dc_cuckoo_bucket_set(bucket, 1, 1, bits);
+        bucket = dc_cuckoo_bucket_set(bucket, 3, 1, bits);
+        EXPECT_EQ(dc_cuckoo_zero_slots(bucket, bits), 0);
+        EXPECT_EQ(dc_cuckoo_first_slot(dc_cuckoo_zero_slots(bucket ^ dc_cuckoo_broadcast(1, bits),
+                                                            bits),
+                                       bits),
+                  0);
+    }
+}
+
+TEST(FilterCuckoo, PackedBuckets) {
+    // 12 bit fingerprints pack buckets into 6 bytes, so stores must not overwrite neighbours.
+    std::vector<uint8_t> buckets(3 * dc_cuckoo_bucket_bytes(12) + DC_CUCKOO_BUCKET_PADDING, 0);
+    for (size_t index = 0; index < 3; index++) {
+        uint64_t bucket = 0;
+        for (unsigned slot = 0; slot < DC_CUCKOO_BUCKET_SLOTS; slot++) {
+            bucket = dc_cuckoo_bucket_set(bucket, slot, 0xf00 + (index * 4) + slot, 12);
+        }
+        dc_cuckoo_bucket_store(buckets.data(), index, bucket, 12);
+    }
+    for (size_t index = 0; index < 3; index++) {
+        uint64_t const bucket = dc_cuckoo_bucket_load(buckets.data(), index, 12);
+        for (unsigned slot = 0; slot < DC_CUCKOO_BUCKET_SLOTS; slot++) {
+            EXPECT_EQ(dc_cuckoo_bucket_get(bucket, slot, 12), 0xf00 + (index * 4) + slot);
+        }
+    }
+}
+
+TEST(FilterCuckoo, NewFor) {
+    DC_SCOPED(sut) empty = sut_new_for(0, stdalloc_get_ref());
+    EXPECT_EQ(sut_capacity(&empty), DC_CUCKOO_BUCKET_SLOTS);
+
+    DC_SCOPED(sut) exact = sut_new_for(1024, stdalloc_get_ref());
+    EXPECT_EQ(sut_capacity(&exact), 2048);
+
+    DC_SCOPED(sut) below = sut_new_for(970, stdalloc_get_ref());
+    EXPECT_EQ(sut_capacity(&below), 1024);
+}
+
+TEST(FilterCuckoo, NoFalseNegatives) {
+    std::vector<uint64_t> const items = distinct_items(20000, 1);
+    DC_SCOPED(sut) filter = sut_new_for(items.size(), stdalloc_get_ref());
+
+    for (uint64_t item : items) {
+        ASSERT_TRUE(sut_try_add(&filter, item));
+    }
+    EXPECT_EQ(sut_size(&filter), items.size());
+    EXPECT_DOUBLE_EQ(sut_load_factor(&filter), 20000.0 / 32768.0);
+
+    for (uint64_t item : items) {
+        ASSERT_TRUE(sut_contains(&filter, item));
+    }
+}
+
+TEST(FilterCuckoo, RemoveRestoresAbsence) {
+    std::vector<uint64_t> const items = distinct_items(4000, 2);
+    DC_SCOPED(sut) filter = sut_new_for(items.size(), stdalloc_get_ref());
+    for (uint64_t item : items) {
+        sut_add(&filter, item);
+    }
+
+    for (size_t i = 0; i < items.size(); i += 2) {
+        ASSERT_TRUE(sut_remove(&filter, items[i]));
+    }
+    EXPECT_EQ(sut_size(&filter), items.size() / 2);
+
+    size_t false_positives = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (i % 2 == 0) {
+            false_positives += sut_contains(&filter, items[i]) ? 1 : 0;
+        } else {
+            ASSERT_TRUE(sut_contains(&filter, items[i]));
+        }
+    }
+    EXPECT_LT(false_positives, 20);
+
+    for (size_t i = 1; i < items.size(); i += 2) {
+        ASSERT_TRUE(sut_remove(&filter, items[i]));
+    }
+    EXPECT_EQ(sut_size(&filter), 0);
+    for (uint64_t item : items) {
+        ASSERT_FALSE(sut_contains(&filter, item));
+    }
+}
+
+TEST(FilterCuckoo, FillsUntilFull) {
+    std::vector<uint64_t> const items = distinct_items(1000, 3);
+    DC_SCOPED(sut) filter = sut_new_with_buckets(64, stdalloc_get_ref());
+
+    size_t added = 0;
+    while (sut_try_add(&filter, items[added])) {
+        added++;
+    }
+    EXPECT_GT(sut_load_factor(&filter), 0.9);
+    EXPECT_EQ(sut_size(&filter), added);
+
+    // Including the item kicked aside when the filter became full.
+    for (size_t i = 0; i < added; i++) {
+        ASSERT_TRUE(sut_contains(&filter, items[i]));
+    }
+
+    EXPECT_FALSE(sut_try_add(&filter, items[added]));
+    ASSERT_TRUE(sut_remove(&filter, items[0]));
+    EXPECT_TRUE(sut_try_add(&filter, items[added]));
+    for (size_t i = 1; i <= added; i++) {
+        ASSERT_TRUE(sut_contains(&filter, items[i]));
+    }
+}
+
+TEST(FilterCuckoo, Duplicates) {
+    DC_SCOPED(sut) filter = sut_new_with_buckets(16, stdalloc_get_ref());
+    for (size_t i = 0; i < 3; i++) {
+        sut_add(&filter, 7);
+    }
+    EXPECT_EQ(sut_size(&filter), 3);
+    for (size_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(sut_contains(&filter, 7));
+        ASSERT_TRUE(sut_remove(&filter, 7));
+    }
+    EXPECT_FALSE(sut_contains(&filter, 7));
+    EXPECT_FALSE(sut_remove(&filter, 7));
+}
+
+namespace {
+template <typename Impl> void check_false_positive_rate() {
+    std::vector<uint64_t> const items = distinct_items(30000, 4);
+    typename Impl::Self filter = Impl::Self_new_for(items.size(), stdalloc_get_ref());
+    for (uint64_t item : items) {
+        Impl::Self_add(&filter, item);
+    }
+
+    size_t false_positives = 0;
+    std::vector<uint64_t> const queries = distinct_items(1000000, 5);
+    for (uint64_t query : queries) {
+        false_positives += Impl::Self_contains(&filter, query) ? 1 : 0;
+    }
+    double const observed =
+        static_cast<double>(false_positives) / static_cast<double>(queries.size());
+    double const bound = Impl::Self_false_positive_rate(&filter);
+    EXPECT_LT(observed, bound * 1.1);
+    EXPECT_GT(observed, bound * 0.5);
+    Impl::Self_delete(&filter);
+}
+} // namespace
+
+TEST(FilterCuckoo, FalsePositiveRate) {
+    check_false_positive_rate<Bits8>();
+    check_false_positive_rate<Bits12>();
+    check_false_positive_rate<Bits16>();
+}
+
+TEST(FilterCuckoo, CloneAndDebug) {
+    DC_SCOPED(sut) filter = sut_new_with_buckets(4, stdalloc_get_ref());
+    sut_add(&filter, 42);
+    EXPECT_EQ(sut_capacity_bytes(&filter), 4 * 6);
+
+    DC_SCOPED(sut) cloned = sut_clone(&filter);
+    ASSERT_TRUE(sut_remove(&filter, 42));
+    EXPECT_TRUE(sut_contains(&cloned, 42));
+    EXPECT_EQ(sut_size(&cloned), 1);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&cloned, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  fingerprint_bits: 12,\n"
+        "  buckets: 4,\n"
+        "  size: 1,\n"
+        "  victim: false,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -0,0 +1,10 @@
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+
+#define ITEM uint32_t
+#define ITEM_HASH uint32_t_hash_id
+#define FINGERPRINT_BITS 12
+#define NAME expand_1
+#include <derive-c/container/filter/cuckoo/template.h>
+
+int main() {}
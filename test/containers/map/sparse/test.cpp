@@ -0,0 +1,170 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/for.h>
+#include <derive-c/utils/debug/string.h>
+
+#define INDEX_BITS 32
+#define VALUE size_t
+#define NAME int_map
+#include <derive-c/container/map/sparse/template.h>
+
+namespace {
+void check_matches(int_map const* map, std::unordered_map<uint32_t, size_t> const& model) {
+    ASSERT_EQ(int_map_size(map), model.size());
+    size_t iterated = 0;
+    DC_FOR_CONST(int_map, map, iter, item) {
+        ASSERT_EQ(model.at(*item.key), *item.value);
+        iterated++;
+    }
+    ASSERT_EQ(iterated, model.size());
+}
+} // namespace
+
+TEST(SparseMap, InsertReadRemove) {
+    DC_SCOPED(int_map) map = int_map_new_with_universe(100, stdalloc_get_ref());
+    EXPECT_EQ(int_map_universe(&map), 100);
+
+    for (uint32_t key = 0; key < 100; key += 3) {
+        ASSERT_EQ(*int_map_insert(&map, key, key * 10), key * 10);
+    }
+    EXPECT_EQ(int_map_try_insert(&map, 3, 0), nullptr);
+    EXPECT_EQ(*int_map_read(&map, 3), 30);
+    EXPECT_EQ(int_map_try_read(&map, 4), nullptr);
+    EXPECT_EQ(int_map_try_read(&map, 1000), nullptr);
+    EXPECT_FALSE(int_map_contains(&map, 1000));
+
+    *int_map_write(&map, 3) = 7;
+    EXPECT_EQ(int_map_remove(&map, 3), 7);
+    EXPECT_FALSE(int_map_contains(&map, 3));
+    size_t value = 0;
+    EXPECT_FALSE(int_map_try_remove(&map, 3, &value));
+    EXPECT_TRUE(int_map_contains(&map, 99));
+}
+
+TEST(SparseMap, MatchesModel) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<uint32_t> keys(0, 511);
+    DC_SCOPED(int_map) map = int_map_new_with_universe(512, stdalloc_get_ref());
+    std::unordered_map<uint32_t, size_t> model;
+
+    for (size_t step = 0; step < 20000; step++) {
+        uint32_t const key = keys(gen);
+        switch (gen() % 8) {
+        case 0:
+            int_map_clear(&map);
+            model.clear();
+            break;
+        case 1:
+        case 2:
+        case 3: {
+            size_t value = 0;
+            bool const removed = int_map_try_remove(&map, key, &value);
+            ASSERT_EQ(removed, model.contains(key));
+            if (removed) {
+                ASSERT_EQ(value, model.at(key));
+                model.erase(key);
+            }
+            break;
+        }
+        default: {
+            bool const inserted = int_map_try_insert(&map, key, step) != nullptr;
+            ASSERT_EQ(inserted, !model.contains(key));
+            model.try_emplace(key, step);
+            break;
+        }
+        }
+        ASSERT_EQ(int_map_contains(&map, key), model.contains(key));
+        if (step % 97 == 0) {
+            check_matches(&map, model);
+        }
+    }
+    check_matches(&map, model);
+}
+
+TEST(SparseMap, ClearKeepsStalePositionsAbsent) {
+    DC_SCOPED(int_map) map = int_map_new_with_universe(16, stdalloc_get_ref());
+    for (uint32_t key = 0; key < 16; key++) {
+        int_map_insert(&map, key, key);
+    }
+    int_map_clear(&map);
+    EXPECT_EQ(int_map_size(&map), 0);
+
+    // The positions of 0 and 1 still point at entries 0 and 1, now holding 15 and 14.
+    int_map_insert(&map, 15, 0);
+    int_map_insert(&map, 14, 1);
+    for (uint32_t key = 0; key < 14; key++) {
+        ASSERT_FALSE(int_map_contains(&map, key));
+    }
+    EXPECT_EQ(*int_map_read(&map, 15), 0);
+    EXPECT_EQ(*int_map_read(&map, 14), 1);
+}
+
+TEST(SparseMap, CloneIsIndependent) {
+    DC_SCOPED(int_map) map = int_map_new_with_universe(64, stdalloc_get_ref());
+    for (uint32_t key = 0; key < 64; key += 2) {
+        int_map_insert(&map, key, key);
+    }
+    DC_SCOPED(int_map) cloned = int_map_clone(&map);
+    int_map_clear(&map);
+
+    EXPECT_EQ(int_map_size(&cloned), 32);
+    for (uint32_t key = 0; key < 64; key++) {
+        ASSERT_EQ(int_map_contains(&cloned, key), key % 2 == 0);
+    }
+}
+
+#define INDEX_BITS 8
+#define VALUE std::string*
+#define VALUE_DELETE(value_ptr) delete *(value_ptr)
+#define VALUE_CLONE(value_ptr) new std::string(**(value_ptr))
+#define VALUE_DEBUG(value_ptr, fmt, stream) fprintf(stream, "%s", (*(value_ptr))->c_str())
+#define NAME string_map
+#include <derive-c/container/map/sparse/template.h>
+
+TEST(SparseMap, ClearDeletesValues) {
+    DC_SCOPED(string_map) map = string_map_new_with_universe(string_map_max_capacity,
+                                                             stdalloc_get_ref());
+    for (uint8_t key = 0; key < 200; key++) {
+        string_map_insert(&map, key, new std::string(std::to_string(key)));
+    }
+    DC_SCOPED(string_map) cloned = string_map_clone(&map);
+    string_map_clear(&map);
+    string_map_insert(&map, 3, new std::string("three"));
+
+    EXPECT_EQ(**string_map_read(&map, 3), "three");
+    EXPECT_EQ(**string_map_read(&cloned, 3), "3");
+    string_map_delete_entry(&cloned, 3);
+    EXPECT_EQ(string_map_size(&cloned), 199);
+}
+
+TEST(SparseMap, Debug) {
+    DC_SCOPED(string_map) map = string_map_new_with_universe(10, stdalloc_get_ref());
+    string_map_insert(&map, 7, new std::string("foo"));
+    string_map_insert(&map, 2, new std::string("bar"));
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    string_map_debug(&map, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "string_map@" DC_PTR_REPLACE " {\n"
+        "  universe: 10,\n"
+        "  size: 2,\n"
+        "  capacity: 8,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  entries: [\n"
+        "    {key: 7, value: foo},\n"
+        "    {key: 2, value: bar},\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
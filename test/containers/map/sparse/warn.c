@@ -0,0 +1,20 @@
+#include <derive-c/prelude.h>
+
+#define INDEX_BITS 8
+#define VALUE double
+#define NAME expand_1
+#include <derive-c/container/map/sparse/template.h>
+
+#define INDEX_BITS 32
+#define VALUE char*
+#define VALUE_DELETE(value_ptr) free(*value_ptr)
+#define NAME expand_2
+#include <derive-c/container/map/sparse/template.h>
+
+#define INDEX_BITS 64
+#define VALUE long
+#define GROWTH_POLICY dc_growth_double
+#define NAME expand_3
+#include <derive-c/container/map/sparse/template.h>
+
+int main() {}
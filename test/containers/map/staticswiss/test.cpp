@@ -0,0 +1,213 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/for.h>
+#include <derive-c/utils/debug/string.h>
+
+#define CAPACITY 64
+#define KEY uint32_t
+#define KEY_HASH DC_DEFAULT_HASH
+#define VALUE size_t
+#define NAME int_map
+#include <derive-c/container/map/staticswiss/template.h>
+
+// JUSTIFY: Hashing keys to a few positions, with few distinct `H2`s
+//  - Probes wrap around the table and cross groups, and tombstones are dropped with entries moved
+//    far from their first group.
+static size_t colliding_hash(uint32_t const* key) {
+    return ((size_t)(*key % 3) << 62) | ((size_t)(*key % 5) * 7);
+}
+
+#define CAPACITY 64
+#define KEY uint32_t
+#define KEY_HASH colliding_hash
+#define VALUE size_t
+#define NAME colliding_map
+#include <derive-c/container/map/staticswiss/template.h>
+
+namespace {
+void check_matches(int_map const* map, std::unordered_map<uint32_t, size_t> const& model) {
+    ASSERT_EQ(int_map_size(map), model.size());
+    size_t iterated = 0;
+    DC_FOR_CONST(int_map, map, iter, item) {
+        ASSERT_EQ(model.at(*item.key), *item.value);
+        iterated++;
+    }
+    ASSERT_EQ(iterated, model.size());
+}
+
+void check_matches(colliding_map const* map, std::unordered_map<uint32_t, size_t> const& model) {
+    ASSERT_EQ(colliding_map_size(map), model.size());
+    size_t iterated = 0;
+    DC_FOR_CONST(colliding_map, map, iter, item) {
+        ASSERT_EQ(model.at(*item.key), *item.value);
+        iterated++;
+    }
+    ASSERT_EQ(iterated, model.size());
+}
+} // namespace
+
+TEST(StaticSwissMap, InsertReadRemove) {
+    DC_SCOPED(int_map) map = int_map_new();
+    EXPECT_EQ(int_map_max_capacity, 56);
+
+    for (uint32_t key = 0; key < 40; key++) {
+        ASSERT_EQ(*int_map_insert(&map, key, key * 10), key * 10);
+    }
+    EXPECT_EQ(int_map_try_insert(&map, 3, 0), nullptr);
+    EXPECT_EQ(*int_map_read(&map, 3), 30);
+    EXPECT_EQ(int_map_try_read(&map, 40), nullptr);
+
+    *int_map_write(&map, 3) = 7;
+    EXPECT_EQ(int_map_remove(&map, 3), 7);
+    EXPECT_EQ(int_map_try_read(&map, 3), nullptr);
+    size_t value = 0;
+    EXPECT_FALSE(int_map_try_remove(&map, 3, &value));
+    EXPECT_EQ(int_map_size(&map), 39);
+}
+
+TEST(StaticSwissMap, FullAtMaxCapacity) {
+    DC_SCOPED(int_map) map = int_map_new();
+    for (uint32_t key = 0; key < int_map_max_capacity; key++) {
+        ASSERT_NE(int_map_try_insert(&map, key, key), nullptr);
+    }
+    EXPECT_EQ(int_map_try_insert(&map, 1000, 0), nullptr);
+
+    // Removing one entry makes space again, reusing its tombstone.
+    int_map_delete_entry(&map, 10);
+    EXPECT_NE(int_map_try_insert(&map, 1000, 0), nullptr);
+    EXPECT_EQ(int_map_try_insert(&map, 1001, 0), nullptr);
+    for (uint32_t key = 0; key < int_map_max_capacity; key++) {
+        ASSERT_EQ(int_map_try_read(&map, key) != nullptr, key != 10);
+    }
+}
+
+TEST(StaticSwissMap, MatchesModel) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<uint32_t> keys(0, 127);
+    DC_SCOPED(int_map) map = int_map_new();
+    std::unordered_map<uint32_t, size_t> model;
+
+    for (size_t step = 0; step < 50000; step++) {
+        uint32_t const key = keys(gen);
+        switch (gen() % 16) {
+        case 0:
+            int_map_clear(&map);
+            model.clear();
+            break;
+        case 1:
+        case 2:
+        case 3:
+        case 4:
+        case 5:
+        case 6: {
+            size_t value = 0;
+            bool const removed = int_map_try_remove(&map, key, &value);
+            ASSERT_EQ(removed, model.contains(key));
+            if (removed) {
+                ASSERT_EQ(value, model.at(key));
+                model.erase(key);
+            }
+            break;
+        }
+        default: {
+            bool const inserted = int_map_try_insert(&map, key, step) != nullptr;
+            ASSERT_EQ(inserted, !model.contains(key) && model.size() < int_map_max_capacity);
+            if (inserted) {
+                model.emplace(key, step);
+            }
+            break;
+        }
+        }
+        ASSERT_EQ(int_map_try_read(&map, key) != nullptr, model.contains(key));
+        if (step % 97 == 0) {
+            check_matches(&map, model);
+        }
+    }
+    check_matches(&map, model);
+}
+
+TEST(StaticSwissMap, CollidingChurnDropsTombstones) {
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<uint32_t> keys(0, 1023);
+    DC_SCOPED(colliding_map) map = colliding_map_new();
+    std::unordered_map<uint32_t, size_t> model;
+
+    // Kept near the max capacity, so most inserts first drop the tombstones of the removals.
+    for (size_t step = 0; step < 50000; step++) {
+        uint32_t const key = keys(gen);
+        if (model.size() >= colliding_map_max_capacity - 2 || (gen() % 4 == 0 && !model.empty())) {
+            uint32_t const removed = model.begin()->first;
+            ASSERT_EQ(colliding_map_remove(&map, removed), model.at(removed));
+            model.erase(removed);
+        } else {
+            bool const inserted = colliding_map_try_insert(&map, key, step) != nullptr;
+            ASSERT_EQ(inserted, !model.contains(key));
+            model.try_emplace(key, step);
+        }
+        if (step % 31 == 0) {
+            check_matches(&map, model);
+            for (auto const& [model_key, model_value] : model) {
+                ASSERT_EQ(*colliding_map_read(&map, model_key), model_value);
+            }
+        }
+    }
+    check_matches(&map, model);
+}
+
+#define CAPACITY 16
+#define KEY uint32_t
+#define KEY_HASH DC_DEFAULT_HASH
+#define VALUE std::string*
+#define VALUE_DELETE(value_ptr) delete *(value_ptr)
+#define VALUE_CLONE(value_ptr) new std::string(**(value_ptr))
+#define VALUE_DEBUG(value_ptr, fmt, stream) fprintf(stream, "%s", (*(value_ptr))->c_str())
+#define NAME string_map
+#include <derive-c/container/map/staticswiss/template.h>
+
+TEST(StaticSwissMap, CloneAndClear) {
+    DC_SCOPED(string_map) map = string_map_new();
+    for (uint32_t key = 0; key < string_map_max_capacity; key++) {
+        string_map_insert(&map, key, new std::string(std::to_string(key)));
+    }
+    DC_SCOPED(string_map) cloned = string_map_clone(&map);
+    string_map_clear(&map);
+    EXPECT_EQ(string_map_size(&map), 0);
+    string_map_insert(&map, 3, new std::string("three"));
+
+    EXPECT_EQ(**string_map_read(&map, 3), "three");
+    EXPECT_EQ(**string_map_read(&cloned, 3), "3");
+    string_map_delete_entry(&cloned, 3);
+    EXPECT_EQ(string_map_size(&cloned), string_map_max_capacity - 1);
+}
+
+TEST(StaticSwissMap, Debug) {
+    DC_SCOPED(string_map) map = string_map_new();
+    string_map_insert(&map, 7, new std::string("foo"));
+    string_map_insert(&map, 2, new std::string("bar"));
+    string_map_delete_entry(&map, 7);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    string_map_debug(&map, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "string_map@" DC_PTR_REPLACE " {\n"
+        "  capacity: 16,\n"
+        "  tombstones: 1,\n"
+        "  count: 1,\n"
+        "  entries: [\n"
+        "    {key: 2, value: bar},\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+
+#define INDEX_BITS 32
+#define NAME sut
+#include <derive-c/container/partition/union_find/template.h>
+
+namespace {
+std::vector<sut_pair> random_pairs(size_t size, size_t count, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<sut_pair> pairs(count);
+    for (sut_pair& pair : pairs) {
+        pair.left = static_cast<uint32_t>(gen() % size);
+        pair.right = static_cast<uint32_t>(gen() % size);
+    }
+    return pairs;
+}
+
+// The depth of the tree of `index`, without compressing the path.
+size_t depth(sut const* union_find, uint32_t index) {
+    size_t result = 0;
+    while (union_find->parents[index] != index) {
+        index = union_find->parents[index];
+        result++;
+    }
+    return result;
+}
+} // namespace
+
+TEST(PartitionUnionFind, Singletons) {
+    DC_SCOPED(sut) union_find = sut_new(10, stdalloc_get_ref());
+    EXPECT_EQ(sut_size(&union_find), 10);
+    EXPECT_EQ(sut_sets(&union_find), 10);
+    for (uint32_t index = 0; index < 10; index++) {
+        EXPECT_EQ(sut_find(&union_find, index), index);
+    }
+    EXPECT_FALSE(sut_same(&union_find, 1, 2));
+}
+
+TEST(PartitionUnionFind, Unite) {
+    DC_SCOPED(sut) union_find = sut_new(6, stdalloc_get_ref());
+    EXPECT_TRUE(sut_unite(&union_find, 0, 1));
+    EXPECT_TRUE(sut_unite(&union_find, 2, 3));
+    EXPECT_TRUE(sut_unite(&union_find, 1, 3));
+    EXPECT_FALSE(sut_unite(&union_find, 0, 2));
+    EXPECT_FALSE(sut_unite(&union_find, 4, 4));
+    EXPECT_EQ(sut_sets(&union_find), 3);
+
+    EXPECT_TRUE(sut_same(&union_find, 0, 3));
+    EXPECT_FALSE(sut_same(&union_find, 0, 4));
+    EXPECT_FALSE(sut_same(&union_find, 4, 5));
+}
+
+TEST(PartitionUnionFind, MatchesReference) {
+    size_t const size = 2000;
+    std::vector<sut_pair> const pairs = random_pairs(size, 1500, 1);
+    DC_SCOPED(sut) union_find = sut_new(size, stdalloc_get_ref());
+
+    // Each index labelled by its set, relabelling a whole set on each union.
+    std::vector<size_t> labels(size);
+    for (size_t index = 0; index < size; index++) {
+        labels[index] = index;
+    }
+    size_t sets = size;
+    for (sut_pair const& pair : pairs) {
+        size_t const from = labels[pair.right];
+        size_t const to = labels[pair.left];
+        bool const merges = from != to;
+        if (merges) {
+            for (size_t& label : labels) {
+                label = label == from ? to : label;
+            }
+            sets--;
+        }
+        ASSERT_EQ(sut_unite(&union_find, pair.left, pair.right), merges);
+    }
+    EXPECT_EQ(sut_sets(&union_find), sets);
+
+    std::vector<uint32_t> roots(size);
+    sut_find_all(&union_find, roots.data());
+    for (sut_pair const& pair : random_pairs(size, 5000, 2)) {
+        ASSERT_EQ(roots[pair.left] == roots[pair.right], labels[pair.left] == labels[pair.right]);
+    }
+    for (uint32_t index = 0; index < size; index++) {
+        ASSERT_EQ(roots[index], sut_find(&union_find, index));
+        ASSERT_LE(depth(&union_find, index), 1);
+    }
+}
+
+TEST(PartitionUnionFind, UnionPairsMatchesUnite) {
+    size_t const size = 10000;
+    std::vector<sut_pair> const pairs = random_pairs(size, 7001, 3);
+    DC_SCOPED(sut) single = sut_new(size, stdalloc_get_ref());
+    DC_SCOPED(sut) bulk = sut_new(size, stdalloc_get_ref());
+
+    size_t merges = 0;
+    for (sut_pair const& pair : pairs) {
+        merges += sut_unite(&single, pair.left, pair.right) ? 1 : 0;
+    }
+    EXPECT_EQ(sut_union_pairs(&bulk, pairs.data(), pairs.size()), merges);
+    EXPECT_EQ(sut_sets(&bulk), size - merges);
+
+    std::vector<uint32_t> single_roots(size);
+    std::vector<uint32_t> bulk_roots(size);
+    sut_find_all(&single, single_roots.data());
+    sut_find_all(&bulk, bulk_roots.data());
+    EXPECT_EQ(single_roots, bulk_roots);
+}
+
+TEST(PartitionUnionFind, RankBoundsDepth) {
+    // Uniting each index with the last, which without union by rank builds a chain.
+    size_t const size = 1 << 12;
+    DC_SCOPED(sut) union_find = sut_new(size, stdalloc_get_ref());
+    for (uint32_t index = 1; index < size; index++) {
+        sut_unite(&union_find, index, index - 1);
+    }
+    EXPECT_EQ(sut_sets(&union_find), 1);
+    for (uint32_t index = 0; index < size; index++) {
+        ASSERT_LE(depth(&union_find, index), 12);
+    }
+
+    // Pairing sets of equal rank, the worst case for union by rank.
+    DC_SCOPED(sut) balanced = sut_new(size, stdalloc_get_ref());
+    for (uint32_t stride = 1; stride < size; stride *= 2) {
+        for (uint32_t index = 0; index < size; index += 2 * stride) {
+            sut_unite(&balanced, index + stride, index);
+        }
+    }
+    size_t deepest = 0;
+    for (uint32_t index = 0; index < size; index++) {
+        deepest = std::max(deepest, depth(&balanced, index));
+    }
+    EXPECT_LE(deepest, 12);
+}
+
+TEST(PartitionUnionFind, AddGrows) {
+    DC_SCOPED(sut) union_find = sut_new(0, stdalloc_get_ref());
+    for (uint32_t index = 0; index < 100; index++) {
+        EXPECT_EQ(sut_add(&union_find), index);
+        if (index % 2 == 1) {
+            sut_unite(&union_find, index, index - 1);
+        }
+    }
+    EXPECT_EQ(sut_size(&union_find), 100);
+    EXPECT_EQ(sut_sets(&union_find), 50);
+    EXPECT_TRUE(sut_same(&union_find, 98, 99));
+    EXPECT_FALSE(sut_same(&union_find, 97, 98));
+}
+
+TEST(PartitionUnionFind, CloneAndDebug) {
+    DC_SCOPED(sut) union_find = sut_new(4, stdalloc_get_ref());
+    sut_unite(&union_find, 0, 1);
+
+    DC_SCOPED(sut) cloned = sut_clone(&union_find);
+    sut_unite(&union_find, 2, 3);
+    EXPECT_TRUE(sut_same(&cloned, 0, 1));
+    EXPECT_FALSE(sut_same(&cloned, 2, 3));
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&cloned, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  size: 4,\n"
+        "  capacity: 4,\n"
+        "  sets: 3,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -0,0 +1,11 @@
+#include <derive-c/alloc/std.h>
+
+#define INDEX_BITS 32
+#define NAME expand_1
+#include <derive-c/container/partition/union_find/template.h>
+
+#define INDEX_BITS 8
+#define NAME expand_2
+#include <derive-c/container/partition/union_find/template.h>
+
+int main() {}
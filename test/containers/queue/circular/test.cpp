@@ -75,3 +75,41 @@ TEST(DequeTests, Debug) {
             derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
     }
 }
+
+#define ITEM int
+#define NAME int_queue
+#include <derive-c/container/queue/circular/template.h>
+
+namespace {
+bool not_multiple_of_three(int const* item, void* /* ctx */) { return *item % 3 != 0; }
+} // namespace
+
+TEST(CircularTests, RetainWrapped) {
+    DC_SCOPED(int_queue) q = int_queue_new_with_capacity_for(8, stdalloc_get_ref());
+
+    // Wrap the queue around the end of its buffer
+    for (int i = 0; i < 6; i++) {
+        int_queue_push_back(&q, -1);
+    }
+    for (int i = 0; i < 6; i++) {
+        int_queue_pop_front(&q);
+    }
+    for (int i = 0; i < 8; i++) {
+        int_queue_push_back(&q, i);
+    }
+
+    ASSERT_EQ(int_queue_retain(&q, not_multiple_of_three, nullptr), 3);
+    ASSERT_EQ(int_queue_size(&q), 5);
+    for (int expected : {1, 2, 4, 5, 7}) {
+        ASSERT_EQ(int_queue_pop_front(&q), expected);
+    }
+    ASSERT_TRUE(int_queue_empty(&q));
+
+    int_queue_push_back(&q, 3);
+    int_queue_push_back(&q, 6);
+    ASSERT_EQ(int_queue_retain(&q, not_multiple_of_three, nullptr), 2);
+    ASSERT_TRUE(int_queue_empty(&q));
+
+    int_queue_push_front(&q, 10);
+    ASSERT_EQ(int_queue_pop_back(&q), 10);
+}
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/utils/debug/string.h>
+
+#define ITEM uint32_t
+#define ARITY 2
+#define NAME binary_heap
+#include <derive-c/container/queue/heap/template.h>
+
+#define ITEM uint32_t
+#define ARITY 4
+#define NAME quad_heap
+#include <derive-c/container/queue/heap/template.h>
+
+#define ITEM uint32_t
+#define ARITY 8
+#define NAME oct_heap
+#include <derive-c/container/queue/heap/template.h>
+
+#define ITEM uint32_t
+#define ITEM_ORD DC_MEM_GT
+#define NAME max_heap
+#include <derive-c/container/queue/heap/template.h>
+
+#define ITEM uint32_t
+#define INDEXED
+#define NAME indexed_heap
+#include <derive-c/container/queue/heap/template.h>
+
+namespace {
+template <typename Heap, typename Push, typename Pop, typename Size>
+void check_sorted_drain(Heap* heap, Push push, Pop pop, Size size) {
+    std::mt19937 gen(1234);
+    std::vector<uint32_t> expected;
+    for (size_t i = 0; i < 1000; i++) {
+        uint32_t const value = gen() % 500;
+        expected.push_back(value);
+        push(heap, value);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    ASSERT_EQ(size(heap), expected.size());
+    for (uint32_t value : expected) {
+        ASSERT_EQ(pop(heap), value);
+    }
+    ASSERT_EQ(size(heap), 0);
+}
+} // namespace
+
+TEST(HeapTests, PushPopBinary) {
+    DC_SCOPED(binary_heap) heap = binary_heap_new(stdalloc_get_ref());
+    check_sorted_drain(&heap, binary_heap_push, binary_heap_pop, binary_heap_size);
+}
+
+TEST(HeapTests, PushPopQuad) {
+    DC_SCOPED(quad_heap) heap = quad_heap_new(stdalloc_get_ref());
+    check_sorted_drain(&heap, quad_heap_push, quad_heap_pop, quad_heap_size);
+}
+
+TEST(HeapTests, PushPopOct) {
+    DC_SCOPED(oct_heap) heap = oct_heap_new(stdalloc_get_ref());
+    check_sorted_drain(&heap, oct_heap_push, oct_heap_pop, oct_heap_size);
+}
+
+TEST(HeapTests, EmptyPeekAndPop) {
+    DC_SCOPED(quad_heap) heap = quad_heap_new(stdalloc_get_ref());
+    ASSERT_TRUE(quad_heap_empty(&heap));
+    ASSERT_EQ(quad_heap_try_peek(&heap), nullptr);
+
+    uint32_t value = 0;
+    ASSERT_FALSE(quad_heap_try_pop(&heap, &value));
+
+    quad_heap_push(&heap, 3);
+    quad_heap_push(&heap, 1);
+    quad_heap_push(&heap, 2);
+    ASSERT_EQ(*quad_heap_peek(&heap), 1);
+    ASSERT_TRUE(quad_heap_try_pop(&heap, &value));
+    ASSERT_EQ(value, 1);
+    ASSERT_EQ(*quad_heap_peek(&heap), 2);
+}
+
+TEST(HeapTests, MaxHeapOrd) {
+    DC_SCOPED(max_heap) heap = max_heap_new(stdalloc_get_ref());
+    for (uint32_t i = 0; i < 100; i++) {
+        max_heap_push(&heap, (i * 37) % 100);
+    }
+    for (uint32_t i = 100; i > 0; i--) {
+        ASSERT_EQ(max_heap_pop(&heap), i - 1);
+    }
+}
+
+TEST(HeapTests, FromVector) {
+    quad_heap_entry_vector items = quad_heap_entry_vector_new(stdalloc_get_ref());
+    for (uint32_t i = 0; i < 257; i++) {
+        quad_heap_entry_vector_push(&items, (i * 101) % 257);
+    }
+
+    DC_SCOPED(quad_heap) heap = quad_heap_from_vector(items);
+    ASSERT_EQ(quad_heap_size(&heap), 257);
+    for (uint32_t i = 0; i < 257; i++) {
+        ASSERT_EQ(quad_heap_pop(&heap), i);
+    }
+}
+
+TEST(HeapTests, CloneIsIndependent) {
+    DC_SCOPED(quad_heap) heap = quad_heap_new(stdalloc_get_ref());
+    quad_heap_push(&heap, 5);
+    quad_heap_push(&heap, 4);
+
+    DC_SCOPED(quad_heap) clone = quad_heap_clone(&heap);
+    ASSERT_EQ(quad_heap_pop(&heap), 4);
+    ASSERT_EQ(quad_heap_size(&clone), 2);
+    ASSERT_EQ(*quad_heap_peek(&clone), 4);
+}
+
+TEST(HeapTests, IndexedDecreaseKey) {
+    DC_SCOPED(indexed_heap) heap = indexed_heap_new(stdalloc_get_ref());
+    indexed_heap_handle_t a = indexed_heap_push(&heap, 10);
+    indexed_heap_handle_t b = indexed_heap_push(&heap, 20);
+    indexed_heap_handle_t c = indexed_heap_push(&heap, 30);
+
+    indexed_heap_decrease_key(&heap, c, 5);
+    ASSERT_EQ(*indexed_heap_peek(&heap), 5);
+    ASSERT_EQ(*indexed_heap_read(&heap, c), 5);
+
+    indexed_heap_update(&heap, c, 25);
+    ASSERT_EQ(*indexed_heap_peek(&heap), 10);
+
+    ASSERT_EQ(indexed_heap_remove(&heap, a), 10);
+    ASSERT_FALSE(indexed_heap_contains(&heap, a));
+    ASSERT_TRUE(indexed_heap_contains(&heap, b));
+
+    ASSERT_EQ(indexed_heap_pop(&heap), 20);
+    ASSERT_EQ(indexed_heap_pop(&heap), 25);
+    ASSERT_TRUE(indexed_heap_empty(&heap));
+}
+
+TEST(HeapTests, IndexedRandomAgainstModel) {
+    DC_SCOPED(indexed_heap) heap = indexed_heap_new(stdalloc_get_ref());
+    std::map<uint32_t, uint32_t> model; // handle -> value
+    std::vector<indexed_heap_handle_t> handles;
+    std::mt19937 gen(1234);
+
+    for (size_t step = 0; step < 5000; step++) {
+        switch (gen() % 4) {
+        case 0:
+        case 1: {
+            uint32_t const value = gen() % 1000;
+            indexed_heap_handle_t handle = indexed_heap_push(&heap, value);
+            model[handle.index] = value;
+            handles.push_back(handle);
+            break;
+        }
+        case 2: {
+            if (handles.empty()) {
+                break;
+            }
+            indexed_heap_handle_t handle = handles[gen() % handles.size()];
+            if (!indexed_heap_contains(&heap, handle)) {
+                break;
+            }
+            uint32_t const value = gen() % 1000;
+            indexed_heap_update(&heap, handle, value);
+            model[handle.index] = value;
+            break;
+        }
+        default: {
+            if (model.empty()) {
+                break;
+            }
+            uint32_t const popped = indexed_heap_pop(&heap);
+            auto min = std::min_element(model.begin(), model.end(), [](auto const& l, auto const& r) {
+                return l.second < r.second;
+            });
+            ASSERT_EQ(popped, min->second);
+            // Another handle with an equal value may have been popped instead.
+            for (auto it = model.begin(); it != model.end(); ++it) {
+                if (it->second == popped &&
+                    !indexed_heap_contains(&heap, indexed_heap_handle_t{.index = it->first})) {
+                    model.erase(it);
+                    break;
+                }
+            }
+        }
+        }
+        ASSERT_EQ(indexed_heap_size(&heap), model.size());
+    }
+
+    for (auto const& [handle, value] : model) {
+        ASSERT_EQ(*indexed_heap_read(&heap, indexed_heap_handle_t{.index = handle}), value);
+    }
+}
+
+TEST(HeapTests, Debug) {
+    DC_SCOPED(binary_heap) heap = binary_heap_new(stdalloc_get_ref());
+    binary_heap_push(&heap, 3);
+    binary_heap_push(&heap, 1);
+    binary_heap_push(&heap, 2);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    binary_heap_debug(&heap, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+
+    EXPECT_EQ(
+        // clang-format off
+        "binary_heap@" DC_PTR_REPLACE " {\n"
+        "  arity: 2,\n"
+        "  entries: binary_heap_entry_vector@" DC_PTR_REPLACE " {\n"
+        "    size: 3,\n"
+        "    capacity: 8,\n"
+        "    alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "    items: @" DC_PTR_REPLACE " [\n"
+        "      1,\n"
+        "      3,\n"
+        "      2,\n"
+        "    ],\n"
+        "  },\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -0,0 +1,18 @@
+#include <stdint.h>
+
+#define ITEM int
+#define NAME expand_1
+#include <derive-c/container/queue/heap/template.h>
+
+#define ITEM float
+#define ARITY 2
+#define NAME expand_2
+#include <derive-c/container/queue/heap/template.h>
+
+#define ITEM uint64_t
+#define ARITY 8
+#define INDEXED
+#define NAME expand_3
+#include <derive-c/container/queue/heap/template.h>
+
+int main() {}
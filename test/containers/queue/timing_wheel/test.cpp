@@ -0,0 +1,187 @@
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/utils/debug/string.h>
+
+#define ITEM uint32_t
+#define NAME wheel
+#include <derive-c/container/queue/timing_wheel/template.h>
+
+// A small wheel (4 slots, 3 levels) so that cascading and clamping are exercised.
+#define ITEM uint32_t
+#define LEVEL_BITS 2
+#define LEVELS 3
+#define NAME small_wheel
+#include <derive-c/container/queue/timing_wheel/template.h>
+
+namespace {
+std::set<uint32_t> drain(small_wheel* wheel) {
+    std::set<uint32_t> popped;
+    uint32_t item = 0;
+    while (small_wheel_try_pop_expired(wheel, &item)) {
+        popped.insert(item);
+    }
+    return popped;
+}
+} // namespace
+
+TEST(TimingWheelTests, ExpiresInOrder) {
+    DC_SCOPED(wheel) timers = wheel_new(stdalloc_get_ref());
+    wheel_schedule(&timers, 3, 30);
+    wheel_schedule(&timers, 1, 10);
+    wheel_schedule(&timers, 2, 20);
+    ASSERT_EQ(wheel_pending(&timers), 3);
+
+    uint32_t item = 0;
+    ASSERT_FALSE(wheel_try_pop_expired(&timers, &item));
+
+    for (uint32_t tick = 1; tick <= 3; tick++) {
+        ASSERT_EQ(wheel_advance(&timers, 1), 1);
+        ASSERT_EQ(wheel_pop_expired(&timers), tick * 10);
+        ASSERT_FALSE(wheel_try_pop_expired(&timers, &item));
+    }
+    ASSERT_EQ(wheel_size(&timers), 0);
+    ASSERT_EQ(wheel_now(&timers), 3);
+}
+
+TEST(TimingWheelTests, ZeroDelayExpiresImmediately) {
+    DC_SCOPED(wheel) timers = wheel_new(stdalloc_get_ref());
+    wheel_schedule(&timers, 0, 7);
+    ASSERT_EQ(wheel_expired(&timers), 1);
+    ASSERT_EQ(wheel_pending(&timers), 0);
+    ASSERT_EQ(wheel_pop_expired(&timers), 7);
+}
+
+TEST(TimingWheelTests, CancelPendingAndExpired) {
+    DC_SCOPED(wheel) timers = wheel_new(stdalloc_get_ref());
+    wheel_handle_t a = wheel_schedule(&timers, 5, 1);
+    wheel_handle_t b = wheel_schedule(&timers, 5, 2);
+    wheel_handle_t c = wheel_schedule(&timers, 500, 3);
+
+    ASSERT_EQ(wheel_cancel(&timers, c), 3);
+    ASSERT_FALSE(wheel_contains(&timers, c));
+
+    ASSERT_EQ(wheel_advance(&timers, 10), 2);
+    ASSERT_EQ(wheel_cancel(&timers, a), 1);
+    ASSERT_EQ(wheel_pop_expired(&timers), 2);
+
+    uint32_t item = 0;
+    ASSERT_FALSE(wheel_try_cancel(&timers, b, &item));
+    ASSERT_EQ(wheel_size(&timers), 0);
+}
+
+TEST(TimingWheelTests, StaleHandleAfterReuse) {
+    DC_SCOPED(wheel) timers = wheel_new(stdalloc_get_ref());
+    wheel_handle_t old = wheel_schedule(&timers, 1, 1);
+    ASSERT_EQ(wheel_cancel(&timers, old), 1);
+
+    wheel_handle_t reused = wheel_schedule(&timers, 1, 2);
+    ASSERT_EQ(reused.index, old.index);
+    ASSERT_FALSE(wheel_contains(&timers, old));
+    ASSERT_EQ(wheel_try_read(&timers, old), nullptr);
+    ASSERT_EQ(*wheel_read(&timers, reused), 2);
+}
+
+TEST(TimingWheelTests, BeyondRangeIsClamped) {
+    DC_SCOPED(small_wheel) timers = small_wheel_new(stdalloc_get_ref());
+    ASSERT_EQ(small_wheel_max_delay, 63);
+
+    small_wheel_schedule(&timers, 200, 1);
+    ASSERT_EQ(small_wheel_advance(&timers, 199), 0);
+    ASSERT_EQ(small_wheel_advance(&timers, 1), 1);
+    ASSERT_EQ(small_wheel_pop_expired(&timers), 1);
+}
+
+TEST(TimingWheelTests, RandomAgainstModel) {
+    DC_SCOPED(small_wheel) timers = small_wheel_new(stdalloc_get_ref());
+    std::map<uint32_t, std::pair<uint64_t, small_wheel_handle_t>> model; // item -> (expiry, handle)
+    std::mt19937 gen(1234);
+    uint32_t next_item = 0;
+
+    for (size_t step = 0; step < 20000; step++) {
+        switch (gen() % 5) {
+        case 0:
+        case 1: {
+            uint64_t const delay = 1 + (gen() % 150);
+            uint32_t const item = next_item++;
+            small_wheel_handle_t handle = small_wheel_schedule(&timers, delay, item);
+            model[item] = {small_wheel_now(&timers) + delay, handle};
+            break;
+        }
+        case 2: {
+            if (model.empty()) {
+                break;
+            }
+            auto it = std::next(model.begin(), static_cast<long>(gen() % model.size()));
+            ASSERT_EQ(small_wheel_cancel(&timers, it->second.second), it->first);
+            model.erase(it);
+            break;
+        }
+        default: {
+            small_wheel_advance(&timers, 1);
+            uint64_t const now = small_wheel_now(&timers);
+
+            std::set<uint32_t> expected;
+            for (auto it = model.begin(); it != model.end();) {
+                ASSERT_GE(it->second.first, now);
+                if (it->second.first == now) {
+                    expected.insert(it->first);
+                    it = model.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            ASSERT_EQ(drain(&timers), expected);
+        }
+        }
+        ASSERT_EQ(small_wheel_size(&timers), model.size());
+    }
+}
+
+TEST(TimingWheelTests, CloneIsIndependent) {
+    DC_SCOPED(wheel) timers = wheel_new(stdalloc_get_ref());
+    wheel_schedule(&timers, 2, 1);
+    wheel_handle_t b = wheel_schedule(&timers, 4, 2);
+
+    DC_SCOPED(wheel) clone = wheel_clone(&timers);
+    ASSERT_EQ(wheel_cancel(&timers, b), 2);
+
+    ASSERT_EQ(wheel_advance(&clone, 4), 2);
+    ASSERT_EQ(wheel_pop_expired(&clone), 1);
+    ASSERT_EQ(wheel_pop_expired(&clone), 2);
+}
+
+TEST(TimingWheelTests, Debug) {
+    DC_SCOPED(small_wheel) timers = small_wheel_new(stdalloc_get_ref());
+    small_wheel_schedule(&timers, 5, 1);
+    small_wheel_handle_t b = small_wheel_schedule(&timers, 9, 2);
+    small_wheel_schedule(&timers, 0, 3);
+    small_wheel_cancel(&timers, b);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    small_wheel_debug(&timers, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+
+    EXPECT_EQ(
+        // clang-format off
+        "small_wheel@" DC_PTR_REPLACE " {\n"
+        "  now: 0,\n"
+        "  levels: 3,\n"
+        "  slots_per_level: 4,\n"
+        "  pending: 1,\n"
+        "  expired: 1,\n"
+        "  timers: [\n"
+        "    { handle: small_wheel_handle_t { index: 0, generation: 0 }, expiry: 5, item: 1 },\n"
+        "    { handle: small_wheel_handle_t { index: 2, generation: 0 }, expiry: 0, item: 3 },\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
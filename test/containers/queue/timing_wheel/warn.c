@@ -0,0 +1,13 @@
+#include <stdint.h>
+
+#define ITEM int
+#define NAME expand_1
+#include <derive-c/container/queue/timing_wheel/template.h>
+
+#define ITEM uint64_t
+#define LEVEL_BITS 8
+#define LEVELS 3
+#define NAME expand_2
+#include <derive-c/container/queue/timing_wheel/template.h>
+
+int main() {}
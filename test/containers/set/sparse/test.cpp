@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/for.h>
+#include <derive-c/utils/debug/string.h>
+
+#define INDEX_BITS 16
+#define NAME id_set
+#include <derive-c/container/set/sparse/template.h>
+
+TEST(SparseSet, AddRemoveClear) {
+    DC_SCOPED(id_set) set = id_set_new_with_universe(1000, stdalloc_get_ref());
+    for (uint16_t id = 0; id < 1000; id += 7) {
+        id_set_add(&set, id);
+    }
+    EXPECT_FALSE(id_set_try_add(&set, 7));
+    EXPECT_EQ(id_set_size(&set), 143);
+
+    id_set_remove(&set, 14);
+    EXPECT_FALSE(id_set_try_remove(&set, 14));
+    for (uint16_t id = 0; id < 1000; id++) {
+        ASSERT_EQ(id_set_contains(&set, id), id % 7 == 0 && id != 14);
+    }
+
+    id_set_clear(&set);
+    EXPECT_EQ(id_set_size(&set), 0);
+    for (uint16_t id = 0; id < 1000; id++) {
+        ASSERT_FALSE(id_set_contains(&set, id));
+    }
+}
+
+TEST(SparseSet, IteratesLiveItems) {
+    DC_SCOPED(id_set) set = id_set_new_with_universe(64, stdalloc_get_ref());
+    for (uint16_t round = 0; round < 4; round++) {
+        std::set<uint16_t> expected;
+        for (uint16_t id = round; id < 64; id += 5) {
+            id_set_add(&set, id);
+            expected.insert(id);
+        }
+        id_set_remove(&set, round);
+        expected.erase(round);
+
+        std::set<uint16_t> iterated;
+        DC_FOR_CONST(id_set, &set, iter, item) { ASSERT_TRUE(iterated.insert(*item).second); }
+        ASSERT_EQ(iterated, expected);
+        id_set_clear(&set);
+    }
+}
+
+TEST(SparseSet, Debug) {
+    DC_SCOPED(id_set) set = id_set_new_with_universe(4, stdalloc_get_ref());
+    id_set_add(&set, 3);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    id_set_debug(&set, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "id_set@" DC_PTR_REPLACE " {\n"
+        "  map: __private_id_set_inner_map@" DC_PTR_REPLACE " {\n"
+        "    universe: 4,\n"
+        "    size: 1,\n"
+        "    capacity: 4,\n"
+        "    alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "    entries: [\n"
+        "      {key: 3, value: [UNIT]},\n"
+        "    ],\n"
+        "  },\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -0,0 +1,16 @@
+#include <derive-c/prelude.h>
+
+#define INDEX_BITS 8
+#define NAME expand_1
+#include <derive-c/container/set/sparse/template.h>
+
+#define INDEX_BITS 16
+#define NAME expand_2
+#include <derive-c/container/set/sparse/template.h>
+
+#define INDEX_BITS 32
+#define GROWTH_POLICY dc_growth_double
+#define NAME expand_3
+#include <derive-c/container/set/sparse/template.h>
+
+int main() {}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define NAME sut
+#include <derive-c/container/sketch/count_min/template.h>
+
+namespace {
+// Item `i` is added `10000 / (i + 1)` times, so a few items dominate the total.
+std::vector<uint64_t> skewed_counts(size_t items) {
+    std::vector<uint64_t> counts(items);
+    for (size_t i = 0; i < items; i++) {
+        counts[i] = 10000 / (i + 1) + 1;
+    }
+    return counts;
+}
+} // namespace
+
+TEST(SketchCountMin, NewFor) {
+    DC_SCOPED(sut) sketch = sut_new_for(0.001, 0.01, stdalloc_get_ref());
+    EXPECT_EQ(sketch.width, 2719);
+    EXPECT_EQ(sketch.depth, 5);
+
+    DC_SCOPED(sut) coarse = sut_new_for(0.5, 0.5, stdalloc_get_ref());
+    EXPECT_EQ(coarse.width, 6);
+    EXPECT_EQ(coarse.depth, 1);
+}
+
+TEST(SketchCountMin, NewForDepthCap) {
+    // ceil(ln(1 / delta)) rows, up to e^-16 (about 1.125e-7)
+    DC_SCOPED(sut) below_cap = sut_new_for(0.5, 5e-7, stdalloc_get_ref());
+    EXPECT_EQ(below_cap.depth, 15);
+
+    DC_SCOPED(sut) at_cap = sut_new_for(0.5, 1.2e-7, stdalloc_get_ref());
+    EXPECT_EQ(at_cap.depth, DC_COUNT_MIN_MAX_DEPTH);
+
+    // Beyond it, the depth is capped rather than failing
+    DC_SCOPED(sut) beyond_cap = sut_new_for(0.5, 1e-7, stdalloc_get_ref());
+    EXPECT_EQ(beyond_cap.depth, DC_COUNT_MIN_MAX_DEPTH);
+
+    DC_SCOPED(sut) far_beyond_cap = sut_new_for(0.5, 1e-300, stdalloc_get_ref());
+    EXPECT_EQ(far_beyond_cap.depth, DC_COUNT_MIN_MAX_DEPTH);
+}
+
+TEST(SketchCountMin, ExactWithoutCollisions) {
+    DC_SCOPED(sut) sketch = sut_new_with_dimensions(1 << 16, 4, stdalloc_get_ref());
+    sut_add(&sketch, 1);
+    sut_add(&sketch, 1);
+    sut_add_count(&sketch, 2, 40);
+    EXPECT_EQ(sut_estimate(&sketch, 1), 2);
+    EXPECT_EQ(sut_estimate(&sketch, 2), 40);
+    EXPECT_EQ(sut_estimate(&sketch, 3), 0);
+    EXPECT_EQ(sut_total(&sketch), 42);
+}
+
+TEST(SketchCountMin, ConservativeUpdate) {
+    // With a single column every item shares counters, and conservative update still counts the
+    // total, rather than each row receiving every add.
+    DC_SCOPED(sut) sketch = sut_new_with_dimensions(1, 3, stdalloc_get_ref());
+    sut_add_count(&sketch, 1, 3);
+    sut_add_count(&sketch, 2, 4);
+    EXPECT_EQ(sut_estimate(&sketch, 1), 7);
+    EXPECT_EQ(sut_estimate(&sketch, 2), 7);
+
+    // With collisions, an add only raises the item's counters that are below its new estimate,
+    // leaving the others unchanged.
+    DC_SCOPED(sut) colliding = sut_new_with_dimensions(4, 8, stdalloc_get_ref());
+    for (uint64_t item = 0; item < 16; item++) {
+        sut_add_count(&colliding, item, item + 1);
+    }
+    std::vector<uint64_t*> counters;
+    for (size_t row = 0; row < 8; row++) {
+        counters.push_back(
+            &colliding.counters[(row * 4) + dc_count_min_column(dc_sketch_mix(16), row, 4)]);
+    }
+    std::vector<uint64_t> before;
+    for (uint64_t* counter : counters) {
+        before.push_back(*counter);
+    }
+    uint64_t const updated = sut_estimate(&colliding, 16) + 5;
+
+    sut_add_count(&colliding, 16, 5);
+    EXPECT_EQ(sut_estimate(&colliding, 16), updated);
+    for (size_t row = 0; row < 8; row++) {
+        EXPECT_EQ(*counters[row], std::max(before[row], updated));
+    }
+}
+
+TEST(SketchCountMin, ErrorBound) {
+    std::vector<uint64_t> const counts = skewed_counts(20000);
+    DC_SCOPED(sut) sketch = sut_new_for(0.001, 0.01, stdalloc_get_ref());
+    for (size_t i = 0; i < counts.size(); i++) {
+        sut_add_count(&sketch, i, counts[i]);
+    }
+
+    double const bound = sut_error_bound(&sketch);
+    EXPECT_NEAR(bound, 0.001 * static_cast<double>(sut_total(&sketch)),
+                0.00001 * static_cast<double>(sut_total(&sketch)));
+
+    size_t exceeding = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        uint64_t const estimate = sut_estimate(&sketch, i);
+        ASSERT_GE(estimate, counts[i]);
+        exceeding += static_cast<double>(estimate - counts[i]) > bound ? 1 : 0;
+    }
+    EXPECT_LE(exceeding, counts.size() / 100);
+}
+
+TEST(SketchCountMin, MergeSumsCounts) {
+    std::vector<uint64_t> const counts = skewed_counts(5000);
+    DC_SCOPED(sut) left = sut_new_for(0.001, 0.01, stdalloc_get_ref());
+    DC_SCOPED(sut) right = sut_new_for(0.001, 0.01, stdalloc_get_ref());
+    for (size_t i = 0; i < counts.size(); i++) {
+        sut_add_count(i % 2 == 0 ? &left : &right, i, counts[i]);
+        sut_add_count(&right, i, 1);
+    }
+
+    uint64_t const total = sut_total(&left) + sut_total(&right);
+    sut_merge(&left, &right);
+    EXPECT_EQ(sut_total(&left), total);
+    for (size_t i = 0; i < counts.size(); i++) {
+        ASSERT_GE(sut_estimate(&left, i), counts[i] + 1);
+    }
+}
+
+TEST(SketchCountMin, CloneAndDebug) {
+    DC_SCOPED(sut) sketch = sut_new_with_dimensions(16, 2, stdalloc_get_ref());
+    sut_add_count(&sketch, 42, 3);
+    EXPECT_EQ(sut_capacity_bytes(&sketch), 16 * 2 * 8);
+
+    DC_SCOPED(sut) cloned = sut_clone(&sketch);
+    sut_add(&sketch, 42);
+    EXPECT_EQ(sut_estimate(&cloned, 42), 3);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&cloned, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  width: 16,\n"
+        "  depth: 2,\n"
+        "  total: 3,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -0,0 +1,9 @@
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+
+#define ITEM uint32_t
+#define ITEM_HASH uint32_t_hash_id
+#define NAME expand_1
+#include <derive-c/container/sketch/count_min/template.h>
+
+int main() {}
@@ -0,0 +1,156 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+#include <derive-c/utils/debug/string.h>
+
+#define ITEM uint64_t
+#define ITEM_HASH uint64_t_hash_id
+#define PRECISION 12
+#define NAME sut
+#include <derive-c/container/sketch/hyperloglog/template.h>
+
+namespace {
+std::vector<uint64_t> distinct_items(size_t count, uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<uint64_t> items(count);
+    for (uint64_t& item : items) {
+        item = gen();
+    }
+    return items;
+}
+
+double relative_error(double estimate, size_t actual) {
+    return std::abs(estimate - static_cast<double>(actual)) / static_cast<double>(actual);
+}
+
+// The standard error for 2^12 registers.
+double const standard_error = 1.04 / 64.0;
+} // namespace
+
+TEST(SketchHyperLogLog, Empty) {
+    DC_SCOPED(sut) sketch = sut_new(stdalloc_get_ref());
+    EXPECT_TRUE(sut_is_sparse(&sketch));
+    EXPECT_EQ(sut_estimate(&sketch), 0.0);
+}
+
+TEST(SketchHyperLogLog, SparseNearExact) {
+    DC_SCOPED(sut) sketch = sut_new(stdalloc_get_ref());
+    for (uint64_t item = 0; item < 500; item++) {
+        sut_add(&sketch, item);
+        sut_add(&sketch, item);
+    }
+    EXPECT_TRUE(sut_is_sparse(&sketch));
+    EXPECT_NEAR(sut_estimate(&sketch), 500.0, 1.0);
+    EXPECT_LE(sut_capacity_bytes(&sketch), 4096);
+}
+
+TEST(SketchHyperLogLog, SparseToDense) {
+    DC_SCOPED(sut) sketch = sut_new(stdalloc_get_ref());
+    uint64_t item = 0;
+    while (sut_is_sparse(&sketch)) {
+        sut_add(&sketch, item++);
+    }
+    // At most an eighth of the registers' memory in entries of 4 bytes.
+    EXPECT_GT(item, 4096 / 16);
+    EXPECT_LE(item, 4096 / 8 + 1);
+    EXPECT_EQ(sut_capacity_bytes(&sketch), 4096);
+    EXPECT_LT(relative_error(sut_estimate(&sketch), item), 3 * standard_error);
+}
+
+TEST(SketchHyperLogLog, ErrorBound) {
+    for (size_t const count : {100, 1000, 10000, 100000, 1000000}) {
+        std::vector<uint64_t> const items = distinct_items(count, count);
+        DC_SCOPED(sut) sketch = sut_new(stdalloc_get_ref());
+        for (uint64_t item : items) {
+            sut_add(&sketch, item);
+        }
+        EXPECT_LT(relative_error(sut_estimate(&sketch), count), 4 * standard_error)
+            << "count " << count;
+    }
+}
+
+TEST(SketchHyperLogLog, MeanErrorMatchesStandardError) {
+    size_t const runs = 50;
+    size_t const count = 20000;
+    double squared_error = 0.0;
+    for (size_t run = 0; run < runs; run++) {
+        DC_SCOPED(sut) sketch = sut_new(stdalloc_get_ref());
+        for (uint64_t item : distinct_items(count, 1000 + run)) {
+            sut_add(&sketch, item);
+        }
+        double const error = relative_error(sut_estimate(&sketch), count);
+        squared_error += error * error;
+    }
+    EXPECT_LT(std::sqrt(squared_error / runs), 1.3 * standard_error);
+}
+
+TEST(SketchHyperLogLog, SequentialItems) {
+    DC_SCOPED(sut) sketch = sut_new(stdalloc_get_ref());
+    for (uint64_t item = 0; item < 100000; item++) {
+        sut_add(&sketch, item);
+    }
+    EXPECT_LT(relative_error(sut_estimate(&sketch), 100000), 4 * standard_error);
+}
+
+TEST(SketchHyperLogLog, MergeMatchesUnion) {
+    // Sparse with sparse, sparse with dense, and dense with dense.
+    for (auto const [left_count, right_count] :
+         {std::pair{100, 200}, std::pair{300, 300}, std::pair{100, 5000}, std::pair{5000, 100},
+          std::pair{5000, 8000}}) {
+        std::vector<uint64_t> const left_items = distinct_items(left_count, 1);
+        std::vector<uint64_t> const right_items = distinct_items(right_count, 2);
+
+        DC_SCOPED(sut) left = sut_new(stdalloc_get_ref());
+        DC_SCOPED(sut) right = sut_new(stdalloc_get_ref());
+        DC_SCOPED(sut) both = sut_new(stdalloc_get_ref());
+        for (uint64_t item : left_items) {
+            sut_add(&left, item);
+            sut_add(&both, item);
+        }
+        for (uint64_t item : right_items) {
+            sut_add(&right, item);
+            sut_add(&both, item);
+        }
+
+        sut_merge(&left, &right);
+        EXPECT_EQ(sut_is_sparse(&left), sut_is_sparse(&both));
+        EXPECT_DOUBLE_EQ(sut_estimate(&left), sut_estimate(&both))
+            << "left " << left_count << " right " << right_count;
+    }
+}
+
+TEST(SketchHyperLogLog, CloneAndDebug) {
+    DC_SCOPED(sut) sketch = sut_new(stdalloc_get_ref());
+    sut_add(&sketch, 42);
+
+    DC_SCOPED(sut) cloned = sut_clone(&sketch);
+    for (uint64_t item = 0; item < 1000; item++) {
+        sut_add(&sketch, item);
+    }
+    EXPECT_NEAR(sut_estimate(&cloned), 1.0, 0.01);
+
+    DC_SCOPED(sut) dense = sut_clone(&sketch);
+    EXPECT_FALSE(sut_is_sparse(&dense));
+    EXPECT_DOUBLE_EQ(sut_estimate(&dense), sut_estimate(&sketch));
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    sut_debug(&cloned, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ(
+        // clang-format off
+        "sut@" DC_PTR_REPLACE " {\n"
+        "  precision: 12,\n"
+        "  sparse: 1 entries,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
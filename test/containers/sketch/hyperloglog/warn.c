@@ -0,0 +1,10 @@
+#include <derive-c/algorithm/hash/default.h>
+#include <derive-c/alloc/std.h>
+
+#define ITEM uint32_t
+#define ITEM_HASH uint32_t_hash_id
+#define PRECISION 12
+#define NAME expand_1
+#include <derive-c/container/sketch/hyperloglog/template.h>
+
+int main() {}
@@ -1,3 +1,4 @@
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -45,6 +46,175 @@ TEST(VectorTests, CreateWithCapacity2) {
     sut_delete(&sut);
 }
 
+TEST(VectorTests, Extend) {
+    DC_SCOPED(sut) sut = sut_new(stdalloc_get_ref());
+    sut_push(&sut, 0);
+
+    size_t const items[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    size_t* first = sut_extend(&sut, items, 10);
+    ASSERT_EQ(first, sut_write(&sut, 1));
+    ASSERT_EQ(sut_size(&sut), 11);
+    for (size_t i = 0; i < 11; i++) {
+        ASSERT_EQ(*sut_read(&sut, i), i);
+    }
+
+    ASSERT_EQ(sut_extend(&sut, items, 0), nullptr);
+    ASSERT_EQ(sut_size(&sut), 11);
+}
+
+TEST(VectorTests, ExtendFromSelf) {
+    DC_SCOPED(sut) sut = sut_new_with_capacity(4, stdalloc_get_ref());
+    for (size_t i = 0; i < 4; i++) {
+        sut_push(&sut, i);
+    }
+    ASSERT_EQ(sut_size(&sut), sut.capacity);
+
+    // Full, so extending reallocates the data being copied from
+    sut_extend(&sut, sut_data(&sut), sut_size(&sut));
+    ASSERT_EQ(sut_size(&sut), 8);
+    for (size_t i = 0; i < 8; i++) {
+        ASSERT_EQ(*sut_read(&sut, i), i % 4);
+    }
+
+    // From the middle of the vector
+    sut_extend(&sut, sut_read(&sut, 2), 6);
+    ASSERT_EQ(sut_size(&sut), 14);
+    for (size_t i = 8; i < 14; i++) {
+        ASSERT_EQ(*sut_read(&sut, i), (i - 6) % 4);
+    }
+}
+
+TEST(VectorTests, ResizeUninit) {
+    DC_SCOPED(sut) sut = sut_new(stdalloc_get_ref());
+    sut_push(&sut, 0);
+
+    size_t* fill = sut_resize_uninit(&sut, 100);
+    ASSERT_NE(fill, nullptr);
+    for (size_t i = 0; i < 99; i++) {
+        fill[i] = i + 1;
+    }
+    ASSERT_EQ(sut_size(&sut), 100);
+    for (size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(*sut_read(&sut, i), i);
+    }
+
+    ASSERT_EQ(sut_resize_uninit(&sut, 10), nullptr);
+    ASSERT_EQ(sut_size(&sut), 10);
+    ASSERT_EQ(sut_try_read(&sut, 10), nullptr);
+}
+
+namespace {
+size_t square_plus(size_t index, void* ctx) { return (index * index) + *static_cast<size_t*>(ctx); }
+} // namespace
+
+TEST(VectorTests, ExtendWith) {
+    DC_SCOPED(sut) sut = sut_new(stdalloc_get_ref());
+    sut_push(&sut, 7);
+
+    size_t offset = 3;
+    sut_extend_with(&sut, 20, square_plus, &offset);
+    ASSERT_EQ(sut_size(&sut), 21);
+    ASSERT_EQ(*sut_read(&sut, 0), 7);
+    for (size_t i = 1; i < 21; i++) {
+        ASSERT_EQ(*sut_read(&sut, i), (i * i) + 3);
+    }
+}
+
+namespace {
+bool is_even(size_t const* item, void* /* ctx */) { return *item % 2 == 0; }
+} // namespace
+
+TEST(VectorTests, Retain) {
+    DC_SCOPED(sut) sut = sut_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 100; i++) {
+        sut_push(&sut, i);
+    }
+
+    ASSERT_EQ(sut_retain(&sut, is_even, nullptr), 50);
+    ASSERT_EQ(sut_size(&sut), 50);
+    for (size_t i = 0; i < 50; i++) {
+        ASSERT_EQ(*sut_read(&sut, i), i * 2);
+    }
+
+    ASSERT_EQ(sut_retain(&sut, is_even, nullptr), 0);
+    ASSERT_EQ(sut_size(&sut), 50);
+}
+
+TEST(VectorTests, ShrinkToFit) {
+    DC_SCOPED(sut) sut = sut_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 100; i++) {
+        sut_push(&sut, i);
+    }
+    ASSERT_EQ(sut.capacity, 128);
+
+    sut_shrink_to_fit(&sut);
+    ASSERT_EQ(sut.capacity, 100);
+    for (size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(*sut_read(&sut, i), i);
+    }
+
+    sut_push(&sut, 100);
+    ASSERT_EQ(sut.capacity, 200);
+
+    ASSERT_EQ(sut_resize_uninit(&sut, 0), nullptr);
+    sut_shrink_to_fit(&sut);
+    ASSERT_EQ(sut.capacity, 0);
+    ASSERT_EQ(sut_data(&sut), nullptr);
+
+    sut_push(&sut, 7);
+    ASSERT_EQ(*sut_read(&sut, 0), 7);
+}
+
+#define NAME one_and_half_vec
+#define ITEM size_t
+#define GROWTH_POLICY dc_growth_one_and_half
+#include <derive-c/container/vector/dynamic/template.h>
+
+namespace {
+DC_GROWTH_DOUBLE_THEN_LINEAR(double_then_linear_64, 64)
+} // namespace
+
+#define NAME double_then_linear_vec
+#define ITEM size_t
+#define GROWTH_POLICY double_then_linear_64
+#include <derive-c/container/vector/dynamic/template.h>
+
+TEST(VectorTests, GrowthPolicies) {
+    std::vector<size_t> one_and_half;
+    std::vector<size_t> double_then_linear;
+
+    DC_SCOPED(one_and_half_vec) a = one_and_half_vec_new(stdalloc_get_ref());
+    DC_SCOPED(double_then_linear_vec) b = double_then_linear_vec_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 300; i++) {
+        if (a.size == a.capacity) {
+            one_and_half_vec_push(&a, i);
+            one_and_half.push_back(a.capacity);
+        } else {
+            one_and_half_vec_push(&a, i);
+        }
+        if (b.size == b.capacity) {
+            double_then_linear_vec_push(&b, i);
+            double_then_linear.push_back(b.capacity);
+        } else {
+            double_then_linear_vec_push(&b, i);
+        }
+    }
+
+    ASSERT_EQ(one_and_half, (std::vector<size_t>{8, 12, 18, 27, 40, 60, 90, 135, 202, 303}));
+    ASSERT_EQ(double_then_linear, (std::vector<size_t>{8, 16, 32, 64, 128, 192, 256, 320}));
+    for (size_t i = 0; i < 300; i++) {
+        ASSERT_EQ(*one_and_half_vec_read(&a, i), i);
+        ASSERT_EQ(*double_then_linear_vec_read(&b, i), i);
+    }
+
+    // Bulk appends grow to at least the required size
+    size_t const items[100] = {};
+    one_and_half_vec_extend(&a, items, 100);
+    ASSERT_EQ(a.capacity, 454);
+    double_then_linear_vec_extend(&b, items, 100);
+    ASSERT_EQ(b.capacity, 400);
+}
+
 #define NAME test_vec
 #define ITEM char const*
 #include <derive-c/container/vector/dynamic/template.h>
@@ -0,0 +1,177 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-c/utils/debug/string.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#define BITS 5
+#define NAME u5_vec
+#include <derive-c/container/vector/packed/template.h>
+
+#define BITS 12
+#define NAME u12_vec
+#include <derive-c/container/vector/packed/template.h>
+
+#define BITS 25
+#define NAME u25_vec
+#include <derive-c/container/vector/packed/template.h>
+
+#define BITS 31
+#define NAME u31_vec
+#include <derive-c/container/vector/packed/template.h>
+
+#define BITS 32
+#define NAME u32_vec
+#include <derive-c/container/vector/packed/template.h>
+
+namespace {
+dc_packed_isa scalar_isa() { return DC_PACKED_ISA_SCALAR; }
+dc_packed_isa avx2_isa() { return DC_PACKED_ISA_AVX2; }
+
+/// Runs a check with each of the unpack kernels selected in turn.
+template <typename F> void for_each_isa(F check) {
+    for (auto* isa : {scalar_isa, avx2_isa}) {
+        if (isa == avx2_isa && !__builtin_cpu_supports("avx2")) {
+            continue;
+        }
+        DC_MOCKABLE_SET(dc_packed_isa_get)(isa);
+        check();
+    }
+    DC_MOCKABLE_SET(dc_packed_isa_get)(DC_MOCKABLE_REAL(dc_packed_isa_get));
+}
+
+#define PACKED_CASE(NAME)                                                                          \
+    struct NAME##_case {                                                                           \
+        using Self = NAME;                                                                         \
+        static constexpr auto max_value = NAME##_max_value;                                        \
+        static constexpr auto create = NAME##_new;                                                 \
+        static constexpr auto push = NAME##_push;                                                  \
+        static constexpr auto get = NAME##_get;                                                    \
+        static constexpr auto set = NAME##_set;                                                    \
+        static constexpr auto size = NAME##_size;                                                  \
+        static constexpr auto unpack = NAME##_unpack;                                              \
+        static constexpr auto destroy = NAME##_delete;                                             \
+    };
+
+PACKED_CASE(u5_vec)
+PACKED_CASE(u12_vec)
+PACKED_CASE(u25_vec)
+PACKED_CASE(u31_vec)
+PACKED_CASE(u32_vec)
+
+#undef PACKED_CASE
+
+template <typename Case> void check_against_std(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> dist(0, Case::max_value);
+
+    typename Case::Self v = Case::create(stdalloc_get_ref());
+    std::vector<uint32_t> model;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t const value = dist(rng);
+        Case::push(&v, value);
+        model.push_back(value);
+    }
+
+    // Overwrite values, including neighbours in the same and adjacent words
+    for (size_t i = 0; i < count / 2; i++) {
+        size_t const index = rng() % count;
+        uint32_t const value = dist(rng);
+        Case::set(&v, index, value);
+        model[index] = value;
+    }
+
+    ASSERT_EQ(Case::size(&v), count);
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(Case::get(&v, i), model[i]) << "index " << i;
+    }
+
+    for_each_isa([&] {
+        // Unaligned starts and lengths either side of the vector width
+        for (size_t from : {0, 1, 3, 7, 13}) {
+            if (from > count) {
+                continue;
+            }
+            std::vector<uint32_t> out(count - from);
+            Case::unpack(&v, from, out.size(), out.data());
+            ASSERT_EQ(out, std::vector<uint32_t>(model.begin() + from, model.end()));
+        }
+    });
+
+    Case::destroy(&v);
+}
+} // namespace
+
+TEST(PackedVectorTests, MatchesStd) {
+    for (size_t count : {0, 1, 7, 8, 9, 63, 64, 65, 1000}) {
+        check_against_std<u5_vec_case>(count, static_cast<uint32_t>(count));
+        check_against_std<u12_vec_case>(count, static_cast<uint32_t>(count));
+        check_against_std<u25_vec_case>(count, static_cast<uint32_t>(count));
+        check_against_std<u31_vec_case>(count, static_cast<uint32_t>(count));
+        check_against_std<u32_vec_case>(count, static_cast<uint32_t>(count));
+    }
+}
+
+TEST(PackedVectorTests, MaxValuesAcrossWords) {
+    DC_SCOPED(u12_vec) v = u12_vec_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 20; i++) {
+        u12_vec_push(&v, u12_vec_max_value);
+    }
+    // Value 5 spans bits [60, 72), crossing the first word boundary
+    u12_vec_set(&v, 5, 0);
+    for (size_t i = 0; i < 20; i++) {
+        ASSERT_EQ(u12_vec_get(&v, i), i == 5 ? 0 : u12_vec_max_value);
+    }
+}
+
+TEST(PackedVectorTests, MemoryPerValue) {
+    DC_SCOPED(u5_vec) v = u5_vec_new_with_capacity(1024, stdalloc_get_ref());
+    // 1024 values of 5 bits in 80 words, and one padding word
+    ASSERT_EQ(u5_vec_capacity_bytes(&v), 81 * sizeof(uint64_t));
+}
+
+TEST(PackedVectorTests, PopAndClone) {
+    DC_SCOPED(u5_vec) v = u5_vec_new(stdalloc_get_ref());
+    for (uint32_t i = 0; i < 100; i++) {
+        u5_vec_push(&v, i % 32);
+    }
+
+    DC_SCOPED(u5_vec) cloned = u5_vec_clone(&v);
+    for (uint32_t i = 100; i > 0; i--) {
+        ASSERT_EQ(u5_vec_pop(&v), (i - 1) % 32);
+    }
+    uint32_t value = 0;
+    ASSERT_FALSE(u5_vec_try_pop(&v, &value));
+    ASSERT_FALSE(u5_vec_try_get(&v, 0, &value));
+
+    ASSERT_EQ(u5_vec_size(&cloned), 100);
+    ASSERT_TRUE(u5_vec_try_get(&cloned, 99, &value));
+    ASSERT_EQ(value, 99 % 32);
+}
+
+TEST(PackedVectorTests, Debug) {
+    DC_SCOPED(u5_vec) v = u5_vec_new(stdalloc_get_ref());
+    u5_vec_push(&v, 1);
+    u5_vec_push(&v, 31);
+    u5_vec_push(&v, 7);
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    u5_vec_debug(&v, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+
+    EXPECT_EQ(
+        // clang-format off
+        "u5_vec@" DC_PTR_REPLACE " {\n"
+        "  bits: 5,\n"
+        "  size: 3,\n"
+        "  capacity: 64,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  values: [1, 31, 7],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -0,0 +1,15 @@
+#include <stdint.h>
+
+#define BITS 1
+#define NAME expand_1
+#include <derive-c/container/vector/packed/template.h>
+
+#define BITS 12
+#define NAME expand_2
+#include <derive-c/container/vector/packed/template.h>
+
+#define BITS 32
+#define NAME expand_3
+#include <derive-c/container/vector/packed/template.h>
+
+int main() {}
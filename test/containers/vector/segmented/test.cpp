@@ -0,0 +1,160 @@
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <derive-c/utils/debug/string.h>
+#include <derive-c/utils/for.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#define NAME sut
+#define ITEM size_t
+#define INITIAL_SEGMENT_INDEX_BITS 2
+#include <derive-c/container/vector/segmented/template.h>
+
+TEST(SegmentedVectorTests, SegmentsDouble) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    ASSERT_EQ(sut_capacity(&v), 0);
+
+    sut_push(&v, 0);
+    ASSERT_EQ(sut_capacity(&v), 4);
+
+    for (size_t i = 1; i < 5; i++) {
+        sut_push(&v, i);
+    }
+    ASSERT_EQ(sut_capacity(&v), 8);
+
+    for (size_t i = 5; i < 9; i++) {
+        sut_push(&v, i);
+    }
+    ASSERT_EQ(sut_capacity(&v), 16);
+
+    for (size_t i = 0; i < 9; i++) {
+        ASSERT_EQ(*sut_read(&v, i), i);
+    }
+    ASSERT_EQ(sut_try_read(&v, 9), nullptr);
+}
+
+TEST(SegmentedVectorTests, PointersStableAcrossGrowth) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    std::vector<size_t*> pointers;
+    for (size_t i = 0; i < 1000; i++) {
+        pointers.push_back(sut_push(&v, i));
+    }
+
+    for (size_t i = 0; i < 1000; i++) {
+        ASSERT_EQ(pointers[i], sut_write(&v, i));
+        ASSERT_EQ(*pointers[i], i);
+    }
+
+    // Popping and pushing again reuses the same segments
+    for (size_t i = 0; i < 500; i++) {
+        sut_pop(&v);
+    }
+    size_t const capacity = sut_capacity(&v);
+    for (size_t i = 500; i < 1000; i++) {
+        ASSERT_EQ(sut_push(&v, i), pointers[i]);
+    }
+    ASSERT_EQ(sut_capacity(&v), capacity);
+}
+
+TEST(SegmentedVectorTests, Reserve) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    sut_reserve(&v, 100);
+    ASSERT_EQ(sut_capacity(&v), 128);
+    ASSERT_EQ(sut_size(&v), 0);
+
+    sut_reserve(&v, 10);
+    ASSERT_EQ(sut_capacity(&v), 128);
+}
+
+TEST(SegmentedVectorTests, InsertAndRemoveAcrossSegments) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    sut_push(&v, 0);
+    sut_push(&v, 7);
+
+    size_t const items[] = {1, 2, 3, 4, 5, 6};
+    ASSERT_EQ(*sut_try_insert_at(&v, 1, items, 6), 1);
+    ASSERT_EQ(sut_size(&v), 8);
+    for (size_t i = 0; i < 8; i++) {
+        ASSERT_EQ(*sut_read(&v, i), i);
+    }
+
+    sut_remove_at(&v, 1, 5);
+    ASSERT_EQ(sut_size(&v), 3);
+    ASSERT_EQ(sut_pop(&v), 7);
+    ASSERT_EQ(sut_pop(&v), 6);
+    ASSERT_EQ(sut_pop(&v), 0);
+
+    size_t item = 0;
+    ASSERT_FALSE(sut_try_pop(&v, &item));
+}
+
+TEST(SegmentedVectorTests, Clone) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 20; i++) {
+        sut_push(&v, i);
+    }
+
+    DC_SCOPED(sut) cloned = sut_clone(&v);
+    ASSERT_EQ(sut_size(&cloned), 20);
+    *sut_write(&v, 0) = 42;
+    for (size_t i = 0; i < 20; i++) {
+        ASSERT_EQ(*sut_read(&cloned, i), i);
+    }
+}
+
+TEST(SegmentedVectorTests, Iterate) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 37; i++) {
+        sut_push(&v, i);
+    }
+
+    size_t expected = 0;
+    DC_FOR(sut, &v, iter, item) {
+        ASSERT_EQ(*item, expected);
+        *item *= 2;
+        expected++;
+    }
+    ASSERT_EQ(expected, 37);
+
+    expected = 0;
+    DC_FOR_CONST(sut, &v, iter_const, item) {
+        ASSERT_EQ(*item, expected * 2);
+        expected++;
+    }
+    ASSERT_EQ(expected, 37);
+}
+
+#define NAME test_vec
+#define ITEM char const*
+#define INITIAL_SEGMENT_INDEX_BITS 1
+#include <derive-c/container/vector/segmented/template.h>
+
+TEST(SegmentedVectorTests, Debug) {
+    DC_SCOPED(test_vec) v = test_vec_new(stdalloc_get_ref());
+    test_vec_push(&v, "foo");
+    test_vec_push(&v, "bar");
+    test_vec_push(&v, "bing");
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    test_vec_debug(&v, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+
+    EXPECT_EQ(
+        // clang-format off
+        "test_vec@" DC_PTR_REPLACE " {\n"
+        "  size: 3,\n"
+        "  capacity: 4,\n"
+        "  segments: 2,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  items: [\n"
+        "    char*@" DC_PTR_REPLACE " \"foo\",\n"
+        "    char*@" DC_PTR_REPLACE " \"bar\",\n"
+        "    char*@" DC_PTR_REPLACE " \"bing\",\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
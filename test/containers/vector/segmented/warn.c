@@ -0,0 +1,17 @@
+#include <stdint.h>
+
+#define ITEM char
+#define NAME expand_1
+#include <derive-c/container/vector/segmented/template.h>
+
+#define ITEM float
+#define INITIAL_SEGMENT_INDEX_BITS 1
+#define NAME expand_2
+#include <derive-c/container/vector/segmented/template.h>
+
+#define ITEM char*
+#define INITIAL_SEGMENT_INDEX_BITS 8
+#define NAME expand_3
+#include <derive-c/container/vector/segmented/template.h>
+
+int main() {}
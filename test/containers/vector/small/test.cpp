@@ -0,0 +1,135 @@
+
+#include <gtest/gtest.h>
+
+#include <derive-c/utils/debug/string.h>
+#include <derive-c/utils/for.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#define NAME sut
+#define ITEM size_t
+#define INLINE_CAPACITY 4
+#include <derive-c/container/vector/small/template.h>
+
+TEST(SmallVectorTests, InlineUntilOverflow) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    ASSERT_TRUE(sut_is_inline(&v));
+
+    for (size_t i = 0; i < 4; i++) {
+        sut_push(&v, i);
+    }
+    ASSERT_TRUE(sut_is_inline(&v));
+    ASSERT_EQ(sut_capacity(&v), 4);
+
+    sut_push(&v, 4);
+    ASSERT_FALSE(sut_is_inline(&v));
+    ASSERT_EQ(sut_capacity(&v), 8);
+
+    for (size_t i = 0; i < 5; i++) {
+        ASSERT_EQ(*sut_read(&v, i), i);
+    }
+}
+
+TEST(SmallVectorTests, CreateWithCapacity) {
+    DC_SCOPED(sut) small = sut_new_with_capacity(2, stdalloc_get_ref());
+    ASSERT_TRUE(sut_is_inline(&small));
+
+    DC_SCOPED(sut) large = sut_new_with_capacity(64, stdalloc_get_ref());
+    ASSERT_FALSE(sut_is_inline(&large));
+    ASSERT_EQ(sut_capacity(&large), 64);
+}
+
+TEST(SmallVectorTests, InsertAndRemoveAcrossSpill) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    sut_push(&v, 0);
+    sut_push(&v, 5);
+
+    size_t const items[] = {1, 2, 3, 4};
+    ASSERT_NE(sut_try_insert_at(&v, 1, items, 4), nullptr);
+    ASSERT_FALSE(sut_is_inline(&v));
+    ASSERT_EQ(sut_size(&v), 6);
+    for (size_t i = 0; i < 6; i++) {
+        ASSERT_EQ(*sut_read(&v, i), i);
+    }
+
+    sut_remove_at(&v, 0, 3);
+    ASSERT_EQ(sut_size(&v), 3);
+    ASSERT_EQ(sut_pop(&v), 5);
+    ASSERT_EQ(sut_pop(&v), 4);
+    ASSERT_EQ(sut_pop(&v), 3);
+
+    size_t item = 0;
+    ASSERT_FALSE(sut_try_pop(&v, &item));
+}
+
+TEST(SmallVectorTests, CloneInlineAndSpilled) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    sut_push(&v, 1);
+    sut_push(&v, 2);
+
+    DC_SCOPED(sut) inline_clone = sut_clone(&v);
+    ASSERT_TRUE(sut_is_inline(&inline_clone));
+    ASSERT_EQ(*sut_read(&inline_clone, 1), 2);
+
+    for (size_t i = 0; i < 10; i++) {
+        sut_push(&v, i);
+    }
+    DC_SCOPED(sut) spilled_clone = sut_clone(&v);
+    ASSERT_FALSE(sut_is_inline(&spilled_clone));
+    ASSERT_EQ(sut_size(&spilled_clone), 12);
+    *sut_write(&v, 0) = 42;
+    ASSERT_EQ(*sut_read(&spilled_clone, 0), 1);
+}
+
+TEST(SmallVectorTests, Iterate) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    for (size_t i = 0; i < 6; i++) {
+        sut_push(&v, i);
+    }
+
+    size_t expected = 0;
+    DC_FOR(sut, &v, iter, item) {
+        ASSERT_EQ(*item, expected);
+        *item *= 2;
+        expected++;
+    }
+    ASSERT_EQ(expected, 6);
+
+    expected = 0;
+    DC_FOR_CONST(sut, &v, iter_const, item) {
+        ASSERT_EQ(*item, expected * 2);
+        expected++;
+    }
+}
+
+#define NAME test_vec
+#define ITEM char const*
+#define INLINE_CAPACITY 2
+#include <derive-c/container/vector/small/template.h>
+
+TEST(SmallVectorTests, Debug) {
+    DC_SCOPED(test_vec) v = test_vec_new(stdalloc_get_ref());
+    test_vec_push(&v, "foo");
+    test_vec_push(&v, "bar");
+    test_vec_push(&v, "bing");
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    test_vec_debug(&v, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+
+    EXPECT_EQ(
+        // clang-format off
+        "test_vec@" DC_PTR_REPLACE " {\n"
+        "  size: 3,\n"
+        "  capacity: 4,\n"
+        "  inline_capacity: 2,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  items: @" DC_PTR_REPLACE " [\n"
+        "    char*@" DC_PTR_REPLACE " \"foo\",\n"
+        "    char*@" DC_PTR_REPLACE " \"bar\",\n"
+        "    char*@" DC_PTR_REPLACE " \"bing\",\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
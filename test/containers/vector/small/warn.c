@@ -0,0 +1,18 @@
+#include <stdint.h>
+
+#define ITEM char
+#define INLINE_CAPACITY 1
+#define NAME expand_1
+#include <derive-c/container/vector/small/template.h>
+
+#define ITEM float
+#define INLINE_CAPACITY 7
+#define NAME expand_2
+#include <derive-c/container/vector/small/template.h>
+
+#define ITEM char*
+#define INLINE_CAPACITY 8
+#define NAME expand_3
+#include <derive-c/container/vector/small/template.h>
+
+int main() {}
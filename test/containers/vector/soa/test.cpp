@@ -0,0 +1,228 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <derive-c/utils/debug/string.h>
+
+#include <derive-cpp/fmt/remove_ptrs.hpp>
+
+#define Trade_REFLECT(F)                                                                           \
+    F(uint64_t, id)                                                                                \
+    F(double, price)                                                                               \
+    F(uint32_t, quantity)                                                                          \
+    F(char, side)
+
+DC_DERIVE_STRUCT(Trade)
+
+#define ITEM Trade
+#define NAME sut
+#include <derive-c/container/vector/soa/template.h>
+
+namespace {
+Trade trade(uint64_t id) {
+    return Trade{
+        .id = id,
+        .price = static_cast<double>(id) * 0.5,
+        .quantity = static_cast<uint32_t>(id * 3),
+        .side = (id % 2 == 0) ? 'B' : 'S',
+    };
+}
+
+void expect_trade_eq(Trade const& actual, Trade const& expected) {
+    EXPECT_EQ(actual.id, expected.id);
+    EXPECT_EQ(actual.price, expected.price);
+    EXPECT_EQ(actual.quantity, expected.quantity);
+    EXPECT_EQ(actual.side, expected.side);
+}
+} // namespace
+
+TEST(SoaVectorTests, PushReadWrite) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    for (uint64_t i = 0; i < 100; i++) {
+        ASSERT_EQ(sut_push(&v, trade(i)), i);
+    }
+    ASSERT_EQ(sut_size(&v), 100);
+
+    for (uint64_t i = 0; i < 100; i++) {
+        expect_trade_eq(sut_read(&v, i), trade(i));
+    }
+
+    sut_write(&v, 10, trade(1000));
+    expect_trade_eq(sut_read(&v, 10), trade(1000));
+
+    Trade out;
+    ASSERT_FALSE(sut_try_read(&v, 100, &out));
+    ASSERT_FALSE(sut_try_write(&v, 100, trade(0)));
+}
+
+TEST(SoaVectorTests, Columns) {
+    DC_SCOPED(sut) v = sut_new_with_capacity(16, stdalloc_get_ref());
+    ASSERT_EQ(sut_capacity(&v), 16);
+    for (uint64_t i = 0; i < 10; i++) {
+        sut_push(&v, trade(i));
+    }
+
+    uint32_t const* quantities = sut_column_const_quantity(&v);
+    uint64_t total = 0;
+    for (size_t i = 0; i < sut_size(&v); i++) {
+        total += quantities[i];
+    }
+    ASSERT_EQ(total, 3 * 45);
+
+    // Writes through a column are seen by whole item reads
+    double* prices = sut_column_price(&v);
+    prices[4] = 99.0;
+    ASSERT_EQ(sut_read(&v, 4).price, 99.0);
+    ASSERT_EQ(sut_read(&v, 4).id, 4);
+}
+
+TEST(SoaVectorTests, PopAndClone) {
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    for (uint64_t i = 0; i < 20; i++) {
+        sut_push(&v, trade(i));
+    }
+
+    DC_SCOPED(sut) cloned = sut_clone(&v);
+    for (uint64_t i = 20; i > 0; i--) {
+        expect_trade_eq(sut_pop(&v), trade(i - 1));
+    }
+    Trade out;
+    ASSERT_FALSE(sut_try_pop(&v, &out));
+
+    ASSERT_EQ(sut_size(&cloned), 20);
+    expect_trade_eq(sut_read(&cloned, 19), trade(19));
+}
+
+TEST(SoaVectorTests, MatchesModel) {
+    std::mt19937_64 rng(7);
+    DC_SCOPED(sut) v = sut_new(stdalloc_get_ref());
+    std::vector<Trade> model;
+
+    for (size_t op = 0; op < 5000; op++) {
+        switch (rng() % 4) {
+        case 0:
+        case 1: {
+            Trade const item = trade(rng() % 1000);
+            sut_push(&v, item);
+            model.push_back(item);
+            break;
+        }
+        case 2: {
+            if (!model.empty()) {
+                expect_trade_eq(sut_pop(&v), model.back());
+                model.pop_back();
+            }
+            break;
+        }
+        case 3: {
+            if (!model.empty()) {
+                size_t const index = rng() % model.size();
+                Trade const item = trade(rng() % 1000);
+                sut_write(&v, index, item);
+                model[index] = item;
+            }
+            break;
+        }
+        }
+    }
+
+    ASSERT_EQ(sut_size(&v), model.size());
+    uint64_t const* ids = sut_column_const_id(&v);
+    for (size_t i = 0; i < model.size(); i++) {
+        ASSERT_EQ(ids[i], model[i].id);
+        expect_trade_eq(sut_read(&v, i), model[i]);
+    }
+}
+
+#define Named_REFLECT(F)                                                                           \
+    F(char*, name)                                                                                 \
+    F(uint32_t, age)
+
+DC_DERIVE_STRUCT(Named)
+
+static void named_delete(Named* self) { free(self->name); }
+
+static Named named_clone(Named const* self) {
+    return Named{.name = strdup(self->name), .age = self->age};
+}
+
+static void named_debug(Named const* self, dc_debug_fmt /* fmt */, FILE* stream) {
+    fprintf(stream, "%s (%u)", self->name, self->age);
+}
+
+#define ITEM Named
+#define ITEM_DELETE named_delete
+#define ITEM_CLONE named_clone
+#define ITEM_DEBUG named_debug
+#define NAME named_vec
+#include <derive-c/container/vector/soa/template.h>
+
+TEST(SoaVectorTests, OwnedFields) {
+    DC_SCOPED(named_vec) v = named_vec_new(stdalloc_get_ref());
+    named_vec_push(&v, Named{.name = strdup("alice"), .age = 30});
+    named_vec_push(&v, Named{.name = strdup("bob"), .age = 40});
+
+    DC_SCOPED(named_vec) cloned = named_vec_clone(&v);
+    ASSERT_NE(named_vec_column_const_name(&cloned)[0], named_vec_column_const_name(&v)[0]);
+
+    // The previous item is deleted on write
+    named_vec_write(&v, 0, Named{.name = strdup("carol"), .age = 50});
+    ASSERT_STREQ(named_vec_read(&v, 0).name, "carol");
+    ASSERT_STREQ(named_vec_read(&cloned, 0).name, "alice");
+
+    Named popped = named_vec_pop(&cloned);
+    ASSERT_STREQ(popped.name, "bob");
+    named_delete(&popped);
+}
+
+TEST(SoaVectorTests, Debug) {
+    DC_SCOPED(named_vec) v = named_vec_new(stdalloc_get_ref());
+    named_vec_push(&v, Named{.name = strdup("alice"), .age = 30});
+    named_vec_push(&v, Named{.name = strdup("bob"), .age = 40});
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    named_vec_debug(&v, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+
+    EXPECT_EQ(
+        // clang-format off
+        "named_vec@" DC_PTR_REPLACE " {\n"
+        "  size: 2,\n"
+        "  capacity: 8,\n"
+        "  alloc: stdalloc@" DC_PTR_REPLACE " { },\n"
+        "  items: [\n"
+        "    alice (30),\n"
+        "    bob (40),\n"
+        "  ],\n"
+        "}"
+        // clang-format on
+        ,
+        derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
+
+// A user's item named as the template's placeholder keeps its reflection across instantiations.
+#define item_t_REFLECT(F)                                                                          \
+    F(int, a)                                                                                      \
+    F(int, b)
+
+DC_DERIVE_STRUCT(item_t)
+
+#define ITEM item_t
+#define NAME first_item_vec
+#include <derive-c/container/vector/soa/template.h>
+
+#define ITEM item_t
+#define NAME second_item_vec
+#include <derive-c/container/vector/soa/template.h>
+
+TEST(SoaVectorTests, ItemNamedAsPlaceholder) {
+    DC_SCOPED(first_item_vec) first = first_item_vec_new(stdalloc_get_ref());
+    DC_SCOPED(second_item_vec) second = second_item_vec_new(stdalloc_get_ref());
+    first_item_vec_push(&first, item_t{.a = 1, .b = 2});
+    second_item_vec_push(&second, item_t{.a = 3, .b = 4});
+    EXPECT_EQ(first_item_vec_column_const_b(&first)[0], 2);
+    EXPECT_EQ(second_item_vec_column_const_a(&second)[0], 3);
+}
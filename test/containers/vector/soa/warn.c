@@ -0,0 +1,26 @@
+#include <stdint.h>
+
+#include <derive-c/core/prelude.h>
+
+#define Point_REFLECT(F)                                                                           \
+    F(float, x)                                                                                    \
+    F(float, y)
+
+DC_DERIVE_STRUCT(Point)
+
+#define ITEM Point
+#define NAME expand_1
+#include <derive-c/container/vector/soa/template.h>
+
+#define Record_REFLECT(F)                                                                          \
+    F(uint64_t, id)                                                                                \
+    F(char, tag)                                                                                   \
+    F(double, value)
+
+DC_DERIVE_STRUCT(Record)
+
+#define ITEM Record
+#define NAME expand_2
+#include <derive-c/container/vector/soa/template.h>
+
+int main() {}
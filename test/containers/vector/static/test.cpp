@@ -54,3 +54,30 @@ TEST(VectorTests, Debug) {
             derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
     }
 }
+
+#define NAME int_vec
+#define CAPACITY 16
+#define ITEM int
+#include <derive-c/container/vector/static/template.h>
+
+namespace {
+bool below(int const* item, void* ctx) { return *item < *static_cast<int*>(ctx); }
+} // namespace
+
+TEST(VectorTests, Retain) {
+    DC_SCOPED(int_vec) v = int_vec_new();
+    for (int i = 0; i < 16; i++) {
+        int_vec_push(&v, 15 - i);
+    }
+
+    int bound = 4;
+    ASSERT_EQ(int_vec_retain(&v, below, &bound), 12);
+    ASSERT_EQ(int_vec_size(&v), 4);
+    for (uint8_t i = 0; i < 4; i++) {
+        ASSERT_EQ(*int_vec_read(&v, i), 3 - i);
+    }
+
+    bound = 0;
+    ASSERT_EQ(int_vec_retain(&v, below, &bound), 4);
+    ASSERT_EQ(int_vec_size(&v), 0);
+}
@@ -130,3 +130,57 @@ TEST_F(OptionTests, DebugNone) {
     EXPECT_EQ("optional_int@" DC_PTR_REPLACE " { NONE }",
               derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
 }
+
+#define NAME optional_ptr
+#define ITEM int const*
+#define ITEM_NICHE NULL
+#include <derive-c/utils/option/template.h>
+
+static_assert(sizeof(optional_ptr) == sizeof(int const*));
+
+TEST(NicheOption, Pointer) {
+    int const value = 3;
+    optional_ptr opt = optional_ptr_empty();
+    ASSERT_FALSE(optional_ptr_is_present(&opt));
+    ASSERT_EQ(optional_ptr_get_const(&opt), nullptr);
+    ASSERT_EQ(optional_ptr_get_value_or(&opt, &value), &value);
+
+    ASSERT_FALSE(optional_ptr_replace(&opt, &value));
+    ASSERT_TRUE(optional_ptr_is_present(&opt));
+    ASSERT_EQ(*optional_ptr_get_const(&opt), &value);
+    ASSERT_TRUE(optional_ptr_replace(&opt, &value));
+
+    optional_ptr cloned = optional_ptr_clone(&opt);
+    ASSERT_EQ(*optional_ptr_get(&cloned), &value);
+}
+
+#define INDEX_BITS 32
+#define NAME ints
+#define VALUE int
+#include <derive-c/container/arena/contiguous/template.h>
+
+#define NAME optional_index
+#define ITEM ints_index_t
+#define ITEM_NICHE ints_index_t_none()
+#define ITEM_IS_NICHE ints_index_t_is_none
+#define ITEM_DEBUG ints_index_t_debug
+#include <derive-c/utils/option/template.h>
+
+static_assert(sizeof(optional_index) == sizeof(ints_index_t));
+
+TEST(NicheOption, ArenaIndex) {
+    DC_SCOPED(ints) arena = ints_new_with_capacity_for(4, stdalloc_get_ref());
+    ints_index_t const index = ints_insert(&arena, 7);
+
+    optional_index opt = optional_index_from(index);
+    ASSERT_TRUE(optional_index_is_present(&opt));
+    ASSERT_EQ(*ints_read(&arena, *optional_index_get_const(&opt)), 7);
+
+    optional_index none = optional_index_empty();
+    ASSERT_FALSE(optional_index_is_present(&none));
+
+    DC_SCOPED(dc_debug_string_builder) sb = dc_debug_string_builder_new(stdalloc_get_ref());
+    optional_index_debug(&none, dc_debug_fmt_new(), dc_debug_string_builder_stream(&sb));
+    EXPECT_EQ("optional_index@" DC_PTR_REPLACE " { NONE }",
+              derivecpp::fmt::pointer_replace(dc_debug_string_builder_string(&sb)));
+}
@@ -9,4 +9,21 @@
 #include <derive-c/utils/option/template.h>
 
 
+#define ITEM char*
+#define NAME expand_3
+#define ITEM_NICHE NULL
+#define ITEM_DELETE(item_ptr) free(*item_ptr)
+#include <derive-c/utils/option/template.h>
+
+#define INDEX_BITS 32
+#define NAME ints
+#define VALUE int
+#include <derive-c/container/arena/contiguous/template.h>
+
+#define ITEM ints_index_t
+#define NAME expand_4
+#define ITEM_NICHE ints_index_t_none()
+#define ITEM_IS_NICHE ints_index_t_is_none
+#include <derive-c/utils/option/template.h>
+
 int main() {}